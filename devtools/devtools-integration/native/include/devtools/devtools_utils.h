@@ -36,7 +36,7 @@ class DevToolsUtil {
   using DomNodeMetas = hippy::devtools::DomNodeMetas;
   using DomainMetas = hippy::devtools::DomainMetas;
   using DomNodeLocation = hippy::devtools::DomNodeLocation;
-  using NodePropsUnorderedMap = std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>>;
+  using NodePropsUnorderedMap = std::shared_ptr<const hippy::dom::DomValueMap>;
 
   static DomNodeMetas ToDomNodeMetas(const std::shared_ptr<DomNode>& root_node, const std::shared_ptr<DomNode>& dom_node);
 
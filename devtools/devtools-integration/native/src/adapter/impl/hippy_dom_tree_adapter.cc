@@ -44,7 +44,7 @@ void HippyDomTreeAdapter::UpdateDomTree(hippy::devtools::UpdateDomNodeMetas meta
       callback(is_success);
       return;
     }
-    std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>> style_map{};
+    hippy::dom::DomValueMap style_map{};
     for (auto &meta : metas_list) {
       if (meta.IsDouble()) {
         style_map.insert({meta.GetKey(), std::make_shared<footstone::value::HippyValue>(meta.ToDouble())});
@@ -55,7 +55,7 @@ void HippyDomTreeAdapter::UpdateDomTree(hippy::devtools::UpdateDomNodeMetas meta
     std::shared_ptr<DomManager> dom_manager = hippy_dom->dom_manager.lock();
     if (dom_manager) {
       auto node = dom_manager->GetNode(hippy_dom->root_node, static_cast<uint32_t>(node_id));
-      node->UpdateProperties(style_map, std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>>{});
+      node->UpdateProperties(style_map, hippy::dom::DomValueMap{});
       is_success = true;
     }
     callback(is_success);
@@ -0,0 +1,137 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "dom/animation/animation_manager.h"
+#include "dom/animation/cubic_bezier_animation.h"
+#include "dom/dom_manager.h"
+#include "dom/dom_node.h"
+#include "dom/node_props.h"
+#include "dom/root_node.h"
+#include "footstone/hippy_value.h"
+#include "footstone/logging.h"
+#include "footstone/task_runner.h"
+
+namespace hippy {
+namespace dom {
+namespace benchmark {
+
+namespace {
+
+using HippyValue = footstone::value::HippyValue;
+using HippyValueObjectType = footstone::value::HippyValue::HippyValueObjectType;
+
+constexpr uint32_t kRootId = 1;
+constexpr uint32_t kAnimationNodeCount = 500;
+constexpr uint64_t kAnimationDuration = 60 * 1000;
+constexpr int kFrameTimes = 1000;
+
+struct AnimatedPage {
+  std::shared_ptr<CountingRenderManager> render_manager;
+  std::shared_ptr<DomManager> dom_manager;
+  std::shared_ptr<RootNode> root_node;
+  std::vector<std::shared_ptr<CubicBezierAnimation>> animations;
+};
+
+// kAnimationNodeCount 个节点，每个节点的 opacity 与 transform 中的 translateX 各由一个动画驱动
+AnimatedPage CreateAnimatedPage(const std::vector<std::string>& timing_functions) {
+  AnimatedPage page;
+  page.render_manager = std::make_shared<CountingRenderManager>();
+  page.dom_manager = std::make_shared<DomManager>();
+  page.dom_manager->SetRenderManager(page.render_manager);
+  // 布局事件与 vsync 回调投递到未绑定 worker 的 runner，直接调用 UpdateAnimations 模拟每一帧
+  page.dom_manager->SetTaskRunner(std::make_shared<footstone::TaskRunner>("animation"));
+  page.root_node = std::make_shared<RootNode>(kRootId);
+  page.root_node->SetDomManager(page.dom_manager);
+  page.root_node->SetRootSize(1080, 1920);
+  auto animation_manager = page.root_node->GetAnimationManager();
+
+  auto create_animation = [&page, &animation_manager, &timing_functions](double to_value) {
+    auto index = page.animations.size();
+    auto animation = std::make_shared<CubicBezierAnimation>(
+        CubicBezierAnimation::Mode::kTiming, 0, 0, to_value, CubicBezierAnimation::ValueType::kUndefined,
+        kAnimationDuration, timing_functions[index % timing_functions.size()], 0);
+    animation->SetAnimationManager(animation_manager);
+    animation_manager->AddAnimation(animation);
+    page.animations.push_back(animation);
+    HippyValueObjectType object;
+    object[kAnimationId] = HippyValue(animation->GetId());
+    return HippyValue(object);
+  };
+
+  std::vector<std::shared_ptr<DomInfo>> infos;
+  for (uint32_t i = 0; i < kAnimationNodeCount; ++i) {
+    auto style = std::make_shared<DomValueMap>();
+    (*style)[kWidth] = std::make_shared<HippyValue>(100);
+    (*style)[kHeight] = std::make_shared<HippyValue>(100);
+    (*style)[kOpacity] = std::make_shared<HippyValue>(create_animation(1));
+    HippyValueObjectType translate;
+    translate["translateX"] = create_animation(200);
+    (*style)["transform"] = std::make_shared<HippyValue>(HippyValue::HippyValueArrayType{HippyValue(translate)});
+    auto ext = std::make_shared<DomValueMap>();
+    (*ext)[kUseAnimation] = std::make_shared<HippyValue>(true);
+    auto node = std::make_shared<DomNode>(kRootId + 1 + i, kRootId, static_cast<int32_t>(i), "View", "View", style,
+                                          ext, page.root_node);
+    infos.push_back(std::make_shared<DomInfo>(node, nullptr, nullptr));
+  }
+  DomManager::CreateDomNodes(page.root_node, std::move(infos), false);
+  page.dom_manager->EndBatch(page.root_node);
+
+  for (const auto& animation : page.animations) {
+    animation->Start();
+    // 直接从动画中段开始，每帧都需要求解曲线
+    animation->SetExecTime(kAnimationDuration / 2);
+  }
+  return page;
+}
+
+}  // namespace
+
+void RunAnimationManagerBenchmark() {
+  auto measure = [](bool support_animation_props) {
+    auto page = CreateAnimatedPage({kAnimationTimingFunctionEaseInOut, "cubic-bezier(.45,2.84,.38,.5)"});
+    page.render_manager->support_animation_props = support_animation_props;
+    page.render_manager->updated_count = 0;
+    page.render_manager->animation_props_count = 0;
+    auto animation_manager = page.root_node->GetAnimationManager();
+    Clock::duration total{0};
+    for (int i = 0; i < kFrameTimes; ++i) {
+      auto begin = Clock::now();
+      animation_manager->UpdateAnimations();
+      total += Clock::now() - begin;
+    }
+    FOOTSTONE_DCHECK(page.render_manager->updated_count + page.render_manager->animation_props_count ==
+                     kAnimationNodeCount * kFrameTimes);
+    return ToMicroseconds(total / kFrameTimes);
+  };
+  auto batched = measure(false);
+  auto direct = measure(true);
+  std::printf("[AnimationManager] animations = %u, per frame: dom batch = %lldus, paint only = %lldus\n",
+              kAnimationNodeCount * 2, static_cast<long long>(batched), static_cast<long long>(direct));
+}
+
+}  // namespace benchmark
+}  // namespace dom
+}  // namespace hippy
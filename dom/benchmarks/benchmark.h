@@ -0,0 +1,96 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dom/render_manager.h"
+
+namespace hippy {
+inline namespace dom {
+namespace benchmark {
+
+using Clock = std::chrono::steady_clock;
+
+inline int64_t ToNanoseconds(Clock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+inline int64_t ToMicroseconds(Clock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+// 只统计调用次数的渲染层，基准中的耗时只包含 dom 层
+class CountingRenderManager : public RenderManager {
+ public:
+  CountingRenderManager() : RenderManager("CountingRenderManager") {}
+
+  void CreateRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&&) override {}
+  void UpdateRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&& nodes) override {
+    updated_count += nodes.size();
+  }
+  void MoveRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&&) override {}
+  void DeleteRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&&) override {}
+  void UpdateLayout(std::weak_ptr<RootNode>, const std::vector<std::shared_ptr<DomNode>>&) override {}
+  void MoveRenderNode(std::weak_ptr<RootNode>, std::vector<int32_t>&&, int32_t, int32_t, int32_t) override {}
+  void EndBatch(std::weak_ptr<RootNode>) override {}
+  bool UpdateAnimationProps(std::weak_ptr<RootNode>, const std::vector<AnimationPropsUpdate>& updates) override {
+    if (!support_animation_props) {
+      return false;
+    }
+    animation_props_count += updates.size();
+    return true;
+  }
+  void BeforeLayout(std::weak_ptr<RootNode>) override {}
+  void AfterLayout(std::weak_ptr<RootNode>) override {}
+  void AddEventListener(std::weak_ptr<RootNode>, std::weak_ptr<DomNode>, const std::string&) override {}
+  void RemoveEventListener(std::weak_ptr<RootNode>, std::weak_ptr<DomNode>, const std::string&) override {}
+  void CallFunction(std::weak_ptr<RootNode>, std::weak_ptr<DomNode>, const std::string&, const DomArgument&,
+                    uint32_t) override {}
+
+  bool support_animation_props = false;
+  size_t updated_count = 0;
+  size_t animation_props_count = 0;
+};
+
+void RunLayoutTransferBenchmark();
+void RunUpdateDomNodesBenchmark();
+void RunLongListBenchmark();
+void RunStatisticsBenchmark();
+void RunEventDispatchBenchmark();
+void RunParallelLayoutBenchmark();
+void RunMeasureCacheBenchmark();
+void RunAnimationManagerBenchmark();
+void RunDomSnapshotBenchmark();
+void RunDomSnapshotRecorderBenchmark();
+void RunHippyValueBenchmark();
+void RunSerializerBenchmark();
+void RunPostTaskBenchmark();
+void RunPostClosureBenchmark();
+void RunWorkStealingBenchmark();
+
+}  // namespace benchmark
+}  // namespace dom
+}  // namespace hippy
@@ -0,0 +1,231 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.h"
+#include "dom/dom_manager.h"
+#include "dom/dom_node.h"
+#include "dom/dom_snapshot.h"
+#include "dom/dom_snapshot_recorder.h"
+#include "dom/node_props.h"
+#include "dom/root_node.h"
+#include "footstone/hippy_value.h"
+#include "footstone/logging.h"
+
+namespace hippy {
+namespace dom {
+namespace benchmark {
+
+namespace {
+
+using HippyValue = footstone::value::HippyValue;
+using HippyValueArrayType = footstone::value::HippyValue::HippyValueArrayType;
+using HippyValueObjectType = footstone::value::HippyValue::HippyValueObjectType;
+
+constexpr uint32_t kRootId = 1;
+constexpr uint32_t kListId = kRootId + 1;
+constexpr uint32_t kCellCount = 500;
+constexpr int kStartTimes = 10;
+constexpr int kBatchTimes = 100;
+constexpr char kSnapshotPath[] = "dom_snapshot_benchmark.snapshot";
+
+std::shared_ptr<DomManager> CreateDomManager() {
+  auto dom_manager = std::make_shared<DomManager>();
+  dom_manager->SetRenderManager(std::make_shared<CountingRenderManager>());
+  return dom_manager;
+}
+
+std::shared_ptr<RootNode> CreateRoot() {
+  auto root_node = std::make_shared<RootNode>(kRootId);
+  root_node->SetRootSize(1080, 1920);
+  return root_node;
+}
+
+// 一个列表页面：列表下 kCellCount 个 cell，每个 cell 包含一张图片与一段文本，样式大多相同
+std::shared_ptr<RootNode> CreateLaidOutPage(const std::shared_ptr<DomManager>& dom_manager) {
+  auto root_node = CreateRoot();
+  std::vector<std::shared_ptr<DomInfo>> infos;
+  auto add = [&infos, &root_node](uint32_t id, uint32_t pid, const std::string& view_name,
+                                  std::shared_ptr<DomValueMap> style, std::shared_ptr<DomValueMap> ext) {
+    auto node = std::make_shared<DomNode>(id, pid, 0, view_name, view_name, std::move(style), std::move(ext),
+                                          root_node);
+    infos.push_back(std::make_shared<DomInfo>(node, nullptr, nullptr));
+  };
+  auto list_style = std::make_shared<DomValueMap>();
+  (*list_style)[kFlex] = std::make_shared<HippyValue>(1);
+  add(kListId, kRootId, "ListView", list_style, std::make_shared<DomValueMap>());
+  auto id = kListId;
+  for (uint32_t k = 0; k < kCellCount; ++k) {
+    auto cell_style = std::make_shared<DomValueMap>();
+    (*cell_style)[kHeight] = std::make_shared<HippyValue>(120);
+    (*cell_style)[kFlexDirection] = std::make_shared<HippyValue>("row");
+    (*cell_style)[kBackgroundColor] = std::make_shared<HippyValue>(0xffffffffu);
+    HippyValueObjectType shadow;
+    shadow["x"] = HippyValue(0);
+    shadow["y"] = HippyValue(1.5);
+    (*cell_style)["shadowOffset"] = std::make_shared<HippyValue>(shadow);
+    auto cell_ext = std::make_shared<DomValueMap>();
+    (*cell_ext)["key"] = std::make_shared<HippyValue>("cell-" + std::to_string(k));
+    auto cell_id = ++id;
+    add(cell_id, kListId, "ListViewItem", cell_style, cell_ext);
+
+    auto image_style = std::make_shared<DomValueMap>();
+    (*image_style)[kWidth] = std::make_shared<HippyValue>(100);
+    (*image_style)[kHeight] = std::make_shared<HippyValue>(100);
+    (*image_style)["src"] = std::make_shared<HippyValue>("https://example.com/" + std::to_string(k % 20) + ".png");
+    add(++id, cell_id, "Image", image_style, std::make_shared<DomValueMap>());
+
+    auto text_style = std::make_shared<DomValueMap>();
+    (*text_style)[kFlex] = std::make_shared<HippyValue>(1);
+    (*text_style)[kFontSize] = std::make_shared<HippyValue>(16.0);
+    (*text_style)[kText] = std::make_shared<HippyValue>("item " + std::to_string(k));
+    HippyValueArrayType transform = {HippyValue(1), HippyValue(true), HippyValue::Null()};
+    (*text_style)["transform"] = std::make_shared<HippyValue>(transform);
+    add(++id, cell_id, "Text", text_style, std::make_shared<DomValueMap>());
+  }
+  DomManager::CreateDomNodes(root_node, std::move(infos), false);
+  dom_manager->EndBatch(root_node);
+  return root_node;
+}
+
+// 第 k 个 cell 中文本节点的更新
+std::shared_ptr<DomInfo> CreateTextUpdate(const std::shared_ptr<RootNode>& root_node, uint32_t k,
+                                          const std::string& text) {
+  auto cell_id = kListId + 1 + k * 3;
+  auto style = std::make_shared<DomValueMap>();
+  (*style)[kFlex] = std::make_shared<HippyValue>(1);
+  (*style)[kFontSize] = std::make_shared<HippyValue>(16.0);
+  (*style)[kText] = std::make_shared<HippyValue>(text);
+  auto node = std::make_shared<DomNode>(cell_id + 2, cell_id, 1, "Text", "Text", style,
+                                        std::make_shared<DomValueMap>(), root_node);
+  return std::make_shared<DomInfo>(node, nullptr, nullptr);
+}
+
+void RemoveSnapshotFiles(const std::string& path) {
+  std::remove(path.c_str());
+  std::remove((path + ".log").c_str());
+}
+
+}  // namespace
+
+void RunDomSnapshotBenchmark() {
+  auto dom_manager = CreateDomManager();
+  auto origin = CreateLaidOutPage(dom_manager);
+  auto legacy_snapshot = DomManager::GetSnapShot(origin);
+  auto binary_snapshot = DomSnapshot::Serialize(origin);
+  std::string path = kSnapshotPath;
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(binary_snapshot.data(), static_cast<std::streamsize>(binary_snapshot.size()));
+  }
+
+  auto measure = [](const std::function<std::shared_ptr<RootNode>()>& start) {
+    Clock::duration total{0};
+    for (int i = 0; i < kStartTimes; ++i) {
+      auto begin = Clock::now();
+      auto root_node = start();
+      total += Clock::now() - begin;
+      FOOTSTONE_DCHECK(root_node->GetNode(kListId) != nullptr);
+    }
+    return static_cast<long long>(ToMicroseconds(total / kStartTimes));
+  };
+  // 冷启动：创建节点并布局
+  auto cold = measure([&dom_manager] { return CreateLaidOutPage(dom_manager); });
+  // 热启动：HippyValue 快照，整体反序列化后重新布局
+  auto legacy = measure([&dom_manager, &legacy_snapshot] {
+    auto root_node = CreateRoot();
+    dom_manager->SetSnapShot(root_node, legacy_snapshot);
+    return root_node;
+  });
+  // 热启动：二进制快照，打开内存中的快照
+  auto binary = measure([&dom_manager, &binary_snapshot] {
+    auto root_node = CreateRoot();
+    dom_manager->SetSnapShot(root_node, DomSnapshot::FromBuffer(binary_snapshot));
+    return root_node;
+  });
+  // 热启动：二进制快照，mmap 快照文件
+  auto mapped = measure([&dom_manager, &path] {
+    auto root_node = CreateRoot();
+    dom_manager->SetSnapShot(root_node, DomSnapshot::Open(path));
+    return root_node;
+  });
+  std::remove(path.c_str());
+
+  std::printf("[DomSnapshot] nodes = %u, size: legacy = %zuB, binary = %zuB\n", kCellCount * 3 + 2,
+              legacy_snapshot.size(), binary_snapshot.size());
+  std::printf("[DomSnapshot] cold = %lldus, warm legacy = %lldus, warm binary = %lldus, warm binary mmap = %lldus\n",
+              cold, legacy, binary, mapped);
+}
+
+void RunDomSnapshotRecorderBenchmark() {
+  auto dom_manager = CreateDomManager();
+  std::string path = kSnapshotPath;
+
+  // 每个 batch 更新一个文本节点
+  auto measure = [&dom_manager](const std::shared_ptr<RootNode>& root_node,
+                                const std::function<void()>& after_batch) {
+    Clock::duration total{0};
+    for (int i = 0; i < kBatchTimes; ++i) {
+      auto begin = Clock::now();
+      DomManager::UpdateDomNodes(root_node, {CreateTextUpdate(root_node, i % kCellCount, std::to_string(i))});
+      dom_manager->EndBatch(root_node);
+      after_batch();
+      total += Clock::now() - begin;
+    }
+    return static_cast<long long>(ToMicroseconds(total / kBatchTimes));
+  };
+  auto baseline = measure(CreateLaidOutPage(dom_manager), [] {});
+
+  auto full_root = CreateLaidOutPage(dom_manager);
+  size_t full_size = 0;
+  auto full = measure(full_root, [&full_root, &path, &full_size] {
+    auto snapshot = DomSnapshot::Serialize(full_root);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(snapshot.data(), static_cast<std::streamsize>(snapshot.size()));
+    full_size += snapshot.size();
+  });
+  RemoveSnapshotFiles(path);
+
+  auto delta_root = CreateLaidOutPage(dom_manager);
+  auto recorder = std::make_shared<DomSnapshotRecorder>(delta_root, path);
+  delta_root->AddInterceptor(recorder);
+  if (!recorder->Compact()) {
+    FOOTSTONE_LOG(ERROR) << "write base snapshot failed, path = " << path;
+    return;
+  }
+  auto delta = measure(delta_root, [] {});
+  auto statistics = recorder->GetStatistics();
+  RemoveSnapshotFiles(path);
+
+  std::printf("[DomSnapshotRecorder] per batch: no snapshot = %lldus, full snapshot = %lldus (%zuB), "
+              "delta = %lldus (%zuB)\n", baseline, full, full_size / kBatchTimes, delta,
+              static_cast<size_t>(statistics.log_size / kBatchTimes));
+}
+
+}  // namespace benchmark
+}  // namespace dom
+}  // namespace hippy
@@ -0,0 +1,83 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <functional>
+
+#include "benchmark.h"
+#include "footstone/hippy_value.h"
+#include "footstone/logging.h"
+
+namespace hippy {
+namespace dom {
+namespace benchmark {
+
+using HippyValue = footstone::value::HippyValue;
+
+void RunHippyValueBenchmark() {
+  constexpr int kTimes = 100000;
+  HippyValue::HippyValueObjectType style;
+  style["width"] = HippyValue(100);
+  style["height"] = HippyValue(10.5);
+  style["color"] = HippyValue(static_cast<uint32_t>(0xff000000));
+  style["display"] = HippyValue("flex");
+  style["text"] = HippyValue("hippy text content for benchmark");
+  HippyValue::HippyValueArrayType transform;
+  for (int i = 0; i < 4; ++i) {
+    HippyValue::HippyValueObjectType translate;
+    translate["translateX"] = HippyValue(i);
+    transform.push_back(HippyValue(translate));
+  }
+  style["transform"] = HippyValue(transform);
+  HippyValue value(style);
+
+  // 累加结果，避免循环被优化掉
+  size_t hash = 0;
+  auto start = Clock::now();
+  for (int i = 0; i < kTimes; ++i) {
+    const HippyValue copy = value;
+    hash += copy.ToObjectChecked().size();
+  }
+  auto copy_cost = Clock::now() - start;
+
+  HippyValue other(style);
+  bool equal = true;
+  start = Clock::now();
+  for (int i = 0; i < kTimes; ++i) {
+    equal = equal && value == other;
+  }
+  auto equal_cost = Clock::now() - start;
+  FOOTSTONE_DCHECK(equal);
+
+  start = Clock::now();
+  for (int i = 0; i < kTimes; ++i) {
+    hash += std::hash<HippyValue>{}(value);
+  }
+  auto hash_cost = Clock::now() - start;
+
+  std::printf("[HippyValue] sizeof = %zu, copy = %lldns, equal = %lldns, hash = %lldns (%zu)\n", sizeof(HippyValue),
+              static_cast<long long>(ToNanoseconds(copy_cost) / kTimes),
+              static_cast<long long>(ToNanoseconds(equal_cost) / kTimes),
+              static_cast<long long>(ToNanoseconds(hash_cost) / kTimes), hash);
+}
+
+}  // namespace benchmark
+}  // namespace dom
+}  // namespace hippy
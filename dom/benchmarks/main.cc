@@ -0,0 +1,65 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <iostream>
+
+#include "benchmark.h"
+
+using namespace hippy::dom::benchmark;  // NOLINT(build/namespaces)
+
+namespace {
+
+struct Benchmark {
+  const char* name;
+  void (*run)();
+};
+
+constexpr Benchmark kBenchmarks[] = {
+    {"LayoutTransfer", RunLayoutTransferBenchmark},
+    {"UpdateDomNodes", RunUpdateDomNodesBenchmark},
+    {"LongList", RunLongListBenchmark},
+    {"Statistics", RunStatisticsBenchmark},
+    {"EventDispatch", RunEventDispatchBenchmark},
+    {"ParallelLayout", RunParallelLayoutBenchmark},
+    {"MeasureCache", RunMeasureCacheBenchmark},
+    {"AnimationManager", RunAnimationManagerBenchmark},
+    {"DomSnapshot", RunDomSnapshotBenchmark},
+    {"DomSnapshotRecorder", RunDomSnapshotRecorderBenchmark},
+    {"HippyValue", RunHippyValueBenchmark},
+    {"Serializer", RunSerializerBenchmark},
+    {"PostTask", RunPostTaskBenchmark},
+    {"PostClosure", RunPostClosureBenchmark},
+    {"WorkStealing", RunWorkStealingBenchmark},
+};
+
+}  // namespace
+
+// 用法：dom_benchmark [name]，指定 name 时只运行名字中包含 name 的基准
+int main(int argc, char** argv) {
+  const char* filter = argc > 1 ? argv[1] : nullptr;
+  for (const auto& benchmark : kBenchmarks) {
+    if (filter && !std::strstr(benchmark.name, filter)) {
+      continue;
+    }
+    benchmark.run();
+  }
+  return 0;
+}
@@ -0,0 +1,403 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "benchmark.h"
+#include "dom/dom_node.h"
+#include "dom/measure_cache.h"
+#include "dom/node_props.h"
+#include "dom/root_node.h"
+#include "footstone/hippy_value.h"
+#include "footstone/logging.h"
+#include "footstone/worker_manager.h"
+
+namespace hippy {
+namespace dom {
+namespace benchmark {
+
+namespace {
+
+using HippyValue = footstone::value::HippyValue;
+using HippyValueArrayType = footstone::value::HippyValue::HippyValueArrayType;
+using HippyValueObjectType = footstone::value::HippyValue::HippyValueObjectType;
+
+constexpr uint32_t kRootId = 1;
+constexpr uint32_t kFanout = 8;
+constexpr int kLayoutTimes = 20;
+constexpr int kEventDispatchTimes = 100000;
+// 模拟平台测量文本的开销
+constexpr auto kMeasureCost = std::chrono::microseconds(20);
+
+// node k 是 node k / kFanout - 1（或根节点）的子节点
+std::shared_ptr<RootNode> CreateTree(uint32_t count) {
+  auto root_node = std::make_shared<RootNode>(kRootId);
+  std::vector<std::shared_ptr<DomInfo>> infos;
+  infos.reserve(count);
+  for (uint32_t k = 0; k < count; ++k) {
+    uint32_t id = k + kRootId + 1;
+    uint32_t pid = k < kFanout ? kRootId : k / kFanout - 1 + kRootId + 1;
+    auto style = std::make_shared<DomValueMap>();
+    (*style)[kHeight] = std::make_shared<HippyValue>(10);
+    auto node = std::make_shared<DomNode>(id, pid, 0, "View", "View", style, std::make_shared<DomValueMap>(),
+                                          root_node);
+    infos.push_back(std::make_shared<DomInfo>(node, nullptr, nullptr));
+  }
+  root_node->CreateDomNodes(std::move(infos), false);
+  root_node->SetRootSize(1080, 1920);
+  std::vector<std::shared_ptr<DomNode>> changed_nodes;
+  root_node->DoLayout(changed_nodes);
+  return root_node;
+}
+
+void UpdateLeafHeight(const std::shared_ptr<RootNode>& root_node, uint32_t count, int height) {
+  auto leaf = root_node->GetNode(count + kRootId);
+  DomValueMap style_update;
+  style_update[kHeight] = std::make_shared<HippyValue>(height);
+  leaf->UpdateLayoutStyleInfo(style_update, {});
+}
+
+std::shared_ptr<DomInfo> CreateUpdateInfo(const std::shared_ptr<RootNode>& root_node, uint32_t id,
+                                          const std::shared_ptr<DomValueMap>& style) {
+  auto node = std::make_shared<DomNode>(id, kRootId, 0, "Text", "Text", style, std::make_shared<DomValueMap>(),
+                                        root_node);
+  return std::make_shared<DomInfo>(node, nullptr, nullptr);
+}
+
+std::shared_ptr<DomInfo> CreateChildInfo(const std::shared_ptr<RootNode>& root_node, uint32_t id, uint32_t pid,
+                                         const std::shared_ptr<RefInfo>& ref_info) {
+  auto node = std::make_shared<DomNode>(id, pid, 0, "View", "View", std::make_shared<DomValueMap>(),
+                                        std::make_shared<DomValueMap>(), root_node);
+  return std::make_shared<DomInfo>(node, ref_info, nullptr);
+}
+
+}  // namespace
+
+void RunLayoutTransferBenchmark() {
+  for (uint32_t count : {1000u, 10000u, 50000u}) {
+    auto full_tree = CreateTree(count);
+    auto incremental_tree = CreateTree(count);
+    incremental_tree->SetEnableIncrementalLayoutTransfer(true);
+    Clock::duration full_cost{0};
+    Clock::duration incremental_cost{0};
+    for (int i = 0; i < kLayoutTimes; ++i) {
+      int height = i % 2 == 0 ? 20 : 10;
+      UpdateLeafHeight(full_tree, count, height);
+      UpdateLeafHeight(incremental_tree, count, height);
+
+      std::vector<std::shared_ptr<DomNode>> full_changed;
+      auto start = Clock::now();
+      full_tree->DoLayout(full_changed, false);
+      full_cost += Clock::now() - start;
+
+      std::vector<std::shared_ptr<DomNode>> incremental_changed;
+      start = Clock::now();
+      incremental_tree->DoLayout(incremental_changed, true);
+      incremental_cost += Clock::now() - start;
+      FOOTSTONE_DCHECK(full_changed.size() == incremental_changed.size());
+    }
+    std::printf("[LayoutTransfer] nodes = %u, full = %lldns, incremental = %lldns\n", count,
+                static_cast<long long>(ToNanoseconds(full_cost) / kLayoutTimes),
+                static_cast<long long>(ToNanoseconds(incremental_cost) / kLayoutTimes));
+  }
+}
+
+void RunUpdateDomNodesBenchmark() {
+  constexpr uint32_t kUpdateCount = 1000;
+  constexpr int kBatchTimes = 20;
+  Clock::duration cost{0};
+  for (int i = 0; i < kBatchTimes; ++i) {
+    // 每个批次使用新的 RootNode，保证每个节点都是批次内首次更新
+    auto root_node = std::make_shared<RootNode>(kRootId);
+    std::vector<std::shared_ptr<DomInfo>> create_infos;
+    std::vector<std::shared_ptr<DomInfo>> update_infos;
+    for (uint32_t k = 0; k < kUpdateCount; ++k) {
+      auto style = std::make_shared<DomValueMap>();
+      (*style)[kWidth] = std::make_shared<HippyValue>(100);
+      (*style)[kHeight] = std::make_shared<HippyValue>(10);
+      (*style)["color"] = std::make_shared<HippyValue>(0xff000000);
+      (*style)["backgroundColor"] = std::make_shared<HippyValue>(0xffffffff);
+      (*style)["text"] = std::make_shared<HippyValue>("hippy text content");
+      HippyValueArrayType transform;
+      for (int t = 0; t < 4; ++t) {
+        HippyValueObjectType object;
+        object["translateX"] = HippyValue(t);
+        transform.push_back(HippyValue(object));
+      }
+      (*style)["transform"] = std::make_shared<HippyValue>(transform);
+      create_infos.push_back(CreateUpdateInfo(root_node, k + kRootId + 1, style));
+      auto update = std::make_shared<DomValueMap>(*style);
+      (*update)["text"] = std::make_shared<HippyValue>("updated hippy text content");
+      update_infos.push_back(CreateUpdateInfo(root_node, k + kRootId + 1, update));
+    }
+    root_node->CreateDomNodes(std::move(create_infos), false);
+
+    auto start = Clock::now();
+    root_node->UpdateDomNodes(std::move(update_infos));
+    cost += Clock::now() - start;
+  }
+  std::printf("[UpdateDomNodes] updates per batch = %u, cost = %lldns\n", kUpdateCount,
+              static_cast<long long>(ToNanoseconds(cost) / kBatchTimes));
+}
+
+void RunLongListBenchmark() {
+  constexpr uint32_t kListId = kRootId + 1;
+  for (uint32_t count : {1000u, 10000u}) {
+    auto root_node = std::make_shared<RootNode>(kRootId);
+    root_node->CreateDomNodes({CreateChildInfo(root_node, kListId, kRootId, nullptr)}, false);
+    auto list = root_node->GetNode(kListId);
+
+    // 追加：每一项都插在上一项之后
+    std::vector<std::shared_ptr<DomInfo>> append_infos;
+    for (uint32_t k = 0; k < count; ++k) {
+      uint32_t id = kListId + 1 + k;
+      auto ref_info = k == 0 ? nullptr : std::make_shared<RefInfo>(id - 1, RelativeType::kBack);
+      append_infos.push_back(CreateChildInfo(root_node, id, kListId, ref_info));
+    }
+    auto start = Clock::now();
+    root_node->CreateDomNodes(std::move(append_infos), false);
+    auto append_cost = Clock::now() - start;
+
+    // 前插：每一项都插在当前第一项之前
+    std::vector<std::shared_ptr<DomInfo>> prepend_infos;
+    for (uint32_t k = 0; k < count; ++k) {
+      uint32_t id = kListId + 1 + count + k;
+      auto ref_id = k == 0 ? kListId + 1 : id - 1;
+      prepend_infos.push_back(
+          CreateChildInfo(root_node, id, kListId, std::make_shared<RefInfo>(ref_id, RelativeType::kFront)));
+    }
+    start = Clock::now();
+    root_node->CreateDomNodes(std::move(prepend_infos), false);
+    auto prepend_cost = Clock::now() - start;
+
+    std::vector<std::shared_ptr<DomInfo>> delete_infos;
+    for (uint32_t k = 0; k < 2 * count; k += 2) {
+      delete_infos.push_back(std::make_shared<DomInfo>(list->GetChildAt(k), nullptr, nullptr));
+    }
+    start = Clock::now();
+    root_node->DeleteDomNodes(std::move(delete_infos));
+    auto delete_cost = Clock::now() - start;
+    FOOTSTONE_DCHECK(list->GetChildCount() == count);
+
+    // 尾部固定节点：每一项都插在同一个 footer 之前
+    uint32_t footer_id = kListId + 1 + 2 * count;
+    auto last_ref = std::make_shared<RefInfo>(list->GetChildAt(count - 1)->GetId(), RelativeType::kBack);
+    root_node->CreateDomNodes({CreateChildInfo(root_node, footer_id, kListId, last_ref)}, false);
+    std::vector<std::shared_ptr<DomInfo>> footer_infos;
+    for (uint32_t k = 0; k < count; ++k) {
+      footer_infos.push_back(CreateChildInfo(root_node, footer_id + 1 + k, kListId,
+                                             std::make_shared<RefInfo>(footer_id, RelativeType::kFront)));
+    }
+    start = Clock::now();
+    root_node->CreateDomNodes(std::move(footer_infos), false);
+    auto footer_cost = Clock::now() - start;
+
+    std::printf("[LongList] items = %u, append = %lldus, prepend = %lldus, delete = %lldus, footer = %lldus\n",
+                count, static_cast<long long>(ToMicroseconds(append_cost)),
+                static_cast<long long>(ToMicroseconds(prepend_cost)),
+                static_cast<long long>(ToMicroseconds(delete_cost)),
+                static_cast<long long>(ToMicroseconds(footer_cost)));
+  }
+}
+
+void RunStatisticsBenchmark() {
+  constexpr uint32_t kNodeCount = 10000;
+  auto root_node = CreateTree(kNodeCount);
+
+  // 对比原先每次统计时的全树遍历
+  uint32_t traverse_count = 0;
+  auto start = Clock::now();
+  root_node->Traverse([&traverse_count](const std::shared_ptr<DomNode>&) { ++traverse_count; });
+  auto traverse_cost = Clock::now() - start;
+
+  RootNode::Statistics statistics;
+  start = Clock::now();
+  for (int i = 0; i < kLayoutTimes; ++i) {
+    statistics = root_node->GetStatistics();
+  }
+  auto statistics_cost = (Clock::now() - start) / kLayoutTimes;
+  FOOTSTONE_DCHECK(statistics.total_node_count == traverse_count);
+
+  std::printf("[Statistics] nodes = %u, traverse = %lldus, statistics = %lldns\n", kNodeCount,
+              static_cast<long long>(ToMicroseconds(traverse_cost)),
+              static_cast<long long>(ToNanoseconds(statistics_cost)));
+}
+
+void RunEventDispatchBenchmark() {
+  constexpr uint32_t kDepth = 20;
+  // 深度为 kDepth 的单链
+  auto root_node = std::make_shared<RootNode>(kRootId);
+  std::vector<std::shared_ptr<DomInfo>> infos;
+  for (uint32_t k = 0; k < kDepth; ++k) {
+    uint32_t id = kRootId + 1 + k;
+    infos.push_back(CreateChildInfo(root_node, id, id - 1, nullptr));
+  }
+  root_node->CreateDomNodes(std::move(infos), false);
+  auto leaf = root_node->GetNode(kRootId + kDepth);
+  int call_count = 0;
+  root_node->AddEventListener("touchstart", 1, false, [&call_count](const std::shared_ptr<DomEvent>&) {
+    ++call_count;
+  });
+
+  auto dispatch = [&leaf](const std::string& name) {
+    auto start = Clock::now();
+    for (int i = 0; i < kEventDispatchTimes; ++i) {
+      leaf->HandleEvent(std::make_shared<DomEvent>(name, leaf, true, true));
+    }
+    return (Clock::now() - start) / kEventDispatchTimes;
+  };
+  // 路径上没有任何监听的高频事件
+  auto unlistened_cost = dispatch("scroll");
+  // 捕获与冒泡经过整条路径，只有根节点监听
+  auto listened_cost = dispatch("touchstart");
+  FOOTSTONE_DCHECK(call_count == kEventDispatchTimes);
+  std::printf("[EventDispatch] depth = %u, unlistened = %lldns, listened = %lldns\n", kDepth,
+              static_cast<long long>(ToNanoseconds(unlistened_cost)),
+              static_cast<long long>(ToNanoseconds(listened_cost)));
+}
+
+void RunParallelLayoutBenchmark() {
+  constexpr uint32_t kPageCount = 8;
+  constexpr uint32_t kItemsPerPage = 50;
+  constexpr uint32_t kPagerId = kRootId + 1;
+  // 根节点下一个 pager，pager 下 kPageCount 个固定宽高的页面，每个页面包含 kItemsPerPage 个需要测量的文本
+  auto create_pager_tree = [] {
+    auto root_node = std::make_shared<RootNode>(kRootId);
+    root_node->SetRootSize(1080, 1920);
+    std::vector<std::shared_ptr<DomInfo>> infos = {CreateChildInfo(root_node, kPagerId, kRootId, nullptr)};
+    auto id = kPagerId;
+    std::vector<uint32_t> item_ids;
+    for (uint32_t p = 0; p < kPageCount; ++p) {
+      auto page_info = CreateChildInfo(root_node, ++id, kPagerId, nullptr);
+      page_info->dom_node->EmplaceStyleMap(kWidth, HippyValue(1080));
+      page_info->dom_node->EmplaceStyleMap(kHeight, HippyValue(1920));
+      infos.push_back(page_info);
+      auto page_id = id;
+      for (uint32_t k = 0; k < kItemsPerPage; ++k) {
+        infos.push_back(CreateChildInfo(root_node, ++id, page_id, nullptr));
+        item_ids.push_back(id);
+      }
+    }
+    root_node->CreateDomNodes(std::move(infos), false);
+    for (auto item_id : item_ids) {
+      root_node->GetNode(item_id)->GetLayoutNode()->SetMeasureFunction(
+          [item_id](float width, LayoutMeasureMode, float, LayoutMeasureMode, void*) {
+            std::this_thread::sleep_for(kMeasureCost);
+            return LayoutSize{width, static_cast<float>(10 + item_id % 7)};
+          });
+    }
+    return root_node;
+  };
+
+  auto render_manager = std::make_shared<CountingRenderManager>();
+  auto serial_root = create_pager_tree();
+  auto start = Clock::now();
+  serial_root->DoAndFlushLayout(render_manager);
+  auto serial_cost = Clock::now() - start;
+
+  for (uint32_t concurrency : {1u, 3u, 7u}) {
+    auto worker_manager = std::make_shared<footstone::WorkerManager>(concurrency);
+    auto parallel_root = create_pager_tree();
+    parallel_root->SetParallelLayoutWorkerManager(worker_manager, concurrency);
+    start = Clock::now();
+    parallel_root->DoAndFlushLayout(render_manager);
+    auto parallel_cost = Clock::now() - start;
+    parallel_root = nullptr;
+    worker_manager->Terminate();
+    std::printf("[ParallelLayout] pages = %u, items per page = %u, threads = %u, "
+                "serial = %lldus, parallel = %lldus\n", kPageCount, kItemsPerPage, concurrency + 1,
+                static_cast<long long>(ToMicroseconds(serial_cost)),
+                static_cast<long long>(ToMicroseconds(parallel_cost)));
+  }
+}
+
+void RunMeasureCacheBenchmark() {
+  constexpr uint32_t kTextCellCount = 200;
+  constexpr uint32_t kDistinctTextCount = 10;
+  constexpr uint32_t kListId = kRootId + 1;
+  constexpr uint32_t kUpdatedId = kRootId + 2;
+  auto render_manager = std::make_shared<CountingRenderManager>();
+  int measure_counts[2][2];
+  Clock::duration costs[2][2];
+  for (bool use_measure_cache : {false, true}) {
+    // 根节点下一个列表，列表中 kTextCellCount 个文本 cell，只有 kDistinctTextCount 种不同的文本
+    std::atomic<int> measure_count{0};
+    auto root_node = std::make_shared<RootNode>(kRootId);
+    root_node->SetRootSize(1080, 1920);
+    std::vector<std::shared_ptr<DomInfo>> infos = {CreateChildInfo(root_node, kListId, kRootId, nullptr)};
+    for (uint32_t k = 0; k < kTextCellCount; ++k) {
+      auto style = std::make_shared<DomValueMap>();
+      (*style)[kText] = std::make_shared<HippyValue>("cell " + std::to_string(k % kDistinctTextCount));
+      (*style)[kFontSize] = std::make_shared<HippyValue>(16);
+      auto node = std::make_shared<DomNode>(kListId + 1 + k, kListId, 0, "Text", "Text", style,
+                                            std::make_shared<DomValueMap>(), root_node);
+      infos.push_back(std::make_shared<DomInfo>(node, nullptr, nullptr));
+    }
+    root_node->CreateDomNodes(std::move(infos), false);
+    for (uint32_t k = 0; k < kTextCellCount; ++k) {
+      auto node = root_node->GetNode(kListId + 1 + k);
+      std::weak_ptr<DomNode> weak_node = node;
+      MeasureFunction measure = [weak_node, &measure_count](float width, LayoutMeasureMode, float,
+                                                            LayoutMeasureMode, void*) {
+        // 模拟 JNI 回调平台测量文本的开销
+        std::this_thread::sleep_for(kMeasureCost);
+        ++measure_count;
+        auto text = weak_node.lock()->GetStyleMap()->at(kText)->ToStringChecked();
+        return LayoutSize{width, static_cast<float>(text.size())};
+      };
+      if (use_measure_cache) {
+        measure = root_node->GetMeasureCache()->Wrap(node, std::move(measure));
+      }
+      node->GetLayoutNode()->SetMeasureFunction(measure);
+    }
+
+    auto start = Clock::now();
+    root_node->DoAndFlushLayout(render_manager);
+    costs[use_measure_cache][0] = Clock::now() - start;
+    measure_counts[use_measure_cache][0] = measure_count.exchange(0);
+
+    // 更新一个 cell 的文本后重新布局
+    auto style = std::make_shared<DomValueMap>();
+    (*style)[kText] = std::make_shared<HippyValue>("updated cell");
+    (*style)[kFontSize] = std::make_shared<HippyValue>(16);
+    root_node->UpdateDomNodes({CreateUpdateInfo(root_node, kUpdatedId, style)});
+    root_node->GetNode(kUpdatedId)->GetLayoutNode()->MarkDirty();
+    start = Clock::now();
+    root_node->DoAndFlushLayout(render_manager);
+    costs[use_measure_cache][1] = Clock::now() - start;
+    measure_counts[use_measure_cache][1] = measure_count.exchange(0);
+  }
+  std::printf("[MeasureCache] cells = %u, distinct texts = %u, first layout: measures = %d -> %d, "
+              "cost = %lldus -> %lldus, relayout: measures = %d -> %d, cost = %lldus -> %lldus\n",
+              kTextCellCount, kDistinctTextCount, measure_counts[0][0], measure_counts[1][0],
+              static_cast<long long>(ToMicroseconds(costs[0][0])), static_cast<long long>(ToMicroseconds(costs[1][0])),
+              measure_counts[0][1], measure_counts[1][1], static_cast<long long>(ToMicroseconds(costs[0][1])),
+              static_cast<long long>(ToMicroseconds(costs[1][1])));
+}
+
+}  // namespace benchmark
+}  // namespace dom
+}  // namespace hippy
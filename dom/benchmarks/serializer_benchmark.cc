@@ -0,0 +1,210 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+
+#include "benchmark.h"
+#include "footstone/deserializer.h"
+#include "footstone/hippy_value.h"
+#include "footstone/logging.h"
+#include "footstone/serializer.h"
+#include "footstone/string_view_utils.h"
+
+namespace hippy {
+namespace dom {
+namespace benchmark {
+
+namespace {
+
+using HippyValue = footstone::value::HippyValue;
+using HippyValueView = footstone::value::HippyValueView;
+using StringViewUtils = footstone::stringview::StringViewUtils;
+using string_view = footstone::stringview::string_view;
+
+// 典型的模块调用参数：网络请求配置与一组列表数据
+HippyValue CreateModuleCallPayload() {
+  HippyValue::HippyValueObjectType headers;
+  headers["Content-Type"] = HippyValue("application/json");
+  headers["Accept-Language"] = HippyValue("zh-CN");
+  headers["X-Request-Id"] = HippyValue("6f1c2a9e-53b4-4c1d-9a7e-2b8f0d4e6a13");
+  HippyValue::HippyValueArrayType items;
+  for (int32_t i = 0; i < 20; ++i) {
+    HippyValue::HippyValueObjectType item;
+    item["id"] = HippyValue(i);
+    item["title"] = HippyValue("动态化框架 " + std::to_string(i));
+    item["score"] = HippyValue(i + 0.5);
+    item["visible"] = HippyValue(i % 2 == 0);
+    items.push_back(HippyValue(std::move(item)));
+  }
+  HippyValue::HippyValueObjectType payload;
+  payload["method"] = HippyValue("GET");
+  payload["url"] = HippyValue("https://hippyjs.org/api/feed?page=2&size=20");
+  payload["headers"] = HippyValue(std::move(headers));
+  payload["timeout"] = HippyValue(15000);
+  payload["items"] = HippyValue(std::move(items));
+  payload["extra"] = HippyValue::Null();
+  return HippyValue(std::move(payload));
+}
+
+// 按 js 引擎遍历对象的方式逐个写入
+void StreamValue(footstone::value::Serializer& serializer, const HippyValue& value) {
+  switch (value.GetType()) {
+    case HippyValue::Type::kUndefined:
+      serializer.WriteUndefined();
+      break;
+    case HippyValue::Type::kNull:
+      serializer.WriteNull();
+      break;
+    case HippyValue::Type::kBoolean:
+      serializer.WriteBoolean(value.ToBooleanChecked());
+      break;
+    case HippyValue::Type::kNumber: {
+      double d = 0;
+      value.ToDouble(d);
+      serializer.WriteNumber(d);
+      break;
+    }
+    case HippyValue::Type::kString: {
+      const auto& str = value.ToStringChecked();
+      serializer.WriteString(string_view::new_from_utf8(str.c_str(), str.length()));
+      break;
+    }
+    case HippyValue::Type::kArray: {
+      const auto& array = value.ToArrayChecked();
+      auto length = static_cast<uint32_t>(array.size());
+      serializer.WriteBeginDenseJSArray(length);
+      for (const auto& element : array) {
+        StreamValue(serializer, element);
+      }
+      serializer.WriteEndDenseJSArray(length);
+      break;
+    }
+    case HippyValue::Type::kObject: {
+      const auto& object = value.ToObjectChecked();
+      serializer.WriteBeginJSObject();
+      for (const auto& [key, element] : object) {
+        serializer.WriteString(string_view(key.c_str(), key.length()));
+        StreamValue(serializer, element);
+      }
+      serializer.WriteEndJSObject(static_cast<uint32_t>(object.size()));
+      break;
+    }
+  }
+}
+
+std::string ToJson(const HippyValue& value) {
+  switch (value.GetType()) {
+    case HippyValue::Type::kBoolean:
+      return value.ToBooleanChecked() ? "true" : "false";
+    case HippyValue::Type::kNumber: {
+      double d = 0;
+      value.ToDouble(d);
+      return std::to_string(d);
+    }
+    case HippyValue::Type::kString:
+      return "\"" + value.ToStringChecked() + "\"";
+    case HippyValue::Type::kArray: {
+      std::string json = "[";
+      for (const auto& element : value.ToArrayChecked()) {
+        json += (json.size() > 1 ? "," : "") + ToJson(element);
+      }
+      return json + "]";
+    }
+    case HippyValue::Type::kObject: {
+      std::string json = "{";
+      for (const auto& [key, element] : value.ToObjectChecked()) {
+        json += (json.size() > 1 ? ",\"" : "\"") + key + "\":" + ToJson(element);
+      }
+      return json + "}";
+    }
+    default:
+      return "null";
+  }
+}
+
+}  // namespace
+
+void RunSerializerBenchmark() {
+  constexpr int kRounds = 20000;
+  auto payload = CreateModuleCallPayload();
+  // js 引擎 JSON.stringify 返回的是 utf16 字符串
+  auto json = StringViewUtils::ConvertEncoding(string_view::new_from_utf8(ToJson(payload).c_str()),
+                                               string_view::Encoding::Utf16);
+
+  size_t json_size = 0;
+  auto begin = Clock::now();
+  for (int i = 0; i < kRounds; ++i) {
+    auto buffer_data = StringViewUtils::ToStdString(
+        StringViewUtils::ConvertEncoding(json, string_view::Encoding::Utf8).utf8_value());
+    json_size = buffer_data.size();
+  }
+  auto json_cost = Clock::now() - begin;
+
+  footstone::value::Serializer serializer;
+  begin = Clock::now();
+  for (int i = 0; i < kRounds; ++i) {
+    serializer.Reset();
+    serializer.WriteHeader();
+    StreamValue(serializer, payload);
+  }
+  auto binary_cost = Clock::now() - begin;
+  auto [buffer, size] = serializer.GetBuffer();
+
+  // 解码端逐个访问全部成员，对应由视图直接创建 js 值
+  std::function<size_t(const HippyValueView&)> walk = [&walk](const HippyValueView& view) -> size_t {
+    size_t count = 1;
+    HippyValueView key;
+    HippyValueView value;
+    for (size_t i = 0; i < view.GetLength(); ++i) {
+      if (view.GetType() == HippyValue::Type::kArray) {
+        view.GetElement(i, value);
+      } else {
+        view.GetPropertyAt(i, key, value);
+      }
+      count += walk(value);
+    }
+    return count;
+  };
+  size_t value_count = 0;
+  begin = Clock::now();
+  for (int i = 0; i < kRounds; ++i) {
+    footstone::value::Deserializer deserializer(buffer, size);
+    HippyValueView view;
+    if (!deserializer.ReadHeader() || !deserializer.ReadValueView(view)) {
+      FOOTSTONE_LOG(ERROR) << "decode module call payload failed";
+      return;
+    }
+    value_count = walk(view);
+  }
+  auto decode_cost = Clock::now() - begin;
+
+  std::printf("[Serializer] module call payload: json %zuB, binary %zuB, %zu values; per call: "
+              "json utf16->utf8 = %lldns, binary encode = %lldns, binary view decode = %lldns\n",
+              json_size, size, value_count, static_cast<long long>(ToNanoseconds(json_cost) / kRounds),
+              static_cast<long long>(ToNanoseconds(binary_cost) / kRounds),
+              static_cast<long long>(ToNanoseconds(decode_cost) / kRounds));
+}
+
+}  // namespace benchmark
+}  // namespace dom
+}  // namespace hippy
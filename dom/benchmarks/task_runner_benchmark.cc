@@ -0,0 +1,109 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+#include "footstone/logging.h"
+#include "footstone/task.h"
+#include "footstone/task_runner.h"
+#include "footstone/worker_manager.h"
+
+namespace hippy {
+namespace dom {
+namespace benchmark {
+
+using Task = footstone::Task;
+using WorkerManager = footstone::WorkerManager;
+
+void RunPostTaskBenchmark() {
+  constexpr int kPostsPerProducer = 20000;
+  for (int producer_count : {1, 2, 4, 8}) {
+    WorkerManager manager(1);
+    auto runner = manager.CreateTaskRunner("contention");
+    std::atomic<int> remaining{producer_count * kPostsPerProducer};
+    std::promise<void> done;
+    std::atomic<int64_t> post_cost{0};
+
+    auto start = Clock::now();
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producer_count; ++p) {
+      producers.emplace_back([&] {
+        auto post_start = Clock::now();
+        for (int i = 0; i < kPostsPerProducer; ++i) {
+          runner->PostTask(std::make_unique<Task>([&] {
+            if (remaining.fetch_sub(1) == 1) {
+              done.set_value();
+            }
+          }));
+        }
+        post_cost += ToNanoseconds(Clock::now() - post_start);
+      });
+    }
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    done.get_future().wait();
+    auto total = Clock::now() - start;
+    manager.Terminate();
+
+    std::printf("[PostTask] producers = %d, post = %lldns, total = %lldus\n", producer_count,
+                static_cast<long long>(post_cost / (producer_count * kPostsPerProducer)),
+                static_cast<long long>(ToMicroseconds(total)));
+  }
+}
+
+void RunPostClosureBenchmark() {
+  constexpr int kPostCount = 100000;
+  WorkerManager manager(1);
+  auto runner = manager.CreateTaskRunner("closure");
+  std::atomic<int64_t> sum{0};
+  std::promise<void> done;
+  auto payload = std::make_shared<int>(1);
+
+  auto start = Clock::now();
+  for (int i = 0; i < kPostCount; ++i) {
+    // 与 JS 到 DOM 的指令类似，捕获一个 shared_ptr 与若干标量
+    runner->PostTask([&sum, &done, payload, i] {
+      sum += *payload;
+      if (i == kPostCount - 1) {
+        done.set_value();
+      }
+    });
+  }
+  auto post_cost = Clock::now() - start;
+  done.get_future().wait();
+  auto total = Clock::now() - start;
+  manager.Terminate();
+  FOOTSTONE_DCHECK(sum == kPostCount);
+
+  std::printf("[PostClosure] posts = %d, post = %lldns, total = %lldns\n", kPostCount,
+              static_cast<long long>(ToNanoseconds(post_cost) / kPostCount),
+              static_cast<long long>(ToNanoseconds(total) / kPostCount));
+}
+
+}  // namespace benchmark
+}  // namespace dom
+}  // namespace hippy
@@ -0,0 +1,140 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+#include "footstone/task.h"
+#include "footstone/task_runner.h"
+#include "footstone/worker_manager.h"
+
+namespace hippy {
+namespace dom {
+namespace benchmark {
+
+namespace {
+
+using Task = footstone::Task;
+using TaskRunner = footstone::TaskRunner;
+using WorkerManager = footstone::WorkerManager;
+
+// 模拟 vfs 等阻塞型任务
+constexpr auto kTaskCost = std::chrono::microseconds(100);
+
+class Latch {
+ public:
+  explicit Latch(int count) : count_(count) {}
+
+  void CountDown() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--count_ == 0) {
+      cv_.notify_all();
+    }
+  }
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return count_ == 0; });
+  }
+
+ private:
+  int count_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+struct SkewedLoadResult {
+  Clock::duration total;
+  Clock::duration mean_latency;
+  Clock::duration p99_latency;
+};
+
+// runner 按 round-robin 绑定到 Worker，只向第 0 个 Worker 上的 runner 投递任务，制造倾斜负载
+SkewedLoadResult RunSkewedLoad(bool enable_stealing, bool steal_safe) {
+  constexpr uint32_t kWorkerCount = 4;
+  constexpr uint32_t kRunnerCount = 16;
+  constexpr int kTasksPerRunner = 100;
+
+  WorkerManager manager(kWorkerCount);
+  manager.SetWorkStealingEnabled(enable_stealing);
+  std::vector<std::shared_ptr<TaskRunner>> hot_runners;
+  std::vector<std::shared_ptr<TaskRunner>> runners;
+  for (uint32_t i = 0; i < kRunnerCount; ++i) {
+    auto runner = manager.CreateTaskRunner("runner");
+    runners.push_back(runner);
+    if (i % kWorkerCount == 0) {
+      runner->SetStealSafe(steal_safe);
+      hot_runners.push_back(runner);
+    }
+  }
+
+  auto task_count = static_cast<int>(hot_runners.size()) * kTasksPerRunner;
+  Latch latch(task_count);
+  std::vector<Clock::duration> latencies(static_cast<size_t>(task_count));
+  auto start = Clock::now();
+  for (int k = 0; k < kTasksPerRunner; ++k) {
+    for (size_t r = 0; r < hot_runners.size(); ++r) {
+      auto index = static_cast<size_t>(k) * hot_runners.size() + r;
+      auto post_time = Clock::now();
+      hot_runners[r]->PostTask(std::make_unique<Task>([&latch, &latencies, index, post_time] {
+        latencies[index] = Clock::now() - post_time;
+        std::this_thread::sleep_for(kTaskCost);
+        latch.CountDown();
+      }));
+    }
+  }
+  latch.Wait();
+  auto total = Clock::now() - start;
+  manager.Terminate();
+
+  std::sort(latencies.begin(), latencies.end());
+  Clock::duration sum{0};
+  for (const auto& latency : latencies) {
+    sum += latency;
+  }
+  return {total, sum / task_count, latencies[latencies.size() * 99 / 100]};
+}
+
+}  // namespace
+
+void RunWorkStealingBenchmark() {
+  struct Mode {
+    const char* name;
+    bool enable_stealing;
+    bool steal_safe;
+  };
+  for (const auto& mode : {Mode{"disabled", false, false}, Mode{"group", true, false}, Mode{"task", true, true}}) {
+    auto result = RunSkewedLoad(mode.enable_stealing, mode.steal_safe);
+    std::printf("[WorkStealing] mode = %s, total = %lldus, mean latency = %lldus, p99 latency = %lldus\n", mode.name,
+                static_cast<long long>(ToMicroseconds(result.total)),
+                static_cast<long long>(ToMicroseconds(result.mean_latency)),
+                static_cast<long long>(ToMicroseconds(result.p99_latency)));
+  }
+}
+
+}  // namespace benchmark
+}  // namespace dom
+}  // namespace hippy
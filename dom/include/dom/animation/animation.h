@@ -186,6 +186,12 @@ class Animation {
   }
 
   virtual double Calculate(uint64_t time);
+  /**
+   * 为 true 时可以转换为 CubicBezierAnimation，由 AnimationManager 与其他动画批量求值
+   */
+  virtual bool IsCubicBezier() const {
+    return false;
+  }
 
   void AddEventListener(const std::string& event, AnimationCb cb);
   void RemoveEventListener(const std::string& event);
@@ -195,6 +201,10 @@ class Animation {
   void Pause();
   void Resume();
   void Repeat(uint64_t now);
+  /**
+   * 执行时间超过 delay + duration 时结束动画，并按剩余次数重复
+   */
+  void EndIfFinished(uint64_t now);
 
  protected:
   uint32_t id_;
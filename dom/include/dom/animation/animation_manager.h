@@ -117,6 +117,9 @@ class AnimationManager
                                  std::unordered_map<uint32_t, std::string>& result);
   void FetchAnimationsFromArray(HippyValue& value,
                                 std::unordered_map<uint32_t, std::string>& result);
+  static uint32_t GetRelatedAnimationId(const std::shared_ptr<Animation>& animation);
+  // 节点本帧的 diff 是否只包含不影响布局的样式
+  static bool IsPaintOnlyDiff(const std::shared_ptr<DomNode>& node);
   void UpdateCubicBezierAnimation(double current,
                                   uint32_t related_animation_id,
                                   std::unordered_map<uint32_t, std::shared_ptr<DomNode>>& update_node_map);
@@ -142,6 +145,16 @@ class AnimationManager
    */
   std::unordered_map<uint32_t, std::unordered_map<uint32_t, std::string>> node_animation_props_map_;
   uint64_t listener_id_;
+
+  /**
+   * UpdateAnimations 每帧使用的缓冲区，在帧之间复用
+   * frame_batch_indexes_ 为本帧各动画在 cubic_bezier_batch_ 中的下标，不能批量求值的动画为 kNotBatched
+   */
+  static constexpr size_t kNotBatched = static_cast<size_t>(-1);
+  std::vector<std::shared_ptr<Animation>> frame_animations_;
+  std::vector<size_t> frame_batch_indexes_;
+  CubicBezierAnimationBatch cubic_bezier_batch_;
+  std::unordered_map<uint32_t, std::shared_ptr<DomNode>> update_node_map_;
 };
 }  // namespace dom
 }  // namespace hippy
@@ -62,6 +62,9 @@ class CubicBezier {
   double SampleCurveY(double t) const;
   double SampleCurveDerivativeX(double t) const;
   double SolveCurveX(double x, double epsilon) const;
+  inline const PolynomialCoefficients& GetCoefficients() const {
+    return p_;
+  }
 
  private:
   void CalculatePolynomialCoefficients(ControlPoint p1, ControlPoint p2);
@@ -22,6 +22,8 @@
 
 #include <string>
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 #include "dom/animation/animation.h"
 #include "dom/animation/animation_math.h"
@@ -37,6 +39,8 @@ constexpr char kAnimationTimingFunctionCubicBezier[] = "cubic-bezier";
 constexpr char kAnimationCubicBezierRegex[] = \
     "^cubic-bezier\\((\\d*.\\d+|\\d+),(\\d*.\\d+|\\d+),(\\d*.\\d+|\\d+),(\\d*.\\d+|\\d+)\\)$";
 
+class CubicBezierAnimationBatch;
+
 class CubicBezierAnimation : public Animation {
  public:
 
@@ -69,6 +73,10 @@ class CubicBezierAnimation : public Animation {
 
   virtual double Calculate(uint64_t time) override;
 
+  virtual bool IsCubicBezier() const override {
+    return true;
+  }
+
   void Update(Mode mode,
               uint64_t delay,
               double start_value,
@@ -89,6 +97,52 @@ class CubicBezierAnimation : public Animation {
   std::string func_;
   CubicBezier cubic_bezier_;
   uint32_t related_id_;
+
+  friend class CubicBezierAnimationBatch;
+};
+
+/**
+ * 同一帧内多个 CubicBezierAnimation 的批量求值，结果与逐个调用 Calculate 一致
+ * 1. 动画的进度、起止值与曲线系数按字段连续存放（SoA），各数组在帧之间复用
+ * 2. 求解曲线的牛顿迭代对所有动画同步进行，循环体没有分支，便于编译器向量化；
+ *    迭代中未收敛的少数动画再逐个调用 CubicBezier::SolveCurveX
+ */
+class CubicBezierAnimationBatch {
+ public:
+  void Clear();
+  inline size_t Size() const {
+    return animations_.size();
+  }
+  /**
+   * 加入一个运行中的动画，duration 为 0 的动画不加入并返回 false
+   */
+  bool Add(const std::shared_ptr<CubicBezierAnimation>& animation, uint64_t now);
+  void Evaluate();
+  /**
+   * 把第 index 个动画的求值结果写回动画，返回动画的当前值
+   */
+  double Apply(size_t index);
+
+ private:
+  static constexpr int kNewtonIterations = 8;
+
+  uint64_t now_ = 0;
+  std::vector<std::shared_ptr<CubicBezierAnimation>> animations_;
+  std::vector<uint64_t> exec_time_;
+  std::vector<double> progress_;
+  std::vector<double> epsilon_;
+  std::vector<double> start_value_;
+  std::vector<double> to_value_;
+  std::vector<double> ax_;
+  std::vector<double> bx_;
+  std::vector<double> cx_;
+  std::vector<double> ay_;
+  std::vector<double> by_;
+  std::vector<double> cy_;
+  std::vector<double> t_;
+  std::vector<double> value_;
+  std::vector<uint8_t> active_;
+  std::vector<uint8_t> solved_;
 };
 
 }
@@ -20,12 +20,12 @@
 
 #pragma once
 
+#include "dom/dom_value_map.h"
 #include "footstone/hippy_value.h"
 
 namespace hippy {
 inline namespace dom {
 using HippyValue = footstone::value::HippyValue;
-using DomValueMap = typename std::unordered_map<std::string, std::shared_ptr<HippyValue>>;
 using DomValueObject = typename std::unordered_map<std::string, HippyValue>;
 using DomValueArray = typename std::vector<HippyValue>;
 using DiffValue = typename std::tuple<std::shared_ptr<DomValueMap>, std::shared_ptr<std::vector<std::string>>>;
@@ -34,6 +34,9 @@ class DomActionInterceptor {
   virtual void OnDomNodeMove(const std::vector<std::shared_ptr<DomInfo>>& nodes) = 0;
 
   virtual void OnDomNodeDelete(const std::vector<std::shared_ptr<DomInfo>>& nodes) = 0;
+
+  // batch 内的操作已全部应用并完成布局
+  virtual void OnDomBatchEnd() {}
   virtual ~DomActionInterceptor() = default;
 };
 }  // namespace dom
@@ -87,7 +87,7 @@ class DomEvent {
   inline std::weak_ptr<DomNode> GetTarget() {
     return target_;
   }
-  inline std::string GetType() {
+  inline const std::string& GetType() {
     return type_;
   }
   inline EventPhase GetEventPhase() {
@@ -50,6 +50,7 @@ class RenderManager;
 class RootNode;
 class LayerOptimizedRenderManager;
 class DomEvent;
+class DomSnapshot;
 struct DomInfo;
 
 using EventCallback = std::function<void(const std::shared_ptr<DomEvent>&)>;
@@ -106,6 +107,11 @@ class DomManager : public std::enable_shared_from_this<DomManager> {
   static void UpdateAnimation(const std::weak_ptr<RootNode>& weak_root_node,
                        std::vector<std::shared_ptr<DomNode>>&& nodes);
   void EndBatch(const std::weak_ptr<RootNode>& root_node);
+  /**
+   * 只改变了绘制属性的动画节点直接下发，返回 false 时需改用 UpdateAnimation 与 EndBatch，见 RootNode::UpdateAnimationProps
+   */
+  bool UpdateAnimationProps(const std::weak_ptr<RootNode>& weak_root_node,
+                            const std::vector<std::shared_ptr<DomNode>>& nodes);
   // 返回0代表失败，正常id从1开始
   static void AddEventListener(const std::weak_ptr<RootNode>& weak_root_node,
                         uint32_t dom_id,
@@ -130,6 +136,12 @@ class DomManager : public std::enable_shared_from_this<DomManager> {
 
   static byte_string GetSnapShot(const std::shared_ptr<RootNode>& root_node);
   bool SetSnapShot(const std::shared_ptr<RootNode>& root_node, const byte_string& buffer);
+  /**
+   * 从 DomSnapshot 恢复节点，根节点尺寸与快照一致时直接使用快照中的布局结果，跳过首次布局计算
+   * delta_log 为 DomSnapshotRecorder 记录的增量日志，恢复快照后依次应用，有增量时重新计算布局
+   */
+  bool SetSnapShot(const std::shared_ptr<RootNode>& root_node, const std::shared_ptr<DomSnapshot>& snapshot,
+                   const std::string& delta_log = {});
 
   void RecordDomStartTimePoint();
   void RecordDomEndTimePoint();
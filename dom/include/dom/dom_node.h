@@ -32,6 +32,7 @@
 #include "dom/dom_event.h"
 #include "dom/dom_listener.h"
 #include "dom/dom_manager.h"
+#include "dom/dom_value_map.h"
 #include "dom/layout_node.h"
 #include "footstone/check.h"
 #include "footstone/hippy_value.h"
@@ -88,13 +89,15 @@ struct DomEventListenerInfo {
   DomEventListenerInfo(uint64_t id, EventCallback cb) : id(id), cb(std::move(cb)) {}
 };
 
+// 监听列表在增删监听时写时复制，派发事件时持有的列表快照不会被回调中的增删修改
+using DomEventListenerList = std::vector<std::shared_ptr<DomEventListenerInfo>>;
+
 class DomNode : public std::enable_shared_from_this<DomNode> {
  public:
   using HippyValue = footstone::value::HippyValue;
 
   DomNode(uint32_t id, uint32_t pid, int32_t index, std::string tag_name, std::string view_name,
-          std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>> style_map,
-          std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>> dom_ext_map,
+          std::shared_ptr<DomValueMap> style_map, std::shared_ptr<DomValueMap> dom_ext_map,
           std::weak_ptr<RootNode> weak_root_node);
 
   DomNode(uint32_t id, uint32_t pid, std::weak_ptr<RootNode> weak_root_node);
@@ -124,7 +127,12 @@ class DomNode : public std::enable_shared_from_this<DomNode> {
   inline void SetPid(uint32_t pid) { pid_ = pid; }
   inline uint32_t GetPid() const { return pid_; }
   inline const RenderInfo& GetRenderInfo() const { return render_info_; }
-  inline void SetRenderInfo(const RenderInfo& render_info) { render_info_ = render_info; }
+  inline void SetRenderInfo(const RenderInfo& render_info) {
+    if (render_info.pid != render_info_.pid) {
+      MarkLayoutTransferDirty();
+    }
+    render_info_ = render_info;
+  }
   inline bool IsLayoutOnly() const { return layout_only_; }
   inline void SetLayoutOnly(bool layout_only) { layout_only_ = layout_only; }
   inline bool IsVirtual() { return is_virtual_; }
@@ -152,47 +160,61 @@ class DomNode : public std::enable_shared_from_this<DomNode> {
   std::shared_ptr<DomNode> RemoveChildAt(int32_t index);
   std::shared_ptr<DomNode> RemoveChildById(uint32_t id);
   void DoLayout();
-  void DoLayout(std::vector<std::shared_ptr<DomNode>>& changed_nodes);
+  void DoLayout(std::vector<std::shared_ptr<DomNode>>& changed_nodes, bool only_dirty_subtree = false);
   void ParseLayoutStyleInfo();
-  void UpdateLayoutStyleInfo(
-      const std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>>& style_update,
-      const std::vector<std::string>& style_delete);
+  void UpdateLayoutStyleInfo(const DomValueMap& style_update, const std::vector<std::string>& style_delete);
 
   /**
    * this method should run in dom taskrunner
    * */
   LayoutResult GetLayoutInfoFromRoot();
   void TransferLayoutOutputsRecursive(std::vector<std::shared_ptr<DomNode>>& changed_nodes);
+  /**
+   * only visit nodes which were laid out in the last pass, whose render parent changed or whose ancestors moved,
+   * the other subtrees keep their previous layout results
+   * */
+  void TransferDirtyLayoutOutputsRecursive(std::vector<std::shared_ptr<DomNode>>& changed_nodes,
+                                           bool ancestor_moved = false);
   std::tuple<float, float> GetLayoutSize();
   void SetLayoutSize(float width, float height);
   void SetLayoutOrigin(float x, float y);
   const LayoutResult& GetLayoutResult() const { return layout_; }
   const LayoutResult& GetRenderLayoutResult() const { return render_layout_; }
 
-  std::vector<std::shared_ptr<DomEventListenerInfo>> GetEventListener(const std::string& name, bool is_capture);
-  const std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>>& GetStyleMap() const {
+  /**
+   * return a snapshot of the listeners which shares storage with the node instead of copying it,
+   * nullptr if there is no listener of the phase
+   * */
+  std::shared_ptr<const DomEventListenerList> GetEventListener(const std::string& name, bool is_capture) const;
+  /**
+   * style 与 ext map 可能与 DomNodeStyleDiffer 的 batch 快照共享，只读返回；
+   * 修改需经 EmplaceStyleMap、UpdateProperties 或 SetStyleMap/SetExtStyleMap，由节点写时复制
+   * */
+  const std::shared_ptr<const DomValueMap> GetStyleMap() const {
     return style_map_;
   }
-  std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>>& GetStyleMap() { return style_map_; }
-  void SetStyleMap(std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>> style) {
+  void SetStyleMap(std::shared_ptr<DomValueMap> style) {
     style_map_ = style;
   }
   void CallFunction(const std::string& name, const DomArgument& param, const CallFunctionCallback& cb);
-  const std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>> GetExtStyle() {
+  const std::shared_ptr<const DomValueMap> GetExtStyle() const {
     return dom_ext_map_;
   }
-  void SetExtStyleMap(std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>> style) {
+  void SetExtStyleMap(std::shared_ptr<DomValueMap> style) {
     dom_ext_map_ = style;
   }
-  const std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>> GetDiffStyle() { return diff_; }
-  void SetDiffStyle(std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>> diff) {
+  const std::shared_ptr<DomValueMap> GetDiffStyle() { return diff_; }
+  void SetDiffStyle(std::shared_ptr<DomValueMap> diff) {
     diff_ = std::move(diff);
   }
+  // 清空 diff 并返回：diff 只被本节点持有时复用原有的 map，渲染侧仍持有时新建，不修改其正在读取的 diff
+  std::shared_ptr<DomValueMap> ResetDiffStyle();
   const std::shared_ptr<std::vector<std::string>> GetDeleteProps() { return delete_props_; }
   void SetDeleteProps(std::shared_ptr<std::vector<std::string>> delete_props) { delete_props_ = delete_props; }
 
   CallFunctionCallback GetCallback(const std::string& name, uint32_t id);
   bool HasEventListeners();
+  bool HasEventListener(const std::string& name) const;
 
   /**
    * @brief 递归替换或插入属性到 style_map
@@ -202,14 +224,11 @@ class DomNode : public std::enable_shared_from_this<DomNode> {
    */
   void EmplaceStyleMap(const std::string& key, const HippyValue& value);
 
-  void EmplaceStyleMapAndGetDiff(const std::string& key, const HippyValue& value,
-                                 std::unordered_map<std::string, std::shared_ptr<HippyValue>>& diff);
+  void EmplaceStyleMapAndGetDiff(const std::string& key, const HippyValue& value, DomValueMap& diff);
 
-  void UpdateProperties(const std::unordered_map<std::string, std::shared_ptr<HippyValue>>& update_style,
-                        const std::unordered_map<std::string, std::shared_ptr<HippyValue>>& update_dom_ext);
+  void UpdateProperties(const DomValueMap& update_style, const DomValueMap& update_dom_ext);
 
-  void UpdateDomNodeStyleAndParseLayoutInfo(
-      const std::unordered_map<std::string, std::shared_ptr<HippyValue>>& update_style);
+  void UpdateDomNodeStyleAndParseLayoutInfo(const DomValueMap& update_style);
 
   HippyValue Serialize() const;
   bool Deserialize(HippyValue value);
@@ -217,14 +236,21 @@ class DomNode : public std::enable_shared_from_this<DomNode> {
   virtual void HandleEvent(const std::shared_ptr<DomEvent>& event);
 
  private:
-  void UpdateDiff(const std::unordered_map<std::string, std::shared_ptr<HippyValue>>& update_style,
-                  const std::unordered_map<std::string, std::shared_ptr<HippyValue>>& update_dom_ext);
-  void UpdateDomExt(const std::unordered_map<std::string, std::shared_ptr<HippyValue>>& update_dom_ext);
-  void UpdateStyle(const std::unordered_map<std::string, std::shared_ptr<HippyValue>>& update_style);
+  void UpdateDiff(const DomValueMap& update_style, const DomValueMap& update_dom_ext);
+  void UpdateDomExt(const DomValueMap& update_dom_ext);
+  void UpdateStyle(const DomValueMap& update_style);
   void UpdateObjectStyle(HippyValue& style_map, const HippyValue& update_style);
   bool ReplaceStyle(HippyValue& object, const std::string& key, const HippyValue& value);
+  bool TransferLayoutOutputs(std::vector<std::shared_ptr<DomNode>>& changed_nodes);
+  void UpdateRenderLayout();
+  void MarkLayoutTransferDirty();
+  int32_t IndexOfChild(const DomNode* child) const;
+  void InsertChildAt(size_t index, const std::shared_ptr<DomNode>& child);
+  void RelabelChildOrder(size_t index);
+  void UpdateSubtreeDepth(int32_t depth);
 
   friend std::ostream& operator<<(std::ostream& os, const DomNode& hippy_value);
+  friend class RootNode;
 
  private:
   uint32_t id_{};          // node id
@@ -232,9 +258,9 @@ class DomNode : public std::enable_shared_from_this<DomNode> {
   int32_t index_{};        // the index position in the child array of the parent node
   std::string tag_name_;   // component name as defined in the DSL
   std::string view_name_;  // render-defined component name
-  std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>> style_map_; // Result after style preprocessing
-  std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>> dom_ext_map_; //  user-defined data
-  std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>> diff_; // User-defined data differences during Update.The map will be cleared after UpdateRenderNode
+  std::shared_ptr<DomValueMap> style_map_; // Result after style preprocessing
+  std::shared_ptr<DomValueMap> dom_ext_map_; //  user-defined data
+  std::shared_ptr<DomValueMap> diff_; // User-defined data differences during Update.The map will be cleared after UpdateRenderNode
   std::shared_ptr<std::vector<std::string>> delete_props_;
 
   std::shared_ptr<LayoutNode> layout_node_;
@@ -251,15 +277,23 @@ class DomNode : public std::enable_shared_from_this<DomNode> {
   // and if they cannot be eliminated for the first time, they cannot be eliminated at all times.
   bool enable_eliminated_ = true;
 
+  // The render parent has changed, render_layout_ must be recalculated in the next layout transfer.
+  // It is also set on all ancestors so that the dirty subtree walk can reach this node.
+  bool layout_transfer_dirty_ = false;
+
   std::weak_ptr<DomNode> parent_;
   std::vector<std::shared_ptr<DomNode>> children_;
+  // 在父节点 children_ 中的排序键，children_ 按该键严格递增，用于二分查找子节点的索引
+  uint64_t child_order_ = 0;
+  // 本节点的深度，根节点（及未挂载的节点）为 1，插入父节点时更新，避免每次向上递归计算
+  int32_t depth_ = 1;
 
   RenderInfo render_info_;
   std::weak_ptr<RootNode> root_node_;
   uint32_t current_callback_id_{};
   // 大部分DomNode没有监听，使用shared_ptr可以有效节约内存
   std::shared_ptr<std::unordered_map<std::string, std::unordered_map<uint32_t, CallFunctionCallback>>> func_cb_map_;
-  std::shared_ptr<std::unordered_map<std::string, std::array<std::vector<std::shared_ptr<DomEventListenerInfo>>, 2>>>
+  std::shared_ptr<std::unordered_map<std::string, std::array<std::shared_ptr<DomEventListenerList>, 2>>>
       event_listener_map_;
 };
 
@@ -0,0 +1,157 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "dom/dom_listener.h"
+#include "footstone/hippy_value.h"
+
+namespace hippy {
+inline namespace dom {
+
+class RootNode;
+
+/**
+ * DOM 树的二进制快照，用于热启动时直接恢复缓存的首屏
+ * 与 DomManager::GetSnapShot 的 HippyValue 快照相比：
+ * 1. 定长的节点表与去重后的字符串、属性条目，可以 mmap 后原地读取，不需要整体反序列化
+ * 2. 相同的属性条目（key 与 value 都相同）只保存、只解码一次
+ * 3. 保存了布局结果，根节点尺寸不变时恢复后直接使用保存的布局，跳过首次布局计算
+ *
+ * 文件布局（本机字节序，各段 4 字节对齐）：
+ *   Header
+ *   NodeRecord[node_count]        节点表，先序遍历顺序，父节点在子节点之前，第一个为 RootNode
+ *   uint32_t[style_ref_count]     节点引用的属性条目下标，每个节点的 style 与 ext 各为其中连续的一段
+ *   StyleEntry[style_count]       去重后的属性条目
+ *   StringEntry[string_count]     去重后的字符串表
+ *   char[string_data_size]        字符串内容
+ *   uint8_t[value_data_size]      属性值编码，见 dom_snapshot.cc
+ */
+class DomSnapshot {
+ public:
+  using HippyValue = footstone::value::HippyValue;
+
+  static constexpr uint32_t kMagic = 0x4E534448;  // "HDSN"
+  static constexpr uint32_t kVersion = 1;
+  // 按本机字节序写入，读取时不一致说明快照来自字节序不同的设备
+  static constexpr uint32_t kByteOrderMark = 0x01020304;
+
+  struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t byte_order_mark;
+    uint32_t file_size;
+    float root_width;
+    float root_height;
+    uint32_t node_count;
+    uint32_t style_ref_count;
+    uint32_t style_count;
+    uint32_t string_count;
+    uint32_t string_data_size;
+    uint32_t value_data_size;
+  };
+
+  struct NodeRecord {
+    uint32_t id;
+    uint32_t pid;
+    int32_t index;
+    uint32_t tag_name;   // 字符串表下标
+    uint32_t view_name;  // 字符串表下标
+    uint32_t style_begin;
+    uint32_t style_count;
+    uint32_t ext_begin;
+    uint32_t ext_count;
+    LayoutResult layout;
+  };
+
+  struct StyleEntry {
+    uint32_t key;  // 字符串表下标
+    uint32_t value_offset;
+    uint32_t value_size;
+  };
+
+  struct StringEntry {
+    uint32_t offset;
+    uint32_t size;
+  };
+
+  /**
+   * 把整棵树编码为快照，需在 dom 线程调用
+   */
+  static std::string Serialize(const std::shared_ptr<RootNode>& root_node);
+
+  /**
+   * mmap 快照文件，文件不存在或格式不合法时返回 nullptr
+   */
+  static std::shared_ptr<DomSnapshot> Open(const std::string& path);
+  static std::shared_ptr<DomSnapshot> FromBuffer(std::string buffer);
+
+  ~DomSnapshot();
+  DomSnapshot(const DomSnapshot&) = delete;
+  DomSnapshot& operator=(const DomSnapshot&) = delete;
+
+  const Header& GetHeader() const { return *header_; }
+  uint32_t GetNodeCount() const { return header_->node_count; }
+  const NodeRecord& GetNode(uint32_t index) const { return nodes_[index]; }
+  uint32_t GetStyleRef(uint32_t index) const { return style_refs_[index]; }
+  uint32_t GetStyleCount() const { return header_->style_count; }
+  const StyleEntry& GetStyle(uint32_t index) const { return styles_[index]; }
+  std::string_view GetString(uint32_t index) const;
+  /**
+   * 解码一个属性条目的 value，编码不合法时返回 false
+   */
+  bool DecodeStyleValue(uint32_t index, HippyValue& value) const;
+
+ private:
+  DomSnapshot() = default;
+
+  bool Parse(const uint8_t* data, size_t size);
+
+  std::string buffer_;
+  void* mapped_ = nullptr;
+  size_t mapped_size_ = 0;
+
+  const Header* header_ = nullptr;
+  const NodeRecord* nodes_ = nullptr;
+  const uint32_t* style_refs_ = nullptr;
+  const StyleEntry* styles_ = nullptr;
+  const StringEntry* strings_ = nullptr;
+  const char* string_data_ = nullptr;
+  const uint8_t* value_data_ = nullptr;
+};
+
+// NodeRecord 原样内嵌 LayoutResult，修改 LayoutResult 的字段会改变文件布局，需要同时提升 kVersion
+static_assert(std::is_trivially_copyable_v<LayoutResult>, "LayoutResult is stored raw in DomSnapshot");
+static_assert(sizeof(LayoutResult) == 12 * sizeof(float) && alignof(LayoutResult) == alignof(float),
+              "LayoutResult layout changed, bump DomSnapshot::kVersion");
+static_assert(offsetof(DomSnapshot::NodeRecord, layout) == 9 * sizeof(uint32_t)
+                  && sizeof(DomSnapshot::NodeRecord) == 9 * sizeof(uint32_t) + sizeof(LayoutResult),
+              "NodeRecord layout changed, bump DomSnapshot::kVersion");
+
+}  // namespace dom
+}  // namespace hippy
@@ -0,0 +1,115 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dom/dom_action_interceptor.h"
+#include "footstone/serializer.h"
+
+namespace hippy {
+inline namespace dom {
+
+class DomManager;
+class RootNode;
+
+/**
+ * 增量维护 DomSnapshot，使热启动快照随页面更新保持最新
+ * 1. 作为 DomActionInterceptor 注册到 RootNode，每次创建、更新、移动、删除节点时向日志文件追加一条增量记录，
+ *    每个 batch 的开销只与变化的节点数有关
+ * 2. batch 结束时日志超过阈值（基础快照大小的一半，且不小于 kMinCompactLogSize）则把当前树写为新的基础快照并清空日志，
+ *    首个 batch 结束时总是写入基础快照
+ * 3. 每个 batch 的记录之后写入一条提交标记。恢复时先恢复基础快照，再按 batch 应用日志中的记录，
+ *    末尾没有提交标记的 batch（如写入时进程退出）会被整体忽略，遇到损坏的记录时停止应用
+ *
+ * 基础快照保存在 path，日志保存在 path + ".log"。恢复完成后再注册 recorder，避免恢复过程被再次记录
+ */
+class DomSnapshotRecorder : public DomActionInterceptor {
+ public:
+  static constexpr size_t kMinCompactLogSize = 64 * 1024;
+
+  struct Statistics {
+    uint32_t record_count = 0;  // 当前日志中的记录数
+    uint64_t log_size = 0;
+    uint64_t snapshot_size = 0;
+    uint32_t compact_count = 0;
+  };
+
+  DomSnapshotRecorder(std::weak_ptr<RootNode> root_node, std::string path);
+  ~DomSnapshotRecorder() override;
+
+  void OnDomNodeCreate(const std::vector<std::shared_ptr<DomInfo>>& nodes) override;
+  void OnDomNodeUpdate(const std::vector<std::shared_ptr<DomInfo>>& nodes) override;
+  void OnDomNodeMove(const std::vector<std::shared_ptr<DomInfo>>& nodes) override;
+  void OnDomNodeDelete(const std::vector<std::shared_ptr<DomInfo>>& nodes) override;
+  void OnDomBatchEnd() override;
+
+  /**
+   * 把当前树写为新的基础快照并清空日志
+   */
+  bool Compact();
+  Statistics GetStatistics() const { return statistics_; }
+  const std::string& GetSnapshotPath() const { return path_; }
+  const std::string& GetLogPath() const { return log_path_; }
+
+  /**
+   * 从 path 处的基础快照与日志恢复节点，需在 dom 线程调用
+   */
+  static bool Restore(const std::shared_ptr<DomManager>& dom_manager, const std::shared_ptr<RootNode>& root_node,
+                      const std::string& path);
+  /**
+   * 按 batch 应用日志中已提交的记录，返回应用的记录数。orig_root_id 为记录时的根节点 id，映射为 root_node 的 id
+   */
+  static uint32_t ApplyLog(const std::shared_ptr<RootNode>& root_node, const std::string& log,
+                           uint32_t orig_root_id);
+
+ private:
+  enum class Op : uint32_t { kCreate, kUpdate, kMove, kDelete, kCommit };
+
+  struct RecordHeader {
+    uint32_t magic;
+    Op op;
+    uint32_t size;
+  };
+
+  static constexpr uint32_t kRecordMagic = 0x44534448;  // "HDSD"
+
+  void Append(Op op, const std::vector<std::shared_ptr<DomInfo>>& nodes);
+  bool WriteRecord(Op op, const uint8_t* data, size_t size);
+  static std::shared_ptr<DomInfo> ParseRecord(Op op, const footstone::value::HippyValue& value,
+                                              const std::shared_ptr<RootNode>& root_node, uint32_t orig_root_id);
+
+  std::weak_ptr<RootNode> root_node_;
+  std::string path_;
+  std::string log_path_;
+  std::ofstream log_file_;
+  footstone::value::Serializer serializer_;
+  bool has_snapshot_ = false;
+  bool has_uncommitted_record_ = false;
+  Statistics statistics_;
+};
+
+}  // namespace dom
+}  // namespace hippy
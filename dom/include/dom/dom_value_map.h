@@ -0,0 +1,123 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "dom/style_atom.h"
+#include "footstone/hippy_value.h"
+
+namespace hippy {
+inline namespace dom {
+
+/**
+ * @brief DomNode 的 style、ext 与 diff 使用的属性表，按样式名原子索引的扁平表。
+ * 1. 条目按插入顺序连续存放，另有一份与之平行的原子数组；已知样式名查找时只比较原子，
+ *    StyleAtom::kUnknown 的条目（业务自定义属性等）才按字符串比较
+ * 2. 节点的属性通常只有十几项，线性查找比哈希表更快，每个节点也省去了哈希表的桶与节点内存
+ * 3. 接口与 std::unordered_map<std::string, std::shared_ptr<HippyValue>> 保持一致，
+ *    按字符串查找、插入与遍历的代码不需要修改；不要通过迭代器修改 key，否则原子会与 key 不一致
+ */
+class DomValueMap {
+ public:
+  using HippyValue = footstone::value::HippyValue;
+  using key_type = std::string;
+  using mapped_type = std::shared_ptr<HippyValue>;
+  using value_type = std::pair<std::string, std::shared_ptr<HippyValue>>;
+  using size_type = std::size_t;
+  using iterator = std::vector<value_type>::iterator;
+  using const_iterator = std::vector<value_type>::const_iterator;
+
+  DomValueMap() = default;
+  DomValueMap(std::initializer_list<value_type> entries);
+  template <typename InputIt>
+  DomValueMap(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
+  const_iterator cbegin() const { return entries_.cbegin(); }
+  const_iterator cend() const { return entries_.cend(); }
+
+  bool empty() const { return entries_.empty(); }
+  size_type size() const { return entries_.size(); }
+  void reserve(size_type count);
+  void clear();
+
+  iterator find(std::string_view key);
+  const_iterator find(std::string_view key) const;
+  iterator find(StyleAtom atom);
+  const_iterator find(StyleAtom atom) const;
+  /**
+   * @brief 已知 key 对应的原子时使用（如遍历另一张表），省去一次原子表查找
+   */
+  const_iterator find(StyleAtom atom, std::string_view key) const;
+  size_type count(std::string_view key) const { return find(key) == end() ? 0 : 1; }
+
+  /**
+   * @brief 与 std::unordered_map::at 不同，key 不存在时不抛异常而是 CHECK 失败
+   */
+  mapped_type& at(std::string_view key);
+  const mapped_type& at(std::string_view key) const;
+  mapped_type& operator[](const std::string& key);
+  mapped_type& operator[](std::string&& key);
+
+  std::pair<iterator, bool> insert(const value_type& entry);
+  std::pair<iterator, bool> insert(value_type&& entry);
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(value_type(first->first, first->second));
+    }
+  }
+  template <typename Key, typename Value>
+  std::pair<iterator, bool> emplace(Key&& key, Value&& value) {
+    return insert(value_type(std::forward<Key>(key), std::forward<Value>(value)));
+  }
+  std::pair<iterator, bool> insert_or_assign(const std::string& key, mapped_type value);
+
+  iterator erase(const_iterator pos);
+  size_type erase(std::string_view key);
+
+  /**
+   * @brief 条目对应的样式名原子，非 dom 层解析的样式为 StyleAtom::kUnknown
+   */
+  StyleAtom GetAtom(const_iterator pos) const { return atoms_[static_cast<size_type>(pos - entries_.begin())]; }
+
+ private:
+  size_type IndexOf(StyleAtom atom, std::string_view key) const;
+  iterator Append(StyleAtom atom, value_type&& entry);
+
+  std::vector<value_type> entries_;
+  std::vector<StyleAtom> atoms_;
+};
+
+}  // namespace dom
+}  // namespace hippy
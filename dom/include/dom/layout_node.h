@@ -22,6 +22,7 @@
 
 #include <functional>
 #include <unordered_map>
+#include "dom/dom_value_map.h"
 #include "footstone/hippy_value.h"
 
 namespace hippy {
@@ -122,7 +123,7 @@ class LayoutNode {
    * @param style_map 属性的map
    */
   virtual void SetLayoutStyles(
-      const std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>>& style_update,
+      const DomValueMap& style_update,
       const std::vector<std::string>& style_delete) = 0;
 };
 
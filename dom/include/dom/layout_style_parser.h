@@ -0,0 +1,85 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dom/dom_value_map.h"
+#include "dom/style_atom.h"
+#include "footstone/hippy_value.h"
+
+namespace hippy {
+inline namespace dom {
+
+/**
+ * @brief 布局样式即 StyleAtom 的布局段，枚举顺序即样式设置到布局引擎的顺序
+ */
+using LayoutStyle = StyleAtom;
+
+constexpr size_t kLayoutStyleCount = static_cast<size_t>(StyleAtom::kLayoutStyleEnd);
+
+/**
+ * @brief 布局样式解析器，TaitankLayoutNode 与 YogaLayoutNode 共用。
+ * 构造时只遍历一次 style_update 与 style_delete，style_update 直接使用 DomValueMap 中保存的原子，
+ * style_delete 通过 StyleAtomTable 把样式名映射为 LayoutStyle，
+ * 再由 Dispatch 按 LayoutStyle 顺序回调布局引擎，避免对每个属性逐一 find。
+ */
+class LayoutStyleParser {
+ public:
+  using HippyValue = footstone::value::HippyValue;
+
+  LayoutStyleParser(const DomValueMap& style_update, const std::vector<std::string>& style_delete);
+
+  /**
+   * @brief 按 LayoutStyle 顺序回调 handler(LayoutStyle style, const HippyValue* value)，
+   * 同时出现在更新与删除中的样式以更新为准，value 为 nullptr 表示样式被删除
+   */
+  template <typename Handler>
+  void Dispatch(Handler&& handler) const {
+    auto styles = updated_ | deleted_;
+    for (size_t i = 0; i < kLayoutStyleCount && styles.any(); ++i) {
+      if (!styles.test(i)) continue;
+      styles.reset(i);
+      handler(static_cast<LayoutStyle>(i), updated_.test(i) ? values_[i] : nullptr);
+    }
+  }
+
+  /**
+   * @brief 删除单边样式（如 marginLeft）时的默认值：本次更新中整体样式（如 margin）的数值，否则为 0
+   */
+  float GetDeletedEdgeDefault(LayoutStyle all_style) const;
+
+  static bool GetLayoutStyle(const std::string& key, LayoutStyle& style);
+
+ private:
+  std::array<const HippyValue*, kLayoutStyleCount> values_{};
+  std::bitset<kLayoutStyleCount> updated_;
+  std::bitset<kLayoutStyleCount> deleted_;
+};
+
+}  // namespace dom
+}  // namespace hippy
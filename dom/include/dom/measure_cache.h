@@ -0,0 +1,140 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dom/diff_utils.h"
+#include "dom/layout_node.h"
+
+namespace hippy {
+inline namespace dom {
+
+class DomNode;
+
+/**
+ * 文本等测量节点的测量结果缓存（LRU）
+ * 1. key 为节点测量相关属性（包含子孙节点，如文本中嵌套的 span）的拷贝与宽高约束，
+ *    内容与约束都相同的节点（如列表中重复的 cell、无关更新后的重新布局）直接复用测量结果，不再回调平台。
+ *    hash 只用于定位，命中时会逐项比较内容，hash 冲突不会复用错误的结果
+ * 2. 节点的内容在首次测量时拷贝并保存，节点属性或子节点变化时需调用 MarkTextDirty 使其失效
+ * 3. 并行布局时测量函数会在多个线程调用，内部加锁保护
+ */
+class MeasureCache : public std::enable_shared_from_this<MeasureCache> {
+ public:
+  static constexpr uint32_t kDefaultCapacity = 512;
+
+  struct Statistics {
+    uint64_t hit_count = 0;
+    uint64_t miss_count = 0;
+    uint32_t size = 0;
+  };
+
+  explicit MeasureCache(uint32_t capacity = kDefaultCapacity);
+
+  /**
+   * 包装节点的测量函数，先查缓存，未命中时调用 measure 并记录结果
+   */
+  MeasureFunction Wrap(const std::shared_ptr<DomNode>& node, MeasureFunction measure);
+
+  /**
+   * 节点测量相关的内容发生变化，清除该节点以及包含该节点的测量节点保存的内容。
+   * 只做常数次查表，不遍历祖先节点，可以在每次创建、更新节点时调用
+   */
+  void MarkTextDirty(const std::shared_ptr<DomNode>& node);
+  void RemoveNode(uint32_t id);
+  void Clear();
+  void SetCapacity(uint32_t capacity);
+  Statistics GetStatistics();
+
+ private:
+  // 单个节点的测量相关属性
+  struct NodeContent {
+    std::string view_name;
+    DomValueObject style;
+    DomValueObject ext;
+    size_t child_count;
+
+    bool operator==(const NodeContent& other) const {
+      return child_count == other.child_count && view_name == other.view_name && style == other.style &&
+          ext == other.ext;
+    }
+  };
+
+  // 测量节点及其子孙节点的内容，按先序排列
+  struct Content {
+    size_t hash;
+    std::vector<NodeContent> nodes;
+  };
+
+  struct Key {
+    std::shared_ptr<const Content> content;
+    float width;
+    LayoutMeasureMode width_measure_mode;
+    float height;
+    LayoutMeasureMode height_measure_mode;
+
+    bool operator==(const Key& other) const {
+      if (width != other.width || width_measure_mode != other.width_measure_mode || height != other.height ||
+          height_measure_mode != other.height_measure_mode) {
+        return false;
+      }
+      return content == other.content ||
+          (content->hash == other.content->hash && content->nodes == other.content->nodes);
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  using Entry = std::pair<Key, LayoutSize>;
+
+  LayoutSize Measure(const std::shared_ptr<DomNode>& node, const MeasureFunction& measure, float width,
+                     LayoutMeasureMode width_measure_mode, float height, LayoutMeasureMode height_measure_mode,
+                     void* layout_context);
+  std::shared_ptr<const Content> GetContent(const std::shared_ptr<DomNode>& node);
+  static std::shared_ptr<const Content> ComputeContent(const std::shared_ptr<DomNode>& node,
+                                                       std::vector<uint32_t>& descendant_ids);
+  void EraseContent(uint32_t id);
+  void Evict();
+
+  std::mutex mutex_;
+  uint32_t capacity_;
+  // 表头为最近使用的结果
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+  // 测量节点 id -> 内容
+  std::unordered_map<uint32_t, std::shared_ptr<const Content>> contents_;
+  // 子孙节点 id -> 内容中包含该节点的测量节点 id，文本嵌套 span 时一般只有一个
+  std::unordered_map<uint32_t, std::vector<uint32_t>> owners_;
+  uint64_t hit_count_ = 0;
+  uint64_t miss_count_ = 0;
+};
+
+}  // namespace dom
+}  // namespace hippy
@@ -47,6 +47,7 @@ constexpr const char* kPosition = "position";
 constexpr const char* kDisplay = "display";
 constexpr const char* kOverflow = "overflow";
 constexpr const char* kOpacity = "opacity";
+constexpr const char* kTransform = "transform";
 constexpr const char* kZIndex = "zIndex";
 constexpr const char* kAspectRatio = "aspectRatio";
 
@@ -34,6 +34,14 @@ inline namespace dom {
 
 class DomNode;
 
+/**
+ * 一个节点在一帧动画中更新的属性，只包含不影响布局的属性
+ */
+struct AnimationPropsUpdate {
+  uint32_t id;
+  std::shared_ptr<DomValueMap> props;
+};
+
 class RenderManager {
  public:
   RenderManager(const std::string& name): density_(1.0f), name_(name){}
@@ -56,6 +64,14 @@ class RenderManager {
                               int32_t to_pid,
                               int32_t index) = 0;
   virtual void EndBatch(std::weak_ptr<RootNode> root_node) = 0;
+  /**
+   * 只影响绘制的动画属性（opacity、transform 等）每帧直接下发，不经过 batch、布局与 EndBatch
+   * 返回 false 表示不支持，调用方改走 UpdateRenderNode 的完整流程
+   */
+  virtual bool UpdateAnimationProps(std::weak_ptr<RootNode> root_node,
+                                    const std::vector<AnimationPropsUpdate>& updates) {
+    return false;
+  }
 
   virtual void BeforeLayout(std::weak_ptr<RootNode> root_node) = 0;
   virtual void AfterLayout(std::weak_ptr<RootNode> root_node) = 0;
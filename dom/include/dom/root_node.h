@@ -24,8 +24,10 @@
 
 #include "dom/diff_utils.h"
 #include "dom/dom_node.h"
+#include "dom/measure_cache.h"
 #include "footstone/persistent_object_map.h"
 #include "footstone/task_runner.h"
+#include "footstone/worker_manager.h"
 
 namespace hippy {
 inline namespace dom {
@@ -49,8 +51,9 @@ class DomNodeStyleDiffer {
   }
 
  private:
-  std::unordered_map<uint32_t, std::unordered_map<std::string, std::shared_ptr<HippyValue>>> node_style_map_;
-  std::unordered_map<uint32_t, std::unordered_map<std::string, std::shared_ptr<HippyValue>>> node_ext_style_map_;
+  // batch 最早的 style 快照，与 DomNode 共享同一份 map，DomNode 修改时写时复制，因此无需深拷贝
+  std::unordered_map<uint32_t, std::shared_ptr<const DomValueMap>> node_style_map_;
+  std::unordered_map<uint32_t, std::shared_ptr<const DomValueMap>> node_ext_style_map_;
 };
 
 class RootNode : public DomNode {
@@ -59,8 +62,18 @@ class RootNode : public DomNode {
   using EventCallback = std::function<void(const std::shared_ptr<DomEvent>&)>;
   using EventCallBackRunner = std::function<void(const std::shared_ptr<DomEvent>&)>;
 
+  // DOM 树统计信息，均为增量维护，查询开销为 O(1)
+  struct Statistics {
+    uint32_t total_node_count = 0;    // 当前树上的节点数，包含 RootNode 本身
+    uint32_t created_node_count = 0;  // 当前 batch 内创建的节点数
+    uint32_t updated_node_count = 0;  // 当前 batch 内更新的节点数
+    uint32_t moved_node_count = 0;    // 当前 batch 内移动的节点数
+    uint32_t deleted_node_count = 0;  // 当前 batch 内删除的节点数（不含被连带删除的子孙节点）
+  };
+
   RootNode(uint32_t id);
   RootNode();
+  ~RootNode() override;
 
   inline std::weak_ptr<DomManager> GetDomManager() { return dom_manager_; }
   inline void SetDomManager(std::weak_ptr<DomManager> dom_manager) {
@@ -68,6 +81,8 @@ class RootNode : public DomNode {
     dom_manager_ = dom_manager;
   }
   inline std::shared_ptr<AnimationManager> GetAnimationManager() { return animation_manager_; }
+  // 测量节点的测量函数经 MeasureCache::Wrap 包装后，内容与约束相同的测量直接复用结果
+  inline std::shared_ptr<MeasureCache> GetMeasureCache() { return measure_cache_; }
 
   virtual void AddEventListener(const std::string& name, uint64_t listener_id, bool use_capture,
                                 const EventCallback& cb) override;
@@ -79,14 +94,25 @@ class RootNode : public DomNode {
   void MoveDomNodes(std::vector<std::shared_ptr<DomInfo>>&& nodes);
   void DeleteDomNodes(std::vector<std::shared_ptr<DomInfo>>&& nodes);
   void UpdateAnimation(std::vector<std::shared_ptr<DomNode>>&& nodes);
+  /**
+   * 把只改变了绘制属性的动画节点（diff 为本帧的属性）直接交给 RenderManager::UpdateAnimationProps，
+   * 不进入 batch、不布局。有尚未下发的 dom 操作、有节点监听 kDomUpdated 或渲染层不支持时返回 false，
+   * 调用方改走 UpdateAnimation
+   */
+  bool UpdateAnimationProps(const std::vector<std::shared_ptr<DomNode>>& nodes,
+                            const std::shared_ptr<RenderManager>& render_manager);
   void CallFunction(uint32_t id, const std::string& name, const DomArgument& param, const CallFunctionCallback& cb);
   void SyncWithRenderManager(const std::shared_ptr<RenderManager>& render_manager);
   void DoAndFlushLayout(const std::shared_ptr<RenderManager>& render_manager);
   void AddEvent(uint32_t id, const std::string& event_name);
   void RemoveEvent(uint32_t id, const std::string& event_name);
   void HandleEvent(const std::shared_ptr<DomEvent>& event) override;
+  // 树上是否有任意节点监听了该事件，没有时 HandleEvent 直接返回
+  bool HasEventListenerInTree(const std::string& name) const;
   void UpdateRenderNode(const std::shared_ptr<DomNode>& node);
+  // 返回树上的节点总数（包含 RootNode），与 DomNode::GetChildCount 的含义不同
   uint32_t GetChildCount();
+  Statistics GetStatistics() const;
 
   std::shared_ptr<DomNode> GetNode(uint32_t id);
   std::tuple<float, float> GetRootSize();
@@ -97,6 +123,29 @@ class RootNode : public DomNode {
   void SetDisableSetRootSize(bool disable) {
     disable_set_root_size_ = disable;
   }
+  // only transfer the layout outputs of dirty subtrees after layout instead of walking the whole tree
+  void SetEnableIncrementalLayoutTransfer(bool enable) {
+    // render parent changes are not marked while disabled, the first layout after enabling walks the whole tree
+    if (enable && !enable_incremental_layout_transfer_) {
+      need_full_layout_transfer_ = true;
+    }
+    enable_incremental_layout_transfer_ = enable;
+  }
+  bool IsIncrementalLayoutTransferEnabled() const { return enable_incremental_layout_transfer_; }
+  /**
+   * lay out the dirty layout boundaries (subtrees whose size is fixed by their own width and height) concurrently
+   * on concurrency task runners of worker_manager before laying out the whole tree, the dom thread lays out
+   * boundaries as well and waits for all of them. the layout engine and the measure functions of the nodes in
+   * boundaries must be thread safe. pass nullptr to disable it. only supported by the taitank layout engine, it
+   * stays disabled when built with yoga
+   * */
+  void SetParallelLayoutWorkerManager(const std::shared_ptr<footstone::WorkerManager>& worker_manager,
+                                      uint32_t concurrency);
+  /**
+   * use the layout results restored from a snapshot as the outputs of the next layout instead of calculating it,
+   * the layout engine lays out these nodes in a later batch
+   * */
+  void SetSnapshotLayout(std::vector<std::pair<std::shared_ptr<DomNode>, LayoutResult>>&& layouts);
 
   static footstone::utils::PersistentObjectMap<uint32_t, std::shared_ptr<RootNode>>& PersistentMap() {
     return persistent_map_;
@@ -119,21 +168,43 @@ class RootNode : public DomNode {
   std::vector<DomOperation> dom_operations_;
   std::vector<EventOperation> event_operations_;
 
+  void CoalesceDomOperations();
+  std::vector<std::shared_ptr<LayoutNode>> CollectDirtyLayoutBoundaries();
+  void LayoutBoundariesConcurrently();
+  void RestoreSnapshotLayout(std::vector<std::shared_ptr<DomNode>>& layout_changed_nodes);
   void FlushDomOperations(const std::shared_ptr<RenderManager>& render_manager);
   void FlushEventOperations(const std::shared_ptr<RenderManager>& render_manager);
   void OnDomNodeCreated(const std::shared_ptr<DomNode>& node);
   void OnDomNodeDeleted(const std::shared_ptr<DomNode>& node);
+  void OnEventListenerAdded(const DomNode& node, const std::string& name);
+  void OnEventListenerRemoved(const DomNode& node, const std::string& name);
+  void DispatchEvent(const std::shared_ptr<DomEvent>& event, const std::shared_ptr<DomNode>& target,
+                     const std::vector<std::shared_ptr<DomNode>>& ancestors);
   std::weak_ptr<RootNode> GetWeakSelf();
 
   std::unordered_map<uint32_t, std::weak_ptr<DomNode>> nodes_;
+  // 事件名 -> 已挂载且监听了该事件的节点数
+  std::unordered_map<std::string, uint32_t> event_listener_counts_;
+  // 复用的祖先路径缓冲区，派发期间被取走，嵌套派发时会使用新的缓冲区
+  std::vector<std::shared_ptr<DomNode>> event_path_;
   std::weak_ptr<DomManager> dom_manager_;
   std::vector<std::shared_ptr<DomActionInterceptor>> interceptors_;
   std::shared_ptr<AnimationManager> animation_manager_;
   std::unique_ptr<DomNodeStyleDiffer> style_differ_;
+  std::shared_ptr<MeasureCache> measure_cache_;
+  // total_node_count 由 nodes_ 得出，这里只记录当前 batch 的操作计数
+  Statistics batch_statistics_;
 
   bool disable_set_root_size_ { false };
+  bool enable_incremental_layout_transfer_ { false };
+  bool need_full_layout_transfer_ { false };
+  std::weak_ptr<footstone::WorkerManager> layout_worker_manager_;
+  std::vector<std::shared_ptr<TaskRunner>> layout_runners_;
+  std::vector<std::pair<std::shared_ptr<DomNode>, LayoutResult>> snapshot_layouts_;
 
   static footstone::utils::PersistentObjectMap<uint32_t, std::shared_ptr<RootNode>> persistent_map_;
+
+  friend class DomNode;
 };
 
 }  // namespace dom
@@ -0,0 +1,106 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace hippy {
+inline namespace dom {
+
+/**
+ * @brief 样式名原子，dom 层需要解析的样式名映射为整数，便于 switch 分发与位集合判断。
+ * 前段为布局样式，顺序即样式设置到布局引擎的顺序，整体样式需先于单边样式（如 margin 先于 marginLeft）
+ *
+ * 原子用于 dom 层解析样式时的分发（LayoutStyleParser、LayerOptimizedRenderManager、AnimationManager），
+ * 同时作为 DomValueMap 的索引：DomNode 的 style、ext 与 diff map 按原子查找，DiffUtils::DiffProps 也按原子比较
+ */
+enum class StyleAtom : uint8_t {
+  kWidth,
+  kMinWidth,
+  kMaxWidth,
+  kHeight,
+  kMinHeight,
+  kMaxHeight,
+  kFlex,
+  kFlexGrow,
+  kFlexShrink,
+  kFlexBasis,
+  kDirection,
+  kFlexDirection,
+  kFlexWrap,
+  kAlignSelf,
+  kAlignItems,
+  kJustifyContent,
+  kOverflow,
+  kDisplay,
+  kMargin,
+  kMarginVertical,
+  kMarginHorizontal,
+  kMarginLeft,
+  kMarginRight,
+  kMarginTop,
+  kMarginBottom,
+  kPadding,
+  kPaddingVertical,
+  kPaddingHorizontal,
+  kPaddingLeft,
+  kPaddingRight,
+  kPaddingTop,
+  kPaddingBottom,
+  kBorderWidth,
+  kBorderLeftWidth,
+  kBorderTopWidth,
+  kBorderRightWidth,
+  kBorderBottomWidth,
+  kLeft,
+  kRight,
+  kTop,
+  kBottom,
+  kPosition,
+  kAspectRatio,
+  kAlignContent,
+  kLayoutStyleEnd,
+  kOpacity = kLayoutStyleEnd,
+  kBackgroundColor,
+  kBorderRadius,
+  kBorderLeftColor,
+  kBorderTopColor,
+  kBorderRightColor,
+  kBorderBottomColor,
+  kUnknown
+};
+
+constexpr size_t kStyleAtomCount = static_cast<size_t>(StyleAtom::kUnknown);
+
+class StyleAtomTable {
+ public:
+  /**
+   * @brief 通过编译期有序表查找样式名对应的原子，非 dom 层解析的样式返回 StyleAtom::kUnknown
+   */
+  static StyleAtom GetAtom(std::string_view key);
+  static const char* GetKey(StyleAtom atom);
+
+  static constexpr bool IsLayoutStyle(StyleAtom atom) { return atom < StyleAtom::kLayoutStyleEnd; }
+};
+
+}  // namespace dom
+}  // namespace hippy
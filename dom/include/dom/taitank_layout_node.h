@@ -52,7 +52,7 @@ class TaitankLayoutNode : public LayoutNode, public std::enable_shared_from_this
    * @param style_map 属性的map
    */
   void SetLayoutStyles(
-      const std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>>& style_update,
+      const DomValueMap& style_update,
       const std::vector<std::string>& style_delete) override;
 
   /**
@@ -222,7 +222,7 @@ class TaitankLayoutNode : public LayoutNode, public std::enable_shared_from_this
   /**
    * @brief 解析属性
    */
-  void Parser(const std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>>& style_update,
+  void Parser(const DomValueMap& style_update,
               const std::vector<std::string>& style_delete);
 
   /**
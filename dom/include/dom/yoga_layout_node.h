@@ -40,7 +40,7 @@ class YogaLayoutNode : public LayoutNode, public std::enable_shared_from_this<Yo
                        void* layout_context = nullptr) override;
 
   void SetLayoutStyles(
-      const std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>>& style_update,
+      const DomValueMap& style_update,
       const std::vector<std::string>& style_delete) override;
 
   void SetWidth(float width) override;
@@ -106,24 +106,24 @@ class YogaLayoutNode : public LayoutNode, public std::enable_shared_from_this<Yo
   int64_t GetKey() { return key_; }
 
  private:
-  void Parser(const std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>>& style_update,
+  void Parser(const DomValueMap& style_update,
               const std::vector<std::string>& style_delete);
 
-  void SetYGWidth(std::shared_ptr<footstone::value::HippyValue> hippy_value);
+  void SetYGWidth(const footstone::value::HippyValue& hippy_value);
 
-  void SetYGHeight(std::shared_ptr<footstone::value::HippyValue> hippy_value);
+  void SetYGHeight(const footstone::value::HippyValue& hippy_value);
 
   void SetDirection(YGDirection direction);
 
-  void SetYGMaxWidth(std::shared_ptr<footstone::value::HippyValue> hippy_value);
+  void SetYGMaxWidth(const footstone::value::HippyValue& hippy_value);
 
-  void SetYGMaxHeight(std::shared_ptr<footstone::value::HippyValue> hippy_value);
+  void SetYGMaxHeight(const footstone::value::HippyValue& hippy_value);
 
-  void SetYGMinWidth(std::shared_ptr<footstone::value::HippyValue> hippy_value);
+  void SetYGMinWidth(const footstone::value::HippyValue& hippy_value);
 
-  void SetYGMinHeight(std::shared_ptr<footstone::value::HippyValue> hippy_value);
+  void SetYGMinHeight(const footstone::value::HippyValue& hippy_value);
 
-  void SetYGFlexBasis(std::shared_ptr<footstone::value::HippyValue> dom_value);
+  void SetYGFlexBasis(const footstone::value::HippyValue& hippy_value);
 
   void SetFlex(float flex);
 
@@ -135,13 +135,13 @@ class YogaLayoutNode : public LayoutNode, public std::enable_shared_from_this<Yo
 
   void SetPositionType(YGPositionType position_type);
 
-  void SetYGPosition(YGEdge edge, std::shared_ptr<footstone::value::HippyValue> hippy_value);
+  void SetYGPosition(YGEdge edge, const footstone::value::HippyValue& hippy_value);
 
-  void SetYGMargin(YGEdge edge, std::shared_ptr<footstone::value::HippyValue> hippy_value);
+  void SetYGMargin(YGEdge edge, const footstone::value::HippyValue& hippy_value);
 
-  void SetYGPadding(YGEdge edge, std::shared_ptr<footstone::value::HippyValue> hippy_value);
+  void SetYGPadding(YGEdge edge, const footstone::value::HippyValue& hippy_value);
 
-  void SetYGBorder(YGEdge edge, std::shared_ptr<footstone::value::HippyValue> hippy_value);
+  void SetYGBorder(YGEdge edge, const footstone::value::HippyValue& hippy_value);
 
   void SetFlexWrap(YGWrap wrap_mode);
 
@@ -286,6 +286,10 @@ void Animation::Run(uint64_t now, const AnimationOnRun& on_run) {
     }
   }
 
+  EndIfFinished(now);
+}
+
+void Animation::EndIfFinished(uint64_t now) {
   if (exec_time_ >= delay_ + duration_) {
     status_ = Animation::Status::kEnd;
     auto animation_manager = animation_manager_.lock();
@@ -20,6 +20,8 @@
 
 #include "dom/animation/animation_manager.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <unordered_map>
 #include <utility>
@@ -29,9 +31,17 @@
 #include "dom/node_props.h"
 #include "dom/render_manager.h"
 #include "dom/root_node.h"
+#include "dom/style_atom.h"
 
 constexpr char kVSyncKey[] = "frameupdate";
 
+// 只影响绘制、不影响布局的样式，与 LayerOptimizedRenderManager::IsJustLayoutProp 相反
+// fontSize 等文本样式会改变测量结果，不属于此类
+static constexpr std::array<hippy::dom::StyleAtom, 7> kPaintOnlyStyles = {
+    hippy::dom::StyleAtom::kOpacity, hippy::dom::StyleAtom::kBackgroundColor, hippy::dom::StyleAtom::kBorderRadius,
+    hippy::dom::StyleAtom::kBorderLeftColor, hippy::dom::StyleAtom::kBorderTopColor,
+    hippy::dom::StyleAtom::kBorderRightColor, hippy::dom::StyleAtom::kBorderBottomColor};
+
 namespace hippy {
 inline namespace dom {
 using Scene = hippy::dom::Scene;
@@ -76,7 +86,7 @@ void AnimationManager::ParseAnimation(const std::shared_ptr<DomNode>& node) {
   auto dom_ext_map_ = node->GetExtStyle();
   auto use_animation_it = dom_ext_map_->find(kUseAnimation);
   if (use_animation_it != dom_ext_map_->end()) {
-    auto style_map_ = node->GetStyleMap();
+    const auto& style_map_ = node->GetStyleMap();
     std::unordered_map<uint32_t, std::string> animation_prop_map;
     for (auto& style: *style_map_) {
       if (style.second->IsObject()) {
@@ -304,37 +314,36 @@ void AnimationManager::UpdateCubicBezierAnimation(double current,
   if (dom_nodes_it == animation_nodes_map_.end()) {
     return;
   }
+  HippyValue prop_value(current);
   for (auto dom_node_id: dom_nodes_it->second) {
     auto node_props_it = node_animation_props_map_.find(dom_node_id);
     if (node_props_it == node_animation_props_map_.end()) {
       continue;
     }
-    auto props = node_props_it->second;
+    const auto& props = node_props_it->second;
     auto prop_it = props.find(related_animation_id);
     if (prop_it == props.end()) {
       continue;
     }
 
+    // 同一节点在一帧内的多个动画写入同一份 diff
     std::shared_ptr<DomNode> dom_node;
-    std::unordered_map<std::string, std::shared_ptr<HippyValue>> diff_value;
+    std::shared_ptr<DomValueMap> diff_value;
     auto it = update_node_map.find(dom_node_id);
     if (it == update_node_map.end()) {
       dom_node = root_node->GetNode(dom_node_id);
       if (!dom_node) {
         continue;
       }
+      diff_value = dom_node->ResetDiffStyle();
+      update_node_map.emplace(dom_node_id, dom_node);
     } else {
-      dom_node = update_node_map[dom_node_id];
-      diff_value = *(dom_node->GetDiffStyle());
+      dom_node = it->second;
+      diff_value = dom_node->GetDiffStyle();
     }
-    HippyValue prop_value(current);
-    dom_node->EmplaceStyleMapAndGetDiff(prop_it->second, prop_value, diff_value);
+    dom_node->EmplaceStyleMapAndGetDiff(prop_it->second, prop_value, *diff_value);
     FOOTSTONE_DLOG(INFO) << "animation related_animation_id = " << related_animation_id
       << "node id = " << dom_node->GetId() << ", key = " << prop_it->second << ", value = " << prop_value;
-
-    dom_node->SetDiffStyle(std::make_shared<
-        std::unordered_map<std::string, std::shared_ptr<HippyValue>>>(std::move(diff_value)));
-    update_node_map[dom_node_id] = dom_node;
   }
 }
 
@@ -366,14 +375,17 @@ void AnimationManager::RemoveVSyncEventListener() {
   }
 }
 
-void AnimationManager::UpdateAnimation(const std::shared_ptr<Animation>& animation, uint64_t now,
-                                       std::unordered_map<uint32_t, std::shared_ptr<DomNode>>& update_node_map) {
-  auto animation_id = animation->GetId();
+uint32_t AnimationManager::GetRelatedAnimationId(const std::shared_ptr<Animation>& animation) {
   auto parent_id = animation->GetParentId();
-  auto related_animation_id = parent_id;
-  if (related_animation_id == hippy::kInvalidAnimationParentId) {
-    related_animation_id = animation_id;
+  if (parent_id == hippy::kInvalidAnimationParentId) {
+    return animation->GetId();
   }
+  return parent_id;
+}
+
+void AnimationManager::UpdateAnimation(const std::shared_ptr<Animation>& animation, uint64_t now,
+                                       std::unordered_map<uint32_t, std::shared_ptr<DomNode>>& update_node_map) {
+  auto related_animation_id = GetRelatedAnimationId(animation);
 
   // on_run is called synchronously
   animation->Run(now, [this, related_animation_id, &update_node_map](double current) {
@@ -392,19 +404,73 @@ void AnimationManager::UpdateAnimations() {
   }
 
   auto now = footstone::time::MonotonicallyIncreasingTime();
-  std::unordered_map<uint32_t, std::shared_ptr<DomNode>> update_node_map;
-  // xcode crash if we change for to loop
-  for (std::vector<std::shared_ptr<Animation>>::size_type i = 0; i < active_animations_.size(); ++i) {
-    UpdateAnimation(active_animations_[i], now, update_node_map);
+  // 动画结束时会从 active_animations_ 中移除，遍历本帧开始时的副本
+  frame_animations_.assign(active_animations_.begin(), active_animations_.end());
+  frame_batch_indexes_.assign(frame_animations_.size(), kNotBatched);
+  // 持续运行中的贝塞尔动画先统一求值，其余动画（动画组、本帧刚开始或恢复的动画）仍逐个 Run
+  cubic_bezier_batch_.Clear();
+  for (size_t i = 0; i < frame_animations_.size(); ++i) {
+    const auto& animation = frame_animations_[i];
+    if (animation->IsCubicBezier() && !animation->HasChildren()
+        && animation->GetStatus() == Animation::Status::kRunning) {
+      auto index = cubic_bezier_batch_.Size();
+      if (cubic_bezier_batch_.Add(std::static_pointer_cast<CubicBezierAnimation>(animation), now)) {
+        frame_batch_indexes_[i] = index;
+      }
+    }
   }
+  cubic_bezier_batch_.Evaluate();
+
+  for (size_t i = 0; i < frame_animations_.size(); ++i) {
+    const auto& animation = frame_animations_[i];
+    if (frame_batch_indexes_[i] == kNotBatched) {
+      UpdateAnimation(animation, now, update_node_map_);
+      continue;
+    }
+    auto current = cubic_bezier_batch_.Apply(frame_batch_indexes_[i]);
+    UpdateCubicBezierAnimation(current, GetRelatedAnimationId(animation), update_node_map_);
+    animation->EndIfFinished(now);
+  }
+  // 本帧只改变了绘制属性的节点直接下发，不进入 batch，也不触发布局
   std::vector<std::shared_ptr<DomNode>> update_nodes;
-  update_nodes.reserve(update_node_map.size());
-  for (const auto& [key, value]: update_node_map) {
-    update_nodes.push_back(value);
+  std::vector<std::shared_ptr<DomNode>> paint_only_nodes;
+  update_nodes.reserve(update_node_map_.size());
+  for (const auto& [key, value]: update_node_map_) {
+    if (IsPaintOnlyDiff(value)) {
+      paint_only_nodes.push_back(value);
+    } else {
+      update_nodes.push_back(value);
+    }
+  }
+  update_node_map_.clear();
+  frame_animations_.clear();
+  cubic_bezier_batch_.Clear();
+  auto published = !paint_only_nodes.empty() && dom_manager->UpdateAnimationProps(root_node_, paint_only_nodes);
+  if (!published) {
+    update_nodes.insert(update_nodes.end(), paint_only_nodes.begin(), paint_only_nodes.end());
+  } else if (update_nodes.empty()) {
+    return;
   }
   dom_manager->UpdateAnimation(root_node_, std::move(update_nodes));
   dom_manager->EndBatch(root_node_);
 }
 
+bool AnimationManager::IsPaintOnlyDiff(const std::shared_ptr<DomNode>& node) {
+  auto diff = node->GetDiffStyle();
+  if (!diff) {
+    return false;
+  }
+  for (auto it = diff->cbegin(); it != diff->cend(); ++it) {
+    if (it->first == kTransform || it->first == kColor) {
+      continue;
+    }
+    auto atom = diff->GetAtom(it);
+    if (std::find(kPaintOnlyStyles.begin(), kPaintOnlyStyles.end(), atom) == kPaintOnlyStyles.end()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace dom
 }  // namespace hippy
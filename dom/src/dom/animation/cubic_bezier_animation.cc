@@ -22,6 +22,7 @@
 
 #include "dom/animation/cubic_bezier_animation.h"
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
 #include <regex>
@@ -195,6 +196,97 @@ void CubicBezierAnimation::Update(Mode mode,
   Init();
 }
 
+void CubicBezierAnimationBatch::Clear() {
+  animations_.clear();
+  exec_time_.clear();
+  progress_.clear();
+  epsilon_.clear();
+  start_value_.clear();
+  to_value_.clear();
+  ax_.clear();
+  bx_.clear();
+  cx_.clear();
+  ay_.clear();
+  by_.clear();
+  cy_.clear();
+}
+
+bool CubicBezierAnimationBatch::Add(const std::shared_ptr<CubicBezierAnimation>& animation, uint64_t now) {
+  if (!animation->duration_) {
+    return false;
+  }
+  now_ = now;
+  // 与 CubicBezierAnimation::Calculate 相同的计算
+  auto exec_time = animation->exec_time_ + (now - animation->last_begin_time_);
+  auto progress = static_cast<double>(exec_time - animation->delay_) / static_cast<double>(animation->duration_);
+  const auto& coefficients = animation->cubic_bezier_.GetCoefficients();
+  animations_.push_back(animation);
+  exec_time_.push_back(exec_time);
+  progress_.push_back(progress);
+  epsilon_.push_back(animation->cubic_bezier_.SolveEpsilon(animation->duration_));
+  start_value_.push_back(animation->start_value_);
+  to_value_.push_back(animation->to_value_);
+  ax_.push_back(coefficients.ax);
+  bx_.push_back(coefficients.bx);
+  cx_.push_back(coefficients.cx);
+  ay_.push_back(coefficients.ay);
+  by_.push_back(coefficients.by);
+  cy_.push_back(coefficients.cy);
+  return true;
+}
+
+void CubicBezierAnimationBatch::Evaluate() {
+  auto size = animations_.size();
+  t_.assign(progress_.begin(), progress_.end());
+  value_.resize(size);
+  active_.resize(size);
+  solved_.assign(size, 0);
+  for (size_t i = 0; i < size; ++i) {
+    active_[i] = progress_[i] > 0 && progress_[i] < 1;
+  }
+
+  // 与 CubicBezier::SolveCurveX 相同的牛顿迭代：收敛或导数过小的动画停止迭代，保持 t 不变
+  for (int iteration = 0; iteration < kNewtonIterations; ++iteration) {
+    for (size_t i = 0; i < size; ++i) {
+      auto t = t_[i];
+      auto x2 = ((ax_[i] * t + bx_[i]) * t + cx_[i]) * t - progress_[i];
+      auto d2 = (3.0 * ax_[i] * t + 2.0 * bx_[i]) * t + cx_[i];
+      auto converged = static_cast<uint8_t>(std::fabs(x2) < epsilon_[i]);
+      auto step = static_cast<uint8_t>(active_[i] & !converged & (std::fabs(d2) >= 1e-6));
+      solved_[i] |= static_cast<uint8_t>(active_[i] & converged);
+      active_[i] = step;
+      t_[i] = step ? t - x2 / d2 : t;
+    }
+  }
+
+  for (size_t i = 0; i < size; ++i) {
+    auto progress = progress_[i];
+    if (progress <= 0) {
+      value_[i] = start_value_[i];
+      continue;
+    }
+    if (progress >= 1) {
+      value_[i] = to_value_[i];
+      continue;
+    }
+    auto t = solved_[i] ? t_[i] : animations_[i]->cubic_bezier_.SolveCurveX(progress, epsilon_[i]);
+    auto y = ((ay_[i] * t + by_[i]) * t + cy_[i]) * t;
+    if (animations_[i]->type_ == CubicBezierAnimation::ValueType::kColor) {
+      value_[i] = CubicBezierAnimation::CalculateColor(start_value_[i], to_value_[i], y);
+    } else {
+      value_[i] = start_value_[i] + y * (to_value_[i] - start_value_[i]);
+    }
+  }
+}
+
+double CubicBezierAnimationBatch::Apply(size_t index) {
+  const auto& animation = animations_[index];
+  animation->exec_time_ = exec_time_[index];
+  animation->last_begin_time_ = now_;
+  animation->current_value_ = value_[index];
+  return value_[index];
+}
+
 }
 }
 
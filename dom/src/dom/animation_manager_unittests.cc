@@ -0,0 +1,244 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dom/animation/animation_manager.h"
+#include "dom/animation/cubic_bezier_animation.h"
+#include "dom/dom_manager.h"
+#include "dom/dom_node.h"
+#include "dom/node_props.h"
+#include "dom/render_manager.h"
+#include "dom/root_node.h"
+#include "footstone/base_time.h"
+#include "footstone/hippy_value.h"
+#include "footstone/task_runner.h"
+
+namespace hippy {
+namespace dom {
+namespace testing {
+
+using HippyValue = footstone::value::HippyValue;
+using HippyValueObjectType = footstone::value::HippyValue::HippyValueObjectType;
+
+constexpr uint32_t kRootId = 1;
+constexpr uint32_t kAnimationNodeCount = 500;
+constexpr uint64_t kAnimationDuration = 60 * 1000;
+constexpr int kFrameTimes = 10;
+
+class UpdateCountingRenderManager : public RenderManager {
+ public:
+  UpdateCountingRenderManager() : RenderManager("UpdateCountingRenderManager") {}
+
+  void CreateRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&&) override {}
+  void UpdateRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&& nodes) override {
+    updated_count += nodes.size();
+  }
+  void MoveRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&&) override {}
+  void DeleteRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&&) override {}
+  void UpdateLayout(std::weak_ptr<RootNode>, const std::vector<std::shared_ptr<DomNode>>&) override {}
+  void MoveRenderNode(std::weak_ptr<RootNode>, std::vector<int32_t>&&, int32_t, int32_t, int32_t) override {}
+  void EndBatch(std::weak_ptr<RootNode>) override { ++end_batch_count; }
+  bool UpdateAnimationProps(std::weak_ptr<RootNode>, const std::vector<AnimationPropsUpdate>& updates) override {
+    if (!support_animation_props) {
+      return false;
+    }
+    animation_props_count += updates.size();
+    return true;
+  }
+  void BeforeLayout(std::weak_ptr<RootNode>) override { ++layout_pass_count; }
+  void AfterLayout(std::weak_ptr<RootNode>) override {}
+  void AddEventListener(std::weak_ptr<RootNode>, std::weak_ptr<DomNode>, const std::string&) override {}
+  void RemoveEventListener(std::weak_ptr<RootNode>, std::weak_ptr<DomNode>, const std::string&) override {}
+  void CallFunction(std::weak_ptr<RootNode>, std::weak_ptr<DomNode>, const std::string&, const DomArgument&,
+                    uint32_t) override {}
+
+  void Reset() {
+    updated_count = 0;
+    animation_props_count = 0;
+    end_batch_count = 0;
+    layout_pass_count = 0;
+  }
+
+  bool support_animation_props = false;
+  size_t updated_count = 0;
+  size_t animation_props_count = 0;
+  int end_batch_count = 0;
+  int layout_pass_count = 0;
+};
+
+struct AnimatedPage {
+  std::shared_ptr<UpdateCountingRenderManager> render_manager;
+  std::shared_ptr<DomManager> dom_manager;
+  std::shared_ptr<RootNode> root_node;
+  std::vector<std::shared_ptr<CubicBezierAnimation>> animations;
+};
+
+// kAnimationNodeCount 个节点，每个节点的 prop（默认为 opacity）与 transform 中的 translateX 各由一个动画驱动
+AnimatedPage CreateAnimatedPage(const std::vector<std::string>& timing_functions,
+                                const std::string& prop = kOpacity) {
+  AnimatedPage page;
+  page.render_manager = std::make_shared<UpdateCountingRenderManager>();
+  page.dom_manager = std::make_shared<DomManager>();
+  page.dom_manager->SetRenderManager(page.render_manager);
+  // 布局事件与 vsync 回调投递到未绑定 worker 的 runner，测试中直接调用 UpdateAnimations 模拟每一帧
+  page.dom_manager->SetTaskRunner(std::make_shared<footstone::TaskRunner>("animation"));
+  page.root_node = std::make_shared<RootNode>(kRootId);
+  page.root_node->SetDomManager(page.dom_manager);
+  page.root_node->SetRootSize(1080, 1920);
+  auto animation_manager = page.root_node->GetAnimationManager();
+
+  auto create_animation = [&page, &animation_manager, &timing_functions](double to_value) {
+    auto index = page.animations.size();
+    auto animation = std::make_shared<CubicBezierAnimation>(
+        CubicBezierAnimation::Mode::kTiming, 0, 0, to_value, CubicBezierAnimation::ValueType::kUndefined,
+        kAnimationDuration, timing_functions[index % timing_functions.size()], 0);
+    animation->SetAnimationManager(animation_manager);
+    animation_manager->AddAnimation(animation);
+    page.animations.push_back(animation);
+    HippyValueObjectType object;
+    object[kAnimationId] = HippyValue(animation->GetId());
+    return HippyValue(object);
+  };
+
+  std::vector<std::shared_ptr<DomInfo>> infos;
+  for (uint32_t i = 0; i < kAnimationNodeCount; ++i) {
+    auto style = std::make_shared<DomValueMap>();
+    (*style)[kWidth] = std::make_shared<HippyValue>(100);
+    (*style)[kHeight] = std::make_shared<HippyValue>(100);
+    (*style)[prop] = std::make_shared<HippyValue>(create_animation(1));
+    HippyValueObjectType translate;
+    translate["translateX"] = create_animation(200);
+    (*style)["transform"] = std::make_shared<HippyValue>(HippyValue::HippyValueArrayType{HippyValue(translate)});
+    auto ext = std::make_shared<DomValueMap>();
+    (*ext)[kUseAnimation] = std::make_shared<HippyValue>(true);
+    auto node = std::make_shared<DomNode>(kRootId + 1 + i, kRootId, static_cast<int32_t>(i), "View", "View", style,
+                                          ext, page.root_node);
+    infos.push_back(std::make_shared<DomInfo>(node, nullptr, nullptr));
+  }
+  DomManager::CreateDomNodes(page.root_node, std::move(infos), false);
+  page.dom_manager->EndBatch(page.root_node);
+
+  for (const auto& animation : page.animations) {
+    animation->Start();
+    // 直接从动画中段开始，每帧都需要求解曲线
+    animation->SetExecTime(kAnimationDuration / 2);
+  }
+  return page;
+}
+
+double GetStyleNumber(const std::shared_ptr<DomNode>& node, const std::string& key) {
+  auto it = node->GetStyleMap()->find(key);
+  if (it == node->GetStyleMap()->end()) {
+    return -1;
+  }
+  double value = -1;
+  it->second->ToDouble(value);
+  return value;
+}
+
+TEST(AnimationManagerTest, UpdateAnimations) {
+  std::vector<std::string> timing_functions = {kAnimationTimingFunctionLinear, kAnimationTimingFunctionEaseIn,
+                                               kAnimationTimingFunctionEaseInOut, "cubic-bezier(.45,2.84,.38,.5)",
+                                               kAnimationTimingFunctionEaseOut};
+  auto page = CreateAnimatedPage(timing_functions);
+  page.render_manager->updated_count = 0;
+  auto animation_manager = page.root_node->GetAnimationManager();
+  animation_manager->UpdateAnimations();
+  // 每个节点只上报一次，两个动画的结果合并在同一份 diff 中
+  EXPECT_EQ(page.render_manager->updated_count, kAnimationNodeCount);
+
+  for (uint32_t i = 0; i < kAnimationNodeCount; ++i) {
+    auto node = page.root_node->GetNode(kRootId + 1 + i);
+    ASSERT_NE(node, nullptr);
+    const auto& opacity_animation = page.animations[i * 2];
+    EXPECT_EQ(GetStyleNumber(node, kOpacity), opacity_animation->GetCurrentValue());
+    auto diff = node->GetDiffStyle();
+    ASSERT_NE(diff, nullptr);
+    EXPECT_EQ(diff->size(), 2u);
+    EXPECT_EQ(diff->count(kOpacity), 1u);
+    EXPECT_EQ(diff->count("transform"), 1u);
+  }
+  // 与单个动画独立计算的结果一致
+  for (size_t i = 0; i < page.animations.size(); ++i) {
+    const auto& animation = page.animations[i];
+    CubicBezierAnimation expected(CubicBezierAnimation::Mode::kTiming, 0, 0, i % 2 == 0 ? 1 : 200,
+                                  CubicBezierAnimation::ValueType::kUndefined, kAnimationDuration,
+                                  timing_functions[i % timing_functions.size()], 0);
+    expected.SetExecTime(animation->GetExecTime());
+    expected.SetLastBeginTime(animation->GetLastBeginTime());
+    ASSERT_DOUBLE_EQ(expected.Calculate(animation->GetLastBeginTime()), animation->GetCurrentValue());
+  }
+}
+
+TEST(AnimationManagerTest, PaintOnlyAnimations) {
+  auto page = CreateAnimatedPage({kAnimationTimingFunctionEaseInOut});
+  page.render_manager->support_animation_props = true;
+  page.render_manager->Reset();
+  page.root_node->GetAnimationManager()->UpdateAnimations();
+  // opacity 与 transform 动画直接下发，没有进入 batch
+  EXPECT_EQ(page.render_manager->animation_props_count, kAnimationNodeCount);
+  EXPECT_EQ(page.render_manager->updated_count, 0u);
+  EXPECT_EQ(page.render_manager->end_batch_count, 0);
+  EXPECT_EQ(page.render_manager->layout_pass_count, 0);
+  auto node = page.root_node->GetNode(kRootId + 1);
+  EXPECT_EQ(GetStyleNumber(node, kOpacity), page.animations[0]->GetCurrentValue());
+
+  // 渲染层不支持时走完整流程
+  page.render_manager->support_animation_props = false;
+  page.render_manager->Reset();
+  page.root_node->GetAnimationManager()->UpdateAnimations();
+  EXPECT_EQ(page.render_manager->updated_count, kAnimationNodeCount);
+  EXPECT_EQ(page.render_manager->end_batch_count, 1);
+
+  // 影响布局的动画走完整流程并重新布局
+  auto layout_page = CreateAnimatedPage({kAnimationTimingFunctionEaseInOut}, kWidth);
+  layout_page.render_manager->support_animation_props = true;
+  layout_page.render_manager->Reset();
+  layout_page.root_node->GetAnimationManager()->UpdateAnimations();
+  EXPECT_EQ(layout_page.render_manager->animation_props_count, 0u);
+  EXPECT_EQ(layout_page.render_manager->updated_count, kAnimationNodeCount);
+  EXPECT_EQ(layout_page.render_manager->layout_pass_count, 1);
+}
+
+TEST(AnimationManagerTest, UpdateAnimationsFrames) {
+  auto run = [](bool support_animation_props) {
+    auto page = CreateAnimatedPage({kAnimationTimingFunctionEaseInOut, "cubic-bezier(.45,2.84,.38,.5)"});
+    page.render_manager->support_animation_props = support_animation_props;
+    page.render_manager->Reset();
+    auto animation_manager = page.root_node->GetAnimationManager();
+    for (int i = 0; i < kFrameTimes; ++i) {
+      animation_manager->UpdateAnimations();
+    }
+    // 每帧每个节点恰好下发一次，两种方式只是下发的路径不同
+    EXPECT_EQ(page.render_manager->updated_count + page.render_manager->animation_props_count,
+              kAnimationNodeCount * kFrameTimes);
+  };
+  run(false);
+  run(true);
+}
+
+}  // namespace testing
+}  // namespace dom
+}  // namespace hippy
@@ -162,7 +162,7 @@ TEST(DeserializerTest, ReadHeader) {
 
   footstone::value::Deserializer deserializer(buffer.first, buffer.second);
   deserializer.ReadHeader();
-  EXPECT_EQ(deserializer.version_, tdf::base::kLatestVersion);
+  EXPECT_EQ(deserializer.version_, footstone::value::kLatestVersion);
   footstone::value::SerializerHelper::DestroyBuffer(buffer);
 }
 
@@ -248,6 +248,61 @@ TEST(DeserializerTest, Object) {
   CheckArray(array2);
 }
 
+TEST(DeserializerTest, ValueView) {
+  footstone::value::HippyValue::HippyValueArrayType array;
+  array.push_back(footstone::value::HippyValue(1));
+  array.push_back(footstone::value::HippyValue("item"));
+  footstone::value::HippyValue::HippyValueObjectType object;
+  object["int32"] = footstone::value::HippyValue(-1);
+  object["double"] = footstone::value::HippyValue(1.5);
+  object["bool"] = footstone::value::HippyValue(true);
+  object["string"] = footstone::value::HippyValue("腾讯");
+  object["array"] = footstone::value::HippyValue(array);
+  footstone::value::HippyValue hippy_value(object);
+
+  footstone::value::Serializer serializer;
+  serializer.WriteHeader();
+  serializer.WriteValue(hippy_value);
+  std::pair<uint8_t*, size_t> buffer = serializer.Release();
+
+  footstone::value::Deserializer deserializer(buffer.first, buffer.second);
+  deserializer.ReadHeader();
+  footstone::value::HippyValueView view;
+  EXPECT_TRUE(deserializer.ReadValueView(view));
+  EXPECT_TRUE(view.GetType() == footstone::value::HippyValue::Type::kObject);
+  EXPECT_EQ(view.GetLength(), 5);
+
+  footstone::value::HippyValueView property;
+  int32_t i32;
+  EXPECT_TRUE(view.GetProperty("int32", property));
+  EXPECT_TRUE(property.ToInt32(i32));
+  EXPECT_EQ(i32, -1);
+  double d;
+  EXPECT_TRUE(view.GetProperty("double", property));
+  EXPECT_TRUE(property.ToDouble(d));
+  EXPECT_EQ(d, 1.5);
+  bool b;
+  EXPECT_TRUE(view.GetProperty("bool", property));
+  EXPECT_TRUE(property.ToBoolean(b));
+  EXPECT_TRUE(b);
+  std::string str;
+  EXPECT_TRUE(view.GetProperty("string", property));
+  EXPECT_TRUE(property.ToString(str));
+  EXPECT_EQ(str, "腾讯");
+  EXPECT_FALSE(view.GetProperty("undefined", property));
+
+  footstone::value::HippyValueView element;
+  EXPECT_TRUE(view.GetProperty("array", property));
+  EXPECT_EQ(property.GetLength(), 2);
+  EXPECT_TRUE(property.GetElement(1, element));
+  EXPECT_TRUE(element.EqualsString("item"));
+
+  footstone::value::HippyValue materialized;
+  EXPECT_TRUE(view.Materialize(materialized));
+  EXPECT_TRUE(materialized == hippy_value);
+  footstone::value::SerializerHelper::DestroyBuffer(buffer);
+}
+
 }  // namespace testing
 }  // namespace dom
 }  // namespace hippy
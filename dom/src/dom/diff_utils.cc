@@ -20,53 +20,36 @@
 
 #include "dom/diff_utils.h"
 
-#include "dom/node_props.h"
+#include "dom/style_atom.h"
 #include "footstone/logging.h"
 namespace hippy {
 inline namespace dom {
 
-static bool ShouldUpdateProperty(const std::string& key, const DomValueMap& old_props_map,
-                                 const DomValueMap& new_props_map) {
-  if (key == kMargin) {
-    if ((new_props_map.find(kMarginLeft) == new_props_map.end() &&
-         old_props_map.find(kMarginLeft) != old_props_map.end()) ||
-        (new_props_map.find(kMarginRight) == new_props_map.end() &&
-         old_props_map.find(kMarginRight) != old_props_map.end()) ||
-        (new_props_map.find(kMarginTop) == new_props_map.end() &&
-         old_props_map.find(kMarginTop) != old_props_map.end()) ||
-        (new_props_map.find(kMarginBottom) == new_props_map.end() &&
-         old_props_map.find(kMarginBottom) != old_props_map.end())) {
-      return true;
-    }
-  }
-
-  if (key == kPadding) {
-    if ((new_props_map.find(kPaddingLeft) == new_props_map.end() &&
-         old_props_map.find(kPaddingLeft) != old_props_map.end()) ||
-        (new_props_map.find(kPaddingRight) == new_props_map.end() &&
-         old_props_map.find(kPaddingRight) != old_props_map.end()) ||
-        (new_props_map.find(kPaddingTop) == new_props_map.end() &&
-         old_props_map.find(kPaddingTop) != old_props_map.end()) ||
-        (new_props_map.find(kPaddingBottom) == new_props_map.end() &&
-         old_props_map.find(kPaddingBottom) != old_props_map.end())) {
+static bool IsAnyRemoved(std::initializer_list<StyleAtom> atoms, const DomValueMap& old_props_map,
+                         const DomValueMap& new_props_map) {
+  for (auto atom : atoms) {
+    if (new_props_map.find(atom) == new_props_map.end() && old_props_map.find(atom) != old_props_map.end()) {
       return true;
     }
   }
+  return false;
+}
 
-  if (key == kBorderWidth) {
-    if ((new_props_map.find(kBorderLeftWidth) == new_props_map.end() &&
-         old_props_map.find(kBorderLeftWidth) != old_props_map.end()) ||
-        (new_props_map.find(kBorderRightWidth) == new_props_map.end() &&
-         old_props_map.find(kBorderRightWidth) != old_props_map.end()) ||
-        (new_props_map.find(kBorderTopWidth) == new_props_map.end() &&
-         old_props_map.find(kBorderTopWidth) != old_props_map.end()) ||
-        (new_props_map.find(kBorderBottomWidth) == new_props_map.end() &&
-         old_props_map.find(kBorderBottomWidth) != old_props_map.end())) {
-      return true;
-    }
+// 对 diff 中每个值未变的条目调用，条目的原子已由 DomValueMap 保存，不需要再查原子表
+static bool ShouldUpdateProperty(StyleAtom atom, const DomValueMap& old_props_map, const DomValueMap& new_props_map) {
+  switch (atom) {
+    case StyleAtom::kMargin:
+      return IsAnyRemoved({StyleAtom::kMarginLeft, StyleAtom::kMarginRight, StyleAtom::kMarginTop,
+                           StyleAtom::kMarginBottom}, old_props_map, new_props_map);
+    case StyleAtom::kPadding:
+      return IsAnyRemoved({StyleAtom::kPaddingLeft, StyleAtom::kPaddingRight, StyleAtom::kPaddingTop,
+                           StyleAtom::kPaddingBottom}, old_props_map, new_props_map);
+    case StyleAtom::kBorderWidth:
+      return IsAnyRemoved({StyleAtom::kBorderLeftWidth, StyleAtom::kBorderRightWidth, StyleAtom::kBorderTopWidth,
+                           StyleAtom::kBorderBottomWidth}, old_props_map, new_props_map);
+    default:
+      return false;
   }
-
-  return false;
 }
 
 DiffValue DiffUtils::DiffProps(const DomValueMap& old_props_map, const DomValueMap& new_props_map, bool skip_style_diff) {
@@ -81,10 +64,9 @@ DiffValue DiffUtils::DiffProps(const DomValueMap& old_props_map, const DomValueM
   // Example:
   //                                      diff                         delete
   //  old_props_map: { a: 1, b: 2, c: 3 } ---> new_props_map: { a: 1 } ----->  delete_props: [b, c]
-  for (const auto& kv : old_props_map) {
-    auto iter = new_props_map.find(kv.first);
-    if (iter == new_props_map.end()) {
-      delete_props->push_back(kv.first);
+  for (auto it = old_props_map.begin(); it != old_props_map.end(); ++it) {
+    if (new_props_map.find(old_props_map.GetAtom(it), it->first) == new_props_map.end()) {
+      delete_props->push_back(it->first);
     }
   }
 
@@ -97,9 +79,11 @@ DiffValue DiffUtils::DiffProps(const DomValueMap& old_props_map, const DomValueM
   //   c: [ c1: 31, c2: 32 ]           c: [ c1: 31 ]            c: [ c1: 31 ]
   //   d: 4                          }                        }
   // }
-  for (const auto& old_prop : old_props_map) {
-    auto key = old_prop.first;
-    auto new_prop_iter = new_props_map.find(key);
+  for (auto it = old_props_map.begin(); it != old_props_map.end(); ++it) {
+    const auto& old_prop = *it;
+    const auto& key = old_prop.first;
+    auto atom = old_props_map.GetAtom(it);
+    auto new_prop_iter = new_props_map.find(atom, key);
     // delete case has already been processed above
     if (new_prop_iter == new_props_map.end()) {
       continue;
@@ -118,7 +102,7 @@ DiffValue DiffUtils::DiffProps(const DomValueMap& old_props_map, const DomValueM
     // new_props_map: { margin: 10 }
     // margin should update, otherwise the layout engine will use last margin bottom value
     if (old_prop.second != nullptr && *old_prop.second == *new_prop_iter->second) {
-      if (ShouldUpdateProperty(key, old_props_map, new_props_map)) {
+      if (ShouldUpdateProperty(atom, old_props_map, new_props_map)) {
         (*update_props)[key] = new_prop_iter->second;
       }
     }
@@ -132,12 +116,11 @@ DiffValue DiffUtils::DiffProps(const DomValueMap& old_props_map, const DomValueM
   //   a: 1,         --->    c: { c1: 31 }  ----->     c: { c1: 31 },
   // }                       d: [ d1: 41 ]             d: [ d1: 41 ],
   //                       }                         }
-  for (const auto& new_prop : new_props_map) {
-    auto key = new_prop.first;
-    if (old_props_map.find(key) != old_props_map.end()) {
+  for (auto it = new_props_map.begin(); it != new_props_map.end(); ++it) {
+    if (old_props_map.find(new_props_map.GetAtom(it), it->first) != old_props_map.end()) {
       continue;
     }
-    (*update_props)[key] = new_prop.second;
+    (*update_props)[it->first] = it->second;
   }
 
   DiffValue diff_props = std::make_tuple(update_props, delete_props);
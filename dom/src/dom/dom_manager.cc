@@ -22,6 +22,7 @@
 
 #include "dom/dom_manager.h"
 
+#include <cmath>
 #include <mutex>
 #include <stack>
 #include <utility>
@@ -31,6 +32,8 @@
 #include "dom/dom_action_interceptor.h"
 #include "dom/dom_event.h"
 #include "dom/dom_node.h"
+#include "dom/dom_snapshot.h"
+#include "dom/dom_snapshot_recorder.h"
 #include "dom/layer_optimized_render_manager.h"
 #include "dom/render_manager.h"
 #include "dom/root_node.h"
@@ -79,7 +82,8 @@ void DomManager::CreateDomNodes(const std::weak_ptr<RootNode>& weak_root_node,
   }
   size_t create_size = nodes.size();
   root_node->CreateDomNodes(std::move(nodes), needSortByIndex);
-  FOOTSTONE_DLOG(INFO) << "[Hippy Statistic] create node size = " << create_size << ", total node size = " << root_node->GetChildCount();
+  FOOTSTONE_DLOG(INFO) << "[Hippy Statistic] create node size = " << create_size << ", total node size = "
+                       << root_node->GetStatistics().total_node_count;
 }
 
 void DomManager::UpdateDomNodes(const std::weak_ptr<RootNode>& weak_root_node,
@@ -90,7 +94,8 @@ void DomManager::UpdateDomNodes(const std::weak_ptr<RootNode>& weak_root_node,
   }
   size_t update_size = nodes.size();
   root_node->UpdateDomNodes(std::move(nodes));
-  FOOTSTONE_DLOG(INFO) << "[Hippy Statistic] update node size = " << update_size << ", total node size = " << root_node->GetChildCount();
+  FOOTSTONE_DLOG(INFO) << "[Hippy Statistic] update node size = " << update_size << ", total node size = "
+                       << root_node->GetStatistics().total_node_count;
 }
 
 void DomManager::MoveDomNodes(const std::weak_ptr<RootNode>& weak_root_node,
@@ -101,7 +106,8 @@ void DomManager::MoveDomNodes(const std::weak_ptr<RootNode>& weak_root_node,
   }
   size_t move_size = nodes.size();
   root_node->MoveDomNodes(std::move(nodes));
-  FOOTSTONE_DLOG(INFO) << "[Hippy Statistic] move node size = " << move_size << ", total node size = " << root_node->GetChildCount();
+  FOOTSTONE_DLOG(INFO) << "[Hippy Statistic] move node size = " << move_size << ", total node size = "
+                       << root_node->GetStatistics().total_node_count;
 }
 
 void DomManager::UpdateAnimation(const std::weak_ptr<RootNode>& weak_root_node,
@@ -121,7 +127,8 @@ void DomManager::DeleteDomNodes(const std::weak_ptr<RootNode>& weak_root_node,
   }
   size_t delete_size = nodes.size();
   root_node->DeleteDomNodes(std::move(nodes));
-  FOOTSTONE_DLOG(INFO) << "[Hippy Statistic] delete node size = " << delete_size << ", total node size = " << root_node->GetChildCount();
+  FOOTSTONE_DLOG(INFO) << "[Hippy Statistic] delete node size = " << delete_size << ", total node size = "
+                       << root_node->GetStatistics().total_node_count;
 }
 
 void DomManager::EndBatch(const std::weak_ptr<RootNode>& weak_root_node) {
@@ -134,10 +141,20 @@ void DomManager::EndBatch(const std::weak_ptr<RootNode>& weak_root_node) {
   if (!root_node) {
     return;
   }
-  FOOTSTONE_DLOG(INFO) << "[Hippy Statistic] total node size = " << root_node->GetChildCount();
+  FOOTSTONE_DLOG(INFO) << "[Hippy Statistic] total node size = " << root_node->GetStatistics().total_node_count;
   root_node->SyncWithRenderManager(render_manager);
 }
 
+bool DomManager::UpdateAnimationProps(const std::weak_ptr<RootNode>& weak_root_node,
+                                      const std::vector<std::shared_ptr<DomNode>>& nodes) {
+  auto render_manager = render_manager_.lock();
+  auto root_node = weak_root_node.lock();
+  if (!render_manager || !root_node) {
+    return false;
+  }
+  return root_node->UpdateAnimationProps(nodes, render_manager);
+}
+
 void DomManager::AddEventListener(const std::weak_ptr<RootNode>& weak_root_node, uint32_t dom_id,
                                   const std::string& name, uint64_t listener_id, bool use_capture,
                                   const EventCallback& cb) {
@@ -274,6 +291,78 @@ bool DomManager::SetSnapShot(const std::shared_ptr<RootNode>& root_node, const b
   return true;
 }
 
+bool DomManager::SetSnapShot(const std::shared_ptr<RootNode>& root_node, const std::shared_ptr<DomSnapshot>& snapshot,
+                             const std::string& delta_log) {
+  if (!root_node || !snapshot || snapshot->GetNodeCount() == 0) {
+    return false;
+  }
+  const auto& orig_root = snapshot->GetNode(0);
+  if (orig_root.pid != 0) {
+    return false;
+  }
+  // 相同的属性条目只解码一次，各节点持有的 HippyValue 拷贝共享字符串与 object 的负载
+  std::vector<std::shared_ptr<HippyValue>> values(snapshot->GetStyleCount());
+  auto decode_style_map = [&snapshot, &values](uint32_t begin, uint32_t count) -> std::shared_ptr<DomValueMap> {
+    auto map = std::make_shared<DomValueMap>();
+    map->reserve(count);
+    for (uint32_t i = begin; i < begin + count; ++i) {
+      auto index = snapshot->GetStyleRef(i);
+      auto& value = values[index];
+      if (!value) {
+        value = std::make_shared<HippyValue>();
+        if (!snapshot->DecodeStyleValue(index, *value)) {
+          return nullptr;
+        }
+      }
+      map->emplace(snapshot->GetString(snapshot->GetStyle(index).key), std::make_shared<HippyValue>(*value));
+    }
+    return map;
+  };
+
+  auto root_width = root_node->GetLayoutNode()->GetStyleWidth();
+  auto root_height = root_node->GetLayoutNode()->GetStyleHeight();
+  const auto& header = snapshot->GetHeader();
+  // 根节点尺寸为 NaN 时表示自适应内容
+  auto same_size = [](float a, float b) { return a == b || (std::isnan(a) && std::isnan(b)); };
+  bool restore_layout = same_size(root_width, header.root_width) && same_size(root_height, header.root_height);
+  std::vector<std::shared_ptr<DomInfo>> nodes;
+  nodes.reserve(snapshot->GetNodeCount() - 1);
+  std::vector<std::pair<std::shared_ptr<DomNode>, LayoutResult>> layouts;
+  if (restore_layout) {
+    layouts.reserve(snapshot->GetNodeCount());
+    layouts.emplace_back(root_node, orig_root.layout);
+  }
+  for (uint32_t i = 1; i < snapshot->GetNodeCount(); ++i) {
+    const auto& record = snapshot->GetNode(i);
+    auto style = decode_style_map(record.style_begin, record.style_count);
+    auto ext = decode_style_map(record.ext_begin, record.ext_count);
+    if (!style || !ext) {
+      return false;
+    }
+    auto pid = record.pid == orig_root.id ? root_node->GetId() : record.pid;
+    auto dom_node = std::make_shared<DomNode>(record.id, pid, record.index,
+                                              std::string(snapshot->GetString(record.tag_name)),
+                                              std::string(snapshot->GetString(record.view_name)),
+                                              std::move(style), std::move(ext), root_node);
+    if (restore_layout) {
+      layouts.emplace_back(dom_node, record.layout);
+    }
+    nodes.push_back(std::make_shared<DomInfo>(std::move(dom_node), nullptr, nullptr));
+  }
+
+  CreateDomNodes(root_node, std::move(nodes), false);
+  // 应用增量后快照中的布局结果不再可靠
+  if (!delta_log.empty() && DomSnapshotRecorder::ApplyLog(root_node, delta_log, orig_root.id) > 0) {
+    restore_layout = false;
+  }
+  if (restore_layout) {
+    root_node->SetSnapshotLayout(std::move(layouts));
+  }
+  EndBatch(root_node);
+
+  return true;
+}
+
 void DomManager::RecordDomStartTimePoint() {
   if (dom_start_time_point_.ToEpochDelta() == TimeDelta::Zero()) {
     dom_start_time_point_ = footstone::TimePoint::SystemNow();
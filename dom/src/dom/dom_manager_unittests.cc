@@ -83,8 +83,8 @@ std::vector<std::shared_ptr<hippy::DomInfo>> ParserJson(const std::string& json_
     auto id = node_info["id"].get<int>();
     auto pid = node_info["pId"].get<int>();
     auto view_name = node_info["name"].get<json::string_t>();
-    std::unordered_map<std::string, std::shared_ptr<HippyValue>> style_map;
-    std::unordered_map<std::string, std::shared_ptr<HippyValue>> dom_ext_map;
+    hippy::dom::DomValueMap style_map;
+    hippy::dom::DomValueMap dom_ext_map;
     if (!node_info["props"].empty()) {
       auto props = node_info["props"].get<json::object_t>();
       for (const auto& kv : props) {
@@ -21,6 +21,7 @@
 #include "dom/dom_node.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <utility>
 #include "dom/diff_utils.h"
 #include "dom/node_props.h"
@@ -60,9 +61,29 @@ const std::map<int32_t, std::string> kRelativeTypeMap = {
 
 using HippyValueObjectType = footstone::value::HippyValue::HippyValueObjectType;
 
+// style_map_ 与 dom_ext_map_ 及其中的值可能被 DomNodeStyleDiffer 的 batch 快照共享，原地修改前需写时复制
+template <typename T>
+static void DetachIfShared(std::shared_ptr<T>& ptr) {
+  if (ptr != nullptr && ptr.use_count() > 1) {
+    ptr = std::make_shared<T>(*ptr);
+  }
+}
+
+static bool ContainsNestedStyle(const HippyValue& style, const std::string& key) {
+  if (style.IsObject()) {
+    for (const auto& o : style.ToObjectChecked()) {
+      if (o.first == key || ContainsNestedStyle(o.second, key)) return true;
+    }
+  } else if (style.IsArray()) {
+    for (const auto& a : style.ToArrayChecked()) {
+      if (ContainsNestedStyle(a, key)) return true;
+    }
+  }
+  return false;
+}
+
 DomNode::DomNode(uint32_t id, uint32_t pid, int32_t index, std::string tag_name, std::string view_name,
-                 std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>> style_map,
-                 std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>> dom_ext_map,
+                 std::shared_ptr<DomValueMap> style_map, std::shared_ptr<DomValueMap> dom_ext_map,
                  std::weak_ptr<RootNode> weak_root_node)
     : id_(id),
       pid_(pid),
@@ -86,13 +107,111 @@ DomNode::DomNode() : DomNode(0, 0, {}) {}
 
 DomNode::~DomNode() = default;
 
+// 子节点排序键的初始值与间隔，前插与追加各可连续进行约 2^30 次后才需要重新编号，
+// 在两个节点之间插入取中点，空隙耗尽时由 RelabelChildOrder 局部重新编号
+constexpr uint64_t kChildOrderBase = 1ULL << 62;
+constexpr uint64_t kChildOrderStep = 1ULL << 32;
+
 int32_t DomNode::IndexOf(const std::shared_ptr<DomNode>& child) {
-  for (size_t i = 0; i < children_.size(); i++) {
-    if (children_[i] == child) {
-      return footstone::check::checked_numeric_cast<size_t, int32_t>(i);
+  if (!child) {
+    return kInvalidIndex;
+  }
+  return IndexOfChild(child.get());
+}
+
+int32_t DomNode::IndexOfChild(const DomNode* child) const {
+  auto it = std::lower_bound(children_.begin(), children_.end(), child->child_order_,
+                             [](const std::shared_ptr<DomNode>& node, uint64_t order) {
+                               return node->child_order_ < order;
+                             });
+  if (it == children_.end() || it->get() != child) {
+    return kInvalidIndex;
+  }
+  return footstone::check::checked_numeric_cast<std::ptrdiff_t, int32_t>(it - children_.begin());
+}
+
+void DomNode::InsertChildAt(size_t index, const std::shared_ptr<DomNode>& child) {
+  children_.insert(children_.begin() + static_cast<std::ptrdiff_t>(index), child);
+  child->UpdateSubtreeDepth(depth_ + 1);
+  bool has_prev = index > 0;
+  bool has_next = index + 1 < children_.size();
+  if (!has_prev && !has_next) {
+    child->child_order_ = kChildOrderBase;
+    return;
+  }
+  if (!has_next) {
+    auto prev = children_[index - 1]->child_order_;
+    if (prev <= UINT64_MAX - kChildOrderStep) {
+      child->child_order_ = prev + kChildOrderStep;
+      return;
+    }
+  } else if (!has_prev) {
+    auto next = children_[index + 1]->child_order_;
+    if (next > kChildOrderStep) {
+      child->child_order_ = next - kChildOrderStep;
+      return;
+    }
+  } else {
+    auto prev = children_[index - 1]->child_order_;
+    auto next = children_[index + 1]->child_order_;
+    if (next - prev > 1) {
+      child->child_order_ = prev + (next - prev) / 2;
+      return;
+    }
+  }
+  // 相邻排序键之间没有空隙，只对插入点附近的一段子节点重新编号
+  RelabelChildOrder(index);
+}
+
+// 参考 order-maintenance 的做法：以插入点相邻节点的排序键为中心，按 2 的幂逐级扩大对齐的键区间，
+// 直到区间内的节点数不超过 (4/3)^level，再把这些节点在区间内均匀铺开。
+// 密集插入（例如反复插在固定的尾部节点之前）只会重新编号局部的少量节点，均摊 O(log n) 次编号
+void DomNode::RelabelChildOrder(size_t index) {
+  constexpr int kMaxLevel = 64;
+  auto anchor = index > 0 ? children_[index - 1]->child_order_ : children_[index + 1]->child_order_;
+  // [lo, hi] 为落在当前键区间内的子节点，包含新插入的节点
+  size_t lo = index;
+  size_t hi = index;
+  double capacity = 1;
+  for (int level = 1; level <= kMaxLevel; ++level) {
+    capacity *= 4.0 / 3.0;
+    uint64_t mask = level == kMaxLevel ? UINT64_MAX : (1ULL << level) - 1;
+    uint64_t begin = anchor & ~mask;
+    uint64_t end = anchor | mask;
+    while (lo > 0 && children_[lo - 1]->child_order_ >= begin) {
+      --lo;
+    }
+    while (hi + 1 < children_.size() && children_[hi + 1]->child_order_ <= end) {
+      ++hi;
+    }
+    auto count = hi - lo + 1;
+    if (static_cast<double>(count) > capacity && level < kMaxLevel) {
+      continue;
+    }
+    auto gap = mask / count;
+    auto order = begin + gap / 2;
+    for (auto k = lo; k <= hi; ++k) {
+      children_[k]->child_order_ = order;
+      order += gap;
+    }
+    return;
+  }
+}
+
+void DomNode::UpdateSubtreeDepth(int32_t depth) {
+  // 同一父节点内移动或新建的叶子节点深度不变或没有子孙，通常不需要遍历子树
+  if (depth_ == depth) {
+    return;
+  }
+  std::vector<std::pair<DomNode*, int32_t>> stack = {{this, depth}};
+  while (!stack.empty()) {
+    auto [node, node_depth] = stack.back();
+    stack.pop_back();
+    node->depth_ = node_depth;
+    for (const auto& child : node->children_) {
+      stack.emplace_back(child.get(), node_depth + 1);
     }
   }
-  return kInvalidIndex;
 }
 
 std::shared_ptr<DomNode> DomNode::GetChildAt(size_t index) {
@@ -104,35 +223,20 @@ std::shared_ptr<DomNode> DomNode::GetChildAt(size_t index) {
 
 int32_t DomNode::AddChildByRefInfo(const std::shared_ptr<DomInfo>& dom_info) {
   std::shared_ptr<RefInfo>& ref_info = dom_info->ref_info;
+  // 找不到参照节点时与没有参照信息一样追加到末尾
+  auto insert_index = children_.size();
   if (ref_info) {
-    if (children_.size() == 0) {
-       children_.push_back(dom_info->dom_node);
-    } else {
-      for (uint32_t i = 0; i < children_.size(); ++i) {
-        auto& child = children_[i];
-        if (ref_info->ref_id == child->GetId()) {
-          if (ref_info->relative_to_ref == RelativeType::kFront) {
-            children_.insert(
-                children_.begin() + footstone::check::checked_numeric_cast<uint32_t, int32_t>(i),
-                dom_info->dom_node);
-          } else {
-            children_.insert(
-                children_.begin() + footstone::check::checked_numeric_cast<uint32_t, int32_t>(i + 1),
-                dom_info->dom_node);
-          }
-          break;
-        }
-        if (i == children_.size() - 1) {
-          children_.push_back(dom_info->dom_node);
-          break;
-        }
+    auto ref_index = GetChildIndex(ref_info->ref_id);
+    if (ref_index != kInvalidIndex) {
+      insert_index = static_cast<size_t>(ref_index);
+      if (ref_info->relative_to_ref != RelativeType::kFront) {
+        ++insert_index;
       }
     }
-  } else {
-    children_.push_back(dom_info->dom_node);
   }
+  InsertChildAt(insert_index, dom_info->dom_node);
   dom_info->dom_node->SetParent(shared_from_this());
-  int32_t index = dom_info->dom_node->GetSelfIndex();
+  auto index = footstone::check::checked_numeric_cast<size_t, int32_t>(insert_index);
   // TODO(charleeshen): 支持不同的view，需要终端注册
   if (view_name_ == "Text") {
     return index;
@@ -143,6 +247,17 @@ int32_t DomNode::AddChildByRefInfo(const std::shared_ptr<DomInfo>& dom_info) {
 }
 
 int32_t DomNode::GetChildIndex(uint32_t id) {
+  // 通过 RootNode 的节点表找到子节点后二分查找，节点未注册时（如尚未挂载的子树）退化为线性查找
+  auto root_node = root_node_.lock();
+  if (root_node) {
+    auto child = root_node->GetNode(id);
+    if (child && child->parent_.lock().get() == this) {
+      auto index = IndexOfChild(child.get());
+      if (index != kInvalidIndex) {
+        return index;
+      }
+    }
+  }
   int32_t index = -1;
   for (uint32_t i = 0; i < children_.size(); ++i) {
     auto& child = children_[i];
@@ -156,24 +271,26 @@ int32_t DomNode::GetChildIndex(uint32_t id) {
 
 void DomNode::MarkWillChange(bool flag) {
   if (!dom_ext_map_) {
-    dom_ext_map_ = std::make_shared<std::unordered_map<std::string, std::shared_ptr<HippyValue>>>();
+    dom_ext_map_ = std::make_shared<DomValueMap>();
   }
+  DetachIfShared(dom_ext_map_);
   (*dom_ext_map_)[kNodeWillChangeKey] = std::make_shared<hippy::HippyValue>(flag);
 }
 
 int32_t DomNode::GetSelfIndex() {
   auto parent = parent_.lock();
   if (parent) {
-    return parent->GetChildIndex(id_);
+    return parent->IndexOfChild(this);
   }
   return -1;
 }
 
 int32_t DomNode::GetSelfDepth() {
-  if (auto parent = parent_.lock()) {
-    return 1 + parent->GetSelfDepth();
+  // 被移除的子树在重新插入前保留原深度，子树的根节点按未挂载处理
+  if (parent_.expired()) {
+    return 1;
   }
-  return 1;
+  return depth_;
 }
 
 std::shared_ptr<DomNode> DomNode::RemoveChildAt(int32_t index) {
@@ -185,18 +302,11 @@ std::shared_ptr<DomNode> DomNode::RemoveChildAt(int32_t index) {
 }
 
 std::shared_ptr<DomNode> DomNode::RemoveChildById(uint32_t id) {
-  auto it = children_.begin();
-  while (it != children_.end()) {
-    auto child = *it;
-    if (id == child->GetId()) {
-      child->SetParent(nullptr);
-      children_.erase(it);
-      layout_node_->RemoveChild(child->GetLayoutNode());
-      return child;
-    }
-    it++;
+  auto index = GetChildIndex(id);
+  if (index == kInvalidIndex) {
+    return nullptr;
   }
-  return nullptr;
+  return RemoveChildAt(index);
 }
 
 void DomNode::DoLayout() {
@@ -204,9 +314,13 @@ void DomNode::DoLayout() {
   DoLayout(changed_nodes);
 }
 
-void DomNode::DoLayout(std::vector<std::shared_ptr<DomNode>>& changed_nodes) {
+void DomNode::DoLayout(std::vector<std::shared_ptr<DomNode>>& changed_nodes, bool only_dirty_subtree) {
   layout_node_->CalculateLayout(is_layout_width_nan_ ? NAN : 0, is_layout_height_nan_ ? NAN : 0);
-  TransferLayoutOutputsRecursive(changed_nodes);
+  if (only_dirty_subtree) {
+    TransferDirtyLayoutOutputsRecursive(changed_nodes);
+  } else {
+    TransferLayoutOutputsRecursive(changed_nodes);
+  }
 }
 
 void DomNode::HandleEvent(const std::shared_ptr<DomEvent>& event) {
@@ -237,20 +351,38 @@ void DomNode::AddEventListener(const std::string& name, uint64_t listener_id, bo
                                const EventCallback& cb) {
   if (!event_listener_map_) {
     event_listener_map_ = std::make_shared<
-        std::unordered_map<std::string, std::array<std::vector<std::shared_ptr<DomEventListenerInfo>>, 2>>>();
+        std::unordered_map<std::string, std::array<std::shared_ptr<DomEventListenerList>, 2>>>();
   }
   auto it = event_listener_map_->find(name);
   if (it == event_listener_map_->end()) {
-    (*event_listener_map_)[name] = {};
+    it = event_listener_map_->emplace(name, std::array<std::shared_ptr<DomEventListenerList>, 2>{}).first;
     auto root_node = root_node_.lock();
     if (root_node) {
       root_node->AddEvent(GetId(), name);
+      root_node->OnEventListenerAdded(*this, name);
     }
   }
-  if (use_capture) {
-    (*event_listener_map_)[name][kCapture].push_back(std::make_shared<DomEventListenerInfo>(listener_id, cb));
-  } else {
-    (*event_listener_map_)[name][kBubble].push_back(std::make_shared<DomEventListenerInfo>(listener_id, cb));
+  auto& listeners = it->second[use_capture ? kCapture : kBubble];
+  if (!listeners) {
+    listeners = std::make_shared<DomEventListenerList>();
+  }
+  // 正在派发的事件可能还持有该列表
+  DetachIfShared(listeners);
+  listeners->push_back(std::make_shared<DomEventListenerInfo>(listener_id, cb));
+}
+
+static void RemoveListenerById(std::shared_ptr<DomEventListenerList>& listeners, uint64_t listener_id) {
+  if (!listeners) {
+    return;
+  }
+  auto it = std::find_if(listeners->begin(), listeners->end(),
+                         [listener_id](const std::shared_ptr<DomEventListenerInfo>& item) {
+                           return item->id == listener_id;
+                         });
+  if (it != listeners->end()) {
+    auto index = it - listeners->begin();
+    DetachIfShared(listeners);
+    listeners->erase(listeners->begin() + index);
   }
 }
 
@@ -259,51 +391,34 @@ void DomNode::RemoveEventListener(const std::string& name, uint64_t listener_id)
     return;
   }
 
-  // remove dom node capture function
   auto it = event_listener_map_->find(name);
   if (it == event_listener_map_->end()) {
     return;
   }
-  auto capture_listeners = it->second[kCapture];
-  auto capture_it = std::find_if(capture_listeners.begin(), capture_listeners.end(),
-                                 [listener_id](const std::shared_ptr<DomEventListenerInfo>& item) {
-                                   if (item->id == listener_id) {
-                                     return true;
-                                   }
-                                   return false;
-                                 });
-  if (capture_it != capture_listeners.end()) {
-    capture_listeners.erase(capture_it);
-  }
-
+  // remove dom node capture function
+  auto& capture_listeners = it->second[kCapture];
+  RemoveListenerById(capture_listeners, listener_id);
   // remove dom node bubble function
-  auto bubble_listeners = it->second[kBubble];
-  auto bubble_it = std::find_if(bubble_listeners.begin(), bubble_listeners.end(),
-                                [listener_id](const std::shared_ptr<DomEventListenerInfo>& item) {
-                                  if (item->id == listener_id) {
-                                    return true;
-                                  }
-                                  return false;
-                                });
-  if (bubble_it != bubble_listeners.end()) {
-    bubble_listeners.erase(bubble_it);
-  }
-  if (capture_listeners.empty() && bubble_listeners.empty()) {
+  auto& bubble_listeners = it->second[kBubble];
+  RemoveListenerById(bubble_listeners, listener_id);
+  if ((!capture_listeners || capture_listeners->empty()) && (!bubble_listeners || bubble_listeners->empty())) {
     event_listener_map_->erase(it);
     auto root_node = root_node_.lock();
     if (root_node) {
       root_node->RemoveEvent(GetId(), name);
+      root_node->OnEventListenerRemoved(*this, name);
     }
   }
 }
 
-std::vector<std::shared_ptr<DomEventListenerInfo>> DomNode::GetEventListener(const std::string& name, bool is_capture) {
+std::shared_ptr<const DomEventListenerList> DomNode::GetEventListener(const std::string& name,
+                                                                      bool is_capture) const {
   if (!event_listener_map_) {
-    return {};
+    return nullptr;
   }
   auto it = event_listener_map_->find(name);
   if (it == event_listener_map_->end()) {
-    return {};
+    return nullptr;
   }
   if (is_capture) {
     return it->second[kCapture];
@@ -313,9 +428,8 @@ std::vector<std::shared_ptr<DomEventListenerInfo>> DomNode::GetEventListener(con
 
 void DomNode::ParseLayoutStyleInfo() { layout_node_->SetLayoutStyles(*style_map_, std::vector<std::string>{}); }
 
-void DomNode::UpdateLayoutStyleInfo(
-    const std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>>& style_update,
-    const std::vector<std::string>& style_delete) {
+void DomNode::UpdateLayoutStyleInfo(const DomValueMap& style_update,
+                                    const std::vector<std::string>& style_delete) {
   layout_node_->SetLayoutStyles(style_update, style_delete);
 }
 LayoutResult DomNode::GetLayoutInfoFromRoot() {
@@ -330,12 +444,38 @@ LayoutResult DomNode::GetLayoutInfoFromRoot() {
 }
 
 void DomNode::TransferLayoutOutputsRecursive(std::vector<std::shared_ptr<DomNode>>& changed_nodes) {
+  TransferLayoutOutputs(changed_nodes);
+  for (auto& it : children_) {
+    it->TransferLayoutOutputsRecursive(changed_nodes);
+  }
+}
+
+void DomNode::TransferDirtyLayoutOutputsRecursive(std::vector<std::shared_ptr<DomNode>>& changed_nodes,
+                                                  bool ancestor_moved) {
+  // the layout engine only lays out the dirty path, a node which was not laid out in the last pass has no laid
+  // out descendants either, so the whole subtree can be skipped unless its render layout depends on a moved ancestor
+  bool need_transfer = ancestor_moved || layout_transfer_dirty_ || layout_node_->IsDirty() ||
+                       layout_node_->HasNewLayout();
+  if (!need_transfer) {
+    return;
+  }
+  bool moved = TransferLayoutOutputs(changed_nodes) || ancestor_moved;
+  for (auto& it : children_) {
+    // only nodes whose render parent is not their dom parent accumulate the positions of their ancestors
+    bool depend_on_ancestors = it->render_info_.pid != it->pid_ || it->IsLayoutOnly() || it->IsVirtual();
+    it->TransferDirtyLayoutOutputsRecursive(changed_nodes, moved && depend_on_ancestors);
+  }
+}
+
+bool DomNode::TransferLayoutOutputs(std::vector<std::shared_ptr<DomNode>>& changed_nodes) {
   auto not_equal = std::not_equal_to<>();
   bool changed =  layout_node_->IsDirty() || layout_node_->HasNewLayout();
   bool trigger_layout_event =
       not_equal(layout_.left, layout_node_->GetLeft()) || not_equal(layout_.top, layout_node_->GetTop()) ||
       not_equal(layout_.width, layout_node_->GetWidth()) || not_equal(layout_.height, layout_node_->GetHeight());
 
+  float old_left = layout_.left;
+  float old_top = layout_.top;
   layout_.left = std::isnan(layout_node_->GetLeft()) ? 0 : layout_node_->GetLeft();
   layout_.top = std::isnan(layout_node_->GetTop()) ? 0 : layout_node_->GetTop();
   layout_.width = std::isnan(layout_node_->GetWidth()) ? 0 : std::max<float>(layout_node_->GetWidth(), .0);
@@ -349,25 +489,17 @@ void DomNode::TransferLayoutOutputsRecursive(std::vector<std::shared_ptr<DomNode
   layout_.paddingRight = layout_node_->GetPadding(Edge::EdgeRight);
   layout_.paddingBottom = layout_node_->GetPadding(Edge::EdgeBottom);
 
+  bool moved = not_equal(layout_.left, old_left) || not_equal(layout_.top, old_top);
   float old_absolute_left = render_layout_.left;
   float old_absolute_top = render_layout_.top;
-  render_layout_ = layout_;
-
-  if (render_info_.pid != pid_) {
-    // 调整层级优化后的最终坐标
-    auto parent = GetParent();
-    while (parent != nullptr && parent->GetId() != render_info_.pid) {
-      render_layout_.left += parent->layout_.left;
-      render_layout_.top += parent->layout_.top;
-      parent = parent->GetParent();
-    }
-  }
+  UpdateRenderLayout();
   // 层级优化后的结果是否改变
   if (not_equal(render_layout_.left, old_absolute_left) || not_equal(render_layout_.top, old_absolute_top)) {
     changed = true;
   }
 
   layout_node_->SetHasNewLayout(false);
+  layout_transfer_dirty_ = false;
   if (changed) {
     changed_nodes.push_back(shared_from_this());
     HippyValueObjectType layout_param;
@@ -393,8 +525,33 @@ void DomNode::TransferLayoutOutputsRecursive(std::vector<std::shared_ptr<DomNode
       }
     }
   }
-  for (auto& it : children_) {
-    it->TransferLayoutOutputsRecursive(changed_nodes);
+  return moved;
+}
+
+void DomNode::UpdateRenderLayout() {
+  render_layout_ = layout_;
+  if (render_info_.pid != pid_) {
+    // 调整层级优化后的最终坐标
+    auto parent = GetParent();
+    while (parent != nullptr && parent->GetId() != render_info_.pid) {
+      render_layout_.left += parent->layout_.left;
+      render_layout_.top += parent->layout_.top;
+      parent = parent->GetParent();
+    }
+  }
+}
+
+void DomNode::MarkLayoutTransferDirty() {
+  layout_transfer_dirty_ = true;
+  // the marks on the ancestors are only read by the incremental transfer, the full transfer visits every node anyway
+  auto root = root_node_.lock();
+  if (root == nullptr || !root->IsIncrementalLayoutTransferEnabled()) {
+    return;
+  }
+  auto parent = parent_.lock();
+  while (parent != nullptr) {
+    parent->layout_transfer_dirty_ = true;
+    parent = parent->GetParent();
   }
 }
 
@@ -444,12 +601,19 @@ CallFunctionCallback DomNode::GetCallback(const std::string& name, uint32_t id)
 
 bool DomNode::HasEventListeners() { return event_listener_map_ != nullptr && !event_listener_map_->empty(); }
 
+bool DomNode::HasEventListener(const std::string& name) const {
+  return event_listener_map_ != nullptr && event_listener_map_->find(name) != event_listener_map_->end();
+}
+
 void DomNode::EmplaceStyleMap(const std::string& key, const HippyValue& value) {
+  DetachIfShared(style_map_);
   auto iter = style_map_->find(key);
   if (iter != style_map_->end()) {
     iter->second = std::make_shared<HippyValue>(value);
   } else {
     for (auto& style: *style_map_) {
+      if (!ContainsNestedStyle(*style.second, key)) continue;
+      DetachIfShared(style.second);
       auto replaced = ReplaceStyle(*style.second, key, value);
       if (replaced) {
         return;
@@ -459,14 +623,25 @@ void DomNode::EmplaceStyleMap(const std::string& key, const HippyValue& value) {
   }
 }
 
-void DomNode::EmplaceStyleMapAndGetDiff(const std::string& key, const HippyValue& value,
-                                        std::unordered_map<std::string, std::shared_ptr<HippyValue>>& diff) {
+std::shared_ptr<DomValueMap> DomNode::ResetDiffStyle() {
+  if (diff_ && diff_.use_count() == 1) {
+    diff_->clear();
+  } else {
+    diff_ = std::make_shared<DomValueMap>();
+  }
+  return diff_;
+}
+
+void DomNode::EmplaceStyleMapAndGetDiff(const std::string& key, const HippyValue& value, DomValueMap& diff) {
+  DetachIfShared(style_map_);
   auto it = style_map_->find(key);
   if (it != style_map_->end()) {
     it->second = std::make_shared<HippyValue>(value);
     diff[key] = it->second;
   } else {
     for (auto& style: *style_map_) {
+      if (!ContainsNestedStyle(*style.second, key)) continue;
+      DetachIfShared(style.second);
       auto replaced = ReplaceStyle(*style.second, key, value);
       if (replaced) {
         diff[style.first] = style.second;
@@ -478,8 +653,7 @@ void DomNode::EmplaceStyleMapAndGetDiff(const std::string& key, const HippyValue
   }
 }
 
-void DomNode::UpdateProperties(const std::unordered_map<std::string, std::shared_ptr<HippyValue>>& update_style,
-                               const std::unordered_map<std::string, std::shared_ptr<HippyValue>>& update_dom_ext) {
+void DomNode::UpdateProperties(const DomValueMap& update_style, const DomValueMap& update_dom_ext) {
   auto root_node = root_node_.lock();
   FOOTSTONE_DCHECK(root_node);
   if (root_node) {
@@ -490,16 +664,12 @@ void DomNode::UpdateProperties(const std::unordered_map<std::string, std::shared
   }
 }
 
-void DomNode::UpdateDomNodeStyleAndParseLayoutInfo(
-    const std::unordered_map<std::string, std::shared_ptr<HippyValue>>& update_style) {
+void DomNode::UpdateDomNodeStyleAndParseLayoutInfo(const DomValueMap& update_style) {
   UpdateStyle(update_style);
   ParseLayoutStyleInfo();
 }
 
-void DomNode::UpdateDiff(const std::unordered_map<std::string,
-                                                  std::shared_ptr<HippyValue>>& update_style,
-                         const std::unordered_map<std::string,
-                                                  std::shared_ptr<HippyValue>>& update_dom_ext) {
+void DomNode::UpdateDiff(const DomValueMap& update_style, const DomValueMap& update_dom_ext) {
   auto style_diff_value = DiffUtils::DiffProps(*this->GetStyleMap(), update_style, false);
   auto ext_diff_value = DiffUtils::DiffProps(*this->GetExtStyle(), update_dom_ext, false);
   auto style_update = std::get<0>(style_diff_value);
@@ -514,12 +684,13 @@ void DomNode::UpdateDiff(const std::unordered_map<std::string,
   SetDiffStyle(diff_value);
 }
 
-void DomNode::UpdateDomExt(const std::unordered_map<std::string, std::shared_ptr<HippyValue>>& update_dom_ext) {
+void DomNode::UpdateDomExt(const DomValueMap& update_dom_ext) {
   if (update_dom_ext.empty()) return;
 
+  DetachIfShared(this->dom_ext_map_);
   for (const auto& v : update_dom_ext) {
     if (this->dom_ext_map_ == nullptr) {
-      this->dom_ext_map_ = std::make_shared<std::unordered_map<std::string, std::shared_ptr<HippyValue>>>();
+      this->dom_ext_map_ = std::make_shared<DomValueMap>();
     }
 
     auto iter = this->dom_ext_map_->find(v.first);
@@ -530,6 +701,7 @@ void DomNode::UpdateDomExt(const std::unordered_map<std::string, std::shared_ptr
     }
 
     if (v.second->IsObject() && iter->second->IsObject()) {
+      DetachIfShared(iter->second);
       this->UpdateObjectStyle(*iter->second, *v.second);
     } else {
       iter->second = std::make_shared<HippyValue>(*v.second);
@@ -537,12 +709,13 @@ void DomNode::UpdateDomExt(const std::unordered_map<std::string, std::shared_ptr
   }
 }
 
-void DomNode::UpdateStyle(const std::unordered_map<std::string, std::shared_ptr<HippyValue>>& update_style) {
+void DomNode::UpdateStyle(const DomValueMap& update_style) {
   if (update_style.empty()) return;
 
+  DetachIfShared(this->style_map_);
   for (const auto& v : update_style) {
     if (this->style_map_ == nullptr) {
-      this->style_map_ = std::make_shared<std::unordered_map<std::string, std::shared_ptr<HippyValue>>>();
+      this->style_map_ = std::make_shared<DomValueMap>();
     }
 
     auto iter = this->style_map_->find(v.first);
@@ -553,6 +726,7 @@ void DomNode::UpdateStyle(const std::unordered_map<std::string, std::shared_ptr<
     }
 
     if (v.second->IsObject() && iter->second->IsObject()) {
+      DetachIfShared(iter->second);
       this->UpdateObjectStyle(*iter->second, *v.second);
     } else {
       iter->second = std::make_shared<HippyValue>(*v.second);
@@ -564,7 +738,7 @@ void DomNode::UpdateObjectStyle(HippyValue& style_map, const HippyValue& update_
   FOOTSTONE_DCHECK(style_map.IsObject());
   FOOTSTONE_DCHECK(update_style.IsObject());
 
-  auto style_object = style_map.ToObjectChecked();
+  auto style_object = std::as_const(style_map).ToObjectChecked();
   for (auto& v : update_style.ToObjectChecked()) {
     auto iter = style_object.find(v.first);
     if (iter == style_object.end()) {
@@ -579,30 +753,30 @@ void DomNode::UpdateObjectStyle(HippyValue& style_map, const HippyValue& update_
   }
 }
 
+// 先通过 const 接口查找，只对包含 key 的路径取可修改的引用，避免复制路径之外共享的 object 与 array
 bool DomNode::ReplaceStyle(HippyValue& style, const std::string& key, const HippyValue& value) {
+  const HippyValue& const_style = style;
   if (style.IsObject()) {
-    auto& object = style.ToObjectChecked();
+    const auto& object = const_style.ToObjectChecked();
     if (object.find(key) != object.end()) {
-      object.at(key) = value;
+      style.ToObjectChecked().at(key) = value;
       return true;
     }
 
-    bool replaced = false;
-    for (auto& o : object) {
-      replaced = ReplaceStyle(o.second, key, value);
-      if (replaced) break;
+    for (const auto& o : object) {
+      if (!ContainsNestedStyle(o.second, key)) continue;
+      return ReplaceStyle(style.ToObjectChecked().at(o.first), key, value);
     }
-    return replaced;
+    return false;
   }
 
   if (style.IsArray()) {
-    auto& array = style.ToArrayChecked();
-    bool replaced = false;
-    for (auto& a : array) {
-      replaced = ReplaceStyle(a, key, value);
-      if (replaced) break;
+    const auto& array = const_style.ToArrayChecked();
+    for (size_t i = 0; i < array.size(); ++i) {
+      if (!ContainsNestedStyle(array[i], key)) continue;
+      return ReplaceStyle(style.ToArrayChecked()[i], key, value);
     }
-    return replaced;
+    return false;
   }
 
   return false;
@@ -710,7 +884,7 @@ bool DomNode::Deserialize(HippyValue value) {
     FOOTSTONE_LOG(ERROR) << "Deserialize value is not object";
     return false;
   }
-  HippyValueObjectType dom_node_obj = value.ToObjectChecked();
+  HippyValueObjectType dom_node_obj = std::as_const(value).ToObjectChecked();
 
   uint32_t id;
   auto flag = dom_node_obj[kNodePropertyId].ToUint32(id);
@@ -754,22 +928,20 @@ bool DomNode::Deserialize(HippyValue value) {
     return false;
   }
 
-  auto style_obj = dom_node_obj[kNodePropertyStyle];
+  const auto& style_obj = dom_node_obj[kNodePropertyStyle];
   if (style_obj.IsObject()) {
-    auto style = style_obj.ToObjectChecked();
-    std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>> style_map =
-        std::make_shared<std::unordered_map<std::string, std::shared_ptr<HippyValue>>>();
+    const auto& style = style_obj.ToObjectChecked();
+    std::shared_ptr<DomValueMap> style_map = std::make_shared<DomValueMap>();
     for (const auto& p: style) {
       (*style_map)[p.first] = std::make_shared<HippyValue>(p.second);
     }
     SetStyleMap(std::move(style_map));
   }
 
-  auto ext_obj = dom_node_obj[kNodePropertyExt];
+  const auto& ext_obj = dom_node_obj[kNodePropertyExt];
   if (ext_obj.IsObject()) {
-    auto ext = ext_obj.ToObjectChecked();
-    std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>> ext_map =
-        std::make_shared<std::unordered_map<std::string, std::shared_ptr<HippyValue>>>();
+    const auto& ext = ext_obj.ToObjectChecked();
+    std::shared_ptr<DomValueMap> ext_map = std::make_shared<DomValueMap>();
     for (const auto& p: ext) {
       (*ext_map)[p.first] = std::make_shared<HippyValue>(p.second);
     }
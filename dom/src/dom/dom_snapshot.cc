@@ -0,0 +1,471 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dom/dom_snapshot.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "dom/dom_node.h"
+#include "dom/root_node.h"
+#include "footstone/check.h"
+#include "footstone/logging.h"
+
+namespace hippy {
+inline namespace dom {
+
+using HippyValue = footstone::value::HippyValue;
+using HippyValueArrayType = footstone::value::HippyValue::HippyValueArrayType;
+using HippyValueObjectType = footstone::value::HippyValue::HippyValueObjectType;
+
+static_assert(sizeof(DomSnapshot::Header) % 4 == 0);
+static_assert(sizeof(DomSnapshot::NodeRecord) % 4 == 0);
+static_assert(std::is_trivially_copyable_v<DomSnapshot::NodeRecord>);
+
+namespace {
+
+// 属性值编码：1 字节的类型，后跟定长的内容，字符串为字符串表下标，
+// array 为 4 字节的长度后跟各元素，object 为 4 字节的长度后跟各 (key 的字符串表下标, value)
+enum class ValueTag : uint8_t {
+  kUndefined,
+  kNull,
+  kFalse,
+  kTrue,
+  kInt32,
+  kUint32,
+  kDouble,
+  kString,
+  kArray,
+  kObject,
+};
+
+// 嵌套的 array/object 层数上限，避免不合法的快照导致栈溢出
+constexpr uint32_t kMaxValueDepth = 64;
+
+template <typename T>
+void Append(std::string& buffer, const T& value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void AlignTo4(std::string& buffer) {
+  buffer.resize((buffer.size() + 3) & ~static_cast<size_t>(3));
+}
+
+class SnapshotWriter {
+ public:
+  void AddNode(const std::shared_ptr<DomNode>& node, uint32_t pid) {
+    DomSnapshot::NodeRecord record{};
+    record.id = node->GetId();
+    record.pid = pid;
+    record.index = node->GetIndex();
+    record.tag_name = InternString(node->GetTagName());
+    record.view_name = InternString(node->GetViewName());
+    AddStyleMap(node->GetStyleMap(), record.style_begin, record.style_count);
+    AddStyleMap(node->GetExtStyle(), record.ext_begin, record.ext_count);
+    record.layout = node->GetLayoutResult();
+    nodes_.push_back(record);
+  }
+
+  std::string Finish(float root_width, float root_height) {
+    DomSnapshot::Header header{};
+    header.magic = DomSnapshot::kMagic;
+    header.version = DomSnapshot::kVersion;
+    header.byte_order_mark = DomSnapshot::kByteOrderMark;
+    header.root_width = root_width;
+    header.root_height = root_height;
+    header.node_count = Count(nodes_.size());
+    header.style_ref_count = Count(style_refs_.size());
+    header.style_count = Count(styles_.size());
+    header.string_count = Count(strings_.size());
+    header.string_data_size = Count(string_data_.size());
+    header.value_data_size = Count(value_data_.size());
+
+    std::string buffer;
+    buffer.reserve(sizeof(header) + nodes_.size() * sizeof(DomSnapshot::NodeRecord) +
+                   style_refs_.size() * sizeof(uint32_t) + styles_.size() * sizeof(DomSnapshot::StyleEntry) +
+                   strings_.size() * sizeof(DomSnapshot::StringEntry) + string_data_.size() + value_data_.size() + 8);
+    Append(buffer, header);
+    buffer.append(reinterpret_cast<const char*>(nodes_.data()), nodes_.size() * sizeof(DomSnapshot::NodeRecord));
+    buffer.append(reinterpret_cast<const char*>(style_refs_.data()), style_refs_.size() * sizeof(uint32_t));
+    buffer.append(reinterpret_cast<const char*>(styles_.data()), styles_.size() * sizeof(DomSnapshot::StyleEntry));
+    buffer.append(reinterpret_cast<const char*>(strings_.data()),
+                  strings_.size() * sizeof(DomSnapshot::StringEntry));
+    buffer.append(string_data_);
+    AlignTo4(buffer);
+    buffer.append(value_data_);
+    AlignTo4(buffer);
+    auto file_size = Count(buffer.size());
+    std::memcpy(&buffer[offsetof(DomSnapshot::Header, file_size)], &file_size, sizeof(file_size));
+    return buffer;
+  }
+
+ private:
+  static uint32_t Count(size_t size) { return footstone::check::checked_numeric_cast<size_t, uint32_t>(size); }
+
+  uint32_t InternString(const std::string& str) {
+    auto it = string_index_.find(str);
+    if (it != string_index_.end()) {
+      return it->second;
+    }
+    auto index = Count(strings_.size());
+    strings_.push_back({Count(string_data_.size()), Count(str.size())});
+    string_data_.append(str);
+    string_index_.emplace(str, index);
+    return index;
+  }
+
+  void AddStyleMap(const std::shared_ptr<const DomValueMap>& map, uint32_t& begin, uint32_t& count) {
+    begin = Count(style_refs_.size());
+    count = 0;
+    if (!map) {
+      return;
+    }
+    for (const auto& [key, value] : *map) {
+      if (!value) {
+        continue;
+      }
+      style_refs_.push_back(InternStyle(key, *value));
+      ++count;
+    }
+  }
+
+  // key 与 value 编码都相同的条目只保存一份
+  uint32_t InternStyle(const std::string& key, const HippyValue& value) {
+    encoded_.clear();
+    Append(encoded_, InternString(key));
+    EncodeValue(value, encoded_);
+    auto it = style_index_.find(encoded_);
+    if (it != style_index_.end()) {
+      return it->second;
+    }
+    auto index = Count(styles_.size());
+    auto value_size = encoded_.size() - sizeof(uint32_t);
+    styles_.push_back({InternString(key), Count(value_data_.size()), Count(value_size)});
+    value_data_.append(encoded_, sizeof(uint32_t), value_size);
+    style_index_.emplace(encoded_, index);
+    return index;
+  }
+
+  void EncodeValue(const HippyValue& value, std::string& buffer) {
+    if (value.IsBoolean()) {
+      Append(buffer, value.ToBooleanChecked() ? ValueTag::kTrue : ValueTag::kFalse);
+    } else if (value.IsInt32()) {
+      Append(buffer, ValueTag::kInt32);
+      Append(buffer, value.ToInt32Checked());
+    } else if (value.IsUInt32()) {
+      Append(buffer, ValueTag::kUint32);
+      Append(buffer, value.ToUint32Checked());
+    } else if (value.IsNumber()) {
+      Append(buffer, ValueTag::kDouble);
+      Append(buffer, value.IsDouble() ? value.ToDoubleChecked() : NAN);
+    } else if (value.IsString()) {
+      Append(buffer, ValueTag::kString);
+      Append(buffer, InternString(value.ToStringChecked()));
+    } else if (value.IsArray()) {
+      const auto& array = value.ToArrayChecked();
+      Append(buffer, ValueTag::kArray);
+      Append(buffer, Count(array.size()));
+      for (const auto& element : array) {
+        EncodeValue(element, buffer);
+      }
+    } else if (value.IsObject()) {
+      const auto& object = value.ToObjectChecked();
+      Append(buffer, ValueTag::kObject);
+      Append(buffer, Count(object.size()));
+      for (const auto& [key, element] : object) {
+        Append(buffer, InternString(key));
+        EncodeValue(element, buffer);
+      }
+    } else if (value.IsNull()) {
+      Append(buffer, ValueTag::kNull);
+    } else {
+      Append(buffer, ValueTag::kUndefined);
+    }
+  }
+
+  std::vector<DomSnapshot::NodeRecord> nodes_;
+  std::vector<uint32_t> style_refs_;
+  std::vector<DomSnapshot::StyleEntry> styles_;
+  std::vector<DomSnapshot::StringEntry> strings_;
+  std::string string_data_;
+  std::string value_data_;
+  std::unordered_map<std::string, uint32_t> string_index_;
+  std::unordered_map<std::string, uint32_t> style_index_;
+  std::string encoded_;
+};
+
+class ValueReader {
+ public:
+  ValueReader(const DomSnapshot& snapshot, const uint8_t* data, size_t size)
+      : snapshot_(snapshot), data_(data), end_(data + size) {}
+
+  bool Read(HippyValue& value, uint32_t depth = 0) {
+    ValueTag tag;
+    if (depth > kMaxValueDepth || !ReadRaw(tag)) {
+      return false;
+    }
+    switch (tag) {
+      case ValueTag::kUndefined:
+        value = HippyValue::Undefined();
+        return true;
+      case ValueTag::kNull:
+        value = HippyValue::Null();
+        return true;
+      case ValueTag::kFalse:
+      case ValueTag::kTrue:
+        value = HippyValue(tag == ValueTag::kTrue);
+        return true;
+      case ValueTag::kInt32:
+        return ReadNumber<int32_t>(value);
+      case ValueTag::kUint32:
+        return ReadNumber<uint32_t>(value);
+      case ValueTag::kDouble:
+        return ReadNumber<double>(value);
+      case ValueTag::kString: {
+        std::string_view str;
+        if (!ReadString(str)) {
+          return false;
+        }
+        value = HippyValue(str.data(), str.size());
+        return true;
+      }
+      case ValueTag::kArray: {
+        uint32_t count;
+        if (!ReadRaw(count) || count > static_cast<size_t>(end_ - data_)) {
+          return false;
+        }
+        HippyValueArrayType array(count);
+        for (auto& element : array) {
+          if (!Read(element, depth + 1)) {
+            return false;
+          }
+        }
+        value = HippyValue(std::move(array));
+        return true;
+      }
+      case ValueTag::kObject: {
+        uint32_t count;
+        if (!ReadRaw(count) || count > static_cast<size_t>(end_ - data_)) {
+          return false;
+        }
+        HippyValueObjectType object;
+        object.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+          std::string_view key;
+          HippyValue element;
+          if (!ReadString(key) || !Read(element, depth + 1)) {
+            return false;
+          }
+          object.emplace(std::string(key), std::move(element));
+        }
+        value = HippyValue(std::move(object));
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+
+ private:
+  template <typename T>
+  bool ReadRaw(T& out) {
+    if (static_cast<size_t>(end_ - data_) < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&out, data_, sizeof(T));
+    data_ += sizeof(T);
+    return true;
+  }
+
+  template <typename T>
+  bool ReadNumber(HippyValue& value) {
+    T number;
+    if (!ReadRaw(number)) {
+      return false;
+    }
+    value = HippyValue(number);
+    return true;
+  }
+
+  bool ReadString(std::string_view& str) {
+    uint32_t index;
+    if (!ReadRaw(index) || index >= snapshot_.GetHeader().string_count) {
+      return false;
+    }
+    str = snapshot_.GetString(index);
+    return true;
+  }
+
+  const DomSnapshot& snapshot_;
+  const uint8_t* data_;
+  const uint8_t* end_;
+};
+
+}  // namespace
+
+std::string DomSnapshot::Serialize(const std::shared_ptr<RootNode>& root_node) {
+  if (!root_node) {
+    return {};
+  }
+  SnapshotWriter writer;
+  // 与 RootNode::Traverse 相同的先序遍历，节点的 pid 取实际的父节点
+  root_node->Traverse([&writer](const std::shared_ptr<DomNode>& node) {
+    auto parent = node->GetParent();
+    writer.AddNode(node, parent ? parent->GetId() : 0);
+  });
+  // 记录 SetRootSize 设置的根节点尺寸，恢复时根节点尺寸相同才能复用布局结果
+  auto root_layout_node = root_node->GetLayoutNode();
+  return writer.Finish(root_layout_node->GetStyleWidth(), root_layout_node->GetStyleHeight());
+}
+
+std::shared_ptr<DomSnapshot> DomSnapshot::Open(const std::string& path) {
+#ifdef _WIN32
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return nullptr;
+  }
+  return FromBuffer(std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st {};
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return nullptr;
+  }
+  auto size = static_cast<size_t>(st.st_size);
+  void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // 映射建立后即可关闭文件
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    FOOTSTONE_LOG(ERROR) << "DomSnapshot mmap failed, path = " << path;
+    return nullptr;
+  }
+  std::shared_ptr<DomSnapshot> snapshot(new DomSnapshot());
+  snapshot->mapped_ = mapped;
+  snapshot->mapped_size_ = size;
+  if (!snapshot->Parse(static_cast<const uint8_t*>(mapped), size)) {
+    return nullptr;
+  }
+  return snapshot;
+#endif
+}
+
+std::shared_ptr<DomSnapshot> DomSnapshot::FromBuffer(std::string buffer) {
+  std::shared_ptr<DomSnapshot> snapshot(new DomSnapshot());
+  snapshot->buffer_ = std::move(buffer);
+  if (!snapshot->Parse(reinterpret_cast<const uint8_t*>(snapshot->buffer_.data()), snapshot->buffer_.size())) {
+    return nullptr;
+  }
+  return snapshot;
+}
+
+DomSnapshot::~DomSnapshot() {
+#ifndef _WIN32
+  if (mapped_) {
+    munmap(mapped_, mapped_size_);
+  }
+#endif
+}
+
+bool DomSnapshot::Parse(const uint8_t* data, size_t size) {
+  if (size < sizeof(Header) || reinterpret_cast<uintptr_t>(data) % alignof(Header) != 0) {
+    return false;
+  }
+  header_ = reinterpret_cast<const Header*>(data);
+  if (header_->magic != kMagic || header_->version != kVersion || header_->byte_order_mark != kByteOrderMark ||
+      header_->file_size != size) {
+    FOOTSTONE_LOG(ERROR) << "DomSnapshot header mismatch";
+    return false;
+  }
+  // 各段的大小均由 uint32_t 计数得到，使用 uint64_t 累加不会溢出
+  uint64_t offset = sizeof(Header);
+  auto section = [data, &offset](uint64_t section_size) {
+    auto begin = data + offset;
+    offset += section_size;
+    return begin;
+  };
+  nodes_ = reinterpret_cast<const NodeRecord*>(section(uint64_t{header_->node_count} * sizeof(NodeRecord)));
+  style_refs_ = reinterpret_cast<const uint32_t*>(section(uint64_t{header_->style_ref_count} * sizeof(uint32_t)));
+  styles_ = reinterpret_cast<const StyleEntry*>(section(uint64_t{header_->style_count} * sizeof(StyleEntry)));
+  strings_ = reinterpret_cast<const StringEntry*>(section(uint64_t{header_->string_count} * sizeof(StringEntry)));
+  string_data_ = reinterpret_cast<const char*>(section((uint64_t{header_->string_data_size} + 3) & ~uint64_t{3}));
+  value_data_ = section(uint64_t{header_->value_data_size});
+  if (offset > size) {
+    return false;
+  }
+
+  // 一次性校验所有下标，之后的访问无需再检查
+  for (uint32_t i = 0; i < header_->string_count; ++i) {
+    if (uint64_t{strings_[i].offset} + strings_[i].size > header_->string_data_size) {
+      return false;
+    }
+  }
+  for (uint32_t i = 0; i < header_->style_count; ++i) {
+    const auto& style = styles_[i];
+    if (style.key >= header_->string_count ||
+        uint64_t{style.value_offset} + style.value_size > header_->value_data_size) {
+      return false;
+    }
+  }
+  for (uint32_t i = 0; i < header_->style_ref_count; ++i) {
+    if (style_refs_[i] >= header_->style_count) {
+      return false;
+    }
+  }
+  for (uint32_t i = 0; i < header_->node_count; ++i) {
+    const auto& node = nodes_[i];
+    if (node.tag_name >= header_->string_count || node.view_name >= header_->string_count ||
+        uint64_t{node.style_begin} + node.style_count > header_->style_ref_count ||
+        uint64_t{node.ext_begin} + node.ext_count > header_->style_ref_count) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string_view DomSnapshot::GetString(uint32_t index) const {
+  const auto& entry = strings_[index];
+  return {string_data_ + entry.offset, entry.size};
+}
+
+bool DomSnapshot::DecodeStyleValue(uint32_t index, HippyValue& value) const {
+  const auto& style = styles_[index];
+  ValueReader reader(*this, value_data_ + style.value_offset, style.value_size);
+  return reader.Read(value);
+}
+
+}  // namespace dom
+}  // namespace hippy
@@ -0,0 +1,333 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dom/dom_snapshot_recorder.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include "dom/dom_manager.h"
+#include "dom/dom_node.h"
+#include "dom/dom_snapshot.h"
+#include "dom/root_node.h"
+#include "footstone/check.h"
+#include "footstone/deserializer.h"
+#include "footstone/logging.h"
+
+namespace hippy {
+inline namespace dom {
+
+using HippyValue = footstone::value::HippyValue;
+using HippyValueArrayType = footstone::value::HippyValue::HippyValueArrayType;
+using HippyValueObjectType = footstone::value::HippyValue::HippyValueObjectType;
+using Deserializer = footstone::value::Deserializer;
+
+namespace {
+
+HippyValue ToObject(const std::shared_ptr<const DomValueMap>& map) {
+  HippyValueObjectType object;
+  if (map) {
+    for (const auto& [key, value] : *map) {
+      if (value) {
+        object[key] = *value;
+      }
+    }
+  }
+  return HippyValue(std::move(object));
+}
+
+std::shared_ptr<DomValueMap> ToMap(const HippyValue& value) {
+  auto map = std::make_shared<DomValueMap>();
+  if (value.IsObject()) {
+    const auto& object = value.ToObjectChecked();
+    map->reserve(object.size());
+    for (const auto& [key, element] : object) {
+      map->emplace(key, std::make_shared<HippyValue>(element));
+    }
+  }
+  return map;
+}
+
+}  // namespace
+
+DomSnapshotRecorder::DomSnapshotRecorder(std::weak_ptr<RootNode> root_node, std::string path)
+    : root_node_(std::move(root_node)), path_(std::move(path)), log_path_(path_ + ".log") {}
+
+DomSnapshotRecorder::~DomSnapshotRecorder() {
+  if (log_file_.is_open()) {
+    log_file_.close();
+  }
+}
+
+void DomSnapshotRecorder::OnDomNodeCreate(const std::vector<std::shared_ptr<DomInfo>>& nodes) {
+  Append(Op::kCreate, nodes);
+}
+
+void DomSnapshotRecorder::OnDomNodeUpdate(const std::vector<std::shared_ptr<DomInfo>>& nodes) {
+  Append(Op::kUpdate, nodes);
+}
+
+void DomSnapshotRecorder::OnDomNodeMove(const std::vector<std::shared_ptr<DomInfo>>& nodes) {
+  Append(Op::kMove, nodes);
+}
+
+void DomSnapshotRecorder::OnDomNodeDelete(const std::vector<std::shared_ptr<DomInfo>>& nodes) {
+  Append(Op::kDelete, nodes);
+}
+
+void DomSnapshotRecorder::OnDomBatchEnd() {
+  // 提交标记之前的记录才会在恢复时应用，batch 写入到一半时进程退出不会恢复出半个 batch
+  if (has_uncommitted_record_) {
+    WriteRecord(Op::kCommit, nullptr, 0);
+    has_uncommitted_record_ = false;
+  }
+  auto threshold = std::max<uint64_t>(kMinCompactLogSize, statistics_.snapshot_size / 2);
+  if (!has_snapshot_ || statistics_.log_size > threshold) {
+    Compact();
+  } else if (log_file_.is_open()) {
+    log_file_.flush();
+  }
+}
+
+// 记录的内容为节点数组，每个节点为按位置编码的数组：
+//   create/update: [id, pid, index, tag_name, view_name, style, ext, ref_id, relative_to_ref]
+//   move: [id, pid, ref_id, relative_to_ref]
+//   delete: [id, pid]
+// 更新时 DomInfo 中携带的是节点完整的 style 与 ext，直接保存即可
+void DomSnapshotRecorder::Append(Op op, const std::vector<std::shared_ptr<DomInfo>>& nodes) {
+  // 尚未写入基础快照时，本 batch 结束后写入的快照已经包含这些操作
+  if (!has_snapshot_ || nodes.empty()) {
+    return;
+  }
+  HippyValueArrayType records;
+  records.reserve(nodes.size());
+  for (const auto& info : nodes) {
+    if (!info || !info->dom_node) {
+      continue;
+    }
+    const auto& node = info->dom_node;
+    HippyValueArrayType record = {HippyValue(node->GetId()), HippyValue(node->GetPid())};
+    if (op == Op::kCreate || op == Op::kUpdate) {
+      record.emplace_back(node->GetIndex());
+      record.emplace_back(node->GetTagName());
+      record.emplace_back(node->GetViewName());
+      record.push_back(ToObject(node->GetStyleMap()));
+      record.push_back(ToObject(node->GetExtStyle()));
+    }
+    if (op != Op::kDelete) {
+      record.emplace_back(info->ref_info ? info->ref_info->ref_id : kInvalidId);
+      record.emplace_back(info->ref_info ? info->ref_info->relative_to_ref : RelativeType::kDefault);
+    }
+    records.emplace_back(std::move(record));
+  }
+
+  serializer_.Reset();
+  serializer_.WriteHeader();
+  serializer_.WriteValue(HippyValue(std::move(records)));
+  auto [buffer, size] = serializer_.GetBuffer();
+  if (WriteRecord(op, buffer, size)) {
+    has_uncommitted_record_ = true;
+    ++statistics_.record_count;
+  }
+}
+
+bool DomSnapshotRecorder::WriteRecord(Op op, const uint8_t* data, size_t size) {
+  if (!log_file_.is_open()) {
+    log_file_.open(log_path_, std::ios::binary | std::ios::app);
+  }
+  RecordHeader header{kRecordMagic, op, footstone::check::checked_numeric_cast<size_t, uint32_t>(size)};
+  log_file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (size > 0) {
+    log_file_.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+  }
+  if (!log_file_) {
+    FOOTSTONE_LOG(ERROR) << "DomSnapshotRecorder write log failed, path = " << log_path_;
+    log_file_.clear();
+    return false;
+  }
+  statistics_.log_size += sizeof(header) + size;
+  return true;
+}
+
+bool DomSnapshotRecorder::Compact() {
+  auto root_node = root_node_.lock();
+  if (!root_node) {
+    return false;
+  }
+  auto snapshot = DomSnapshot::Serialize(root_node);
+  auto temp_path = path_ + ".tmp";
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    file.write(snapshot.data(), static_cast<std::streamsize>(snapshot.size()));
+    if (!file) {
+      FOOTSTONE_LOG(ERROR) << "DomSnapshotRecorder write snapshot failed, path = " << temp_path;
+      return false;
+    }
+  }
+  // 先清空日志再替换基础快照，两步之间中断时得到的是旧快照与空日志，内容较旧但仍然一致
+  if (log_file_.is_open()) {
+    log_file_.close();
+  }
+  log_file_.open(log_path_, std::ios::binary | std::ios::trunc);
+#ifdef _WIN32
+  std::remove(path_.c_str());
+#endif
+  if (std::rename(temp_path.c_str(), path_.c_str()) != 0) {
+    FOOTSTONE_LOG(ERROR) << "DomSnapshotRecorder rename snapshot failed, path = " << path_;
+    has_snapshot_ = false;
+    return false;
+  }
+  has_snapshot_ = true;
+  has_uncommitted_record_ = false;
+  statistics_.record_count = 0;
+  statistics_.log_size = 0;
+  statistics_.snapshot_size = snapshot.size();
+  ++statistics_.compact_count;
+  return true;
+}
+
+bool DomSnapshotRecorder::Restore(const std::shared_ptr<DomManager>& dom_manager,
+                                  const std::shared_ptr<RootNode>& root_node, const std::string& path) {
+  if (!dom_manager) {
+    return false;
+  }
+  auto snapshot = DomSnapshot::Open(path);
+  if (!snapshot) {
+    return false;
+  }
+  std::string log;
+  std::ifstream log_file(path + ".log", std::ios::binary);
+  if (log_file) {
+    log.assign(std::istreambuf_iterator<char>(log_file), std::istreambuf_iterator<char>());
+  }
+  return dom_manager->SetSnapShot(root_node, snapshot, log);
+}
+
+std::shared_ptr<DomInfo> DomSnapshotRecorder::ParseRecord(Op op, const HippyValue& value,
+                                                          const std::shared_ptr<RootNode>& root_node,
+                                                          uint32_t orig_root_id) {
+  if (!value.IsArray()) {
+    return nullptr;
+  }
+  const auto& record = value.ToArrayChecked();
+  size_t expected_size = op == Op::kDelete ? 2 : (op == Op::kMove ? 4 : 9);
+  uint32_t id;
+  uint32_t pid;
+  if (record.size() != expected_size || !record[0].ToUint32(id) || !record[1].ToUint32(pid)) {
+    return nullptr;
+  }
+  if (pid == orig_root_id) {
+    pid = root_node->GetId();
+  }
+  std::shared_ptr<DomNode> node;
+  if (op == Op::kCreate || op == Op::kUpdate) {
+    int32_t index;
+    if (!record[2].ToInt32(index) || !record[3].IsString() || !record[4].IsString() || !record[5].IsObject() ||
+        !record[6].IsObject()) {
+      return nullptr;
+    }
+    node = std::make_shared<DomNode>(id, pid, index, record[3].ToStringChecked(), record[4].ToStringChecked(),
+                                     ToMap(record[5]), ToMap(record[6]), root_node);
+  } else {
+    node = std::make_shared<DomNode>(id, pid, root_node);
+  }
+  std::shared_ptr<RefInfo> ref_info;
+  if (op != Op::kDelete) {
+    uint32_t ref_id;
+    int32_t relative_to_ref;
+    if (!record[record.size() - 2].ToUint32(ref_id) || !record.back().ToInt32(relative_to_ref)) {
+      return nullptr;
+    }
+    if (ref_id != kInvalidId) {
+      ref_info = std::make_shared<RefInfo>(ref_id, relative_to_ref);
+    }
+  }
+  return std::make_shared<DomInfo>(std::move(node), std::move(ref_info), nullptr);
+}
+
+uint32_t DomSnapshotRecorder::ApplyLog(const std::shared_ptr<RootNode>& root_node, const std::string& log,
+                                       uint32_t orig_root_id) {
+  uint32_t applied = 0;
+  size_t offset = 0;
+  // 当前 batch 中已解析的记录，读到提交标记后才应用
+  std::vector<std::pair<Op, std::vector<std::shared_ptr<DomInfo>>>> batch;
+  while (log.size() - offset >= sizeof(RecordHeader)) {
+    RecordHeader header;
+    std::memcpy(&header, log.data() + offset, sizeof(header));
+    offset += sizeof(header);
+    if (header.magic != kRecordMagic || header.size > log.size() - offset) {
+      // 写入到一半的记录
+      break;
+    }
+    if (header.op == Op::kCommit) {
+      for (auto& [op, infos] : batch) {
+        switch (op) {
+          case Op::kCreate:
+            root_node->CreateDomNodes(std::move(infos), false);
+            break;
+          case Op::kUpdate:
+            root_node->UpdateDomNodes(std::move(infos));
+            break;
+          case Op::kMove:
+            root_node->MoveDomNodes(std::move(infos));
+            break;
+          default:
+            root_node->DeleteDomNodes(std::move(infos));
+            break;
+        }
+        ++applied;
+      }
+      batch.clear();
+      continue;
+    }
+    if (header.op != Op::kCreate && header.op != Op::kUpdate && header.op != Op::kMove &&
+        header.op != Op::kDelete) {
+      FOOTSTONE_LOG(ERROR) << "DomSnapshotRecorder unknown op = " << static_cast<uint32_t>(header.op);
+      break;
+    }
+    Deserializer deserializer(reinterpret_cast<const uint8_t*>(log.data() + offset), header.size);
+    offset += header.size;
+    HippyValue value;
+    if (!deserializer.ReadHeader() || !deserializer.ReadValue(value) || !value.IsArray()) {
+      FOOTSTONE_LOG(ERROR) << "DomSnapshotRecorder corrupt record";
+      break;
+    }
+    std::vector<std::shared_ptr<DomInfo>> infos;
+    const auto& records = std::as_const(value).ToArrayChecked();
+    infos.reserve(records.size());
+    for (const auto& record : records) {
+      auto info = ParseRecord(header.op, record, root_node, orig_root_id);
+      if (!info) {
+        // 记录内容损坏，丢弃当前 batch 及之后的全部记录，结果停留在上一个完整的 batch
+        FOOTSTONE_LOG(ERROR) << "DomSnapshotRecorder corrupt record";
+        return applied;
+      }
+      infos.push_back(std::move(info));
+    }
+    batch.emplace_back(header.op, std::move(infos));
+  }
+  return applied;
+}
+
+}  // namespace dom
+}  // namespace hippy
@@ -0,0 +1,406 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "dom/dom_manager.h"
+#include "dom/dom_node.h"
+#include "dom/dom_snapshot.h"
+#include "dom/dom_snapshot_recorder.h"
+#include "dom/node_props.h"
+#include "dom/render_manager.h"
+#include "dom/root_node.h"
+#include "footstone/hippy_value.h"
+#include "footstone/serializer.h"
+
+namespace hippy {
+namespace dom {
+namespace testing {
+
+using HippyValue = footstone::value::HippyValue;
+using HippyValueArrayType = footstone::value::HippyValue::HippyValueArrayType;
+using HippyValueObjectType = footstone::value::HippyValue::HippyValueObjectType;
+
+constexpr uint32_t kRootId = 1;
+constexpr uint32_t kListId = kRootId + 1;
+constexpr uint32_t kCellCount = 500;
+constexpr int kBatchTimes = 100;
+
+class CountingRenderManager : public RenderManager {
+ public:
+  CountingRenderManager() : RenderManager("CountingRenderManager") {}
+
+  void CreateRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&& nodes) override {
+    created_count += nodes.size();
+  }
+  void UpdateRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&&) override {}
+  void MoveRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&&) override {}
+  void DeleteRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&&) override {}
+  void UpdateLayout(std::weak_ptr<RootNode>, const std::vector<std::shared_ptr<DomNode>>& nodes) override {
+    // 布局结果在 AfterLayout 之后才下发
+    EXPECT_FALSE(in_layout);
+    layout_count += nodes.size();
+  }
+  void MoveRenderNode(std::weak_ptr<RootNode>, std::vector<int32_t>&&, int32_t, int32_t, int32_t) override {}
+  void EndBatch(std::weak_ptr<RootNode>) override {}
+  void BeforeLayout(std::weak_ptr<RootNode>) override {
+    EXPECT_FALSE(in_layout);
+    in_layout = true;
+    ++layout_pass_count;
+  }
+  void AfterLayout(std::weak_ptr<RootNode>) override {
+    EXPECT_TRUE(in_layout);
+    in_layout = false;
+  }
+  void AddEventListener(std::weak_ptr<RootNode>, std::weak_ptr<DomNode>, const std::string&) override {}
+  void RemoveEventListener(std::weak_ptr<RootNode>, std::weak_ptr<DomNode>, const std::string&) override {}
+  void CallFunction(std::weak_ptr<RootNode>, std::weak_ptr<DomNode>, const std::string&, const DomArgument&,
+                    uint32_t) override {}
+
+  void Reset() {
+    created_count = 0;
+    layout_count = 0;
+    layout_pass_count = 0;
+  }
+
+  size_t created_count = 0;
+  size_t layout_count = 0;
+  int layout_pass_count = 0;
+  bool in_layout = false;
+};
+
+std::shared_ptr<DomManager> CreateDomManager(const std::shared_ptr<RenderManager>& render_manager) {
+  auto dom_manager = std::make_shared<DomManager>();
+  dom_manager->SetRenderManager(render_manager);
+  return dom_manager;
+}
+
+std::shared_ptr<RootNode> CreateRoot() {
+  auto root_node = std::make_shared<RootNode>(kRootId);
+  root_node->SetRootSize(1080, 1920);
+  return root_node;
+}
+
+// 一个列表页面：列表下 kCellCount 个 cell，每个 cell 包含一张图片与一段文本，样式大多相同
+std::vector<std::shared_ptr<DomInfo>> CreatePageInfos(const std::shared_ptr<RootNode>& root_node) {
+  std::vector<std::shared_ptr<DomInfo>> infos;
+  auto add = [&infos, &root_node](uint32_t id, uint32_t pid, const std::string& view_name,
+                                  std::shared_ptr<DomValueMap> style, std::shared_ptr<DomValueMap> ext) {
+    auto node = std::make_shared<DomNode>(id, pid, 0, view_name, view_name, std::move(style), std::move(ext),
+                                          root_node);
+    infos.push_back(std::make_shared<DomInfo>(node, nullptr, nullptr));
+  };
+  auto list_style = std::make_shared<DomValueMap>();
+  (*list_style)[kFlex] = std::make_shared<HippyValue>(1);
+  add(kListId, kRootId, "ListView", list_style, std::make_shared<DomValueMap>());
+  auto id = kListId;
+  for (uint32_t k = 0; k < kCellCount; ++k) {
+    auto cell_style = std::make_shared<DomValueMap>();
+    (*cell_style)[kHeight] = std::make_shared<HippyValue>(120);
+    (*cell_style)[kFlexDirection] = std::make_shared<HippyValue>("row");
+    (*cell_style)[kBackgroundColor] = std::make_shared<HippyValue>(0xffffffffu);
+    HippyValueObjectType shadow;
+    shadow["x"] = HippyValue(0);
+    shadow["y"] = HippyValue(1.5);
+    (*cell_style)["shadowOffset"] = std::make_shared<HippyValue>(shadow);
+    auto cell_ext = std::make_shared<DomValueMap>();
+    (*cell_ext)["key"] = std::make_shared<HippyValue>("cell-" + std::to_string(k));
+    auto cell_id = ++id;
+    add(cell_id, kListId, "ListViewItem", cell_style, cell_ext);
+
+    auto image_style = std::make_shared<DomValueMap>();
+    (*image_style)[kWidth] = std::make_shared<HippyValue>(100);
+    (*image_style)[kHeight] = std::make_shared<HippyValue>(100);
+    (*image_style)["src"] = std::make_shared<HippyValue>("https://example.com/" + std::to_string(k % 20) + ".png");
+    add(++id, cell_id, "Image", image_style, std::make_shared<DomValueMap>());
+
+    auto text_style = std::make_shared<DomValueMap>();
+    (*text_style)[kFlex] = std::make_shared<HippyValue>(1);
+    (*text_style)[kFontSize] = std::make_shared<HippyValue>(16.0);
+    (*text_style)[kText] = std::make_shared<HippyValue>("item " + std::to_string(k));
+    HippyValueArrayType transform = {HippyValue(1), HippyValue(true), HippyValue::Null()};
+    (*text_style)["transform"] = std::make_shared<HippyValue>(transform);
+    add(++id, cell_id, "Text", text_style, std::make_shared<DomValueMap>());
+  }
+  return infos;
+}
+
+using NodeState = std::tuple<uint32_t, uint32_t, std::string, HippyValueObjectType, HippyValueObjectType, float, float,
+                             float, float>;
+
+std::vector<NodeState> CollectNodes(const std::shared_ptr<RootNode>& root_node) {
+  auto to_object = [](const std::shared_ptr<const DomValueMap>& map) {
+    HippyValueObjectType object;
+    if (map) {
+      for (const auto& [key, value] : *map) {
+        object[key] = *value;
+      }
+    }
+    return object;
+  };
+  std::vector<NodeState> nodes;
+  root_node->Traverse([&nodes, &to_object](const std::shared_ptr<DomNode>& node) {
+    const auto& layout = node->GetRenderLayoutResult();
+    nodes.emplace_back(node->GetId(), node->GetPid(), node->GetViewName(), to_object(node->GetStyleMap()),
+                       to_object(node->GetExtStyle()), layout.left, layout.top, layout.width, layout.height);
+  });
+  return nodes;
+}
+
+std::shared_ptr<RootNode> CreateLaidOutPage(const std::shared_ptr<DomManager>& dom_manager) {
+  auto root_node = CreateRoot();
+  DomManager::CreateDomNodes(root_node, CreatePageInfos(root_node), false);
+  dom_manager->EndBatch(root_node);
+  return root_node;
+}
+
+TEST(DomSnapshotTest, RoundTrip) {
+  auto render_manager = std::make_shared<CountingRenderManager>();
+  auto dom_manager = CreateDomManager(render_manager);
+  auto origin = CreateLaidOutPage(dom_manager);
+  auto expected = CollectNodes(origin);
+
+  auto snapshot = DomSnapshot::FromBuffer(DomSnapshot::Serialize(origin));
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_EQ(snapshot->GetNodeCount(), expected.size());
+  EXPECT_EQ(snapshot->GetHeader().root_width, 1080);
+  // 相同的样式条目只保存一份
+  EXPECT_LT(snapshot->GetStyleCount(), snapshot->GetHeader().style_ref_count / 2);
+  EXPECT_EQ(snapshot->GetString(snapshot->GetNode(1).view_name), "ListView");
+
+  render_manager->Reset();
+  auto restored = CreateRoot();
+  ASSERT_TRUE(dom_manager->SetSnapShot(restored, snapshot));
+  EXPECT_EQ(CollectNodes(restored), expected);
+  // 根节点尺寸不变，直接使用快照中的布局结果，恢复的布局同样经过 BeforeLayout/AfterLayout
+  EXPECT_EQ(render_manager->created_count, expected.size() - 1);
+  EXPECT_EQ(render_manager->layout_pass_count, 1);
+  EXPECT_GT(render_manager->layout_count, 0u);
+
+  // 后续 batch 正常布局，结果与快照一致
+  dom_manager->EndBatch(restored);
+  EXPECT_EQ(render_manager->layout_pass_count, 2);
+  EXPECT_EQ(CollectNodes(restored), expected);
+
+  // 根节点尺寸变化时丢弃快照中的布局结果
+  render_manager->Reset();
+  auto resized = std::make_shared<RootNode>(kRootId);
+  resized->SetRootSize(720, 1280);
+  ASSERT_TRUE(dom_manager->SetSnapShot(resized, snapshot));
+  EXPECT_EQ(render_manager->layout_pass_count, 1);
+}
+
+TEST(DomSnapshotTest, RejectInvalidSnapshot) {
+  auto render_manager = std::make_shared<CountingRenderManager>();
+  auto origin = CreateLaidOutPage(CreateDomManager(render_manager));
+  auto buffer = DomSnapshot::Serialize(origin);
+  ASSERT_NE(DomSnapshot::FromBuffer(buffer), nullptr);
+
+  EXPECT_EQ(DomSnapshot::FromBuffer(buffer.substr(0, buffer.size() - 4)), nullptr);
+  EXPECT_EQ(DomSnapshot::FromBuffer(std::string(8, '\0')), nullptr);
+  auto bad_magic = buffer;
+  bad_magic[0] ^= 0xff;
+  EXPECT_EQ(DomSnapshot::FromBuffer(bad_magic), nullptr);
+  // 第一个节点的 view_name 指向不存在的字符串
+  auto bad_string = buffer;
+  uint32_t invalid_index = 0xffffffff;
+  std::memcpy(&bad_string[sizeof(DomSnapshot::Header) + offsetof(DomSnapshot::NodeRecord, view_name)],
+              &invalid_index, sizeof(invalid_index));
+  EXPECT_EQ(DomSnapshot::FromBuffer(bad_string), nullptr);
+  EXPECT_EQ(DomSnapshot::Open(::testing::TempDir() + "not_exist.snapshot"), nullptr);
+}
+
+TEST(DomSnapshotTest, WarmStart) {
+  auto render_manager = std::make_shared<CountingRenderManager>();
+  auto dom_manager = CreateDomManager(render_manager);
+  auto origin = CreateLaidOutPage(dom_manager);
+  auto expected = CollectNodes(origin);
+  auto legacy_snapshot = DomManager::GetSnapShot(origin);
+  auto binary_snapshot = DomSnapshot::Serialize(origin);
+  auto path = ::testing::TempDir() + "dom_snapshot_unittests.snapshot";
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(binary_snapshot.data(), static_cast<std::streamsize>(binary_snapshot.size()));
+  }
+
+  // HippyValue 快照，整体反序列化后重新布局
+  auto root_node = CreateRoot();
+  EXPECT_TRUE(dom_manager->SetSnapShot(root_node, legacy_snapshot));
+  EXPECT_EQ(CollectNodes(root_node), expected);
+  // 二进制快照，打开内存中的快照
+  root_node = CreateRoot();
+  EXPECT_TRUE(dom_manager->SetSnapShot(root_node, DomSnapshot::FromBuffer(binary_snapshot)));
+  EXPECT_EQ(CollectNodes(root_node), expected);
+  // 二进制快照，mmap 快照文件
+  root_node = CreateRoot();
+  EXPECT_TRUE(dom_manager->SetSnapShot(root_node, DomSnapshot::Open(path)));
+  EXPECT_EQ(CollectNodes(root_node), expected);
+  std::remove(path.c_str());
+}
+
+// 第 k 个 cell 中文本节点的更新
+std::shared_ptr<DomInfo> CreateTextUpdate(const std::shared_ptr<RootNode>& root_node, uint32_t k,
+                                          const std::string& text) {
+  auto cell_id = kListId + 1 + k * 3;
+  auto style = std::make_shared<DomValueMap>();
+  (*style)[kFlex] = std::make_shared<HippyValue>(1);
+  (*style)[kFontSize] = std::make_shared<HippyValue>(16.0);
+  (*style)[kText] = std::make_shared<HippyValue>(text);
+  auto node = std::make_shared<DomNode>(cell_id + 2, cell_id, 1, "Text", "Text", style,
+                                        std::make_shared<DomValueMap>(), root_node);
+  return std::make_shared<DomInfo>(node, nullptr, nullptr);
+}
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void RemoveSnapshotFiles(const std::string& path) {
+  std::remove(path.c_str());
+  std::remove((path + ".log").c_str());
+}
+
+TEST(DomSnapshotTest, IncrementalRecord) {
+  auto render_manager = std::make_shared<CountingRenderManager>();
+  auto dom_manager = CreateDomManager(render_manager);
+  auto path = ::testing::TempDir() + "dom_snapshot_recorder_unittests.snapshot";
+  RemoveSnapshotFiles(path);
+  auto origin = CreateRoot();
+  auto recorder = std::make_shared<DomSnapshotRecorder>(origin, path);
+  origin->AddInterceptor(recorder);
+
+  // 首个 batch 结束时写入基础快照
+  DomManager::CreateDomNodes(origin, CreatePageInfos(origin), false);
+  dom_manager->EndBatch(origin);
+  EXPECT_EQ(recorder->GetStatistics().compact_count, 1u);
+  EXPECT_EQ(recorder->GetStatistics().log_size, 0u);
+  EXPECT_EQ(ReadFile(path).size(), recorder->GetStatistics().snapshot_size);
+  auto snapshot_nodes = CollectNodes(origin);
+
+  // 之后的 batch 只追加增量
+  auto new_cell_id = kListId + kCellCount * 3 + 1;
+  auto new_cell = std::make_shared<DomNode>(new_cell_id, kListId, 0, "ListViewItem", "ListViewItem",
+                                            std::make_shared<DomValueMap>(), std::make_shared<DomValueMap>(), origin);
+  new_cell->EmplaceStyleMap(kHeight, HippyValue(60));
+  DomManager::CreateDomNodes(
+      origin, {std::make_shared<DomInfo>(new_cell, std::make_shared<RefInfo>(kListId + 1, 0), nullptr)}, false);
+  DomManager::UpdateDomNodes(origin, {CreateTextUpdate(origin, 1, "updated 1"), CreateTextUpdate(origin, 2, "")});
+  auto moved = std::make_shared<DomNode>(kListId + 1 + 3 * 3, kListId, origin);
+  DomManager::MoveDomNodes(origin, {std::make_shared<DomInfo>(moved, std::make_shared<RefInfo>(kListId + 1, 1),
+                                                              nullptr)});
+  auto deleted = std::make_shared<DomNode>(kListId + 1 + 4 * 3, kListId, origin);
+  DomManager::DeleteDomNodes(origin, {std::make_shared<DomInfo>(deleted, nullptr, nullptr)});
+  dom_manager->EndBatch(origin);
+  auto statistics = recorder->GetStatistics();
+  EXPECT_EQ(statistics.compact_count, 1u);
+  EXPECT_EQ(statistics.record_count, 4u);
+  EXPECT_GT(statistics.log_size, 0u);
+  EXPECT_LT(statistics.log_size, statistics.snapshot_size / 100);
+
+  auto expected = CollectNodes(origin);
+  auto restore = [&dom_manager, &path] {
+    auto root_node = CreateRoot();
+    EXPECT_TRUE(DomSnapshotRecorder::Restore(dom_manager, root_node, path));
+    return CollectNodes(root_node);
+  };
+  EXPECT_EQ(restore(), expected);
+
+  // 末尾写入到一半的记录被忽略
+  auto committed_log = ReadFile(path + ".log");
+  auto write_log = [&path](const std::string& content) {
+    std::ofstream log(path + ".log", std::ios::binary | std::ios::trunc);
+    log.write(content.data(), static_cast<std::streamsize>(content.size()));
+  };
+  write_log(committed_log + "HDSD");
+  EXPECT_EQ(restore(), expected);
+
+  // 缺少提交标记的 batch 整体被忽略（记录头为 magic、op、size 三个 uint32_t）
+  constexpr size_t kRecordHeaderSize = 3 * sizeof(uint32_t);
+  write_log(committed_log.substr(0, committed_log.size() - kRecordHeaderSize));
+  EXPECT_EQ(restore(), snapshot_nodes);
+
+  // 类型错误的记录不会导致崩溃，停留在上一个完整的 batch
+  {
+    footstone::value::Serializer serializer;
+    serializer.WriteHeader();
+    serializer.WriteValue(HippyValue(HippyValueArrayType{
+        HippyValue(HippyValueArrayType{HippyValue(kListId), HippyValue(kRootId), HippyValue(0), HippyValue(1),
+                                       HippyValue(2), HippyValue(3), HippyValue(4), HippyValue(kInvalidId),
+                                       HippyValue(0)})}));
+    auto [buffer, size] = serializer.GetBuffer();
+    uint32_t create_header[] = {0x44534448, 0, static_cast<uint32_t>(size)};
+    uint32_t commit_header[] = {0x44534448, 4, 0};
+    std::string corrupt_log = committed_log;
+    corrupt_log.append(reinterpret_cast<const char*>(create_header), sizeof(create_header));
+    corrupt_log.append(reinterpret_cast<const char*>(buffer), size);
+    corrupt_log.append(reinterpret_cast<const char*>(commit_header), sizeof(commit_header));
+    write_log(corrupt_log);
+  }
+  EXPECT_EQ(restore(), expected);
+
+  // 合并后日志清空，基础快照包含全部变化
+  DomManager::UpdateDomNodes(origin, {CreateTextUpdate(origin, 5, "updated 5")});
+  dom_manager->EndBatch(origin);
+  ASSERT_TRUE(recorder->Compact());
+  EXPECT_EQ(recorder->GetStatistics().compact_count, 2u);
+  EXPECT_EQ(ReadFile(path + ".log").size(), 0u);
+  EXPECT_EQ(restore(), CollectNodes(origin));
+  RemoveSnapshotFiles(path);
+}
+
+TEST(DomSnapshotTest, IncrementalRecordManyBatches) {
+  auto render_manager = std::make_shared<CountingRenderManager>();
+  auto dom_manager = CreateDomManager(render_manager);
+  auto path = ::testing::TempDir() + "dom_snapshot_recorder_batches.snapshot";
+  RemoveSnapshotFiles(path);
+  auto root_node = CreateLaidOutPage(dom_manager);
+  auto recorder = std::make_shared<DomSnapshotRecorder>(root_node, path);
+  root_node->AddInterceptor(recorder);
+  ASSERT_TRUE(recorder->Compact());
+
+  // 每个 batch 更新一个文本节点
+  for (int i = 0; i < kBatchTimes; ++i) {
+    DomManager::UpdateDomNodes(root_node, {CreateTextUpdate(root_node, i % kCellCount, std::to_string(i))});
+    dom_manager->EndBatch(root_node);
+  }
+  auto statistics = recorder->GetStatistics();
+  EXPECT_EQ(statistics.compact_count, 1u);
+  EXPECT_EQ(statistics.record_count, static_cast<uint32_t>(kBatchTimes));
+
+  auto restored = CreateRoot();
+  ASSERT_TRUE(DomSnapshotRecorder::Restore(dom_manager, restored, path));
+  EXPECT_EQ(CollectNodes(restored), CollectNodes(root_node));
+  RemoveSnapshotFiles(path);
+}
+
+}  // namespace testing
+}  // namespace dom
+}  // namespace hippy
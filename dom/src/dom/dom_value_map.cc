@@ -0,0 +1,153 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dom/dom_value_map.h"
+
+#include <algorithm>
+
+#include "footstone/check.h"
+
+namespace hippy {
+inline namespace dom {
+
+DomValueMap::DomValueMap(std::initializer_list<value_type> entries) {
+  reserve(entries.size());
+  insert(entries.begin(), entries.end());
+}
+
+void DomValueMap::reserve(size_type count) {
+  entries_.reserve(count);
+  atoms_.reserve(count);
+}
+
+void DomValueMap::clear() {
+  entries_.clear();
+  atoms_.clear();
+}
+
+DomValueMap::size_type DomValueMap::IndexOf(StyleAtom atom, std::string_view key) const {
+  auto size = atoms_.size();
+  if (atom != StyleAtom::kUnknown) {
+    return static_cast<size_type>(std::find(atoms_.begin(), atoms_.end(), atom) - atoms_.begin());
+  }
+  for (size_type i = 0; i < size; ++i) {
+    if (atoms_[i] == StyleAtom::kUnknown && entries_[i].first == key) {
+      return i;
+    }
+  }
+  return size;
+}
+
+DomValueMap::iterator DomValueMap::find(std::string_view key) {
+  return entries_.begin() + static_cast<std::ptrdiff_t>(IndexOf(StyleAtomTable::GetAtom(key), key));
+}
+
+DomValueMap::const_iterator DomValueMap::find(std::string_view key) const {
+  return entries_.begin() + static_cast<std::ptrdiff_t>(IndexOf(StyleAtomTable::GetAtom(key), key));
+}
+
+DomValueMap::iterator DomValueMap::find(StyleAtom atom) {
+  FOOTSTONE_DCHECK(atom != StyleAtom::kUnknown);
+  return entries_.begin() + static_cast<std::ptrdiff_t>(IndexOf(atom, {}));
+}
+
+DomValueMap::const_iterator DomValueMap::find(StyleAtom atom) const {
+  FOOTSTONE_DCHECK(atom != StyleAtom::kUnknown);
+  return entries_.begin() + static_cast<std::ptrdiff_t>(IndexOf(atom, {}));
+}
+
+DomValueMap::const_iterator DomValueMap::find(StyleAtom atom, std::string_view key) const {
+  return entries_.begin() + static_cast<std::ptrdiff_t>(IndexOf(atom, key));
+}
+
+DomValueMap::mapped_type& DomValueMap::at(std::string_view key) {
+  auto it = find(key);
+  FOOTSTONE_CHECK(it != entries_.end()) << "DomValueMap key not found: " << key;
+  return it->second;
+}
+
+const DomValueMap::mapped_type& DomValueMap::at(std::string_view key) const {
+  auto it = find(key);
+  FOOTSTONE_CHECK(it != entries_.end()) << "DomValueMap key not found: " << key;
+  return it->second;
+}
+
+DomValueMap::iterator DomValueMap::Append(StyleAtom atom, value_type&& entry) {
+  entries_.push_back(std::move(entry));
+  atoms_.push_back(atom);
+  return entries_.end() - 1;
+}
+
+DomValueMap::mapped_type& DomValueMap::operator[](const std::string& key) {
+  auto atom = StyleAtomTable::GetAtom(key);
+  auto index = IndexOf(atom, key);
+  if (index < entries_.size()) {
+    return entries_[index].second;
+  }
+  return Append(atom, value_type(key, nullptr))->second;
+}
+
+DomValueMap::mapped_type& DomValueMap::operator[](std::string&& key) {
+  auto atom = StyleAtomTable::GetAtom(key);
+  auto index = IndexOf(atom, key);
+  if (index < entries_.size()) {
+    return entries_[index].second;
+  }
+  return Append(atom, value_type(std::move(key), nullptr))->second;
+}
+
+std::pair<DomValueMap::iterator, bool> DomValueMap::insert(const value_type& entry) {
+  return insert(value_type(entry));
+}
+
+std::pair<DomValueMap::iterator, bool> DomValueMap::insert(value_type&& entry) {
+  auto atom = StyleAtomTable::GetAtom(entry.first);
+  auto index = IndexOf(atom, entry.first);
+  if (index < entries_.size()) {
+    return {entries_.begin() + static_cast<std::ptrdiff_t>(index), false};
+  }
+  return {Append(atom, std::move(entry)), true};
+}
+
+std::pair<DomValueMap::iterator, bool> DomValueMap::insert_or_assign(const std::string& key, mapped_type value) {
+  auto result = insert(value_type(key, value));
+  if (!result.second) {
+    result.first->second = std::move(value);
+  }
+  return result;
+}
+
+DomValueMap::iterator DomValueMap::erase(const_iterator pos) {
+  auto offset = pos - entries_.cbegin();
+  atoms_.erase(atoms_.begin() + offset);
+  return entries_.erase(pos);
+}
+
+DomValueMap::size_type DomValueMap::erase(std::string_view key) {
+  auto it = find(key);
+  if (it == entries_.end()) {
+    return 0;
+  }
+  erase(it);
+  return 1;
+}
+
+}  // namespace dom
+}  // namespace hippy
@@ -0,0 +1,91 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+
+#include "dom/dom_value_map.h"
+#include "dom/style_atom.h"
+#include "footstone/hippy_value.h"
+
+namespace hippy {
+namespace dom {
+namespace testing {
+
+using HippyValue = footstone::value::HippyValue;
+
+TEST(DomValueMapTest, FindByStringAndAtom) {
+  DomValueMap map{{"width", std::make_shared<HippyValue>(10)},
+                  {"customProp", std::make_shared<HippyValue>("value")}};
+  EXPECT_EQ(map.size(), 2);
+
+  auto it = map.find("width");
+  ASSERT_NE(it, map.end());
+  EXPECT_EQ(map.GetAtom(it), StyleAtom::kWidth);
+  EXPECT_EQ(map.find(StyleAtom::kWidth), it);
+  EXPECT_EQ(map.find(StyleAtom::kHeight), map.end());
+
+  auto custom = map.find("customProp");
+  ASSERT_NE(custom, map.end());
+  EXPECT_EQ(map.GetAtom(custom), StyleAtom::kUnknown);
+  EXPECT_EQ(map.find(StyleAtom::kUnknown, "customProp"), custom);
+  EXPECT_EQ(map.find("otherProp"), map.end());
+  EXPECT_EQ(map.count("otherProp"), 0);
+}
+
+TEST(DomValueMapTest, InsertKeepsFirstValue) {
+  DomValueMap map;
+  auto result = map.insert({"opacity", std::make_shared<HippyValue>(1)});
+  EXPECT_TRUE(result.second);
+  result = map.insert({"opacity", std::make_shared<HippyValue>(0.5)});
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(*map.at("opacity"), HippyValue(1));
+
+  map.insert_or_assign("opacity", std::make_shared<HippyValue>(0.5));
+  EXPECT_EQ(map.size(), 1);
+  EXPECT_EQ(*map.at("opacity"), HippyValue(0.5));
+
+  map["color"] = std::make_shared<HippyValue>(0xff000000);
+  map["customProp"] = std::make_shared<HippyValue>(true);
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_EQ(map.begin()->first, "opacity");
+}
+
+TEST(DomValueMapTest, EraseKeepsAtomsInSync) {
+  DomValueMap map{{"width", std::make_shared<HippyValue>(10)},
+                  {"customProp", std::make_shared<HippyValue>("value")},
+                  {"height", std::make_shared<HippyValue>(20)}};
+  EXPECT_EQ(map.erase("customProp"), 1);
+  EXPECT_EQ(map.erase("customProp"), 0);
+  EXPECT_EQ(map.size(), 2);
+
+  auto it = map.find("height");
+  ASSERT_NE(it, map.end());
+  EXPECT_EQ(map.GetAtom(it), StyleAtom::kHeight);
+  it = map.erase(map.find(StyleAtom::kWidth));
+  EXPECT_EQ(map.GetAtom(it), StyleAtom::kHeight);
+  EXPECT_EQ(map.size(), 1);
+}
+
+}  // namespace testing
+}  // namespace dom
+}  // namespace hippy
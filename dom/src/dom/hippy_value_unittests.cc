@@ -22,6 +22,7 @@
 
 #include <cstdlib>
 #include <random>
+#include <utility>
 
 #include "footstone/logging.h"
 #include "footstone/hippy_value.h"
@@ -158,7 +159,7 @@ TEST(DomValueTest, Double) {
 
   std::random_device random_device;
   std::mt19937 mt19937(random_device());
-  std::uniform_int_distribution<double> distribution(0, std::numeric_limits<double>::max());
+  std::uniform_real_distribution<double> distribution(0, std::numeric_limits<double>::max());
   for (int i = 0; i < 300; i++) {
     double r = distribution(mt19937);
     d = HippyValue(r);
@@ -256,6 +257,109 @@ TEST(DomValueTest, kArray) {
   EXPECT_EQ(hippy_value.ToArrayChecked().size() == 8, true) << "Array Value size() is not equal to 8.";
 }
 
+TEST(DomValueTest, CopyOnWrite) {
+  HippyValueObjectType object_type;
+  object_type["color"] = HippyValue("red");
+  object_type["text"] = HippyValue("a string longer than the inline capacity");
+  HippyValue object(object_type);
+  HippyValue object_copy = object;
+  EXPECT_EQ(object_copy, object);
+  object_copy.ToObjectChecked()["color"] = HippyValue("blue");
+  EXPECT_EQ(object.ToObjectChecked().at("color").ToStringChecked(), "red");
+  EXPECT_EQ(object_copy.ToObjectChecked().at("color").ToStringChecked(), "blue");
+
+  HippyValue array(HippyValueArrayType{object, HippyValue(1)});
+  HippyValue array_copy = array;
+  array_copy.ToArrayChecked().push_back(HippyValue(2));
+  EXPECT_EQ(array.ToArrayChecked().size(), 2);
+  EXPECT_EQ(array_copy.ToArrayChecked().size(), 3);
+
+  HippyValue long_string = object.ToObjectChecked().at("text");
+  HippyValue long_string_copy = long_string;
+  long_string_copy.ToStringChecked().append("!");
+  EXPECT_EQ(long_string.ToStringChecked(), "a string longer than the inline capacity");
+  EXPECT_NE(long_string, long_string_copy);
+
+  // 赋值为自身的子元素
+  array = array.ToArrayChecked()[0];
+  EXPECT_EQ(array, object);
+}
+
+TEST(DomValueTest, CopyAfterMutableReference) {
+  HippyValue object(HippyValueObjectType{{"color", HippyValue("red")}});
+  auto& object_ref = object.ToObjectChecked();
+  HippyValue object_copy = object;
+  object_ref["color"] = HippyValue("blue");
+  EXPECT_EQ(object.ToObjectChecked().at("color").ToStringChecked(), "blue");
+  EXPECT_EQ(object_copy.ToObjectChecked().at("color").ToStringChecked(), "red");
+
+  HippyValue array(HippyValueArrayType{HippyValue(1)});
+  auto& array_ref = array.ToArrayChecked();
+  HippyValue array_copy(array);
+  array_ref.push_back(HippyValue(2));
+  EXPECT_EQ(array.ToArrayChecked().size(), 2);
+  EXPECT_EQ(array_copy.ToArrayChecked().size(), 1);
+
+  HippyValue long_string("a string longer than the inline capacity");
+  auto& string_ref = long_string.ToStringChecked();
+  HippyValue long_string_copy = long_string;
+  string_ref.append("!");
+  EXPECT_EQ(long_string_copy.ToStringChecked(), "a string longer than the inline capacity");
+
+  // 只通过 const 接口读取的负载仍然共享
+  const HippyValue shared(HippyValueObjectType{{"color", HippyValue("red")}});
+  EXPECT_EQ(shared.ToObjectChecked().size(), 1);
+  HippyValue shared_copy = shared;
+  EXPECT_EQ(&std::as_const(shared_copy).ToObjectChecked(), &shared.ToObjectChecked());
+}
+
+TEST(DomValueTest, AliasedStringAssignment) {
+  const std::string long_text = "a string longer than the inline capacity";
+  HippyValue long_string(long_text);
+  long_string = long_string.ToStringChecked();
+  EXPECT_EQ(long_string.ToStringChecked(), long_text);
+  long_string = long_string.ToStringChecked().c_str();
+  EXPECT_EQ(long_string.ToStringChecked(), long_text);
+
+  HippyValue short_string("short");
+  short_string = short_string.ToStringChecked();
+  EXPECT_EQ(short_string.ToStringChecked(), "short");
+  short_string = short_string.ToStringChecked().c_str();
+  EXPECT_EQ(short_string.ToStringChecked(), "short");
+
+  // 赋值为自身子元素中的字符串
+  HippyValue object(HippyValueObjectType{{"text", HippyValue(long_text)}});
+  object = object.ToObjectChecked().at("text").ToStringChecked();
+  EXPECT_EQ(object.ToStringChecked(), long_text);
+}
+
+TEST(DomValueTest, CopyEqualAndHash) {
+  HippyValueObjectType style;
+  style["width"] = HippyValue(100);
+  style["height"] = HippyValue(10.5);
+  style["color"] = HippyValue(static_cast<uint32_t>(0xff000000));
+  style["display"] = HippyValue("flex");
+  style["text"] = HippyValue("hippy text content for benchmark");
+  HippyValueArrayType transform;
+  for (int i = 0; i < 4; ++i) {
+    HippyValueObjectType translate;
+    translate["translateX"] = HippyValue(i);
+    transform.push_back(HippyValue(translate));
+  }
+  style["transform"] = HippyValue(transform);
+  HippyValue value(style);
+
+  const HippyValue copy = value;
+  EXPECT_EQ(copy.ToObjectChecked().size(), style.size());
+  EXPECT_EQ(copy, value);
+  HippyValue other(style);
+  EXPECT_EQ(value, other);
+  EXPECT_EQ(std::hash<HippyValue>{}(value), std::hash<HippyValue>{}(other));
+
+  style["display"] = HippyValue("none");
+  EXPECT_NE(HippyValue(style), value);
+}
+
 }  // namespace testing
 }  // namespace dom
 }  // namespace hippy
@@ -22,9 +22,12 @@
 
 #include "dom/layer_optimized_render_manager.h"
 
+#include <algorithm>
 #include <unordered_set>
 
 #include "dom/node_props.h"
+#include "dom/root_node.h"
+#include "dom/style_atom.h"
 
 namespace hippy {
 inline namespace dom {
@@ -156,6 +159,22 @@ void LayerOptimizedRenderManager::EndBatch(std::weak_ptr<RootNode> root_node) {
   render_manager_->EndBatch(root_node);
 }
 
+bool LayerOptimizedRenderManager::UpdateAnimationProps(std::weak_ptr<RootNode> root_node,
+                                                       const std::vector<AnimationPropsUpdate>& updates) {
+  auto root = root_node.lock();
+  if (!root) {
+    return false;
+  }
+  // 被优化掉的节点没有对应的渲染节点，属性变化后可能需要创建，由 UpdateRenderNode 处理
+  for (const auto& update : updates) {
+    auto node = root->GetNode(update.id);
+    if (!node || node->IsEnableEliminated()) {
+      return false;
+    }
+  }
+  return render_manager_->UpdateAnimationProps(root_node, updates);
+}
+
 void LayerOptimizedRenderManager::BeforeLayout(std::weak_ptr<RootNode> root_node) {
   render_manager_->BeforeLayout(root_node);
 }
@@ -191,89 +210,78 @@ bool LayerOptimizedRenderManager::ComputeLayoutOnly(const std::shared_ptr<DomNod
 
 bool LayerOptimizedRenderManager::CheckStyleJustLayout(const std::shared_ptr<DomNode>& node) const {
   const auto &style_map = node->GetStyleMap();
-  for (const auto &entry : *style_map) {
-    const auto &key = entry.first;
-    const auto &value = entry.second;
+  for (auto it = style_map->begin(); it != style_map->end(); ++it) {
+    const auto &key = it->first;
+    const auto &value = it->second;
 
     if (IsJustLayoutProp(key.c_str())) {
       continue;
     }
 
-    if (key == kOpacity) {
-      if (value->IsNull() || (value->IsNumber() && value->ToDoubleChecked() == 1)) {
-        continue;
-      }
-    } else if (key == kBorderRadius) {
-      const auto &background_color = style_map->find(kBackgroundColor);
-      if (background_color != style_map->end() &&
-          (*background_color).second->IsNumber() &&
-          (*background_color).second->ToDoubleChecked() != 0) {
-        return false;
-      }
-      const auto &border_width = style_map->find(kBorderWidth);
-      if (border_width != style_map->end() &&
-          (*border_width).second->IsNumber() &&
-          (*border_width).second->ToDoubleChecked() != 0) {
-        return false;
-      }
-    } else if (key == kBorderLeftColor) {
-      if (value->IsNumber() && value->ToDoubleChecked() == 0) {
-        continue;
-      }
-    } else if (key == kBorderRightColor) {
-      if (value->IsNumber() && value->ToDoubleChecked() == 0) {
-        continue;
-      }
-    } else if (key == kBorderTopColor) {
-      if (value->IsNumber() && value->ToDoubleChecked() == 0) {
-        continue;
-      }
-    } else if (key == kBorderBottomColor) {
-      if (value->IsNumber() && value->ToDoubleChecked() == 0) {
-        continue;
-      }
-    } else if (key == kBorderWidth) {
-      if (value->IsNull() || (value->IsNumber() && value->ToDoubleChecked() == 0)) {
-        continue;
-      }
-    } else if (key == kBorderLeftWidth) {
-      if (value->IsNull() || (value->IsNumber() && value->ToDoubleChecked() == 0)) {
-        continue;
-      }
-    } else if (key == kBorderTopWidth) {
-      if (value->IsNull() || (value->IsNumber() && value->ToDoubleChecked() == 0)) {
-        continue;
-      }
-    } else if (key == kBorderRightWidth) {
-      if (value->IsNull() || (value->IsNumber() && value->ToDoubleChecked() == 0)) {
-        continue;
-      }
-    } else if (key == kBorderBottomWidth) {
-      if (value->IsNull() || (value->IsNumber() && value->ToDoubleChecked() == 0)) {
-        continue;
+    switch (style_map->GetAtom(it)) {
+      case StyleAtom::kOpacity:
+        if (value->IsNull() || (value->IsNumber() && value->ToDoubleChecked() == 1)) {
+          continue;
+        }
+        break;
+      case StyleAtom::kBorderRadius: {
+        const auto &background_color = style_map->find(StyleAtom::kBackgroundColor);
+        if (background_color != style_map->end() &&
+            (*background_color).second->IsNumber() &&
+            (*background_color).second->ToDoubleChecked() != 0) {
+          return false;
+        }
+        const auto &border_width = style_map->find(StyleAtom::kBorderWidth);
+        if (border_width != style_map->end() &&
+            (*border_width).second->IsNumber() &&
+            (*border_width).second->ToDoubleChecked() != 0) {
+          return false;
+        }
+        break;
       }
+      case StyleAtom::kBorderLeftColor:
+      case StyleAtom::kBorderRightColor:
+      case StyleAtom::kBorderTopColor:
+      case StyleAtom::kBorderBottomColor:
+        if (value->IsNumber() && value->ToDoubleChecked() == 0) {
+          continue;
+        }
+        break;
+      case StyleAtom::kBorderWidth:
+      case StyleAtom::kBorderLeftWidth:
+      case StyleAtom::kBorderTopWidth:
+      case StyleAtom::kBorderRightWidth:
+      case StyleAtom::kBorderBottomWidth:
+        if (value->IsNull() || (value->IsNumber() && value->ToDoubleChecked() == 0)) {
+          continue;
+        }
+        break;
+      default:
+        break;
     }
     return false;
   }
   return true;
 }
 
-static constexpr std::array<const char*, 31> kJustLayoutProps = {
-        kAilgnSelf, kAlignItems, kFlex, kFlexDirection, kFlexWrap, kJustifyContent,
+static constexpr std::array<StyleAtom, 31> kJustLayoutProps = {
+        StyleAtom::kAlignSelf, StyleAtom::kAlignItems, StyleAtom::kFlex, StyleAtom::kFlexDirection,
+        StyleAtom::kFlexWrap, StyleAtom::kJustifyContent,
         // position
-        kPosition, kRight, kTop, kBottom, kLeft,
+        StyleAtom::kPosition, StyleAtom::kRight, StyleAtom::kTop, StyleAtom::kBottom, StyleAtom::kLeft,
         // dimensions
-        kWidth, kHeight, kMinWidth, kMaxWidth, kMinHeight, kMaxHeight,
+        StyleAtom::kWidth, StyleAtom::kHeight, StyleAtom::kMinWidth, StyleAtom::kMaxWidth,
+        StyleAtom::kMinHeight, StyleAtom::kMaxHeight,
         // margins
-        kMargin, kMarginVertical, kMarginHorizontal,
-        kMarginLeft, kMarginRight, kMarginTop, kMarginBottom,
+        StyleAtom::kMargin, StyleAtom::kMarginVertical, StyleAtom::kMarginHorizontal,
+        StyleAtom::kMarginLeft, StyleAtom::kMarginRight, StyleAtom::kMarginTop, StyleAtom::kMarginBottom,
         // paddings
-        kPadding, kPaddingVertical, kPaddingHorizontal,
-        kPaddingLeft, kPaddingRight, kPaddingTop, kPaddingBottom};
+        StyleAtom::kPadding, StyleAtom::kPaddingVertical, StyleAtom::kPaddingHorizontal,
+        StyleAtom::kPaddingLeft, StyleAtom::kPaddingRight, StyleAtom::kPaddingTop, StyleAtom::kPaddingBottom};
 
 bool LayerOptimizedRenderManager::IsJustLayoutProp(const char *prop_name) const {
-  return std::any_of(kJustLayoutProps.begin(), kJustLayoutProps.end(),
-                     [prop_name](const char *prop) { return strcmp(prop, prop_name) == 0; });
+  auto atom = StyleAtomTable::GetAtom(prop_name);
+  return std::find(kJustLayoutProps.begin(), kJustLayoutProps.end(), atom) != kJustLayoutProps.end();
 }
 
 bool LayerOptimizedRenderManager::CanBeEliminated(const std::shared_ptr<DomNode>& node) {
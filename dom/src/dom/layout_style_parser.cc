@@ -0,0 +1,62 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dom/layout_style_parser.h"
+
+#include "footstone/logging.h"
+
+namespace hippy {
+inline namespace dom {
+
+LayoutStyleParser::LayoutStyleParser(const DomValueMap& style_update,
+                                     const std::vector<std::string>& style_delete) {
+  LayoutStyle style;
+  for (auto it = style_update.begin(); it != style_update.end(); ++it) {
+    style = style_update.GetAtom(it);
+    if (!StyleAtomTable::IsLayoutStyle(style)) continue;
+    const auto& value = it->second;
+    FOOTSTONE_DCHECK(value != nullptr);
+    if (value == nullptr) continue;
+    auto index = static_cast<size_t>(style);
+    values_[index] = value.get();
+    updated_.set(index);
+  }
+  for (const auto& key : style_delete) {
+    if (GetLayoutStyle(key, style)) deleted_.set(static_cast<size_t>(style));
+  }
+}
+
+float LayoutStyleParser::GetDeletedEdgeDefault(LayoutStyle all_style) const {
+  auto index = static_cast<size_t>(all_style);
+  if (updated_.test(index) && values_[index]->IsNumber()) {
+    return static_cast<float>(values_[index]->ToDoubleChecked());
+  }
+  return 0;
+}
+
+bool LayoutStyleParser::GetLayoutStyle(const std::string& key, LayoutStyle& style) {
+  auto atom = StyleAtomTable::GetAtom(key);
+  if (!StyleAtomTable::IsLayoutStyle(atom)) return false;
+  style = atom;
+  return true;
+}
+
+}  // namespace dom
+}  // namespace hippy
@@ -0,0 +1,239 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dom/measure_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stack>
+#include <utility>
+
+#include "dom/diff_utils.h"
+#include "dom/dom_node.h"
+#include "footstone/hash.h"
+#include "footstone/logging.h"
+
+namespace hippy {
+inline namespace dom {
+
+// 对单个条目的 hash 做一次混合（splitmix64 的 finalizer），避免直接求和时不同条目的 hash 相互抵消
+static size_t MixEntryHash(size_t hash) {
+  uint64_t x = hash;
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return static_cast<size_t>(x);
+}
+
+// 属性 map 为无序容器，相同内容的迭代顺序可能不同，这里对混合后的条目 hash 求和，与顺序无关
+static size_t HashValueObject(const DomValueObject& object) {
+  size_t seed = object.size();
+  for (const auto& [key, value] : object) {
+    size_t entry = std::hash<std::string>{}(key);
+    std::hash_combine(entry, value);
+    seed += MixEntryHash(entry);
+  }
+  return seed;
+}
+
+static void CopyValueMap(const std::shared_ptr<const DomValueMap>& map, DomValueObject& object) {
+  if (!map) {
+    return;
+  }
+  object.reserve(map->size());
+  for (const auto& [key, value] : *map) {
+    if (value) {
+      object.emplace(key, *value);
+    }
+  }
+}
+
+MeasureCache::MeasureCache(uint32_t capacity) : capacity_(capacity) {
+  FOOTSTONE_DCHECK(capacity_ > 0);
+}
+
+size_t MeasureCache::KeyHash::operator()(const Key& key) const {
+  size_t seed = key.content->hash;
+  std::hash_combine(seed, key.width);
+  std::hash_combine(seed, static_cast<int>(key.width_measure_mode));
+  std::hash_combine(seed, key.height);
+  std::hash_combine(seed, static_cast<int>(key.height_measure_mode));
+  return seed;
+}
+
+MeasureFunction MeasureCache::Wrap(const std::shared_ptr<DomNode>& node, MeasureFunction measure) {
+  std::weak_ptr<MeasureCache> weak_cache = weak_from_this();
+  std::weak_ptr<DomNode> weak_node = node;
+  return [weak_cache, weak_node, measure = std::move(measure)](float width, LayoutMeasureMode width_measure_mode,
+                                                               float height, LayoutMeasureMode height_measure_mode,
+                                                               void* layout_context) -> LayoutSize {
+    auto cache = weak_cache.lock();
+    auto node = weak_node.lock();
+    if (!cache || !node) {
+      return measure(width, width_measure_mode, height, height_measure_mode, layout_context);
+    }
+    return cache->Measure(node, measure, width, width_measure_mode, height, height_measure_mode, layout_context);
+  };
+}
+
+LayoutSize MeasureCache::Measure(const std::shared_ptr<DomNode>& node, const MeasureFunction& measure, float width,
+                                 LayoutMeasureMode width_measure_mode, float height,
+                                 LayoutMeasureMode height_measure_mode, void* layout_context) {
+  // Undefined 模式下的尺寸没有意义（通常为 NaN），统一置 0 以便比较
+  Key key{GetContent(node),
+          width_measure_mode == LayoutMeasureMode::Undefined || std::isnan(width) ? 0 : width,
+          width_measure_mode,
+          height_measure_mode == LayoutMeasureMode::Undefined || std::isnan(height) ? 0 : height,
+          height_measure_mode};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      ++hit_count_;
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->second;
+    }
+    ++miss_count_;
+  }
+  // 平台测量不持锁，并行布局时多个线程可以同时测量
+  auto size = measure(width, width_measure_mode, height, height_measure_mode, layout_context);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    it->second->second = size;
+    entries_.splice(entries_.begin(), entries_, it->second);
+  } else {
+    entries_.emplace_front(key, size);
+    index_[key] = entries_.begin();
+    Evict();
+  }
+  return size;
+}
+
+std::shared_ptr<const MeasureCache::Content> MeasureCache::GetContent(const std::shared_ptr<DomNode>& node) {
+  auto id = node->GetId();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = contents_.find(id);
+    if (it != contents_.end()) {
+      return it->second;
+    }
+  }
+  std::vector<uint32_t> descendant_ids;
+  auto content = ComputeContent(node, descendant_ids);
+  std::lock_guard<std::mutex> lock(mutex_);
+  contents_[id] = content;
+  for (auto descendant_id : descendant_ids) {
+    auto& owners = owners_[descendant_id];
+    if (std::find(owners.begin(), owners.end(), id) == owners.end()) {
+      owners.push_back(id);
+    }
+  }
+  return content;
+}
+
+// 测量结果由平台决定，dom 层无法准确区分哪些属性会影响测量，这里拷贝节点及其子孙节点的全部属性，
+// 只会降低命中率，不会复用错误的结果
+std::shared_ptr<const MeasureCache::Content> MeasureCache::ComputeContent(const std::shared_ptr<DomNode>& node,
+                                                                          std::vector<uint32_t>& descendant_ids) {
+  auto content = std::make_shared<Content>();
+  size_t seed = 0;
+  std::stack<std::shared_ptr<DomNode>> stack;
+  stack.push(node);
+  while (!stack.empty()) {
+    auto current = stack.top();
+    stack.pop();
+    if (current != node) {
+      descendant_ids.push_back(current->GetId());
+    }
+    const auto& children = current->GetChildren();
+    NodeContent node_content{current->GetViewName(), {}, {}, children.size()};
+    CopyValueMap(current->GetStyleMap(), node_content.style);
+    CopyValueMap(current->GetExtStyle(), node_content.ext);
+    std::hash_combine(seed, node_content.view_name);
+    std::hash_combine(seed, HashValueObject(node_content.style));
+    std::hash_combine(seed, HashValueObject(node_content.ext));
+    std::hash_combine(seed, node_content.child_count);
+    content->nodes.push_back(std::move(node_content));
+    for (auto it = children.rbegin(); it != children.rend(); ++it) {
+      stack.push(*it);
+    }
+  }
+  content->hash = seed;
+  return content;
+}
+
+void MeasureCache::EraseContent(uint32_t id) {
+  contents_.erase(id);
+  auto it = owners_.find(id);
+  if (it == owners_.end()) {
+    return;
+  }
+  // 文本中嵌套的 span 变化时，外层文本节点的内容也随之变化。外层节点重新计算内容时会再次登记
+  for (auto owner_id : it->second) {
+    contents_.erase(owner_id);
+  }
+  owners_.erase(it);
+}
+
+void MeasureCache::MarkTextDirty(const std::shared_ptr<DomNode>& node) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (contents_.empty()) {
+    return;
+  }
+  EraseContent(node->GetId());
+}
+
+void MeasureCache::RemoveNode(uint32_t id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  EraseContent(id);
+}
+
+void MeasureCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  contents_.clear();
+  owners_.clear();
+}
+
+void MeasureCache::SetCapacity(uint32_t capacity) {
+  FOOTSTONE_DCHECK(capacity > 0);
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  Evict();
+}
+
+MeasureCache::Statistics MeasureCache::GetStatistics() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return {hit_count_, miss_count_, static_cast<uint32_t>(entries_.size())};
+}
+
+void MeasureCache::Evict() {
+  while (entries_.size() > capacity_) {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+}
+
+}  // namespace dom
+}  // namespace hippy
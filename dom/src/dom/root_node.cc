@@ -20,12 +20,19 @@
 
 #include "dom/root_node.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
 #include <stack>
+#include <unordered_set>
 
 #include "dom/animation/animation_manager.h"
 #include "dom/render_manager.h"
 #include "footstone/deserializer.h"
 #include "footstone/hippy_value.h"
+#include "footstone/logging.h"
 
 namespace hippy {
 inline namespace dom {
@@ -64,7 +71,8 @@ footstone::utils::PersistentObjectMap<uint32_t, std::shared_ptr<RootNode>> RootN
 // The diff should be {text: "b", fontsize: 12}, but the previous diff algorithm cacluate {fontsize: "b"}
 //
 // To address this issue, the new update algorithm is as follows:
-// 1. When a node's style needs to be updated for the first time, we save the current style.
+// 1. When a node's style needs to be updated for the first time, we save the current style. The saved style shares
+//    the node's map instead of deep copying it, the node copies the map on write while it is shared.
 // 2. Subsequent update differences are generated by comparing the saved styles with the update instructions.
 // 3. At the end of the batch, we clear the saved styles.
 bool DomNodeStyleDiffer::Calculate(const std::shared_ptr<hippy::dom::RootNode>& root_node,
@@ -78,23 +86,19 @@ bool DomNodeStyleDiffer::Calculate(const std::shared_ptr<hippy::dom::RootNode>&
   uint32_t dom_id = dom_node->GetId();
 
   // 保存 batch 最早的 style 和 ext_style, 该批次中的所有的 diff 都由这个 style 比较产生
-  if (node_style_map_.find(dom_id) == node_style_map_.end()) {
-    std::unordered_map<std::string, std::shared_ptr<HippyValue>> style;
-    std::unordered_map<std::string, std::shared_ptr<HippyValue>> ext_style;
-    auto dom_style = dom_node->GetStyleMap();
-    for (const auto& pair : *dom_style) {
-      style[pair.first] = std::make_shared<HippyValue>(*pair.second);
-    }
-    node_style_map_.insert({dom_id, style});
-    auto dom_ext_style = dom_node->GetExtStyle();
-    for (const auto& pair : *dom_ext_style) {
-      ext_style[pair.first] = std::make_shared<HippyValue>(*pair.second);
-    }
-    node_ext_style_map_.insert({dom_id, ext_style});
-  }
-
-  auto base_style = node_style_map_.at(dom_id);
-  auto base_ext_style = node_ext_style_map_.at(dom_id);
+  // 这里只持有 DomNode 当前 map 的引用，DomNode 后续的原地修改会先写时复制，快照内容保持不变
+  auto style_iter = node_style_map_.find(dom_id);
+  if (style_iter == node_style_map_.end()) {
+    std::shared_ptr<const DomValueMap> style = dom_node->GetStyleMap();
+    std::shared_ptr<const DomValueMap> ext_style = dom_node->GetExtStyle();
+    if (style == nullptr) style = std::make_shared<DomValueMap>();
+    if (ext_style == nullptr) ext_style = std::make_shared<DomValueMap>();
+    style_iter = node_style_map_.emplace(dom_id, std::move(style)).first;
+    node_ext_style_map_.emplace(dom_id, std::move(ext_style));
+  }
+
+  const auto& base_style = *style_iter->second;
+  const auto& base_ext_style = *node_ext_style_map_.at(dom_id);
   style_diff = DiffUtils::DiffProps(base_style, *dom_info->dom_node->GetStyleMap(), false);
   ext_style_diff = DiffUtils::DiffProps(base_ext_style, *dom_info->dom_node->GetExtStyle(), false);
   return true;
@@ -105,19 +109,33 @@ RootNode::RootNode(uint32_t id) : DomNode(id, 0, 0, "", "", nullptr, nullptr, {}
   animation_manager_ = std::make_shared<AnimationManager>();
   interceptors_.push_back(animation_manager_);
   style_differ_ = std::make_unique<DomNodeStyleDiffer>();
+  measure_cache_ = std::make_shared<MeasureCache>();
 }
 
 RootNode::RootNode() : RootNode(0) {}
 
+RootNode::~RootNode() {
+  SetParallelLayoutWorkerManager(nullptr, 0);
+}
+
 void RootNode::AddEventListener(const std::string& name, uint64_t listener_id, bool use_capture,
                                 const EventCallback& cb) {
+  // RootNode 没有 root_node_，需要自己维护监听计数
+  auto is_new_event = !HasEventListener(name);
   DomNode::AddEventListener(name, listener_id, use_capture, cb);
   AddEvent(GetId(), name);
+  if (is_new_event) {
+    OnEventListenerAdded(*this, name);
+  }
 }
 
 void RootNode::RemoveEventListener(const std::string& name, uint64_t listener_id) {
+  auto had_event = HasEventListener(name);
   DomNode::RemoveEventListener(name, listener_id);
   RemoveEvent(GetId(), name);
+  if (had_event && !HasEventListener(name)) {
+    OnEventListenerRemoved(*this, name);
+  }
 }
 
 void RootNode::ReleaseResources() {}
@@ -137,9 +155,14 @@ void RootNode::CreateDomNodes(std::vector<std::shared_ptr<DomInfo>>&& nodes, boo
     // 解析布局属性
     node->ParseLayoutStyleInfo();
     parent_node->AddChildByRefInfo(node_info);
-    auto event = std::make_shared<DomEvent>(kDomCreated, node, nullptr);
-    node->HandleEvent(event);
+    measure_cache_->MarkTextDirty(parent_node);
+    // 先登记节点，节点创建前已添加的监听才会计入 event_listener_counts_
     OnDomNodeCreated(node);
+    // 没有监听时不创建事件对象
+    if (HasEventListenerInTree(kDomCreated)) {
+      auto event = std::make_shared<DomEvent>(kDomCreated, node, nullptr);
+      node->HandleEvent(event);
+    }
   }
   for (const auto& node : nodes_to_create) {
     if (needSortByIndex) {
@@ -169,6 +192,9 @@ void RootNode::CreateDomNodes(std::vector<std::shared_ptr<DomInfo>>&& nodes, boo
     });
   }
 
+  batch_statistics_.created_node_count +=
+      footstone::check::checked_numeric_cast<size_t, uint32_t>(nodes_to_create.size());
+
   auto event = std::make_shared<DomEvent>(kDomTreeCreated, weak_from_this(), nullptr);
   HandleEvent(event);
 
@@ -204,9 +230,10 @@ void RootNode::UpdateDomNodes(std::vector<std::shared_ptr<DomInfo>>&& nodes) {
     if (!ext_update->empty()) {
       diff_value->insert(ext_update->begin(), ext_update->end());
     }
-    dom_node->SetStyleMap(node->dom_node->GetStyleMap());
-    dom_node->SetExtStyleMap(node->dom_node->GetExtStyle());
+    dom_node->SetStyleMap(node->dom_node->style_map_);
+    dom_node->SetExtStyleMap(node->dom_node->dom_ext_map_);
     dom_node->SetDiffStyle(diff_value);
+    measure_cache_->MarkTextDirty(dom_node);
 
     auto style_delete = std::get<1>(style_diff);
     auto ext_delete = std::get<1>(ext_style_diff);
@@ -227,10 +254,15 @@ void RootNode::UpdateDomNodes(std::vector<std::shared_ptr<DomInfo>>&& nodes) {
       nodes_to_update.push_back(dom_node);
     }
 
-    auto event = std::make_shared<DomEvent>(kDomUpdated, dom_node, nullptr);
-    dom_node->HandleEvent(event);
+    if (HasEventListenerInTree(kDomUpdated)) {
+      auto event = std::make_shared<DomEvent>(kDomUpdated, dom_node, nullptr);
+      dom_node->HandleEvent(event);
+    }
   }
 
+  batch_statistics_.updated_node_count +=
+      footstone::check::checked_numeric_cast<size_t, uint32_t>(nodes_to_update.size());
+
   auto event = std::make_shared<DomEvent>(kDomTreeUpdated, weak_from_this(), nullptr);
   HandleEvent(event);
 
@@ -255,10 +287,13 @@ void RootNode::MoveDomNodes(std::vector<std::shared_ptr<DomInfo>>&& nodes) {
     }
     nodes_to_move.push_back(node);
     parent_node->AddChildByRefInfo(std::make_shared<DomInfo>(node, node_info->ref_info, nullptr));
+    measure_cache_->MarkTextDirty(parent_node);
   }
   for (const auto& node : nodes_to_move) {
     node->SetRenderInfo({node->GetId(), node->GetPid(), node->GetSelfIndex()});
   }
+  batch_statistics_.moved_node_count +=
+      footstone::check::checked_numeric_cast<size_t, uint32_t>(nodes_to_move.size());
   if (!nodes_to_move.empty()) {
     dom_operations_.push_back({DomOperation::Op::kOpMove, nodes_to_move});
   }
@@ -278,12 +313,18 @@ void RootNode::DeleteDomNodes(std::vector<std::shared_ptr<DomInfo>>&& nodes) {
     std::shared_ptr<DomNode> parent_node = node->GetParent();
     if (parent_node != nullptr) {
       parent_node->RemoveChildAt(parent_node->IndexOf(node));
+      measure_cache_->MarkTextDirty(parent_node);
+    }
+    if (HasEventListenerInTree(kDomDeleted)) {
+      auto event = std::make_shared<DomEvent>(kDomDeleted, node, nullptr);
+      node->HandleEvent(event);
     }
-    auto event = std::make_shared<DomEvent>(kDomDeleted, node, nullptr);
-    node->HandleEvent(event);
     OnDomNodeDeleted(node);
   }
 
+  batch_statistics_.deleted_node_count +=
+      footstone::check::checked_numeric_cast<size_t, uint32_t>(nodes_to_delete.size());
+
   auto event = std::make_shared<DomEvent>(kDomTreeDeleted, weak_from_this(), nullptr);
   HandleEvent(event);
 
@@ -302,8 +343,11 @@ void RootNode::UpdateAnimation(std::vector<std::shared_ptr<DomNode>>&& nodes) {
     node->MarkWillChange(true);
     nodes_to_update.push_back(node);
     node->ParseLayoutStyleInfo();
-    auto event = std::make_shared<DomEvent>(kDomUpdated, node, nullptr);
-    node->HandleEvent(event);
+    measure_cache_->MarkTextDirty(node);
+    if (HasEventListenerInTree(kDomUpdated)) {
+      auto event = std::make_shared<DomEvent>(kDomUpdated, node, nullptr);
+      node->HandleEvent(event);
+    }
   }
   auto event = std::make_shared<DomEvent>(kDomTreeUpdated, weak_from_this(), nullptr);
   HandleEvent(event);
@@ -312,6 +356,28 @@ void RootNode::UpdateAnimation(std::vector<std::shared_ptr<DomNode>>&& nodes) {
   }
 }
 
+bool RootNode::UpdateAnimationProps(const std::vector<std::shared_ptr<DomNode>>& nodes,
+                                    const std::shared_ptr<RenderManager>& render_manager) {
+  // 尚未下发的操作中可能有这些节点的创建，直接下发属性会先于节点创建到达渲染层
+  if (!dom_operations_.empty() || HasEventListenerInTree(kDomUpdated)) {
+    return false;
+  }
+  std::vector<AnimationPropsUpdate> updates;
+  updates.reserve(nodes.size());
+  for (const auto& node : nodes) {
+    updates.push_back({node->GetId(), node->GetDiffStyle()});
+  }
+  if (!render_manager->UpdateAnimationProps(GetWeakSelf(), updates)) {
+    return false;
+  }
+  for (const auto& node : nodes) {
+    node->MarkWillChange(true);
+  }
+  auto event = std::make_shared<DomEvent>(kDomTreeUpdated, weak_from_this(), nullptr);
+  HandleEvent(event);
+  return true;
+}
+
 void RootNode::CallFunction(uint32_t id, const std::string& name, const DomArgument& param,
                             const CallFunctionCallback& cb) {
   auto node = GetNode(id);
@@ -323,6 +389,7 @@ void RootNode::CallFunction(uint32_t id, const std::string& name, const DomArgum
 void RootNode::SyncWithRenderManager(const std::shared_ptr<RenderManager>& render_manager) {
   TDF_PERF_DO_STMT_AND_LOG(unsigned long domCnt = dom_operations_.size();, "RootNode::SyncWithRenderManager");
   if (style_differ_ != nullptr) style_differ_->Reset();
+  batch_statistics_ = {};
   FlushDomOperations(render_manager);
   TDF_PERF_DO_STMT_AND_LOG(unsigned long evCnt = event_operations_.size();
                            , "RootNode::FlushDomOperations Done, dom op count:%lld", domCnt);
@@ -330,6 +397,9 @@ void RootNode::SyncWithRenderManager(const std::shared_ptr<RenderManager>& rende
   TDF_PERF_LOG("RootNode::FlushEventOperations Done, event op count:%d", evCnt);
   DoAndFlushLayout(render_manager);
   TDF_PERF_LOG("RootNode::DoAndFlushLayout Done");
+  for (const auto& interceptor : interceptors_) {
+    interceptor->OnDomBatchEnd();
+  }
   auto dom_manager = dom_manager_.lock();
   if (dom_manager) {
     dom_manager->RecordDomEndTimePoint();
@@ -351,65 +421,86 @@ void RootNode::HandleEvent(const std::shared_ptr<DomEvent>& event) {
   if (!event) {
     return;
   }
+  // 树上没有任何节点监听该事件时不需要派发，DomCreated/DomUpdated 以及大部分滚动、触摸事件都走这里
+  if (!HasEventListenerInTree(event->GetType())) {
+    return;
+  }
   auto target = event->GetTarget().lock();
   if (!target) {
     return;
   }
-  auto event_name = event->GetType();
-  std::stack<std::shared_ptr<DomNode>> capture_list = {};
+  // 取走复用的缓冲区，回调中同步派发的嵌套事件会拿到空缓冲区，不会相互覆盖
+  auto ancestors = std::move(event_path_);
+  ancestors.clear();
   // 执行捕获流程，注：target节点event.StopPropagation并不会阻止捕获流程
   if (event->CanCapture()) {
-    // 获取捕获列表
+    // 获取捕获列表，由近到远，反过来就是冒泡列表
     auto parent = target->GetParent();
     while (parent) {
-      capture_list.push(parent);
-      parent = parent->GetParent();
+      auto next = parent->GetParent();
+      ancestors.push_back(std::move(parent));
+      parent = std::move(next);
     }
   }
+  DispatchEvent(event, target, ancestors);
+  ancestors.clear();
+  event_path_ = std::move(ancestors);
+}
+
+bool RootNode::HasEventListenerInTree(const std::string& name) const {
+  return event_listener_counts_.find(name) != event_listener_counts_.end();
+}
+
+void RootNode::DispatchEvent(const std::shared_ptr<DomEvent>& event, const std::shared_ptr<DomNode>& target,
+                             const std::vector<std::shared_ptr<DomNode>>& ancestors) {
+  const auto& event_name = event->GetType();
+  // 监听列表是共享的快照，回调中增删监听不会影响本次派发
   auto capture_target_listeners = target->GetEventListener(event_name, true);
   auto bubble_target_listeners = target->GetEventListener(event_name, false);
-  // 捕获列表反过来就是冒泡列表，不需要额外遍历生成
   // 执行捕获流程
-  std::stack<std::shared_ptr<DomNode>> bubble_list = {};
-  while (!capture_list.empty()) {
-    auto capture_node = capture_list.top();
-    capture_list.pop();
+  for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
+    const auto& capture_node = *it;
     event->SetCurrentTarget(capture_node);  // 设置当前节点，cb里会用到
     auto listeners = capture_node->GetEventListener(event_name, true);
-    for (const auto& listener : listeners) {
-      event->SetEventPhase(EventPhase::kCapturePhase);
-      listener->cb(event);  // StopPropagation并不会影响同级的回调调用
+    if (listeners) {
+      for (const auto& listener : *listeners) {
+        event->SetEventPhase(EventPhase::kCapturePhase);
+        listener->cb(event);  // StopPropagation并不会影响同级的回调调用
+      }
     }
     if (event->IsPreventCapture()) {  // cb 内部调用了 event.StopPropagation 会阻止捕获
       return;  // 捕获流中StopPropagation不仅会导致捕获流程结束，后面的目标事件和冒泡都会终止
     }
-    bubble_list.push(std::move(capture_node));
   }
   // 执行本身节点回调
   event->SetCurrentTarget(event->GetTarget());
-  for (const auto& listener : capture_target_listeners) {
-    event->SetEventPhase(EventPhase::kAtTarget);
-    listener->cb(event);
+  if (capture_target_listeners) {
+    for (const auto& listener : *capture_target_listeners) {
+      event->SetEventPhase(EventPhase::kAtTarget);
+      listener->cb(event);
+    }
   }
   if (event->IsPreventCapture()) {
     return;
   }
-  for (const auto& listener : bubble_target_listeners) {
-    event->SetEventPhase(EventPhase::kAtTarget);
-    listener->cb(event);
+  if (bubble_target_listeners) {
+    for (const auto& listener : *bubble_target_listeners) {
+      event->SetEventPhase(EventPhase::kAtTarget);
+      listener->cb(event);
+    }
   }
   if (event->IsPreventBubble()) {
     return;
   }
   // 执行冒泡流程
-  while (!bubble_list.empty()) {
-    auto bubble_node = bubble_list.top();
-    bubble_list.pop();
+  for (const auto& bubble_node : ancestors) {
     event->SetCurrentTarget(bubble_node);
     auto listeners = bubble_node->GetEventListener(event_name, false);
-    for (const auto& listener : listeners) {
-      event->SetEventPhase(EventPhase::kBubblePhase);
-      listener->cb(event);
+    if (listeners) {
+      for (const auto& listener : *listeners) {
+        event->SetEventPhase(EventPhase::kBubblePhase);
+        listener->cb(event);
+      }
     }
     if (event->IsPreventBubble()) {
       break;
@@ -440,9 +531,14 @@ void RootNode::UpdateRenderNode(const std::shared_ptr<DomNode>& node) {
 }
 
 uint32_t RootNode::GetChildCount() {
-  uint32_t child_count = 0;
-  Traverse([&child_count](const std::shared_ptr<DomNode>&) { child_count++; });
-  return child_count;
+  return GetStatistics().total_node_count;
+}
+
+RootNode::Statistics RootNode::GetStatistics() const {
+  auto statistics = batch_statistics_;
+  // nodes_ 随节点创建与删除同步维护，不包含 RootNode 本身
+  statistics.total_node_count = footstone::check::checked_numeric_cast<size_t, uint32_t>(nodes_.size()) + 1;
+  return statistics;
 }
 
 std::shared_ptr<DomNode> RootNode::GetNode(uint32_t id) {
@@ -469,9 +565,16 @@ void RootNode::SetRootOrigin(float x, float y) { SetLayoutOrigin(x, y); }
 void RootNode::DoAndFlushLayout(const std::shared_ptr<RenderManager>& render_manager) {
   // Before Layout
   render_manager->BeforeLayout(GetWeakSelf());
-  // 触发布局计算
   std::vector<std::shared_ptr<DomNode>> layout_changed_nodes;
-  DoLayout(layout_changed_nodes);
+  if (!snapshot_layouts_.empty()) {
+    // 从快照恢复后的首个 batch 直接使用保存的布局，跳过布局计算
+    RestoreSnapshotLayout(layout_changed_nodes);
+  } else {
+    // 触发布局计算
+    LayoutBoundariesConcurrently();
+    DoLayout(layout_changed_nodes, enable_incremental_layout_transfer_ && !need_full_layout_transfer_);
+    need_full_layout_transfer_ = false;
+  }
   // After Layout
   render_manager->AfterLayout(GetWeakSelf());
 
@@ -480,7 +583,193 @@ void RootNode::DoAndFlushLayout(const std::shared_ptr<RenderManager>& render_man
   }
 }
 
+void RootNode::SetSnapshotLayout(std::vector<std::pair<std::shared_ptr<DomNode>, LayoutResult>>&& layouts) {
+  snapshot_layouts_ = std::move(layouts);
+}
+
+void RootNode::RestoreSnapshotLayout(std::vector<std::shared_ptr<DomNode>>& layout_changed_nodes) {
+  layout_changed_nodes.reserve(snapshot_layouts_.size());
+  for (auto& [node, layout] : snapshot_layouts_) {
+    // 恢复后同一 batch 内又被删除的节点不再需要布局
+    if (node.get() != this && GetNode(node->GetId()) != node) {
+      continue;
+    }
+    node->layout_ = layout;
+    layout_changed_nodes.push_back(std::move(node));
+  }
+  snapshot_layouts_.clear();
+  // 层级优化后的坐标依赖祖先节点的布局结果，全部恢复后再计算
+  for (const auto& node : layout_changed_nodes) {
+    node->UpdateRenderLayout();
+  }
+}
+
+// 按节点合并 batch 内的操作，减少渲染层调用次数与序列化数据量：
+// 1. 节点创建时渲染层读取的是 flush 时的最终属性，同一 batch 内创建后的更新可以省略
+// 2. 同一 batch 内创建又删除（包括随祖先节点一起删除）的节点，创建与删除都可以省略
+// 3. batch 内多次更新的 diff 都是相对 batch 开始时的属性计算的，后一次已包含前一次，只需要更新一次
+// 4. 已从树上删除的节点不再需要更新与移动
+// 5. 合并后相邻的同类操作合并为一次渲染层调用
+// 创建与移动不合并，移动依赖创建时的 index 顺序
+void RootNode::CoalesceDomOperations() {
+  auto is_mounted = [this](const std::shared_ptr<DomNode>& node) {
+    auto found = nodes_.find(node->GetId());
+    return found != nodes_.end() && found->second.lock() == node;
+  };
+  std::unordered_set<const DomNode*> created_nodes;
+  std::unordered_set<const DomNode*> updated_nodes;
+  std::vector<DomOperation> coalesced_operations;
+  coalesced_operations.reserve(dom_operations_.size());
+  for (auto& dom_operation : dom_operations_) {
+    std::vector<std::shared_ptr<DomNode>> nodes;
+    nodes.reserve(dom_operation.nodes.size());
+    for (auto& node : dom_operation.nodes) {
+      auto keep = true;
+      switch (dom_operation.op) {
+        case DomOperation::Op::kOpCreate:
+          created_nodes.insert(node.get());
+          keep = is_mounted(node);
+          break;
+        case DomOperation::Op::kOpUpdate:
+          keep = created_nodes.find(node.get()) == created_nodes.end() && is_mounted(node) &&
+              updated_nodes.insert(node.get()).second;
+          break;
+        case DomOperation::Op::kOpMove:
+          keep = is_mounted(node);
+          break;
+        case DomOperation::Op::kOpDelete:
+          keep = created_nodes.find(node.get()) == created_nodes.end();
+          break;
+        default:
+          break;
+      }
+      if (keep) {
+        nodes.push_back(std::move(node));
+      }
+    }
+    if (nodes.empty()) {
+      continue;
+    }
+    if (!coalesced_operations.empty() && coalesced_operations.back().op == dom_operation.op) {
+      auto& merged_nodes = coalesced_operations.back().nodes;
+      merged_nodes.insert(merged_nodes.end(), std::make_move_iterator(nodes.begin()),
+                          std::make_move_iterator(nodes.end()));
+    } else {
+      coalesced_operations.push_back({dom_operation.op, std::move(nodes)});
+    }
+  }
+  dom_operations_ = std::move(coalesced_operations);
+}
+
+void RootNode::SetParallelLayoutWorkerManager(const std::shared_ptr<footstone::WorkerManager>& worker_manager,
+                                              uint32_t concurrency) {
+  if (auto previous = layout_worker_manager_.lock()) {
+    for (const auto& runner : layout_runners_) {
+      previous->RemoveTaskRunner(runner);
+    }
+  }
+  layout_runners_.clear();
+  layout_worker_manager_.reset();
+  if (!worker_manager) {
+    return;
+  }
+#ifdef USE_YOGA
+  // YGNodeCalculateLayout 会读写全局的 gCurrentGenerationCount，对不同子树并发调用同样存在数据竞争
+  FOOTSTONE_LOG(WARNING) << "parallel layout is not supported by yoga, root id = " << GetId();
+#else
+  layout_worker_manager_ = worker_manager;
+  for (uint32_t i = 0; i < concurrency; ++i) {
+    layout_runners_.push_back(worker_manager->CreateTaskRunner("hippy_layout"));
+  }
+#endif
+}
+
+// 布局边界：尺寸完全由自身的宽高样式决定的子树，内部布局与父节点无关，可以单独布局。
+// 之后整体布局时，引擎会因约束相同而命中这些子树的布局缓存，只需要确定它们的位置。
+// 绝对定位但没有固定宽高的节点仍依赖包含块的尺寸，不作为边界
+static bool IsLayoutBoundary(const std::shared_ptr<LayoutNode>& layout_node) {
+  return !std::isnan(layout_node->GetStyleWidth()) && !std::isnan(layout_node->GetStyleHeight()) &&
+      !layout_node->HasMeasureFunction();
+}
+
+std::vector<std::shared_ptr<LayoutNode>> RootNode::CollectDirtyLayoutBoundaries() {
+  std::vector<std::shared_ptr<LayoutNode>> boundaries;
+  std::vector<DomNode*> stack = {this};
+  while (!stack.empty()) {
+    auto node = stack.back();
+    stack.pop_back();
+    // 逆序入栈，边界按文档顺序排列
+    const auto& children = node->GetChildren();
+    for (auto it = children.rbegin(); it != children.rend(); ++it) {
+      const auto& layout_node = (*it)->GetLayoutNode();
+      // 引擎中脏标记会向上传递，不脏的子树中没有需要重新布局的节点；Text 的子节点不在引擎的树上
+      if (!layout_node->HasParentEngineNode() || !layout_node->IsDirty()) {
+        continue;
+      }
+      // 边界内部嵌套的边界随外层一起布局
+      if (IsLayoutBoundary(layout_node)) {
+        boundaries.push_back(layout_node);
+      } else {
+        stack.push_back(it->get());
+      }
+    }
+  }
+  return boundaries;
+}
+
+namespace {
+
+// 各线程从同一个下标原子地领取边界，每个边界的布局互不依赖，结果与执行线程和顺序无关
+struct ParallelLayoutState {
+  explicit ParallelLayoutState(std::vector<std::shared_ptr<LayoutNode>>&& nodes) : boundaries(std::move(nodes)) {}
+
+  void Run() {
+    ++running;
+    for (auto index = next++; index < boundaries.size(); index = next++) {
+      const auto& boundary = boundaries[index];
+      boundary->CalculateLayout(boundary->GetStyleWidth(), boundary->GetStyleHeight());
+    }
+    if (--running == 0) {
+      std::lock_guard<std::mutex> lock(mutex);
+      cv.notify_all();
+    }
+  }
+
+  // 调用方的 Run 返回时所有边界都已被领取，此后才开始的 task 领取不到边界，不需要等待
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this] { return running == 0; });
+  }
+
+  std::vector<std::shared_ptr<LayoutNode>> boundaries;
+  std::atomic<size_t> next{0};
+  std::atomic<uint32_t> running{0};
+  std::mutex mutex;
+  std::condition_variable cv;
+};
+
+}  // namespace
+
+void RootNode::LayoutBoundariesConcurrently() {
+  if (layout_runners_.empty()) {
+    return;
+  }
+  auto boundaries = CollectDirtyLayoutBoundaries();
+  if (boundaries.size() < 2) {
+    return;
+  }
+  auto helper_count = std::min(layout_runners_.size(), boundaries.size() - 1);
+  auto state = std::make_shared<ParallelLayoutState>(std::move(boundaries));
+  for (size_t i = 0; i < helper_count; ++i) {
+    layout_runners_[i]->PostTask([state] { state->Run(); });
+  }
+  // DOM 线程同样参与布局，worker 繁忙时也不会阻塞在等待上
+  state->Run();
+  state->Wait();
+}
+
 void RootNode::FlushDomOperations(const std::shared_ptr<RenderManager>& render_manager) {
+  CoalesceDomOperations();
   for (auto& dom_operation : dom_operations_) {
     MarkLayoutNodeDirty(dom_operation.nodes);
     switch (dom_operation.op) {
@@ -541,7 +830,12 @@ void RootNode::FlushEventOperations(const std::shared_ptr<RenderManager>& render
 }
 
 void RootNode::OnDomNodeCreated(const std::shared_ptr<DomNode>& node) {
-  nodes_.insert(std::make_pair(node->GetId(), node));
+  auto inserted = nodes_.insert(std::make_pair(node->GetId(), node)).second;
+  if (inserted && node->event_listener_map_) {
+    for (const auto& [name, listeners] : *node->event_listener_map_) {
+      ++event_listener_counts_[name];
+    }
+  }
 }
 
 void RootNode::OnDomNodeDeleted(const std::shared_ptr<DomNode>& node) {
@@ -551,7 +845,32 @@ void RootNode::OnDomNodeDeleted(const std::shared_ptr<DomNode>& node) {
         OnDomNodeDeleted(child);
       }
     }
+    if (node->event_listener_map_ && GetNode(node->GetId()) == node) {
+      for (const auto& [name, listeners] : *node->event_listener_map_) {
+        OnEventListenerRemoved(*node, name);
+      }
+    }
     nodes_.erase(node->GetId());
+    measure_cache_->RemoveNode(node->GetId());
+  }
+}
+
+void RootNode::OnEventListenerAdded(const DomNode& node, const std::string& name) {
+  // 只统计挂载在树上的节点，未挂载的节点在 OnDomNodeCreated 时再统计
+  if (GetNode(node.GetId()).get() != &node) {
+    return;
+  }
+  ++event_listener_counts_[name];
+}
+
+void RootNode::OnEventListenerRemoved(const DomNode& node, const std::string& name) {
+  if (GetNode(node.GetId()).get() != &node) {
+    return;
+  }
+  auto it = event_listener_counts_.find(name);
+  FOOTSTONE_DCHECK(it != event_listener_counts_.end());
+  if (it != event_listener_counts_.end() && --it->second == 0) {
+    event_listener_counts_.erase(it);
   }
 }
 
@@ -568,7 +887,7 @@ void RootNode::Traverse(const std::function<void(const std::shared_ptr<DomNode>&
     auto top = stack.top();
     stack.pop();
     on_traverse(top);
-    auto children = top->GetChildren();
+    const auto& children = top->GetChildren();
     if (!children.empty()) {
       for (auto it = children.rbegin(); it != children.rend(); ++it) {
         stack.push(*it);
@@ -0,0 +1,668 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "dom/dom_node.h"
+#include "dom/measure_cache.h"
+#include "dom/node_props.h"
+#include "dom/render_manager.h"
+#include "dom/root_node.h"
+#include "footstone/hippy_value.h"
+#include "footstone/worker_manager.h"
+
+namespace hippy {
+namespace dom {
+namespace testing {
+
+using HippyValue = footstone::value::HippyValue;
+using HippyValueArrayType = footstone::value::HippyValue::HippyValueArrayType;
+using HippyValueObjectType = footstone::value::HippyValue::HippyValueObjectType;
+
+constexpr uint32_t kRootId = 1;
+constexpr uint32_t kFanout = 8;
+constexpr int kLayoutTimes = 20;
+
+// Builds a synthetic tree of `count` nodes, node k is a child of node k / kFanout - 1 (or the root)
+std::shared_ptr<RootNode> CreateTree(uint32_t count) {
+  auto root_node = std::make_shared<RootNode>(kRootId);
+  std::vector<std::shared_ptr<DomInfo>> infos;
+  infos.reserve(count);
+  for (uint32_t k = 0; k < count; ++k) {
+    uint32_t id = k + kRootId + 1;
+    uint32_t pid = k < kFanout ? kRootId : k / kFanout - 1 + kRootId + 1;
+    auto style = std::make_shared<DomValueMap>();
+    (*style)[kHeight] = std::make_shared<HippyValue>(10);
+    auto node = std::make_shared<DomNode>(id, pid, 0, "View", "View", style, std::make_shared<DomValueMap>(),
+                                          root_node);
+    infos.push_back(std::make_shared<DomInfo>(node, nullptr, nullptr));
+  }
+  root_node->CreateDomNodes(std::move(infos), false);
+  root_node->SetRootSize(1080, 1920);
+  std::vector<std::shared_ptr<DomNode>> changed_nodes;
+  root_node->DoLayout(changed_nodes);
+  return root_node;
+}
+
+void UpdateLeafHeight(const std::shared_ptr<RootNode>& root_node, uint32_t count, int height) {
+  auto leaf = root_node->GetNode(count + kRootId);
+  DomValueMap style_update;
+  style_update[kHeight] = std::make_shared<HippyValue>(height);
+  leaf->UpdateLayoutStyleInfo(style_update, {});
+}
+
+std::set<uint32_t> ToIdSet(const std::vector<std::shared_ptr<DomNode>>& nodes) {
+  std::set<uint32_t> ids;
+  for (const auto& node : nodes) {
+    ids.insert(node->GetId());
+  }
+  return ids;
+}
+
+TEST(RootNodeTest, IncrementalLayoutTransfer) {
+  constexpr uint32_t kNodeCount = 1000;
+  auto full_tree = CreateTree(kNodeCount);
+  auto incremental_tree = CreateTree(kNodeCount);
+  incremental_tree->SetEnableIncrementalLayoutTransfer(true);
+  for (int i = 0; i < kLayoutTimes; ++i) {
+    int height = i % 2 == 0 ? 20 : 10;
+    UpdateLeafHeight(full_tree, kNodeCount, height);
+    UpdateLeafHeight(incremental_tree, kNodeCount, height);
+
+    std::vector<std::shared_ptr<DomNode>> full_changed;
+    full_tree->DoLayout(full_changed, false);
+    std::vector<std::shared_ptr<DomNode>> incremental_changed;
+    incremental_tree->DoLayout(incremental_changed, true);
+    EXPECT_EQ(ToIdSet(full_changed), ToIdSet(incremental_changed));
+  }
+  full_tree->Traverse([&incremental_tree](const std::shared_ptr<DomNode>& node) {
+    auto other = incremental_tree->GetNode(node->GetId());
+    ASSERT_NE(other, nullptr);
+    EXPECT_EQ(node->GetRenderLayoutResult().left, other->GetRenderLayoutResult().left);
+    EXPECT_EQ(node->GetRenderLayoutResult().top, other->GetRenderLayoutResult().top);
+    EXPECT_EQ(node->GetRenderLayoutResult().width, other->GetRenderLayoutResult().width);
+    EXPECT_EQ(node->GetRenderLayoutResult().height, other->GetRenderLayoutResult().height);
+  });
+}
+
+std::shared_ptr<DomInfo> CreateUpdateInfo(const std::shared_ptr<RootNode>& root_node, uint32_t id,
+                                          const std::shared_ptr<DomValueMap>& style) {
+  auto node = std::make_shared<DomNode>(id, kRootId, 0, "Text", "Text", style, std::make_shared<DomValueMap>(),
+                                        root_node);
+  return std::make_shared<DomInfo>(node, nullptr, nullptr);
+}
+
+TEST(RootNodeTest, UpdateDomNodesDiffAgainstBatchStyle) {
+  auto root_node = std::make_shared<RootNode>(kRootId);
+  auto style = std::make_shared<DomValueMap>();
+  (*style)["text"] = std::make_shared<HippyValue>("a");
+  (*style)["color"] = std::make_shared<HippyValue>("red");
+  root_node->CreateDomNodes({CreateUpdateInfo(root_node, kRootId + 1, style)}, false);
+  auto node = root_node->GetNode(kRootId + 1);
+
+  auto first_update = std::make_shared<DomValueMap>(*style);
+  (*first_update)["text"] = std::make_shared<HippyValue>("b");
+  root_node->UpdateDomNodes({CreateUpdateInfo(root_node, kRootId + 1, first_update)});
+  EXPECT_EQ(node->GetDiffStyle()->size(), 1);
+
+  // 节点与更新指令共享 style map，原地修改时写时复制
+  node->EmplaceStyleMap("color", HippyValue("blue"));
+  EXPECT_EQ(node->GetStyleMap()->at("color")->ToStringChecked(), "blue");
+  EXPECT_EQ(first_update->at("color")->ToStringChecked(), "red");
+
+  auto second_update = std::make_shared<DomValueMap>(*first_update);
+  (*second_update)["fontSize"] = std::make_shared<HippyValue>(12);
+  root_node->UpdateDomNodes({CreateUpdateInfo(root_node, kRootId + 1, second_update)});
+  auto diff = node->GetDiffStyle();
+  ASSERT_EQ(diff->size(), 2);
+  EXPECT_EQ(diff->at("text")->ToStringChecked(), "b");
+  EXPECT_EQ(diff->at("fontSize")->ToInt32Checked(), 12);
+}
+
+TEST(RootNodeTest, UpdateDomNodesBatch) {
+  constexpr uint32_t kUpdateCount = 1000;
+  auto root_node = std::make_shared<RootNode>(kRootId);
+  std::vector<std::shared_ptr<DomInfo>> create_infos;
+  std::vector<std::shared_ptr<DomInfo>> update_infos;
+  for (uint32_t k = 0; k < kUpdateCount; ++k) {
+    auto style = std::make_shared<DomValueMap>();
+    (*style)[kWidth] = std::make_shared<HippyValue>(100);
+    (*style)[kHeight] = std::make_shared<HippyValue>(10);
+    (*style)["color"] = std::make_shared<HippyValue>(0xff000000);
+    (*style)["backgroundColor"] = std::make_shared<HippyValue>(0xffffffff);
+    (*style)["text"] = std::make_shared<HippyValue>("hippy text content");
+    HippyValueArrayType transform;
+    for (int t = 0; t < 4; ++t) {
+      HippyValueObjectType object;
+      object["translateX"] = HippyValue(t);
+      transform.push_back(HippyValue(object));
+    }
+    (*style)["transform"] = std::make_shared<HippyValue>(transform);
+    create_infos.push_back(CreateUpdateInfo(root_node, k + kRootId + 1, style));
+    auto update = std::make_shared<DomValueMap>(*style);
+    (*update)["text"] = std::make_shared<HippyValue>("updated hippy text content");
+    update_infos.push_back(CreateUpdateInfo(root_node, k + kRootId + 1, update));
+  }
+  root_node->CreateDomNodes(std::move(create_infos), false);
+  root_node->UpdateDomNodes(std::move(update_infos));
+
+  auto node = root_node->GetNode(kUpdateCount + kRootId);
+  ASSERT_NE(node, nullptr);
+  ASSERT_EQ(node->GetDiffStyle()->size(), 1);
+  EXPECT_EQ(node->GetDiffStyle()->at("text")->ToStringChecked(), "updated hippy text content");
+}
+
+std::shared_ptr<DomInfo> CreateChildInfo(const std::shared_ptr<RootNode>& root_node, uint32_t id, uint32_t pid,
+                                         const std::shared_ptr<RefInfo>& ref_info) {
+  auto node = std::make_shared<DomNode>(id, pid, 0, "View", "View", std::make_shared<DomValueMap>(),
+                                        std::make_shared<DomValueMap>(), root_node);
+  return std::make_shared<DomInfo>(node, ref_info, nullptr);
+}
+
+TEST(RootNodeTest, LongListChildOperations) {
+  constexpr uint32_t kListId = kRootId + 1;
+  constexpr uint32_t count = 1000;
+  auto root_node = std::make_shared<RootNode>(kRootId);
+  root_node->CreateDomNodes({CreateChildInfo(root_node, kListId, kRootId, nullptr)}, false);
+  auto list = root_node->GetNode(kListId);
+
+  // 追加：每一项都插在上一项之后
+  std::vector<std::shared_ptr<DomInfo>> append_infos;
+  for (uint32_t k = 0; k < count; ++k) {
+    uint32_t id = kListId + 1 + k;
+    auto ref_info = k == 0 ? nullptr : std::make_shared<RefInfo>(id - 1, RelativeType::kBack);
+    append_infos.push_back(CreateChildInfo(root_node, id, kListId, ref_info));
+  }
+  root_node->CreateDomNodes(std::move(append_infos), false);
+
+  // 前插：每一项都插在当前第一项之前
+  std::vector<std::shared_ptr<DomInfo>> prepend_infos;
+  for (uint32_t k = 0; k < count; ++k) {
+    uint32_t id = kListId + 1 + count + k;
+    auto ref_id = k == 0 ? kListId + 1 : id - 1;
+    prepend_infos.push_back(
+        CreateChildInfo(root_node, id, kListId, std::make_shared<RefInfo>(ref_id, RelativeType::kFront)));
+  }
+  root_node->CreateDomNodes(std::move(prepend_infos), false);
+
+  ASSERT_EQ(list->GetChildCount(), 2 * count);
+  for (uint32_t k = 0; k < count; ++k) {
+    EXPECT_EQ(list->GetChildAt(k)->GetId(), kListId + 2 * count - k);
+    EXPECT_EQ(list->GetChildAt(count + k)->GetId(), kListId + 1 + k);
+  }
+  auto middle = list->GetChildAt(count);
+  EXPECT_EQ(middle->GetSelfIndex(), static_cast<int32_t>(count));
+  EXPECT_EQ(middle->GetRenderInfo().index, 0);
+
+  std::vector<std::shared_ptr<DomInfo>> delete_infos;
+  for (uint32_t k = 0; k < 2 * count; k += 2) {
+    delete_infos.push_back(std::make_shared<DomInfo>(list->GetChildAt(k), nullptr, nullptr));
+  }
+  root_node->DeleteDomNodes(std::move(delete_infos));
+
+  ASSERT_EQ(list->GetChildCount(), count);
+  for (uint32_t k = 0; k < count; ++k) {
+    EXPECT_EQ(list->GetChildAt(k)->GetSelfIndex(), static_cast<int32_t>(k));
+  }
+
+  // 尾部固定节点：每一项都插在同一个 footer 之前，相邻排序键的空隙会被反复耗尽
+  constexpr uint32_t kFooterId = kListId + 3 * count + 1;
+  auto last_ref = std::make_shared<RefInfo>(list->GetChildAt(count - 1)->GetId(), RelativeType::kBack);
+  root_node->CreateDomNodes({CreateChildInfo(root_node, kFooterId, kListId, last_ref)}, false);
+  std::vector<std::shared_ptr<DomInfo>> footer_infos;
+  for (uint32_t k = 0; k < count; ++k) {
+    footer_infos.push_back(CreateChildInfo(root_node, kFooterId + 1 + k, kListId,
+                                           std::make_shared<RefInfo>(kFooterId, RelativeType::kFront)));
+  }
+  root_node->CreateDomNodes(std::move(footer_infos), false);
+
+  ASSERT_EQ(list->GetChildCount(), 2 * count + 1);
+  for (uint32_t k = 0; k < count; ++k) {
+    EXPECT_EQ(list->GetChildAt(count + k)->GetId(), kFooterId + 1 + k);
+  }
+  EXPECT_EQ(list->GetChildAt(2 * count)->GetId(), kFooterId);
+  for (uint32_t k = 0; k < 2 * count + 1; ++k) {
+    EXPECT_EQ(list->GetChildAt(k)->GetSelfIndex(), static_cast<int32_t>(k));
+  }
+}
+
+int32_t ComputeDepth(const std::shared_ptr<DomNode>& node) {
+  int32_t depth = 1;
+  for (auto parent = node->GetParent(); parent; parent = parent->GetParent()) {
+    ++depth;
+  }
+  return depth;
+}
+
+TEST(RootNodeTest, StatisticsAndDepth) {
+  constexpr uint32_t kNodeCount = 10000;
+  auto root_node = CreateTree(kNodeCount);
+  auto statistics = root_node->GetStatistics();
+  EXPECT_EQ(statistics.total_node_count, kNodeCount + 1);
+  EXPECT_EQ(statistics.created_node_count, kNodeCount);
+
+  root_node->Traverse([](const std::shared_ptr<DomNode>& node) {
+    EXPECT_EQ(node->GetSelfDepth(), ComputeDepth(node));
+  });
+
+  uint32_t traverse_count = 0;
+  root_node->Traverse([&traverse_count](const std::shared_ptr<DomNode>&) { ++traverse_count; });
+  EXPECT_EQ(traverse_count, statistics.total_node_count);
+
+  // 同一父节点内移动，子树深度不变
+  auto moved = root_node->GetNode(kRootId + 2);
+  auto moved_child = moved->GetChildAt(0);
+  root_node->MoveDomNodes({std::make_shared<DomInfo>(moved, std::make_shared<RefInfo>(kRootId + kFanout,
+                                                                                      RelativeType::kBack), nullptr)});
+  EXPECT_EQ(moved->GetSelfIndex(), static_cast<int32_t>(kFanout) - 1);
+  EXPECT_EQ(moved_child->GetSelfDepth(), ComputeDepth(moved_child));
+  EXPECT_EQ(root_node->GetStatistics().moved_node_count, 1);
+
+  // 删除子树后节点总数同步减少
+  uint32_t subtree_count = 0;
+  std::vector<std::shared_ptr<DomNode>> stack = {moved};
+  while (!stack.empty()) {
+    auto node = stack.back();
+    stack.pop_back();
+    ++subtree_count;
+    stack.insert(stack.end(), node->GetChildren().begin(), node->GetChildren().end());
+  }
+  root_node->DeleteDomNodes({std::make_shared<DomInfo>(moved, nullptr, nullptr)});
+  statistics = root_node->GetStatistics();
+  EXPECT_EQ(statistics.total_node_count, kNodeCount + 1 - subtree_count);
+  EXPECT_EQ(statistics.deleted_node_count, 1);
+
+  // 插入到更深的位置时整棵子树的深度随之更新
+  auto target = root_node->GetNode(kRootId + 1);
+  auto detached = std::make_shared<DomNode>(kNodeCount + kRootId + 1, target->GetId(), root_node);
+  auto detached_child = std::make_shared<DomNode>(kNodeCount + kRootId + 2, detached->GetId(), root_node);
+  detached->AddChildByRefInfo(std::make_shared<DomInfo>(detached_child, nullptr, nullptr));
+  EXPECT_EQ(detached_child->GetSelfDepth(), 2);
+  target->AddChildByRefInfo(std::make_shared<DomInfo>(detached, nullptr, nullptr));
+  EXPECT_EQ(detached_child->GetSelfDepth(), ComputeDepth(target) + 2);
+}
+
+// 深度为 depth 的单链，返回最深的节点
+std::shared_ptr<DomNode> CreateChain(const std::shared_ptr<RootNode>& root_node, uint32_t depth) {
+  std::vector<std::shared_ptr<DomInfo>> infos;
+  for (uint32_t k = 0; k < depth; ++k) {
+    uint32_t id = kRootId + 1 + k;
+    infos.push_back(CreateChildInfo(root_node, id, id - 1, nullptr));
+  }
+  root_node->CreateDomNodes(std::move(infos), false);
+  return root_node->GetNode(kRootId + depth);
+}
+
+TEST(RootNodeTest, EventDispatchOrder) {
+  auto root_node = std::make_shared<RootNode>(kRootId);
+  auto leaf = CreateChain(root_node, 3);
+  auto middle = leaf->GetParent();
+  std::vector<std::pair<uint32_t, EventPhase>> calls;
+  auto record = [&calls](const std::shared_ptr<DomEvent>& event) {
+    calls.emplace_back(event->GetCurrentTarget().lock()->GetId(), event->GetEventPhase());
+  };
+  root_node->AddEventListener("click", 1, true, record);
+  middle->AddEventListener("click", 2, false, record);
+  leaf->AddEventListener("click", 3, false, [&](const std::shared_ptr<DomEvent>& event) {
+    record(event);
+    // 派发过程中移除同一列表中的监听不影响本次派发
+    leaf->RemoveEventListener("click", 4);
+  });
+  leaf->AddEventListener("click", 4, false, record);
+  EXPECT_TRUE(root_node->HasEventListenerInTree("click"));
+  EXPECT_FALSE(root_node->HasEventListenerInTree("scroll"));
+
+  leaf->HandleEvent(std::make_shared<DomEvent>("click", leaf, true, true));
+  std::vector<std::pair<uint32_t, EventPhase>> expected = {{kRootId, EventPhase::kCapturePhase},
+                                                           {leaf->GetId(), EventPhase::kAtTarget},
+                                                           {leaf->GetId(), EventPhase::kAtTarget},
+                                                           {middle->GetId(), EventPhase::kBubblePhase}};
+  EXPECT_EQ(calls, expected);
+
+  // 移除后不再回调
+  calls.clear();
+  middle->RemoveEventListener("click", 2);
+  leaf->HandleEvent(std::make_shared<DomEvent>("click", leaf, true, true));
+  expected = {{kRootId, EventPhase::kCapturePhase}, {leaf->GetId(), EventPhase::kAtTarget}};
+  EXPECT_EQ(calls, expected);
+
+  // 删除节点后其监听不再计入
+  root_node->RemoveEventListener("click", 1);
+  EXPECT_TRUE(root_node->HasEventListenerInTree("click"));
+  root_node->DeleteDomNodes({std::make_shared<DomInfo>(middle, nullptr, nullptr)});  // 连带删除 leaf
+  EXPECT_FALSE(root_node->HasEventListenerInTree("click"));
+}
+
+TEST(RootNodeTest, EventDispatchRootListener) {
+  constexpr uint32_t kDepth = 20;
+  constexpr int kDispatchTimes = 10;
+  auto root_node = std::make_shared<RootNode>(kRootId);
+  auto leaf = CreateChain(root_node, kDepth);
+  int call_count = 0;
+  root_node->AddEventListener("touchstart", 1, false, [&call_count](const std::shared_ptr<DomEvent>&) {
+    ++call_count;
+  });
+
+  auto dispatch = [&leaf](const std::string& name) {
+    for (int i = 0; i < kDispatchTimes; ++i) {
+      leaf->HandleEvent(std::make_shared<DomEvent>(name, leaf, true, true));
+    }
+  };
+  // 路径上没有任何监听的高频事件
+  dispatch("scroll");
+  EXPECT_EQ(call_count, 0);
+  // 捕获与冒泡经过整条路径，只有根节点监听
+  dispatch("touchstart");
+  EXPECT_EQ(call_count, kDispatchTimes);
+}
+
+class RecordingRenderManager : public RenderManager {
+ public:
+  using Call = std::pair<std::string, std::vector<uint32_t>>;
+
+  RecordingRenderManager() : RenderManager("RecordingRenderManager") {}
+
+  void CreateRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&& nodes) override {
+    Record("create", nodes);
+  }
+  void UpdateRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&& nodes) override {
+    Record("update", nodes);
+  }
+  void MoveRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&& nodes) override {
+    Record("move", nodes);
+  }
+  void DeleteRenderNode(std::weak_ptr<RootNode>, std::vector<std::shared_ptr<DomNode>>&& nodes) override {
+    Record("delete", nodes);
+  }
+  void UpdateLayout(std::weak_ptr<RootNode>, const std::vector<std::shared_ptr<DomNode>>&) override {}
+  void MoveRenderNode(std::weak_ptr<RootNode>, std::vector<int32_t>&&, int32_t, int32_t, int32_t) override {}
+  void EndBatch(std::weak_ptr<RootNode>) override {}
+  void BeforeLayout(std::weak_ptr<RootNode>) override {}
+  void AfterLayout(std::weak_ptr<RootNode>) override {}
+  void AddEventListener(std::weak_ptr<RootNode>, std::weak_ptr<DomNode>, const std::string&) override {}
+  void RemoveEventListener(std::weak_ptr<RootNode>, std::weak_ptr<DomNode>, const std::string&) override {}
+  void CallFunction(std::weak_ptr<RootNode>, std::weak_ptr<DomNode>, const std::string&, const DomArgument&,
+                    uint32_t) override {}
+
+  std::vector<Call> TakeCalls() { return std::move(calls_); }
+
+ private:
+  void Record(const std::string& op, const std::vector<std::shared_ptr<DomNode>>& nodes) {
+    std::vector<uint32_t> ids;
+    for (const auto& node : nodes) {
+      ids.push_back(node->GetId());
+    }
+    calls_.emplace_back(op, std::move(ids));
+  }
+
+  std::vector<Call> calls_;
+};
+
+std::shared_ptr<DomInfo> CreateTextUpdateInfo(const std::shared_ptr<RootNode>& root_node, uint32_t id,
+                                              const std::string& text) {
+  auto style = std::make_shared<DomValueMap>();
+  (*style)["text"] = std::make_shared<HippyValue>(text);
+  return CreateUpdateInfo(root_node, id, style);
+}
+
+TEST(RootNodeTest, CoalesceDomOperations) {
+  using Calls = std::vector<RecordingRenderManager::Call>;
+  constexpr uint32_t a = kRootId + 1, b = kRootId + 2, c = kRootId + 3, d = kRootId + 4;
+  auto root_node = std::make_shared<RootNode>(kRootId);
+  auto render_manager = std::make_shared<RecordingRenderManager>();
+  root_node->CreateDomNodes({CreateChildInfo(root_node, a, kRootId, nullptr)}, false);
+  root_node->CreateDomNodes({CreateChildInfo(root_node, b, kRootId, nullptr)}, false);
+  root_node->SyncWithRenderManager(render_manager);
+  // 相邻的同类操作合并为一次调用
+  EXPECT_EQ(render_manager->TakeCalls(), (Calls{{"create", {a, b}}}));
+
+  root_node->CreateDomNodes({CreateChildInfo(root_node, c, kRootId, nullptr),
+                             CreateChildInfo(root_node, d, kRootId, nullptr)}, false);
+  root_node->UpdateDomNodes({CreateTextUpdateInfo(root_node, c, "c1")});
+  root_node->UpdateDomNodes({CreateTextUpdateInfo(root_node, a, "a1")});
+  root_node->UpdateDomNodes({CreateTextUpdateInfo(root_node, a, "a2")});
+  auto b_node = root_node->GetNode(b);
+  root_node->MoveDomNodes({std::make_shared<DomInfo>(b_node, std::make_shared<RefInfo>(a, RelativeType::kFront),
+                                                     nullptr)});
+  root_node->DeleteDomNodes({std::make_shared<DomInfo>(root_node->GetNode(d), nullptr, nullptr)});
+  root_node->UpdateDomNodes({CreateTextUpdateInfo(root_node, b, "b1")});
+  root_node->UpdateDomNodes({CreateTextUpdateInfo(root_node, a, "a3")});
+  root_node->SyncWithRenderManager(render_manager);
+  // c 创建时已带上最终属性，d 创建后又删除，a 只更新一次
+  EXPECT_EQ(render_manager->TakeCalls(),
+            (Calls{{"create", {c}}, {"update", {a}}, {"move", {b}}, {"update", {b}}}));
+  EXPECT_EQ(root_node->GetNode(a)->GetDiffStyle()->at("text")->ToStringChecked(), "a3");
+
+  // 随祖先节点一起删除的新节点不需要创建
+  root_node->CreateDomNodes({CreateChildInfo(root_node, d, a, nullptr)}, false);
+  root_node->UpdateDomNodes({CreateTextUpdateInfo(root_node, b, "b2")});
+  root_node->DeleteDomNodes({std::make_shared<DomInfo>(root_node->GetNode(a), nullptr, nullptr)});
+  root_node->SyncWithRenderManager(render_manager);
+  EXPECT_EQ(render_manager->TakeCalls(), (Calls{{"update", {b}}, {"delete", {a}}}));
+}
+
+constexpr uint32_t kPageCount = 8;
+constexpr uint32_t kItemsPerPage = 50;
+
+// 根节点下一个 pager，pager 下 kPageCount 个固定宽高的页面，每个页面包含 kItemsPerPage 个需要测量的文本
+std::shared_ptr<RootNode> CreatePagerTree() {
+  constexpr uint32_t kPagerId = kRootId + 1;
+  auto root_node = std::make_shared<RootNode>(kRootId);
+  root_node->SetRootSize(1080, 1920);
+  std::vector<std::shared_ptr<DomInfo>> infos = {CreateChildInfo(root_node, kPagerId, kRootId, nullptr)};
+  auto id = kPagerId;
+  std::vector<uint32_t> item_ids;
+  for (uint32_t p = 0; p < kPageCount; ++p) {
+    auto page_info = CreateChildInfo(root_node, ++id, kPagerId, nullptr);
+    page_info->dom_node->EmplaceStyleMap(kWidth, HippyValue(1080));
+    page_info->dom_node->EmplaceStyleMap(kHeight, HippyValue(1920));
+    infos.push_back(page_info);
+    auto page_id = id;
+    for (uint32_t k = 0; k < kItemsPerPage; ++k) {
+      infos.push_back(CreateChildInfo(root_node, ++id, page_id, nullptr));
+      item_ids.push_back(id);
+    }
+  }
+  root_node->CreateDomNodes(std::move(infos), false);
+  for (auto item_id : item_ids) {
+    root_node->GetNode(item_id)->GetLayoutNode()->SetMeasureFunction(
+        [item_id](float width, LayoutMeasureMode, float, LayoutMeasureMode, void*) {
+          return LayoutSize{width, static_cast<float>(10 + item_id % 7)};
+        });
+  }
+  return root_node;
+}
+
+std::vector<std::tuple<uint32_t, float, float, float, float>> CollectLayoutResults(
+    const std::shared_ptr<RootNode>& root_node) {
+  std::vector<std::tuple<uint32_t, float, float, float, float>> results;
+  root_node->Traverse([&results](const std::shared_ptr<DomNode>& node) {
+    const auto& layout = node->GetLayoutResult();
+    results.emplace_back(node->GetId(), layout.left, layout.top, layout.width, layout.height);
+  });
+  return results;
+}
+
+TEST(RootNodeTest, ParallelLayoutPages) {
+  auto render_manager = std::make_shared<RecordingRenderManager>();
+  auto serial_root = CreatePagerTree();
+  serial_root->DoAndFlushLayout(render_manager);
+  auto expected = CollectLayoutResults(serial_root);
+
+  for (uint32_t concurrency : {1u, 3u, 7u}) {
+    auto worker_manager = std::make_shared<footstone::WorkerManager>(concurrency);
+    auto parallel_root = CreatePagerTree();
+    parallel_root->SetParallelLayoutWorkerManager(worker_manager, concurrency);
+    parallel_root->DoAndFlushLayout(render_manager);
+    // 结果与串行布局一致
+    EXPECT_EQ(CollectLayoutResults(parallel_root), expected);
+    parallel_root = nullptr;
+    worker_manager->Terminate();
+  }
+}
+
+constexpr uint32_t kTextCellCount = 200;
+constexpr uint32_t kDistinctTextCount = 10;
+
+// 根节点下一个列表，列表中 kTextCellCount 个文本 cell，只有 kDistinctTextCount 种不同的文本
+std::shared_ptr<RootNode> CreateTextListTree(bool use_measure_cache, std::atomic<int>& measure_count) {
+  constexpr uint32_t kListId = kRootId + 1;
+  auto root_node = std::make_shared<RootNode>(kRootId);
+  root_node->SetRootSize(1080, 1920);
+  std::vector<std::shared_ptr<DomInfo>> infos = {CreateChildInfo(root_node, kListId, kRootId, nullptr)};
+  for (uint32_t k = 0; k < kTextCellCount; ++k) {
+    auto style = std::make_shared<DomValueMap>();
+    (*style)[kText] = std::make_shared<HippyValue>("cell " + std::to_string(k % kDistinctTextCount));
+    (*style)[kFontSize] = std::make_shared<HippyValue>(16);
+    auto node = std::make_shared<DomNode>(kListId + 1 + k, kListId, 0, "Text", "Text", style,
+                                          std::make_shared<DomValueMap>(), root_node);
+    infos.push_back(std::make_shared<DomInfo>(node, nullptr, nullptr));
+  }
+  root_node->CreateDomNodes(std::move(infos), false);
+  for (uint32_t k = 0; k < kTextCellCount; ++k) {
+    auto node = root_node->GetNode(kListId + 1 + k);
+    std::weak_ptr<DomNode> weak_node = node;
+    MeasureFunction measure = [weak_node, &measure_count](float width, LayoutMeasureMode, float, LayoutMeasureMode,
+                                                          void*) {
+      ++measure_count;
+      auto text = weak_node.lock()->GetStyleMap()->at(kText)->ToStringChecked();
+      return LayoutSize{width, static_cast<float>(text.size())};
+    };
+    if (use_measure_cache) {
+      measure = root_node->GetMeasureCache()->Wrap(node, std::move(measure));
+    }
+    node->GetLayoutNode()->SetMeasureFunction(measure);
+  }
+  return root_node;
+}
+
+TEST(RootNodeTest, MeasureCacheTextCells) {
+  constexpr uint32_t kUpdatedId = kRootId + 2;
+  auto render_manager = std::make_shared<RecordingRenderManager>();
+  std::vector<std::tuple<uint32_t, float, float, float, float>> results[2];
+  int measure_counts[2][2];
+  for (bool use_measure_cache : {false, true}) {
+    std::atomic<int> measure_count{0};
+    auto root_node = CreateTextListTree(use_measure_cache, measure_count);
+    root_node->DoAndFlushLayout(render_manager);
+    measure_counts[use_measure_cache][0] = measure_count.exchange(0);
+
+    // 更新一个 cell 的文本，平台侧的 MarkTextDirty 会标脏布局节点
+    auto style = std::make_shared<DomValueMap>();
+    (*style)[kText] = std::make_shared<HippyValue>("updated cell");
+    (*style)[kFontSize] = std::make_shared<HippyValue>(16);
+    root_node->UpdateDomNodes({CreateUpdateInfo(root_node, kUpdatedId, style)});
+    root_node->GetNode(kUpdatedId)->GetLayoutNode()->MarkDirty();
+    root_node->DoAndFlushLayout(render_manager);
+    measure_counts[use_measure_cache][1] = measure_count.exchange(0);
+    results[use_measure_cache] = CollectLayoutResults(root_node);
+    EXPECT_EQ(root_node->GetNode(kUpdatedId)->GetLayoutResult().height, 12);
+
+    if (use_measure_cache) {
+      auto statistics = root_node->GetMeasureCache()->GetStatistics();
+      EXPECT_EQ(statistics.miss_count, static_cast<uint64_t>(measure_counts[1][0] + measure_counts[1][1]));
+      EXPECT_EQ(statistics.size, kDistinctTextCount + 1);
+      EXPECT_GT(statistics.hit_count, 0u);
+    }
+  }
+  // 首次布局每种文本只测量一次，更新后只测量变化的文本
+  EXPECT_EQ(measure_counts[1][0], static_cast<int>(kDistinctTextCount));
+  EXPECT_EQ(measure_counts[1][1], 1);
+  EXPECT_EQ(results[0], results[1]);
+}
+
+TEST(RootNodeTest, MeasureCacheEviction) {
+  auto cache = std::make_shared<MeasureCache>(2);
+  auto root_node = std::make_shared<RootNode>(kRootId);
+  auto node = std::make_shared<DomNode>(kRootId + 1, kRootId, 0, "Text", "Text", std::make_shared<DomValueMap>(),
+                                        std::make_shared<DomValueMap>(), root_node);
+  int measure_count = 0;
+  auto measure = cache->Wrap(node, [&measure_count](float width, LayoutMeasureMode, float, LayoutMeasureMode, void*) {
+    ++measure_count;
+    return LayoutSize{width, 1};
+  });
+  measure(10, LayoutMeasureMode::AtMost, NAN, LayoutMeasureMode::Undefined, nullptr);
+  measure(20, LayoutMeasureMode::AtMost, NAN, LayoutMeasureMode::Undefined, nullptr);
+  // 命中后 10 成为最近使用的结果，插入 30 时淘汰 20
+  EXPECT_EQ(measure(10, LayoutMeasureMode::AtMost, NAN, LayoutMeasureMode::Undefined, nullptr).width, 10);
+  measure(30, LayoutMeasureMode::AtMost, NAN, LayoutMeasureMode::Undefined, nullptr);
+  EXPECT_EQ(measure_count, 3);
+  measure(10, LayoutMeasureMode::AtMost, NAN, LayoutMeasureMode::Undefined, nullptr);
+  EXPECT_EQ(measure_count, 3);
+  measure(20, LayoutMeasureMode::AtMost, NAN, LayoutMeasureMode::Undefined, nullptr);
+  EXPECT_EQ(measure_count, 4);
+
+  // 属性变化后需 MarkTextDirty，否则仍使用旧的内容
+  node->EmplaceStyleMap(kText, HippyValue("text"));
+  measure(20, LayoutMeasureMode::AtMost, NAN, LayoutMeasureMode::Undefined, nullptr);
+  EXPECT_EQ(measure_count, 4);
+  cache->MarkTextDirty(node);
+  measure(20, LayoutMeasureMode::AtMost, NAN, LayoutMeasureMode::Undefined, nullptr);
+  EXPECT_EQ(measure_count, 5);
+  auto statistics = cache->GetStatistics();
+  EXPECT_EQ(statistics.hit_count, 3u);
+  EXPECT_EQ(statistics.miss_count, 5u);
+  EXPECT_EQ(statistics.size, 2u);
+}
+
+TEST(RootNodeTest, MeasureCacheNestedSpan) {
+  auto cache = std::make_shared<MeasureCache>();
+  auto root_node = std::make_shared<RootNode>(kRootId);
+  auto text = std::make_shared<DomNode>(kRootId + 1, kRootId, 0, "Text", "Text", std::make_shared<DomValueMap>(),
+                                        std::make_shared<DomValueMap>(), root_node);
+  auto span = std::make_shared<DomNode>(kRootId + 2, kRootId + 1, 0, "Text", "Text", std::make_shared<DomValueMap>(),
+                                        std::make_shared<DomValueMap>(), root_node);
+  span->EmplaceStyleMap(kText, HippyValue("a"));
+  text->AddChildByRefInfo(std::make_shared<DomInfo>(span, nullptr, nullptr));
+  int measure_count = 0;
+  auto measure = cache->Wrap(text, [&measure_count](float width, LayoutMeasureMode, float, LayoutMeasureMode, void*) {
+    ++measure_count;
+    return LayoutSize{width, 1};
+  });
+  measure(10, LayoutMeasureMode::AtMost, NAN, LayoutMeasureMode::Undefined, nullptr);
+  measure(10, LayoutMeasureMode::AtMost, NAN, LayoutMeasureMode::Undefined, nullptr);
+  EXPECT_EQ(measure_count, 1);
+
+  // span 的内容变化会使外层文本节点的内容失效
+  span->EmplaceStyleMap(kText, HippyValue("b"));
+  cache->MarkTextDirty(span);
+  measure(10, LayoutMeasureMode::AtMost, NAN, LayoutMeasureMode::Undefined, nullptr);
+  EXPECT_EQ(measure_count, 2);
+
+  // 内容恢复后按内容比较命中此前的结果
+  span->EmplaceStyleMap(kText, HippyValue("a"));
+  cache->MarkTextDirty(span);
+  measure(10, LayoutMeasureMode::AtMost, NAN, LayoutMeasureMode::Undefined, nullptr);
+  EXPECT_EQ(measure_count, 2);
+  EXPECT_EQ(cache->GetStatistics().size, 2u);
+}
+
+}  // namespace testing
+}  // namespace dom
+}  // namespace hippy
@@ -25,8 +25,12 @@
 
 #include <codecvt>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <random>
 
+#include "footstone/deserializer.h"
 #include "footstone/serializer.h"
 
 namespace hippy {
@@ -54,7 +58,7 @@ void CheckUint32(footstone::value::Serializer& serializer, uint32_t value, size_
   size_t variant_len = Variant<uint32_t>(value, expect, sizeof(uint32_t));
   size_t uint32_tag_length = 1;
   serializer.WriteUint32(value);
-  EXPECT_EQ(serializer.buffer_[last_size], static_cast<uint8_t>(tdf::base::SerializationTag::kUint32))
+  EXPECT_EQ(serializer.buffer_[last_size], static_cast<uint8_t>(footstone::value::SerializationTag::kUint32))
       << "Serializer WriteUint32() error.";
   EXPECT_EQ(serializer.buffer_size_ - last_size, variant_len + uint32_tag_length) << "Serializer buffer size error.";
   EXPECT_EQ(memcmp(serializer.buffer_ + last_size + uint32_tag_length, expect, variant_len), 0)
@@ -73,7 +77,7 @@ void CheckInt32(footstone::value::Serializer& serializer, int32_t value, size_t
   size_t variant_len = Variant<uint32_t>(zigzag, expect, sizeof(uint32_t));
   size_t int32_tag_length = 1;
   serializer.WriteInt32(value);
-  EXPECT_EQ(serializer.buffer_[last_size], static_cast<uint8_t>(tdf::base::SerializationTag::kInt32))
+  EXPECT_EQ(serializer.buffer_[last_size], static_cast<uint8_t>(footstone::value::SerializationTag::kInt32))
       << "Serializer WriteInt32() error.";
   EXPECT_EQ(serializer.buffer_size_ - last_size, variant_len + int32_tag_length) << "Serializer buffer size error.";
   EXPECT_EQ(memcmp(serializer.buffer_ + last_size + int32_tag_length, expect, variant_len), 0)
@@ -88,7 +92,7 @@ void CheckDouble(footstone::value::Serializer& serializer, double value, size_t
 
   size_t double_tag_length = 1;
   serializer.WriteDouble(value);
-  EXPECT_EQ(serializer.buffer_[last_size], static_cast<uint8_t>(tdf::base::SerializationTag::kDouble))
+  EXPECT_EQ(serializer.buffer_[last_size], static_cast<uint8_t>(footstone::value::SerializationTag::kDouble))
       << "Serializer WriteDouble() error.";
   EXPECT_EQ(serializer.buffer_size_ - last_size, sizeof(double) + double_tag_length) << "Serializer buffer size error.";
   EXPECT_EQ(memcmp(serializer.buffer_ + last_size + double_tag_length, expect, sizeof(double)), 0)
@@ -110,11 +114,11 @@ bool IsOneByteString(std::string& value) {
 
 void CheckString(footstone::value::Serializer& serializer, std::string value, size_t last_size) {
   size_t string_tag_length = 1;
-  tdf::base::SerializationTag tag = tdf::base::SerializationTag::kOneByteString;
+  footstone::value::SerializationTag tag = footstone::value::SerializationTag::kOneByteString;
 
   std::u16string u16;
   if (!IsOneByteString(value)) {
-    tag = tdf::base::SerializationTag::kTwoByteString;
+    tag = footstone::value::SerializationTag::kTwoByteString;
     std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> converter;
     u16 = converter.from_bytes(value);
   }
@@ -134,17 +138,18 @@ void CheckString(footstone::value::Serializer& serializer, std::string value, si
       << "Serializer WriteString() error.";
 
   if (IsOneByteString(value)) {
-    EXPECT_EQ(memcmp(serializer.buffer_ + last_size + string_tag_length + variant_len, value.c_str(), variant_len), 0)
+    EXPECT_EQ(memcmp(serializer.buffer_ + last_size + string_tag_length + variant_len, value.c_str(), string_length), 0)
         << "Serializer WriteString() error.";
   } else {
-    EXPECT_EQ(memcmp(serializer.buffer_ + last_size + string_tag_length + variant_len, u16.c_str(), variant_len), 0)
+    EXPECT_EQ(memcmp(serializer.buffer_ + last_size + string_tag_length + variant_len, u16.c_str(), string_length), 0)
         << "Serializer WriteString() error.";
   }
+  free(expect);
 }
 
 TEST(SerializerTest, Release) {
   footstone::value::Serializer serializer;
-  footstone::value::SerializerHelper(serializer.Release());
+  footstone::value::SerializerHelper::DestroyBuffer(serializer.Release());
   EXPECT_EQ(serializer.buffer_ == nullptr, true) << "Serializer buffer is not equal to nullptr.";
   EXPECT_EQ(serializer.buffer_size_, 0) << "Serializer buffer_size is not equal to 0.";
   EXPECT_EQ(serializer.buffer_capacity_, 0) << "Serializer buffer_capacity is not equal to 0.";
@@ -163,24 +168,24 @@ TEST(SerializerTest, WriteOddball) {
   footstone::value::Serializer serializer;
   serializer.WriteHeader();
 
-  serializer.WriteOddball(tdf::base::Oddball::kUndefined);
+  serializer.WriteOddball(footstone::value::Oddball::kUndefined);
   EXPECT_EQ(serializer.buffer_size_, 3) << "Serializer buffer_size is not equal to 3.";
-  EXPECT_EQ(serializer.buffer_[2], static_cast<uint8_t>(tdf::base::SerializationTag::kUndefined))
+  EXPECT_EQ(serializer.buffer_[2], static_cast<uint8_t>(footstone::value::SerializationTag::kUndefined))
       << "Serializer WriteTag Oddball::kUndefined error.";
 
-  serializer.WriteOddball(tdf::base::Oddball::kNull);
+  serializer.WriteOddball(footstone::value::Oddball::kNull);
   EXPECT_EQ(serializer.buffer_size_, 4) << "Serializer buffer_size is not equal to 4.";
-  EXPECT_EQ(serializer.buffer_[3], static_cast<uint8_t>(tdf::base::SerializationTag::kNull))
+  EXPECT_EQ(serializer.buffer_[3], static_cast<uint8_t>(footstone::value::SerializationTag::kNull))
       << "Serializer WriteTag Oddball::kNull error.";
 
-  serializer.WriteOddball(tdf::base::Oddball::kTrue);
+  serializer.WriteOddball(footstone::value::Oddball::kTrue);
   EXPECT_EQ(serializer.buffer_size_, 5) << "Serializer buffer_size is not equal to 5.";
-  EXPECT_EQ(serializer.buffer_[4], static_cast<uint8_t>(tdf::base::SerializationTag::kTrue))
+  EXPECT_EQ(serializer.buffer_[4], static_cast<uint8_t>(footstone::value::SerializationTag::kTrue))
       << "Serializer WriteTag Oddball::kTrue error.";
 
-  serializer.WriteOddball(tdf::base::Oddball::kFalse);
+  serializer.WriteOddball(footstone::value::Oddball::kFalse);
   EXPECT_EQ(serializer.buffer_size_, 6) << "Serializer buffer_size is not equal to 6.";
-  EXPECT_EQ(serializer.buffer_[5], static_cast<uint8_t>(tdf::base::SerializationTag::kFalse))
+  EXPECT_EQ(serializer.buffer_[5], static_cast<uint8_t>(footstone::value::SerializationTag::kFalse))
       << "Serializer WriteTag Oddball::kFalse error.";
 }
 
@@ -243,7 +248,7 @@ TEST(SerializerTest, WriteDouble) {
   // random
   std::random_device random_device;
   std::mt19937 mt19937(random_device());
-  std::uniform_int_distribution<double> distribution(std::numeric_limits<double>::min(),
+  std::uniform_real_distribution<double> distribution(std::numeric_limits<double>::min(),
                                                      std::numeric_limits<double>::max());
   for (int i = 0; i < 300; i++) {
     CheckDouble(serializer, distribution(mt19937), serializer.buffer_size_);
@@ -261,6 +266,210 @@ TEST(SerializerTest, WriteString) {
   CheckString(serializer, "01234567890", serializer.buffer_size_);
   CheckString(serializer, "腾讯", serializer.buffer_size_);
   CheckString(serializer, "动态化框架", serializer.buffer_size_);
+  // 各长度 utf8 序列的边界码点
+  CheckString(serializer, "\u0080\u07FF", serializer.buffer_size_);
+  CheckString(serializer, "\u0800\uD7FF\uE000\uFFFD", serializer.buffer_size_);
+  CheckString(serializer, "\U00010000\U0010FFFF", serializer.buffer_size_);
+}
+
+TEST(SerializerTest, BufferPool) {
+  auto pool = std::make_shared<footstone::value::SerializerBufferPool>();
+  footstone::value::HippyValue::HippyValueArrayType array;
+  for (int i = 0; i < 1000; ++i) {
+    array.push_back(footstone::value::HippyValue("serializer buffer pool"));
+  }
+  footstone::value::HippyValue hippy_value(array);
+
+  footstone::value::Serializer serializer(pool);
+  serializer.WriteHeader();
+  serializer.WriteValue(hippy_value);
+  auto buffer = serializer.GetBuffer();
+  auto stats = pool->GetStats();
+  EXPECT_EQ(stats.pool_hits, 0);
+  EXPECT_GT(stats.reallocations, 0);
+
+  // 批次间复用缓冲区，不再扩容
+  serializer.Reset();
+  serializer.WriteHeader();
+  serializer.WriteValue(hippy_value);
+  EXPECT_EQ(serializer.GetBuffer(), buffer);
+  EXPECT_EQ(pool->GetStats().reallocations, stats.reallocations);
+  EXPECT_EQ(pool->GetStats().bytes_serialized, buffer.second);
+
+  // 新的 Serializer 扩容时命中池中缓存的缓冲区
+  {
+    footstone::value::Serializer other(pool);
+    other.WriteHeader();
+    other.WriteValue(hippy_value);
+  }
+  stats = pool->GetStats();
+  EXPECT_GT(stats.pool_hits, 0);
+  EXPECT_EQ(stats.bytes_serialized, buffer.second * 2);
+  EXPECT_GT(stats.pooled_bytes, 0);
+
+  pool->SetHighWaterMark(0);
+  EXPECT_EQ(pool->GetStats().pooled_bytes, 0);
+}
+
+// 典型的模块调用参数：网络请求配置与一组列表数据
+footstone::value::HippyValue CreateModuleCallPayload() {
+  using HippyValue = footstone::value::HippyValue;
+  HippyValue::HippyValueObjectType headers;
+  headers["Content-Type"] = HippyValue("application/json");
+  headers["Accept-Language"] = HippyValue("zh-CN");
+  headers["X-Request-Id"] = HippyValue("6f1c2a9e-53b4-4c1d-9a7e-2b8f0d4e6a13");
+  HippyValue::HippyValueArrayType items;
+  for (int32_t i = 0; i < 20; ++i) {
+    HippyValue::HippyValueObjectType item;
+    item["id"] = HippyValue(i);
+    item["title"] = HippyValue("动态化框架 " + std::to_string(i));
+    item["score"] = HippyValue(i + 0.5);
+    item["visible"] = HippyValue(i % 2 == 0);
+    items.push_back(HippyValue(std::move(item)));
+  }
+  HippyValue::HippyValueObjectType payload;
+  payload["method"] = HippyValue("GET");
+  payload["url"] = HippyValue("https://hippyjs.org/api/feed?page=2&size=20");
+  payload["headers"] = HippyValue(std::move(headers));
+  payload["timeout"] = HippyValue(15000);
+  payload["items"] = HippyValue(std::move(items));
+  payload["extra"] = HippyValue::Null();
+  return HippyValue(std::move(payload));
+}
+
+// 按 js 引擎遍历对象的方式逐个写入
+void StreamValue(footstone::value::Serializer& serializer, const footstone::value::HippyValue& value) {
+  using HippyValue = footstone::value::HippyValue;
+  switch (value.GetType()) {
+    case HippyValue::Type::kUndefined:
+      serializer.WriteUndefined();
+      break;
+    case HippyValue::Type::kNull:
+      serializer.WriteNull();
+      break;
+    case HippyValue::Type::kBoolean:
+      serializer.WriteBoolean(value.ToBooleanChecked());
+      break;
+    case HippyValue::Type::kNumber: {
+      double d = 0;
+      value.ToDouble(d);
+      serializer.WriteNumber(d);
+      break;
+    }
+    case HippyValue::Type::kString: {
+      const auto& str = value.ToStringChecked();
+      serializer.WriteString(footstone::stringview::string_view::new_from_utf8(str.c_str(), str.length()));
+      break;
+    }
+    case HippyValue::Type::kArray: {
+      const auto& array = value.ToArrayChecked();
+      auto length = static_cast<uint32_t>(array.size());
+      serializer.WriteBeginDenseJSArray(length);
+      for (const auto& element : array) {
+        StreamValue(serializer, element);
+      }
+      serializer.WriteEndDenseJSArray(length);
+      break;
+    }
+    case HippyValue::Type::kObject: {
+      const auto& object = value.ToObjectChecked();
+      serializer.WriteBeginJSObject();
+      for (const auto& [key, element] : object) {
+        serializer.WriteString(footstone::stringview::string_view(key.c_str(), key.length()));
+        StreamValue(serializer, element);
+      }
+      serializer.WriteEndJSObject(static_cast<uint32_t>(object.size()));
+      break;
+    }
+  }
+}
+
+TEST(SerializerTest, StreamingWrite) {
+  auto payload = CreateModuleCallPayload();
+  footstone::value::Serializer expected;
+  expected.WriteHeader();
+  expected.WriteValue(payload);
+
+  footstone::value::Serializer serializer;
+  serializer.WriteHeader();
+  StreamValue(serializer, payload);
+  ASSERT_EQ(serializer.buffer_size_, expected.buffer_size_);
+  EXPECT_EQ(memcmp(serializer.buffer_, expected.buffer_, serializer.buffer_size_), 0);
+
+  // utf16 字符串不转码直接写入，与 utf8 写入的结果一致
+  footstone::value::Serializer u16_serializer;
+  u16_serializer.WriteString(footstone::stringview::string_view(u"动态化框架 \U0001F600 ñ"));
+  footstone::value::Serializer u8_serializer;
+  u8_serializer.WriteString(std::string("动态化框架 \U0001F600 ñ"));
+  ASSERT_EQ(u16_serializer.buffer_size_, u8_serializer.buffer_size_);
+  EXPECT_EQ(memcmp(u16_serializer.buffer_, u8_serializer.buffer_, u8_serializer.buffer_size_), 0);
+
+  // 整数写为 int32，其余写为 double
+  footstone::value::Serializer number_serializer;
+  number_serializer.WriteNumber(-3);
+  EXPECT_EQ(number_serializer.buffer_[0], static_cast<uint8_t>(footstone::value::SerializationTag::kInt32));
+  number_serializer.Reset();
+  number_serializer.WriteNumber(-0.0);
+  EXPECT_EQ(number_serializer.buffer_[0], static_cast<uint8_t>(footstone::value::SerializationTag::kDouble));
+  number_serializer.Reset();
+  number_serializer.WriteNumber(4294967296.0);
+  EXPECT_EQ(number_serializer.buffer_[0], static_cast<uint8_t>(footstone::value::SerializationTag::kDouble));
+  number_serializer.Reset();
+  number_serializer.WriteNumber(std::numeric_limits<int32_t>::min());
+  EXPECT_EQ(number_serializer.buffer_[0], static_cast<uint8_t>(footstone::value::SerializationTag::kInt32));
+
+  // NaN、Inf 与超出 int32 范围的值不能转换为 int32，必须写为 double
+  for (auto value : {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(),
+                     -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::max(),
+                     -std::numeric_limits<double>::max(), -2147483649.0, 2147483648.0}) {
+    number_serializer.Reset();
+    number_serializer.WriteNumber(value);
+    EXPECT_EQ(number_serializer.buffer_[0], static_cast<uint8_t>(footstone::value::SerializationTag::kDouble));
+  }
+}
+
+TEST(SerializerTest, ModuleCallPayloadViewDecode) {
+  using HippyValue = footstone::value::HippyValue;
+  using HippyValueView = footstone::value::HippyValueView;
+  auto payload = CreateModuleCallPayload();
+  footstone::value::Serializer serializer;
+  serializer.WriteHeader();
+  StreamValue(serializer, payload);
+  auto [buffer, size] = serializer.GetBuffer();
+
+  std::function<size_t(const HippyValue&)> count_values = [&count_values](const HippyValue& value) -> size_t {
+    size_t count = 1;
+    if (value.IsArray()) {
+      for (const auto& element : value.ToArrayChecked()) {
+        count += count_values(element);
+      }
+    } else if (value.IsObject()) {
+      for (const auto& [key, element] : value.ToObjectChecked()) {
+        count += count_values(element);
+      }
+    }
+    return count;
+  };
+  // 解码端逐个访问全部成员，对应由视图直接创建 js 值
+  std::function<size_t(const HippyValueView&)> walk = [&walk](const HippyValueView& view) -> size_t {
+    size_t count = 1;
+    HippyValueView key;
+    HippyValueView value;
+    for (size_t i = 0; i < view.GetLength(); ++i) {
+      if (view.GetType() == HippyValue::Type::kArray) {
+        EXPECT_TRUE(view.GetElement(i, value));
+      } else {
+        EXPECT_TRUE(view.GetPropertyAt(i, key, value));
+      }
+      count += walk(value);
+    }
+    return count;
+  };
+  footstone::value::Deserializer deserializer(buffer, size);
+  HippyValueView view;
+  ASSERT_TRUE(deserializer.ReadHeader());
+  ASSERT_TRUE(deserializer.ReadValueView(view));
+  EXPECT_EQ(walk(view), count_values(payload));
 }
 
 }  // namespace testing
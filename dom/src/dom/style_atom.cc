@@ -0,0 +1,125 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dom/style_atom.h"
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+
+#include "dom/node_props.h"
+
+namespace hippy {
+inline namespace dom {
+
+struct StyleAtomEntry {
+  std::string_view key;
+  StyleAtom atom;
+};
+
+// sorted by key, GetAtom binary searches it
+constexpr std::array<StyleAtomEntry, kStyleAtomCount> kStyleAtomTable = {{
+    {kAlignContent, StyleAtom::kAlignContent},
+    {kAlignItems, StyleAtom::kAlignItems},
+    {kAilgnSelf, StyleAtom::kAlignSelf},
+    {kAspectRatio, StyleAtom::kAspectRatio},
+    {kBackgroundColor, StyleAtom::kBackgroundColor},
+    {kBorderBottomColor, StyleAtom::kBorderBottomColor},
+    {kBorderBottomWidth, StyleAtom::kBorderBottomWidth},
+    {kBorderLeftColor, StyleAtom::kBorderLeftColor},
+    {kBorderLeftWidth, StyleAtom::kBorderLeftWidth},
+    {kBorderRadius, StyleAtom::kBorderRadius},
+    {kBorderRightColor, StyleAtom::kBorderRightColor},
+    {kBorderRightWidth, StyleAtom::kBorderRightWidth},
+    {kBorderTopColor, StyleAtom::kBorderTopColor},
+    {kBorderTopWidth, StyleAtom::kBorderTopWidth},
+    {kBorderWidth, StyleAtom::kBorderWidth},
+    {kBottom, StyleAtom::kBottom},
+    {kDirection, StyleAtom::kDirection},
+    {kDisplay, StyleAtom::kDisplay},
+    {kFlex, StyleAtom::kFlex},
+    {kFlexBasis, StyleAtom::kFlexBasis},
+    {kFlexDirection, StyleAtom::kFlexDirection},
+    {kFlexGrow, StyleAtom::kFlexGrow},
+    {kFlexShrink, StyleAtom::kFlexShrink},
+    {kFlexWrap, StyleAtom::kFlexWrap},
+    {kHeight, StyleAtom::kHeight},
+    {kJustifyContent, StyleAtom::kJustifyContent},
+    {kLeft, StyleAtom::kLeft},
+    {kMargin, StyleAtom::kMargin},
+    {kMarginBottom, StyleAtom::kMarginBottom},
+    {kMarginHorizontal, StyleAtom::kMarginHorizontal},
+    {kMarginLeft, StyleAtom::kMarginLeft},
+    {kMarginRight, StyleAtom::kMarginRight},
+    {kMarginTop, StyleAtom::kMarginTop},
+    {kMarginVertical, StyleAtom::kMarginVertical},
+    {kMaxHeight, StyleAtom::kMaxHeight},
+    {kMaxWidth, StyleAtom::kMaxWidth},
+    {kMinHeight, StyleAtom::kMinHeight},
+    {kMinWidth, StyleAtom::kMinWidth},
+    {kOpacity, StyleAtom::kOpacity},
+    {kOverflow, StyleAtom::kOverflow},
+    {kPadding, StyleAtom::kPadding},
+    {kPaddingBottom, StyleAtom::kPaddingBottom},
+    {kPaddingHorizontal, StyleAtom::kPaddingHorizontal},
+    {kPaddingLeft, StyleAtom::kPaddingLeft},
+    {kPaddingRight, StyleAtom::kPaddingRight},
+    {kPaddingTop, StyleAtom::kPaddingTop},
+    {kPaddingVertical, StyleAtom::kPaddingVertical},
+    {kPosition, StyleAtom::kPosition},
+    {kRight, StyleAtom::kRight},
+    {kTop, StyleAtom::kTop},
+    {kWidth, StyleAtom::kWidth},
+}};
+
+constexpr bool IsStyleAtomTableSorted() {
+  for (size_t i = 1; i < kStyleAtomTable.size(); ++i) {
+    if (!(kStyleAtomTable[i - 1].key < kStyleAtomTable[i].key)) return false;
+  }
+  return true;
+}
+
+static_assert(IsStyleAtomTableSorted(), "kStyleAtomTable must be sorted by key");
+
+// indexed by StyleAtom, built from kStyleAtomTable so both directions stay in sync
+constexpr std::array<const char*, kStyleAtomCount> MakeStyleAtomKeys() {
+  std::array<const char*, kStyleAtomCount> keys{};
+  for (const auto& entry : kStyleAtomTable) {
+    keys[static_cast<size_t>(entry.atom)] = entry.key.data();
+  }
+  return keys;
+}
+
+constexpr std::array<const char*, kStyleAtomCount> kStyleAtomKeys = MakeStyleAtomKeys();
+
+StyleAtom StyleAtomTable::GetAtom(std::string_view key) {
+  auto it = std::lower_bound(kStyleAtomTable.begin(), kStyleAtomTable.end(), key,
+                             [](const StyleAtomEntry& entry, std::string_view k) { return entry.key < k; });
+  if (it == kStyleAtomTable.end() || it->key != key) return StyleAtom::kUnknown;
+  return it->atom;
+}
+
+const char* StyleAtomTable::GetKey(StyleAtom atom) {
+  if (atom >= StyleAtom::kUnknown) return "";
+  return kStyleAtomKeys[static_cast<size_t>(atom)];
+}
+
+}  // namespace dom
+}  // namespace hippy
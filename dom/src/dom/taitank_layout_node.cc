@@ -25,6 +25,7 @@
 
 #include "footstone/logging.h"
 
+#include "dom/layout_style_parser.h"
 #include "dom/node_props.h"
 
 namespace hippy {
@@ -60,33 +61,6 @@ const std::map<std::string, FlexAlign> kAlignMap = {{"auto", FlexAlign::FLEX_ALI
                                                     {"space-between", FlexAlign::FLEX_ALIGN_SPACE_BETWEEN},
                                                     {"space-around", FlexAlign::FLEX_ALIGN_SPACE_AROUND}};
 
-const std::map<std::string, CSSDirection> kMarginMap = {{kMargin, CSSDirection::CSS_ALL},
-                                                        {kMarginVertical, CSSDirection::CSS_VERTICAL},
-                                                        {kMarginHorizontal, CSSDirection::CSS_HORIZONTAL},
-                                                        {kMarginLeft, CSSDirection::CSS_LEFT},
-                                                        {kMarginRight, CSSDirection::CSS_RIGHT},
-                                                        {kMarginTop, CSSDirection::CSS_TOP},
-                                                        {kMarginBottom, CSSDirection::CSS_BOTTOM}};
-
-const std::map<std::string, CSSDirection> kPaddingMap = {{kPadding, CSSDirection::CSS_ALL},
-                                                         {kPaddingVertical, CSSDirection::CSS_VERTICAL},
-                                                         {kPaddingHorizontal, CSSDirection::CSS_HORIZONTAL},
-                                                         {kPaddingLeft, CSSDirection::CSS_LEFT},
-                                                         {kPaddingRight, CSSDirection::CSS_RIGHT},
-                                                         {kPaddingTop, CSSDirection::CSS_TOP},
-                                                         {kPaddingBottom, CSSDirection::CSS_BOTTOM}};
-
-const std::map<std::string, CSSDirection> kPositionMap = {{kLeft, CSSDirection::CSS_LEFT},
-                                                          {kRight, CSSDirection::CSS_RIGHT},
-                                                          {kTop, CSSDirection::CSS_TOP},
-                                                          {kBottom, CSSDirection::CSS_BOTTOM}};
-
-const std::map<std::string, CSSDirection> kBorderMap = {{kBorderWidth, CSSDirection::CSS_ALL},
-                                                        {kBorderLeftWidth, CSSDirection::CSS_LEFT},
-                                                        {kBorderTopWidth, CSSDirection::CSS_TOP},
-                                                        {kBorderRightWidth, CSSDirection::CSS_RIGHT},
-                                                        {kBorderBottomWidth, CSSDirection::CSS_BOTTOM}};
-
 const std::map<std::string, PositionType> kPositionTypeMap = {{"relative", PositionType::POSITION_TYPE_RELATIVE},
                                                               {"absolute", PositionType::POSITION_TYPE_ABSOLUTE}};
 
@@ -112,48 +86,34 @@ TAITANK_GET_STYLE_DECL(Justify, FlexAlign, FlexAlign::FLEX_ALIGN_START)
 
 TAITANK_GET_STYLE_DECL(Align, FlexAlign, FlexAlign::FLEX_ALIGN_STRETCH)
 
-TAITANK_GET_STYLE_DECL(Margin, CSSDirection, CSSDirection::CSS_NONE)
-
-TAITANK_GET_STYLE_DECL(Padding, CSSDirection, CSSDirection::CSS_NONE)
-
-TAITANK_GET_STYLE_DECL(Border, CSSDirection, CSSDirection::CSS_NONE)
-
-TAITANK_GET_STYLE_DECL(Position, CSSDirection, CSSDirection::CSS_NONE)
-
 TAITANK_GET_STYLE_DECL(PositionType, PositionType, PositionType::POSITION_TYPE_RELATIVE)
 
 TAITANK_GET_STYLE_DECL(DisplayType, DisplayType, DisplayType::DISPLAY_TYPE_FLEX)
 
 TAITANK_GET_STYLE_DECL(Direction, TaitankDirection, TaitankDirection::DIRECTION_LTR)
 
-#define SET_STYLE_VALUE(NAME, DEFAULT)                                                         \
-  if (style_update.find(k##NAME) != style_update.end()) {                                      \
-    auto hippy_value = style_update.find(k##NAME)->second;                                     \
-    FOOTSTONE_DCHECK(hippy_value != nullptr);                                                  \
-    if (hippy_value != nullptr) {                                                              \
-      CheckValueType(hippy_value->GetType());                                                  \
-      float value = DEFAULT;                                                                   \
-      if (hippy_value->IsNumber()) value = static_cast<float>(hippy_value->ToDoubleChecked()); \
-      Set##NAME(value);                                                                        \
-    }                                                                                          \
-  } else {                                                                                     \
-    auto it = std::find(style_delete.begin(), style_delete.end(), k##NAME);                    \
-    if (it != style_delete.end()) Set##NAME(DEFAULT);                                          \
+#define SET_FLOAT_STYLE(SETTER, DEFAULT, NAME)                                \
+  if (hippy_value == nullptr) {                                               \
+    SETTER(DEFAULT);                                                          \
+  } else {                                                                    \
+    double value;                                                             \
+    if (hippy_value->ToDouble(value)) {                                       \
+      SETTER(static_cast<float>(value));                                      \
+    } else {                                                                  \
+      FOOTSTONE_LOG(WARNING) << "layout style " NAME " value is not correct"; \
+    }                                                                         \
   }
 
-#define SET_STYLE_VALUES(NAME, STYLENAME, DEFAULT)                                             \
-  if (style_update.find(k##STYLENAME) != style_update.end()) {                                 \
-    auto hippy_value = style_update.find(k##STYLENAME)->second;                                \
-    FOOTSTONE_DCHECK(hippy_value != nullptr);                                                  \
-    if (hippy_value != nullptr) {                                                              \
-      CheckValueType(hippy_value->GetType());                                                  \
-      float value = DEFAULT;                                                                   \
-      if (hippy_value->IsNumber()) value = static_cast<float>(hippy_value->ToDoubleChecked()); \
-      Set##NAME(GetStyle##NAME(k##STYLENAME), value);                                          \
-    }                                                                                          \
-  } else {                                                                                     \
-    auto it = std::find(style_delete.begin(), style_delete.end(), k##STYLENAME);               \
-    if (it != style_delete.end()) Set##NAME(GetStyle##NAME(k##STYLENAME), DEFAULT);            \
+#define SET_ENUM_STYLE(SETTER, GETTER, DEFAULT, NAME)                         \
+  if (hippy_value == nullptr) {                                               \
+    SETTER(DEFAULT);                                                          \
+  } else {                                                                    \
+    std::string value;                                                        \
+    if (hippy_value->ToString(value)) {                                       \
+      SETTER(GETTER(value));                                                  \
+    } else {                                                                  \
+      FOOTSTONE_LOG(WARNING) << "layout style " NAME " value is not correct"; \
+    }                                                                         \
   }
 
 static void CheckValueType(footstone::value::HippyValue::Type type) {
@@ -161,18 +121,10 @@ static void CheckValueType(footstone::value::HippyValue::Type type) {
     FOOTSTONE_DLOG(WARNING) << "Taitank Layout Node Value Type Error";
 }
 
-static float GetDefaultValue(
-    const std::string& key, const std::string& relation_key,
-    const std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>>& style_update,
-    const std::vector<std::string>& style_delete) {
-  auto it = std::find(style_delete.begin(), style_delete.end(), key);
-  if (it == style_delete.end()) return 0;
-
-  float default_value = 0;
-  if (style_update.find(relation_key) != style_update.end()) {
-    auto hippy_value = style_update.find(relation_key)->second;
-    if (hippy_value->IsNumber()) default_value = static_cast<float>(hippy_value->ToDoubleChecked());
-  }
+static float GetNumberValue(const footstone::value::HippyValue* hippy_value, float default_value) {
+  if (hippy_value == nullptr) return default_value;
+  CheckValueType(hippy_value->GetType());
+  if (hippy_value->IsNumber()) return static_cast<float>(hippy_value->ToDoubleChecked());
   return default_value;
 }
 
@@ -226,236 +178,116 @@ void TaitankLayoutNode::CalculateLayout(float parent_width, float parent_height,
 }
 
 void TaitankLayoutNode::SetLayoutStyles(
-    const std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>>& style_update,
+    const DomValueMap& style_update,
     const std::vector<std::string>& style_delete) {
   Parser(style_update, style_delete);
 }
 
 void TaitankLayoutNode::Parser(
-    const std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>>& style_update,
+    const DomValueMap& style_update,
     const std::vector<std::string>& style_delete) {
-  SET_STYLE_VALUE(Width, NAN)
-  SET_STYLE_VALUE(MinWidth, NAN)
-  SET_STYLE_VALUE(MaxWidth, NAN)
-  SET_STYLE_VALUE(Height, NAN)
-  SET_STYLE_VALUE(MinHeight, NAN)
-  SET_STYLE_VALUE(MaxHeight, NAN)
-
-  if (style_update.find(kFlex) != style_update.end()) {
-    FOOTSTONE_DCHECK(style_update.find(kFlex)->second != nullptr);
-    if (style_update.find(kFlex)->second != nullptr) {
-      double value;
-      if (style_update.find(kFlex)->second->ToDouble(value)) {
-        SetFlex(static_cast<float>(value));
-      } else {
-        FOOTSTONE_LOG(WARNING) << "layout flex value is not correct";
-      }
-    }
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kFlex);
-    if (it != style_delete.end()) SetFlex(0);
-  }
-
-  if (style_update.find(kFlexGrow) != style_update.end()) {
-    FOOTSTONE_DCHECK(style_update.find(kFlexGrow)->second != nullptr);
-    if (style_update.find(kFlexGrow)->second != nullptr) {
-      double value;
-      if (style_update.find(kFlexGrow)->second->ToDouble(value)) {
-        SetFlexGrow(static_cast<float>(value));
-      } else {
-        FOOTSTONE_LOG(WARNING) << "layout flex grow value is not correct";
-      }
-    }
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kFlexGrow);
-    if (it != style_delete.end()) SetFlexGrow(0);
-  }
-
-  if (style_update.find(kFlexShrink) != style_update.end()) {
-    FOOTSTONE_DCHECK(style_update.find(kFlexShrink)->second != nullptr);
-    if (style_update.find(kFlexShrink)->second != nullptr) {
-      double value;
-      if (style_update.find(kFlexShrink)->second->ToDouble(value)) {
-        SetFlexShrink(static_cast<float>(value));
-      } else {
-        FOOTSTONE_LOG(WARNING) << "layout flex shrink value is not correct";
-      }
-    }
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kFlexShrink);
-    if (it != style_delete.end()) SetFlexShrink(0);
-  }
-
-  if (style_update.find(kFlexBasis) != style_update.end()) {
-    FOOTSTONE_DCHECK(style_update.find(kFlexBasis)->second != nullptr);
-    if (style_update.find(kFlexBasis)->second != nullptr) {
-      double value;
-      if (style_update.find(kFlexBasis)->second->ToDouble(value)) {
-        SetFlexBasis(static_cast<float>(value));
-      } else {
-        FOOTSTONE_LOG(WARNING) << "layout flex basis value is not correct";
-      }
-    }
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kFlexBasis);
-    if (it != style_delete.end()) SetFlexBasis(NAN);
-  }
-
-  if (style_update.find(kDirection) != style_update.end()) {
-    if (style_update.find(kDirection)->second != nullptr) {
-      std::string value;
-      if (style_update.find(kDirection)->second->ToString(value)) {
-        SetDirection(GetStyleDirection(value));
-      } else {
-        FOOTSTONE_LOG(WARNING) << "layout direction value is not correct";
-      }
-    }
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kDirection);
-    if (it != style_delete.end()) SetDirection(TaitankDirection::DIRECTION_LTR);
-  }
-
-  if (style_update.find(kFlexDirection) != style_update.end()) {
-    FOOTSTONE_DCHECK(style_update.find(kFlexDirection)->second != nullptr);
-    if (style_update.find(kFlexDirection)->second != nullptr) {
-      std::string value;
-      if (style_update.find(kFlexDirection)->second->ToString(value)) {
-        SetFlexDirection(GetStyleFlexDirection(value));
-      } else {
-        FOOTSTONE_LOG(WARNING) << "layout style flex direction value is not correct";
-      }
-    }
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kFlexDirection);
-    if (it != style_delete.end()) SetFlexDirection(FlexDirection::FLEX_DIRECTION_COLUMN);
-  }
-
-  if (style_update.find(kFlexWrap) != style_update.end()) {
-    FOOTSTONE_DCHECK(style_update.find(kFlexWrap)->second != nullptr);
-    if (style_update.find(kFlexWrap)->second != nullptr) {
-      std::string value;
-      if (style_update.find(kFlexWrap)->second->ToString(value)) {
-        SetFlexWrap(GetStyleWrapMode(value));
-      } else {
-        FOOTSTONE_LOG(WARNING) << "layout style flex wrap value is not correct";
-      }
-    }
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kFlexWrap);
-    if (it != style_delete.end()) SetFlexWrap(FlexWrapMode::FLEX_NO_WRAP);
-  }
-
-  if (style_update.find(kAilgnSelf) != style_update.end()) {
-    FOOTSTONE_DCHECK(style_update.find(kAilgnSelf)->second != nullptr);
-    if (style_update.find(kAilgnSelf)->second != nullptr) {
-      std::string value;
-      if (style_update.find(kAilgnSelf)->second->ToString(value)) {
-        SetAlignSelf(GetStyleAlign(value));
-      } else {
-        FOOTSTONE_LOG(WARNING) << "layout style flex align self value is not correct";
-      }
-    }
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kAilgnSelf);
-    if (it != style_delete.end()) SetAlignSelf(FlexAlign::FLEX_ALIGN_AUTO);
-  }
-
-  if (style_update.find(kAlignItems) != style_update.end()) {
-    FOOTSTONE_DCHECK(style_update.find(kAlignItems)->second != nullptr);
-    if (style_update.find(kAlignItems)->second != nullptr) {
-      std::string value;
-      if (style_update.find(kAlignItems)->second->ToString(value)) {
-        SetAlignItems(GetStyleAlign(value));
-      } else {
-        FOOTSTONE_LOG(WARNING) << "layout style flex align items value is not correct";
-      }
-    }
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kAlignItems);
-    if (it != style_delete.end()) SetAlignItems(FlexAlign::FLEX_ALIGN_STRETCH);
-  }
-
-  if (style_update.find(kJustifyContent) != style_update.end()) {
-    FOOTSTONE_DCHECK(style_update.find(kJustifyContent)->second != nullptr);
-    if (style_update.find(kJustifyContent)->second != nullptr) {
-      std::string value;
-      if (style_update.find(kJustifyContent)->second->ToString(value)) {
-        SetJustifyContent(GetStyleJustify(value));
-      } else {
-        FOOTSTONE_LOG(WARNING) << "layout style flex justify content value is not correct";
-      }
-    }
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kJustifyContent);
-    if (it != style_delete.end()) SetJustifyContent(FlexAlign::FLEX_ALIGN_START);
-  }
-
-  if (style_update.find(kOverflow) != style_update.end()) {
-    FOOTSTONE_DCHECK(style_update.find(kOverflow)->second != nullptr);
-    if (style_update.find(kOverflow)->second != nullptr) {
-      std::string value;
-      if (style_update.find(kOverflow)->second->ToString(value)) {
-        SetOverflow(GetStyleOverflow(value));
-      } else {
-        FOOTSTONE_LOG(WARNING) << "layout style over flow value is not correct";
-      }
-    }
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kOverflow);
-    if (it != style_delete.end()) SetOverflow(OverflowType::OVERFLOW_VISIBLE);
-  }
-
-  if (style_update.find(kDisplay) != style_update.end()) {
-    std::string value;
-    if (style_update.find(kDisplay)->second != nullptr && style_update.find(kDisplay)->second->ToString(value)) {
-      SetDisplay(GetStyleDisplayType(value));
-    } else {
-      FOOTSTONE_LOG(WARNING) << "layout style display value is not correct";
-    }
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kOverflow);
-    if (it != style_delete.end()) SetDisplay(DisplayType::DISPLAY_TYPE_FLEX);
-  }
-
-  SET_STYLE_VALUES(Margin, Margin, 0)
-  SET_STYLE_VALUES(Margin, MarginVertical, 0)
-  SET_STYLE_VALUES(Margin, MarginHorizontal, 0)
-  SET_STYLE_VALUES(Margin, MarginLeft, GetDefaultValue(kMarginLeft, kMargin, style_update, style_delete))
-  SET_STYLE_VALUES(Margin, MarginRight, GetDefaultValue(kMarginRight, kMargin, style_update, style_delete))
-  SET_STYLE_VALUES(Margin, MarginTop, GetDefaultValue(kMarginTop, kMargin, style_update, style_delete))
-  SET_STYLE_VALUES(Margin, MarginBottom, GetDefaultValue(kMarginBottom, kMargin, style_update, style_delete))
-  SET_STYLE_VALUES(Padding, Padding, 0)
-  SET_STYLE_VALUES(Padding, PaddingVertical, 0)
-  SET_STYLE_VALUES(Padding, PaddingHorizontal, 0)
-  SET_STYLE_VALUES(Padding, PaddingLeft, GetDefaultValue(kPaddingLeft, kPadding, style_update, style_delete))
-  SET_STYLE_VALUES(Padding, PaddingRight, GetDefaultValue(kPaddingRight, kPadding, style_update, style_delete))
-  SET_STYLE_VALUES(Padding, PaddingTop, GetDefaultValue(kPaddingTop, kPadding, style_update, style_delete))
-  SET_STYLE_VALUES(Padding, PaddingBottom, GetDefaultValue(kPaddingBottom, kPadding, style_update, style_delete))
-  SET_STYLE_VALUES(Border, BorderWidth, 0)
-  SET_STYLE_VALUES(Border, BorderLeftWidth, GetDefaultValue(kBorderLeftWidth, kBorderWidth, style_update, style_delete))
-  SET_STYLE_VALUES(Border, BorderTopWidth, GetDefaultValue(kBorderTopWidth, kBorderWidth, style_update, style_delete))
-  SET_STYLE_VALUES(Border, BorderRightWidth,
-                   GetDefaultValue(kBorderRightWidth, kBorderWidth, style_update, style_delete))
-  SET_STYLE_VALUES(Border, BorderBottomWidth,
-                   GetDefaultValue(kBorderBottomWidth, kBorderWidth, style_update, style_delete))
-  SET_STYLE_VALUES(Position, Left, NAN)
-  SET_STYLE_VALUES(Position, Right, NAN)
-  SET_STYLE_VALUES(Position, Top, NAN)
-  SET_STYLE_VALUES(Position, Bottom, NAN)
-  if (style_update.find(kPosition) != style_update.end()) {
-    FOOTSTONE_DCHECK(style_update.find(kPosition)->second != nullptr);
-    if (style_update.find(kPosition)->second != nullptr) {
-      std::string value;
-      if (style_update.find(kPosition)->second->ToString(value)) {
-        SetPositionType(GetStylePositionType(value));
-      } else {
-        FOOTSTONE_LOG(WARNING) << "layout style position type value is not correct";
-      }
+  LayoutStyleParser parser(style_update, style_delete);
+  // 删除单边样式时，以本次更新的整体样式（如 margin）为默认值
+  auto get_edge_value = [&parser](const footstone::value::HippyValue* hippy_value, LayoutStyle all_style) {
+    return hippy_value != nullptr ? GetNumberValue(hippy_value, 0) : parser.GetDeletedEdgeDefault(all_style);
+  };
+  parser.Dispatch([this, &get_edge_value](LayoutStyle style, const footstone::value::HippyValue* hippy_value) {
+    switch (style) {
+      case LayoutStyle::kWidth: SetWidth(GetNumberValue(hippy_value, NAN)); break;
+      case LayoutStyle::kMinWidth: SetMinWidth(GetNumberValue(hippy_value, NAN)); break;
+      case LayoutStyle::kMaxWidth: SetMaxWidth(GetNumberValue(hippy_value, NAN)); break;
+      case LayoutStyle::kHeight: SetHeight(GetNumberValue(hippy_value, NAN)); break;
+      case LayoutStyle::kMinHeight: SetMinHeight(GetNumberValue(hippy_value, NAN)); break;
+      case LayoutStyle::kMaxHeight: SetMaxHeight(GetNumberValue(hippy_value, NAN)); break;
+      case LayoutStyle::kFlex: SET_FLOAT_STYLE(SetFlex, 0, "flex") break;
+      case LayoutStyle::kFlexGrow: SET_FLOAT_STYLE(SetFlexGrow, 0, "flex grow") break;
+      case LayoutStyle::kFlexShrink: SET_FLOAT_STYLE(SetFlexShrink, 0, "flex shrink") break;
+      case LayoutStyle::kFlexBasis: SET_FLOAT_STYLE(SetFlexBasis, NAN, "flex basis") break;
+      case LayoutStyle::kDirection:
+        SET_ENUM_STYLE(SetDirection, GetStyleDirection, TaitankDirection::DIRECTION_LTR, "direction")
+        break;
+      case LayoutStyle::kFlexDirection:
+        SET_ENUM_STYLE(SetFlexDirection, GetStyleFlexDirection, FlexDirection::FLEX_DIRECTION_COLUMN, "flex direction")
+        break;
+      case LayoutStyle::kFlexWrap:
+        SET_ENUM_STYLE(SetFlexWrap, GetStyleWrapMode, FlexWrapMode::FLEX_NO_WRAP, "flex wrap")
+        break;
+      case LayoutStyle::kAlignSelf:
+        SET_ENUM_STYLE(SetAlignSelf, GetStyleAlign, FlexAlign::FLEX_ALIGN_AUTO, "flex align self")
+        break;
+      case LayoutStyle::kAlignItems:
+        SET_ENUM_STYLE(SetAlignItems, GetStyleAlign, FlexAlign::FLEX_ALIGN_STRETCH, "flex align items")
+        break;
+      case LayoutStyle::kJustifyContent:
+        SET_ENUM_STYLE(SetJustifyContent, GetStyleJustify, FlexAlign::FLEX_ALIGN_START, "flex justify content")
+        break;
+      case LayoutStyle::kOverflow:
+        SET_ENUM_STYLE(SetOverflow, GetStyleOverflow, OverflowType::OVERFLOW_VISIBLE, "over flow")
+        break;
+      case LayoutStyle::kDisplay:
+        SET_ENUM_STYLE(SetDisplay, GetStyleDisplayType, DisplayType::DISPLAY_TYPE_FLEX, "display")
+        break;
+      case LayoutStyle::kMargin: SetMargin(CSSDirection::CSS_ALL, GetNumberValue(hippy_value, 0)); break;
+      case LayoutStyle::kMarginVertical: SetMargin(CSSDirection::CSS_VERTICAL, GetNumberValue(hippy_value, 0)); break;
+      case LayoutStyle::kMarginHorizontal:
+        SetMargin(CSSDirection::CSS_HORIZONTAL, GetNumberValue(hippy_value, 0));
+        break;
+      case LayoutStyle::kMarginLeft:
+        SetMargin(CSSDirection::CSS_LEFT, get_edge_value(hippy_value, LayoutStyle::kMargin));
+        break;
+      case LayoutStyle::kMarginRight:
+        SetMargin(CSSDirection::CSS_RIGHT, get_edge_value(hippy_value, LayoutStyle::kMargin));
+        break;
+      case LayoutStyle::kMarginTop:
+        SetMargin(CSSDirection::CSS_TOP, get_edge_value(hippy_value, LayoutStyle::kMargin));
+        break;
+      case LayoutStyle::kMarginBottom:
+        SetMargin(CSSDirection::CSS_BOTTOM, get_edge_value(hippy_value, LayoutStyle::kMargin));
+        break;
+      case LayoutStyle::kPadding: SetPadding(CSSDirection::CSS_ALL, GetNumberValue(hippy_value, 0)); break;
+      case LayoutStyle::kPaddingVertical:
+        SetPadding(CSSDirection::CSS_VERTICAL, GetNumberValue(hippy_value, 0));
+        break;
+      case LayoutStyle::kPaddingHorizontal:
+        SetPadding(CSSDirection::CSS_HORIZONTAL, GetNumberValue(hippy_value, 0));
+        break;
+      case LayoutStyle::kPaddingLeft:
+        SetPadding(CSSDirection::CSS_LEFT, get_edge_value(hippy_value, LayoutStyle::kPadding));
+        break;
+      case LayoutStyle::kPaddingRight:
+        SetPadding(CSSDirection::CSS_RIGHT, get_edge_value(hippy_value, LayoutStyle::kPadding));
+        break;
+      case LayoutStyle::kPaddingTop:
+        SetPadding(CSSDirection::CSS_TOP, get_edge_value(hippy_value, LayoutStyle::kPadding));
+        break;
+      case LayoutStyle::kPaddingBottom:
+        SetPadding(CSSDirection::CSS_BOTTOM, get_edge_value(hippy_value, LayoutStyle::kPadding));
+        break;
+      case LayoutStyle::kBorderWidth: SetBorder(CSSDirection::CSS_ALL, GetNumberValue(hippy_value, 0)); break;
+      case LayoutStyle::kBorderLeftWidth:
+        SetBorder(CSSDirection::CSS_LEFT, get_edge_value(hippy_value, LayoutStyle::kBorderWidth));
+        break;
+      case LayoutStyle::kBorderTopWidth:
+        SetBorder(CSSDirection::CSS_TOP, get_edge_value(hippy_value, LayoutStyle::kBorderWidth));
+        break;
+      case LayoutStyle::kBorderRightWidth:
+        SetBorder(CSSDirection::CSS_RIGHT, get_edge_value(hippy_value, LayoutStyle::kBorderWidth));
+        break;
+      case LayoutStyle::kBorderBottomWidth:
+        SetBorder(CSSDirection::CSS_BOTTOM, get_edge_value(hippy_value, LayoutStyle::kBorderWidth));
+        break;
+      case LayoutStyle::kLeft: SetPosition(CSSDirection::CSS_LEFT, GetNumberValue(hippy_value, NAN)); break;
+      case LayoutStyle::kRight: SetPosition(CSSDirection::CSS_RIGHT, GetNumberValue(hippy_value, NAN)); break;
+      case LayoutStyle::kTop: SetPosition(CSSDirection::CSS_TOP, GetNumberValue(hippy_value, NAN)); break;
+      case LayoutStyle::kBottom: SetPosition(CSSDirection::CSS_BOTTOM, GetNumberValue(hippy_value, NAN)); break;
+      case LayoutStyle::kPosition:
+        SET_ENUM_STYLE(SetPositionType, GetStylePositionType, PositionType::POSITION_TYPE_RELATIVE, "position type")
+        break;
+      default:
+        // aspectRatio 与 alignContent 只有 Yoga 支持
+        break;
     }
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kPosition);
-    if (it != style_delete.end()) SetPositionType(PositionType::POSITION_TYPE_RELATIVE);
-  }
+  });
 }
 
 void TaitankLayoutNode::SetMeasureFunction(MeasureFunction measure_function) {
@@ -0,0 +1,174 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "footstone/mpsc_queue.h"
+#include "footstone/task.h"
+#include "footstone/task_runner.h"
+#include "footstone/worker_manager.h"
+
+namespace hippy {
+namespace dom {
+namespace testing {
+
+using Task = footstone::Task;
+using TaskRunner = footstone::TaskRunner;
+using WorkerManager = footstone::WorkerManager;
+
+constexpr int kPostsPerProducer = 5000;
+
+TEST(TaskRunnerTest, MpscQueueIsEmpty) {
+  footstone::MpscQueue<Task> queue;
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_EQ(queue.Pop(), nullptr);
+  queue.Push(std::make_unique<Task>());
+  queue.Push(std::make_unique<Task>());
+  EXPECT_FALSE(queue.IsEmpty());
+  EXPECT_NE(queue.Pop(), nullptr);
+  EXPECT_FALSE(queue.IsEmpty());
+  EXPECT_NE(queue.Pop(), nullptr);
+  EXPECT_TRUE(queue.IsEmpty());
+  // stub 被重新放回队列后仍能正确判断
+  queue.Push(std::make_unique<Task>());
+  EXPECT_FALSE(queue.IsEmpty());
+  EXPECT_NE(queue.Pop(), nullptr);
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_EQ(queue.Pop(), nullptr);
+}
+
+TEST(TaskRunnerTest, PostTaskOrder) {
+  WorkerManager manager(1);
+  auto runner = manager.CreateTaskRunner("order");
+  constexpr int kTaskCount = 1000;
+  std::vector<int> order;
+  std::promise<void> done;
+  for (int i = 0; i < kTaskCount; ++i) {
+    runner->PostTask(std::make_unique<Task>([&order, &done, i] {
+      order.push_back(i);
+      if (i == kTaskCount - 1) {
+        done.set_value();
+      }
+    }));
+  }
+  done.get_future().wait();
+  manager.Terminate();
+  ASSERT_EQ(order.size(), kTaskCount);
+  for (int i = 0; i < kTaskCount; ++i) {
+    EXPECT_EQ(order[static_cast<size_t>(i)], i);
+  }
+}
+
+TEST(TaskRunnerTest, PostTaskContention) {
+  for (int producer_count : {1, 2, 4, 8}) {
+    WorkerManager manager(1);
+    auto runner = manager.CreateTaskRunner("contention");
+    // 每个生产者投递的 task 须按投递顺序执行
+    std::vector<int> last_sequence(static_cast<size_t>(producer_count), -1);
+    std::atomic<bool> in_order{true};
+    std::atomic<int> remaining{producer_count * kPostsPerProducer};
+    std::promise<void> done;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producer_count; ++p) {
+      producers.emplace_back([&, p] {
+        for (int i = 0; i < kPostsPerProducer; ++i) {
+          runner->PostTask(std::make_unique<Task>([&, p, i] {
+            auto& last = last_sequence[static_cast<size_t>(p)];
+            if (last + 1 != i) {
+              in_order = false;
+            }
+            last = i;
+            if (remaining.fetch_sub(1) == 1) {
+              done.set_value();
+            }
+          }));
+        }
+      });
+    }
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    done.get_future().wait();
+    manager.Terminate();
+    EXPECT_TRUE(in_order);
+  }
+}
+
+TEST(TaskRunnerTest, PostTaskWithResult) {
+  WorkerManager manager(1);
+  auto runner = manager.CreateTaskRunner("result");
+  auto future = runner->PostTaskWithResult([](int a, int b) { return a + b; }, 1, 2);
+  EXPECT_EQ(future.get(), 3);
+
+  // 只能移动的捕获可以直接投递
+  std::promise<int> promise;
+  auto value = promise.get_future();
+  runner->PostTask([promise = std::move(promise), data = std::make_unique<int>(42)]() mutable {
+    promise.set_value(*data);
+  });
+  EXPECT_EQ(value.get(), 42);
+  manager.Terminate();
+}
+
+TEST(TaskRunnerTest, PostTaskException) {
+  WorkerManager manager(1);
+  auto runner = manager.CreateTaskRunner("exception");
+  runner->PostTask([] { throw std::runtime_error("task error"); });
+  runner->PostTask([](int) { throw 1; }, 0);
+  // 异常被截获，Worker 继续执行后续任务
+  auto future = runner->PostTaskWithResult([] { return 1; });
+  EXPECT_EQ(future.get(), 1);
+  manager.Terminate();
+}
+
+TEST(TaskRunnerTest, PostClosure) {
+  constexpr int kPostCount = 100000;
+  WorkerManager manager(1);
+  auto runner = manager.CreateTaskRunner("closure");
+  std::atomic<int64_t> sum{0};
+  std::promise<void> done;
+  auto payload = std::make_shared<int>(1);
+  for (int i = 0; i < kPostCount; ++i) {
+    // 与 JS 到 DOM 的指令类似，捕获一个 shared_ptr 与若干标量
+    runner->PostTask([&sum, &done, payload, i] {
+      sum += *payload;
+      if (i == kPostCount - 1) {
+        done.set_value();
+      }
+    });
+  }
+  done.get_future().wait();
+  manager.Terminate();
+  EXPECT_EQ(sum, kPostCount);
+  // 投递后 payload 的引用随 task 一起释放
+  EXPECT_EQ(payload.use_count(), 1);
+}
+
+}  // namespace testing
+}  // namespace dom
+}  // namespace hippy
@@ -0,0 +1,117 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "footstone/task.h"
+#include "footstone/task_runner.h"
+#include "footstone/worker_manager.h"
+
+namespace hippy {
+namespace dom {
+namespace testing {
+
+using TaskRunner = footstone::TaskRunner;
+using WorkerManager = footstone::WorkerManager;
+
+constexpr uint32_t kWorkerCount = 4;
+constexpr uint32_t kRunnerCount = 16;
+constexpr int kTasksPerRunner = 100;
+constexpr auto kTaskCost = std::chrono::microseconds(100);
+
+class Latch {
+ public:
+  explicit Latch(int count) : count_(count) {}
+
+  void CountDown() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--count_ == 0) {
+      cv_.notify_all();
+    }
+  }
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return count_ == 0; });
+  }
+
+ private:
+  int count_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+// runner 按 round-robin 绑定到 Worker，只向第 0 个 Worker 上的 runner 投递任务，制造倾斜负载
+// 返回非可窃取的 runner 上的 task 是否串行执行
+bool RunSkewedLoad(bool enable_stealing, bool steal_safe) {
+  WorkerManager manager(kWorkerCount);
+  manager.SetWorkStealingEnabled(enable_stealing);
+  std::vector<std::shared_ptr<TaskRunner>> hot_runners;
+  std::vector<std::shared_ptr<TaskRunner>> runners;
+  for (uint32_t i = 0; i < kRunnerCount; ++i) {
+    auto runner = manager.CreateTaskRunner("runner");
+    runners.push_back(runner);
+    if (i % kWorkerCount == 0) {
+      runner->SetStealSafe(steal_safe);
+      hot_runners.push_back(runner);
+    }
+  }
+
+  auto task_count = static_cast<int>(hot_runners.size()) * kTasksPerRunner;
+  Latch latch(task_count);
+  std::vector<std::atomic<int>> running(hot_runners.size());
+  std::atomic<bool> serial{true};
+  for (int k = 0; k < kTasksPerRunner; ++k) {
+    for (size_t r = 0; r < hot_runners.size(); ++r) {
+      hot_runners[r]->PostTask(std::make_unique<footstone::Task>(
+          [&latch, &running, &serial, r, steal_safe] {
+            // 非可窃取的 runner 上的 task 必须串行执行
+            if (running[r].fetch_add(1) != 0 && !steal_safe) {
+              serial = false;
+            }
+            // 模拟 vfs 等阻塞型任务
+            std::this_thread::sleep_for(kTaskCost);
+            running[r].fetch_sub(1);
+            latch.CountDown();
+          }));
+    }
+  }
+  latch.Wait();
+  manager.Terminate();
+  return serial;
+}
+
+TEST(WorkerManagerTest, WorkStealingSkewedLoad) {
+  EXPECT_TRUE(RunSkewedLoad(false, false));
+  EXPECT_TRUE(RunSkewedLoad(true, false));
+  EXPECT_TRUE(RunSkewedLoad(true, true));
+}
+
+}  // namespace testing
+}  // namespace dom
+}  // namespace hippy
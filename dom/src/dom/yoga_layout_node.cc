@@ -22,6 +22,7 @@
 
 #include <map>
 
+#include "dom/layout_style_parser.h"
 #include "dom/node_props.h"
 #include "footstone/logging.h"
 #include "yoga/Yoga.h"
@@ -57,24 +58,32 @@ const std::map<std::string, YGAlign> kAlignMap = {{"auto", YGAlignAuto},
                                                   {"space-between", YGAlignSpaceBetween},
                                                   {"space-around", YGAlignSpaceAround}};
 
-const std::map<std::string, YGEdge> kMarginMap = {
-    {"margin", YGEdgeAll},         {"marginVertical", YGEdgeVertical}, {"marginHorizontal", YGEdgeHorizontal},
-    {"marginLeft", YGEdgeLeft},    {"marginTop", YGEdgeTop},           {"marginRight", YGEdgeRight},
-    {"marginBottom", YGEdgeBottom}};
-
-const std::map<std::string, YGEdge> kPaddingMap = {
-    {"padding", YGEdgeAll},         {"paddingVertical", YGEdgeVertical}, {"paddingHorizontal", YGEdgeHorizontal},
-    {"paddingLeft", YGEdgeLeft},    {"paddingTop", YGEdgeTop},           {"paddingRight", YGEdgeRight},
-    {"paddingBottom", YGEdgeBottom}};
-
-const std::map<std::string, YGEdge> kPositionMap = {
-    {"left", YGEdgeLeft}, {"top", YGEdgeTop}, {"right", YGEdgeRight}, {"bottom", YGEdgeBottom}};
-
-const std::map<std::string, YGEdge> kBorderMap = {{"borderWidth", YGEdgeAll},
-                                                  {"borderLeftWidth", YGEdgeLeft},
-                                                  {"borderTopWidth", YGEdgeTop},
-                                                  {"borderRightWidth", YGEdgeRight},
-                                                  {"borderBottomWidth", YGEdgeBottom}};
+const std::map<LayoutStyle, YGEdge> kMarginMap = {{LayoutStyle::kMargin, YGEdgeAll},
+                                                  {LayoutStyle::kMarginVertical, YGEdgeVertical},
+                                                  {LayoutStyle::kMarginHorizontal, YGEdgeHorizontal},
+                                                  {LayoutStyle::kMarginLeft, YGEdgeLeft},
+                                                  {LayoutStyle::kMarginTop, YGEdgeTop},
+                                                  {LayoutStyle::kMarginRight, YGEdgeRight},
+                                                  {LayoutStyle::kMarginBottom, YGEdgeBottom}};
+
+const std::map<LayoutStyle, YGEdge> kPaddingMap = {{LayoutStyle::kPadding, YGEdgeAll},
+                                                   {LayoutStyle::kPaddingVertical, YGEdgeVertical},
+                                                   {LayoutStyle::kPaddingHorizontal, YGEdgeHorizontal},
+                                                   {LayoutStyle::kPaddingLeft, YGEdgeLeft},
+                                                   {LayoutStyle::kPaddingTop, YGEdgeTop},
+                                                   {LayoutStyle::kPaddingRight, YGEdgeRight},
+                                                   {LayoutStyle::kPaddingBottom, YGEdgeBottom}};
+
+const std::map<LayoutStyle, YGEdge> kPositionMap = {{LayoutStyle::kLeft, YGEdgeLeft},
+                                                    {LayoutStyle::kTop, YGEdgeTop},
+                                                    {LayoutStyle::kRight, YGEdgeRight},
+                                                    {LayoutStyle::kBottom, YGEdgeBottom}};
+
+const std::map<LayoutStyle, YGEdge> kBorderMap = {{LayoutStyle::kBorderWidth, YGEdgeAll},
+                                                  {LayoutStyle::kBorderLeftWidth, YGEdgeLeft},
+                                                  {LayoutStyle::kBorderTopWidth, YGEdgeTop},
+                                                  {LayoutStyle::kBorderRightWidth, YGEdgeRight},
+                                                  {LayoutStyle::kBorderBottomWidth, YGEdgeBottom}};
 
 const std::map<std::string, YGPositionType> kPositionTypeMap = {
     {"static", YGPositionTypeStatic}, {"relative", YGPositionTypeRelative}, {"absolute", YGPositionTypeAbsolute}};
@@ -85,13 +94,13 @@ const std::map<std::string, YGDirection> kDirectionMap = {
     {"inherit", YGDirectionInherit}, {"ltr", YGDirectionLTR}, {"rtl", YGDirectionRTL}};
 
 #define YG_SET_NUMBER_PERCENT_AUTO_DECL(NAME)                                                      \
-  void YogaLayoutNode::SetYG##NAME(std::shared_ptr<footstone::value::HippyValue> hippy_value) {    \
-    footstone::value::HippyValue::Type type = hippy_value->GetType();                              \
+  void YogaLayoutNode::SetYG##NAME(const footstone::value::HippyValue& hippy_value) {              \
+    footstone::value::HippyValue::Type type = hippy_value.GetType();                               \
     if (type == footstone::value::HippyValue::Type::kNumber) {                                     \
-      auto value = static_cast<float>(hippy_value->ToDoubleChecked());                             \
+      auto value = static_cast<float>(hippy_value.ToDoubleChecked());                              \
       YGNodeStyleSet##NAME(yoga_node_, value);                                                     \
     } else if (type == footstone::value::HippyValue::Type::kString) {                              \
-      std::string value = hippy_value->ToStringChecked();                                          \
+      std::string value = hippy_value.ToStringChecked();                                           \
       if (value == "auto") {                                                                       \
         YGNodeStyleSet##NAME##Auto(yoga_node_);                                                    \
       } else if (value.at(value.length() - 1) == '%') {                                            \
@@ -105,13 +114,13 @@ const std::map<std::string, YGDirection> kDirectionMap = {
   }
 
 #define YG_SET_NUMBER_PERCENT_DECL(NAME)                                                           \
-  void YogaLayoutNode::SetYG##NAME(std::shared_ptr<footstone::value::HippyValue> hippy_value) {    \
-    footstone::value::HippyValue::Type type = hippy_value->GetType();                              \
+  void YogaLayoutNode::SetYG##NAME(const footstone::value::HippyValue& hippy_value) {              \
+    footstone::value::HippyValue::Type type = hippy_value.GetType();                               \
     if (type == footstone::value::HippyValue::Type::kNumber) {                                     \
-      auto value = static_cast<float>(hippy_value->ToDoubleChecked());                             \
+      auto value = static_cast<float>(hippy_value.ToDoubleChecked());                              \
       YGNodeStyleSet##NAME(yoga_node_, value);                                                     \
     } else if (type == footstone::value::HippyValue::Type::kString) {                              \
-      std::string value = hippy_value->ToStringChecked();                                          \
+      std::string value = hippy_value.ToStringChecked();                                           \
       if (value.at(value.length() - 1) == '%') {                                                   \
         YGNodeStyleSet##NAME##Percent(yoga_node_, std::stof(value.substr(0, value.length() - 1))); \
       } else {                                                                                     \
@@ -123,13 +132,13 @@ const std::map<std::string, YGDirection> kDirectionMap = {
   }
 
 #define YG_SET_EDGE_NUMBER_PRECENT_DECL(NAME)                                                                \
-  void YogaLayoutNode::SetYG##NAME(YGEdge edge, std::shared_ptr<footstone::value::HippyValue> hippy_value) { \
-    footstone::value::HippyValue::Type type = hippy_value->GetType();                                        \
+  void YogaLayoutNode::SetYG##NAME(YGEdge edge, const footstone::value::HippyValue& hippy_value) {           \
+    footstone::value::HippyValue::Type type = hippy_value.GetType();                                         \
     if (type == footstone::value::HippyValue::Type::kNumber) {                                               \
-      auto value = static_cast<float>(hippy_value->ToDoubleChecked());                                       \
+      auto value = static_cast<float>(hippy_value.ToDoubleChecked());                                        \
       YGNodeStyleSet##NAME(yoga_node_, edge, value);                                                         \
     } else if (type == footstone::value::HippyValue::Type::kString) {                                        \
-      std::string value = hippy_value->ToStringChecked();                                                    \
+      std::string value = hippy_value.ToStringChecked();                                                     \
       if (value.at(value.length() - 1) == '%') {                                                             \
         YGNodeStyleSet##NAME##Percent(yoga_node_, edge, std::stof(value.substr(0, value.length() - 1)));     \
       } else {                                                                                               \
@@ -141,13 +150,13 @@ const std::map<std::string, YGDirection> kDirectionMap = {
   }
 
 #define YG_SET_EDGE_NUMBER_PERCENT_AUTO_DECL(NAME)                                                           \
-  void YogaLayoutNode::SetYG##NAME(YGEdge edge, std::shared_ptr<footstone::value::HippyValue> hippy_value) { \
-    footstone::value::HippyValue::Type type = hippy_value->GetType();                                        \
+  void YogaLayoutNode::SetYG##NAME(YGEdge edge, const footstone::value::HippyValue& hippy_value) {           \
+    footstone::value::HippyValue::Type type = hippy_value.GetType();                                         \
     if (type == footstone::value::HippyValue::Type::kNumber) {                                               \
-      float value = static_cast<float>(hippy_value->ToDoubleChecked());                                      \
+      float value = static_cast<float>(hippy_value.ToDoubleChecked());                                       \
       YGNodeStyleSet##NAME(yoga_node_, edge, value);                                                         \
     } else if (type == footstone::value::HippyValue::Type::kString) {                                        \
-      std::string value = hippy_value->ToStringChecked();                                                    \
+      std::string value = hippy_value.ToStringChecked();                                                     \
       if (value == "auto") {                                                                                 \
         YGNodeStyleSet##NAME##Auto(yoga_node_, edge);                                                        \
       } else if (value.at(value.length() - 1) == '%') {                                                      \
@@ -161,10 +170,10 @@ const std::map<std::string, YGDirection> kDirectionMap = {
   }
 
 #define YG_SET_EDGE_NUMBER_DECL(NAME)                                                                        \
-  void YogaLayoutNode::SetYG##NAME(YGEdge edge, std::shared_ptr<footstone::value::HippyValue> hippy_value) { \
-    footstone::value::HippyValue::Type type = hippy_value->GetType();                                        \
+  void YogaLayoutNode::SetYG##NAME(YGEdge edge, const footstone::value::HippyValue& hippy_value) {           \
+    footstone::value::HippyValue::Type type = hippy_value.GetType();                                         \
     if (type == footstone::value::HippyValue::Type::kNumber) {                                               \
-      float value = static_cast<float>(hippy_value->ToDoubleChecked());                                      \
+      float value = static_cast<float>(hippy_value.ToDoubleChecked());                                       \
       YGNodeStyleSet##NAME(yoga_node_, edge, value);                                                         \
     } else {                                                                                                 \
       FOOTSTONE_DCHECK(false);                                                                               \
@@ -202,7 +211,7 @@ static YGAlign GetFlexAlign(const std::string& align) {
 }
 
 #define YG_EDGE_DECL(NAME)                                 \
-  static YGEdge Get##NAME##Edge(const std::string& edge) { \
+  static YGEdge Get##NAME##Edge(LayoutStyle edge) {        \
     auto iter = k##NAME##Map.find(edge);                   \
     FOOTSTONE_CHECK(iter != k##NAME##Map.end());           \
     return iter->second;                                   \
@@ -275,7 +284,7 @@ void YogaLayoutNode::CalculateLayout(float parent_width, float parent_height, Di
 }
 
 void YogaLayoutNode::SetLayoutStyles(
-    const std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>>& style_update,
+    const DomValueMap& style_update,
     const std::vector<std::string>& style_delete) {
   Parser(style_update, style_delete);
 }
@@ -404,300 +413,117 @@ bool YogaLayoutNode::IsDirty() { return YGNodeIsDirty(yoga_node_); }
 void YogaLayoutNode::Reset() { YGNodeReset(yoga_node_); }
 
 void YogaLayoutNode::Parser(
-    const std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>>& style_update,
+    const DomValueMap& style_update,
     const std::vector<std::string>& style_delete) {
-  if (style_update.find(kWidth) != style_update.end()) {
-    auto hippy_value = style_update.find(kWidth)->second;
-    SetYGWidth(hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kWidth);
-    if (it != style_delete.end()) YGNodeStyleSetWidth(yoga_node_, NAN);
-  }
-  if (style_update.find(kMinWidth) != style_update.end()) {
-    auto hippy_value = style_update.find(kMinWidth)->second;
-    SetYGMinWidth(hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kMinWidth);
-    if (it != style_delete.end()) YGNodeStyleSetMinWidth(yoga_node_, NAN);
-  }
-  if (style_update.find(kMaxWidth) != style_update.end()) {
-    auto hippy_value = style_update.find(kMaxWidth)->second;
-    SetYGMaxWidth(hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kMaxWidth);
-    if (it != style_delete.end()) YGNodeStyleSetMaxWidth(yoga_node_, NAN);
-  }
-  if (style_update.find(kHeight) != style_update.end()) {
-    auto hippy_value = style_update.find(kHeight)->second;
-    SetYGHeight(hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kHeight);
-    if (it != style_delete.end()) YGNodeStyleSetHeight(yoga_node_, NAN);
-  }
-  if (style_update.find(kMinHeight) != style_update.end()) {
-    auto hippy_value = style_update.find(kMinHeight)->second;
-    SetYGMinHeight(hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kMinHeight);
-    if (it != style_delete.end()) YGNodeStyleSetMinHeight(yoga_node_, NAN);
-  }
-  if (style_update.find(kMaxHeight) != style_update.end()) {
-    auto hippy_value = style_update.find(kMaxHeight)->second;
-    SetYGMaxHeight(hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kMaxHeight);
-    if (it != style_delete.end()) YGNodeStyleSetMaxHeight(yoga_node_, NAN);
-  }
-  if (style_update.find(kFlex) != style_update.end()) {
-    SetFlex(static_cast<float>(style_update.find(kFlex)->second->ToDoubleChecked()));
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kFlex);
-    if (it != style_delete.end()) YGNodeStyleSetFlex(yoga_node_, 0);
-  }
-  if (style_update.find(kFlexGrow) != style_update.end()) {
-    SetFlexGrow(static_cast<float>(style_update.find(kFlexGrow)->second->ToDoubleChecked()));
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kFlexGrow);
-    if (it != style_delete.end()) YGNodeStyleSetFlexGrow(yoga_node_, 0);
-  }
-  if (style_update.find(kFlexShrink) != style_update.end()) {
-    SetFlexShrink(static_cast<float>(style_update.find(kFlexShrink)->second->ToDoubleChecked()));
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kFlexShrink);
-    if (it != style_delete.end()) YGNodeStyleSetFlexShrink(yoga_node_, 0);
-  }
-  if (style_update.find(kFlexBasis) != style_update.end()) {
-    auto dom_value = style_update.find(kFlexBasis)->second;
-    SetYGFlexBasis(dom_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kFlexBasis);
-    if (it != style_delete.end()) YGNodeStyleSetFlexBasis(yoga_node_, NAN);
-  }
-  if (style_update.find(kDirection) != style_update.end()) {
-    SetDirection(GetDirection(style_update.find(kDirection)->second->ToStringChecked()));
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kDirection);
-    if (it != style_delete.end()) YGNodeStyleSetDirection(yoga_node_, YGDirectionLTR);
-  }
-  if (style_update.find(kFlexDirection) != style_update.end()) {
-    SetFlexDirection(GetFlexDirection(style_update.find(kFlexDirection)->second->ToStringChecked()));
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kFlexDirection);
-    if (it != style_delete.end()) YGNodeStyleSetFlexDirection(yoga_node_, YGFlexDirectionColumn);
-  }
-  if (style_update.find(kFlexWrap) != style_update.end()) {
-    SetFlexWrap(GetFlexWrapMode(style_update.find(kFlexWrap)->second->ToStringChecked()));
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kFlexWrap);
-    if (it != style_delete.end()) YGNodeStyleSetFlexWrap(yoga_node_, YGWrapNoWrap);
-  }
-  if (style_update.find(kAilgnSelf) != style_update.end()) {
-    SetAlignSelf(GetFlexAlign(style_update.find(kAilgnSelf)->second->ToStringChecked()));
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kAilgnSelf);
-    if (it != style_delete.end()) YGNodeStyleSetAlignSelf(yoga_node_, YGAlignAuto);
-  }
-  if (style_update.find(kAlignItems) != style_update.end()) {
-    SetAlignItems(GetFlexAlign(style_update.find(kAlignItems)->second->ToStringChecked()));
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kAlignItems);
-    if (it != style_delete.end()) YGNodeStyleSetAlignItems(yoga_node_, YGAlignStretch);
-  }
-  if (style_update.find(kJustifyContent) != style_update.end()) {
-    SetJustifyContent(GetFlexJustify(style_update.find(kJustifyContent)->second->ToStringChecked()));
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kJustifyContent);
-    if (it != style_delete.end()) YGNodeStyleSetJustifyContent(yoga_node_, YGJustifyFlexStart);
-  }
-  if (style_update.find(kOverflow) != style_update.end()) {
-    SetOverflow(GetFlexOverflow(style_update.find(kOverflow)->second->ToStringChecked()));
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kOverflow);
-    if (it != style_delete.end()) YGNodeStyleSetOverflow(yoga_node_, YGOverflowVisible);
-  }
-  if (style_update.find(kDisplay) != style_update.end()) {
-    SetDisplay(GetDisplayType(style_update.find(kDisplay)->second->ToStringChecked()));
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kDisplay);
-    if (it != style_delete.end()) YGNodeStyleSetDisplay(yoga_node_, YGDisplayFlex);
-  }
-  if (style_update.find(kMargin) != style_update.end()) {
-    auto hippy_value = style_update.find(kMargin)->second;
-    SetYGMargin(GetMarginEdge(kMargin), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kMargin);
-    if (it != style_delete.end()) YGNodeStyleSetMargin(yoga_node_, YGEdgeAll, 0);
-  }
-  if (style_update.find(kMarginVertical) != style_update.end()) {
-    auto hippy_value = style_update.find(kMarginVertical)->second;
-    SetYGMargin(GetMarginEdge(kMarginVertical), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kMarginVertical);
-    if (it != style_delete.end()) YGNodeStyleSetMargin(yoga_node_, YGEdgeVertical, 0);
-  }
-  if (style_update.find(kMarginHorizontal) != style_update.end()) {
-    auto hippy_value = style_update.find(kMarginHorizontal)->second;
-    SetYGMargin(GetMarginEdge(kMarginHorizontal), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kMarginHorizontal);
-    if (it != style_delete.end()) YGNodeStyleSetMargin(yoga_node_, YGEdgeHorizontal, 0);
-  }
-  if (style_update.find(kMarginLeft) != style_update.end()) {
-    auto hippy_value = style_update.find(kMarginLeft)->second;
-    SetYGMargin(GetMarginEdge(kMarginLeft), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kMarginLeft);
-    if (it != style_delete.end()) YGNodeStyleSetMargin(yoga_node_, YGEdgeLeft, 0);
-  }
-  if (style_update.find(kMarginRight) != style_update.end()) {
-    auto hippy_value = style_update.find(kMarginRight)->second;
-    SetYGMargin(GetMarginEdge(kMarginRight), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kMarginRight);
-    if (it != style_delete.end()) YGNodeStyleSetMargin(yoga_node_, YGEdgeRight, 0);
-  }
-  if (style_update.find(kMarginTop) != style_update.end()) {
-    auto hippy_value = style_update.find(kMarginTop)->second;
-    SetYGMargin(GetMarginEdge(kMarginTop), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kMarginTop);
-    if (it != style_delete.end()) YGNodeStyleSetMargin(yoga_node_, YGEdgeTop, 0);
-  }
-  if (style_update.find(kMarginBottom) != style_update.end()) {
-    auto hippy_value = style_update.find(kMarginBottom)->second;
-    SetYGMargin(GetMarginEdge(kMarginBottom), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kMarginBottom);
-    if (it != style_delete.end()) YGNodeStyleSetMargin(yoga_node_, YGEdgeBottom, 0);
-  }
-  if (style_update.find(kPadding) != style_update.end()) {
-    auto hippy_value = style_update.find(kPadding)->second;
-    SetYGPadding(GetPaddingEdge(kPadding), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kPadding);
-    if (it != style_delete.end()) YGNodeStyleSetPadding(yoga_node_, YGEdgeAll, 0);
-  }
-  if (style_update.find(kPaddingVertical) != style_update.end()) {
-    auto hippy_value = style_update.find(kPaddingVertical)->second;
-    SetYGPadding(GetPaddingEdge(kPaddingVertical), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kPaddingVertical);
-    if (it != style_delete.end()) YGNodeStyleSetPadding(yoga_node_, YGEdgeVertical, 0);
-  }
-  if (style_update.find(kPaddingHorizontal) != style_update.end()) {
-    auto hippy_value = style_update.find(kPaddingHorizontal)->second;
-    SetYGPadding(GetPaddingEdge(kPaddingHorizontal), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kPaddingHorizontal);
-    if (it != style_delete.end()) YGNodeStyleSetPadding(yoga_node_, YGEdgeHorizontal, 0);
-  }
-  if (style_update.find(kPaddingLeft) != style_update.end()) {
-    auto hippy_value = style_update.find(kPaddingLeft)->second;
-    SetYGPadding(GetPaddingEdge(kPaddingLeft), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kPaddingLeft);
-    if (it != style_delete.end()) YGNodeStyleSetPadding(yoga_node_, YGEdgeLeft, 0);
-  }
-  if (style_update.find(kPaddingRight) != style_update.end()) {
-    auto hippy_value = style_update.find(kPaddingRight)->second;
-    SetYGPadding(GetPaddingEdge(kPaddingRight), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kPaddingRight);
-    if (it != style_delete.end()) YGNodeStyleSetPadding(yoga_node_, YGEdgeRight, 0);
-  }
-  if (style_update.find(kPaddingTop) != style_update.end()) {
-    auto hippy_value = style_update.find(kPaddingTop)->second;
-    SetYGPadding(GetPaddingEdge(kPaddingTop), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kPaddingTop);
-    if (it != style_delete.end()) YGNodeStyleSetPadding(yoga_node_, YGEdgeTop, 0);
-  }
-  if (style_update.find(kPaddingBottom) != style_update.end()) {
-    auto hippy_value = style_update.find(kPaddingBottom)->second;
-    SetYGPadding(GetPaddingEdge(kPaddingBottom), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kPaddingBottom);
-    if (it != style_delete.end()) YGNodeStyleSetPadding(yoga_node_, YGEdgeBottom, 0);
-  }
-  if (style_update.find(kBorderWidth) != style_update.end()) {
-    auto hippy_value = style_update.find(kBorderWidth)->second;
-    SetYGBorder(GetBorderEdge(kBorderWidth), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kBorderWidth);
-    if (it != style_delete.end()) YGNodeStyleSetBorder(yoga_node_, YGEdgeAll, 0);
-  }
-  if (style_update.find(kBorderLeftWidth) != style_update.end()) {
-    auto hippy_value = style_update.find(kBorderLeftWidth)->second;
-    SetYGBorder(GetBorderEdge(kBorderLeftWidth), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kBorderLeftWidth);
-    if (it != style_delete.end()) YGNodeStyleSetBorder(yoga_node_, YGEdgeLeft, 0);
-  }
-  if (style_update.find(kBorderTopWidth) != style_update.end()) {
-    auto hippy_value = style_update.find(kBorderTopWidth)->second;
-    SetYGBorder(GetBorderEdge(kBorderTopWidth), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kBorderTopWidth);
-    if (it != style_delete.end()) YGNodeStyleSetBorder(yoga_node_, YGEdgeTop, 0);
-  }
-  if (style_update.find(kBorderRightWidth) != style_update.end()) {
-    auto hippy_value = style_update.find(kBorderRightWidth)->second;
-    SetYGBorder(GetBorderEdge(kBorderRightWidth), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kBorderRightWidth);
-    if (it != style_delete.end()) YGNodeStyleSetBorder(yoga_node_, YGEdgeRight, 0);
-  }
-  if (style_update.find(kBorderBottomWidth) != style_update.end()) {
-    auto hippy_value = style_update.find(kBorderBottomWidth)->second;
-    SetYGBorder(GetBorderEdge(kBorderBottomWidth), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kBorderBottomWidth);
-    if (it != style_delete.end()) YGNodeStyleSetBorder(yoga_node_, YGEdgeBottom, 0);
-  }
-  if (style_update.find(kLeft) != style_update.end()) {
-    auto hippy_value = style_update.find(kLeft)->second;
-    SetYGPosition(GetPositionEdge(kLeft), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kLeft);
-    if (it != style_delete.end()) YGNodeStyleSetPosition(yoga_node_, YGEdgeLeft, 0);
-  }
-  if (style_update.find(kRight) != style_update.end()) {
-    auto hippy_value = style_update.find(kRight)->second;
-    SetYGPosition(GetPositionEdge(kRight), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kRight);
-    if (it != style_delete.end()) YGNodeStyleSetPosition(yoga_node_, YGEdgeRight, 0);
-  }
-  if (style_update.find(kTop) != style_update.end()) {
-    auto hippy_value = style_update.find(kTop)->second;
-    SetYGPosition(GetPositionEdge(kTop), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kTop);
-    if (it != style_delete.end()) YGNodeStyleSetPosition(yoga_node_, YGEdgeTop, 0);
-  }
-  if (style_update.find(kBottom) != style_update.end()) {
-    auto hippy_value = style_update.find(kBottom)->second;
-    SetYGPosition(GetPositionEdge(kBottom), hippy_value);
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kBottom);
-    if (it != style_delete.end()) YGNodeStyleSetPosition(yoga_node_, YGEdgeBottom, 0);
-  }
-  if (style_update.find(kPosition) != style_update.end()) {
-    SetPositionType(GetPositionType(style_update.find(kPosition)->second->ToStringChecked()));
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kPosition);
-    if (it != style_delete.end()) YGNodeStyleSetPositionType(yoga_node_, YGPositionTypeRelative);
-  }
-  if (style_update.find(kAspectRatio) != style_update.end()) {
-    SetAspectRatio(static_cast<float>(style_update.find(kAspectRatio)->second->ToDoubleChecked()));
-  } else {
-    auto it = std::find(style_delete.begin(), style_delete.end(), kAspectRatio);
-    if (it != style_delete.end()) YGNodeStyleSetAspectRatio(yoga_node_, 0);
-  }
-
-  if (style_update.find(kAlignContent) != style_update.end()) {
-    SetAlignContent(GetFlexAlign(style_update.find(kAlignContent)->second->ToStringChecked()));
-  }
+  LayoutStyleParser parser(style_update, style_delete);
+  parser.Dispatch([this](LayoutStyle style, const footstone::value::HippyValue* hippy_value) {
+    switch (style) {
+      case LayoutStyle::kWidth:
+        hippy_value ? SetYGWidth(*hippy_value) : YGNodeStyleSetWidth(yoga_node_, NAN);
+        break;
+      case LayoutStyle::kMinWidth:
+        hippy_value ? SetYGMinWidth(*hippy_value) : YGNodeStyleSetMinWidth(yoga_node_, NAN);
+        break;
+      case LayoutStyle::kMaxWidth:
+        hippy_value ? SetYGMaxWidth(*hippy_value) : YGNodeStyleSetMaxWidth(yoga_node_, NAN);
+        break;
+      case LayoutStyle::kHeight:
+        hippy_value ? SetYGHeight(*hippy_value) : YGNodeStyleSetHeight(yoga_node_, NAN);
+        break;
+      case LayoutStyle::kMinHeight:
+        hippy_value ? SetYGMinHeight(*hippy_value) : YGNodeStyleSetMinHeight(yoga_node_, NAN);
+        break;
+      case LayoutStyle::kMaxHeight:
+        hippy_value ? SetYGMaxHeight(*hippy_value) : YGNodeStyleSetMaxHeight(yoga_node_, NAN);
+        break;
+      case LayoutStyle::kFlex:
+        SetFlex(hippy_value ? static_cast<float>(hippy_value->ToDoubleChecked()) : 0);
+        break;
+      case LayoutStyle::kFlexGrow:
+        SetFlexGrow(hippy_value ? static_cast<float>(hippy_value->ToDoubleChecked()) : 0);
+        break;
+      case LayoutStyle::kFlexShrink:
+        SetFlexShrink(hippy_value ? static_cast<float>(hippy_value->ToDoubleChecked()) : 0);
+        break;
+      case LayoutStyle::kFlexBasis:
+        hippy_value ? SetYGFlexBasis(*hippy_value) : YGNodeStyleSetFlexBasis(yoga_node_, NAN);
+        break;
+      case LayoutStyle::kDirection:
+        SetDirection(hippy_value ? GetDirection(hippy_value->ToStringChecked()) : YGDirectionLTR);
+        break;
+      case LayoutStyle::kFlexDirection:
+        SetFlexDirection(hippy_value ? GetFlexDirection(hippy_value->ToStringChecked()) : YGFlexDirectionColumn);
+        break;
+      case LayoutStyle::kFlexWrap:
+        SetFlexWrap(hippy_value ? GetFlexWrapMode(hippy_value->ToStringChecked()) : YGWrapNoWrap);
+        break;
+      case LayoutStyle::kAlignSelf:
+        SetAlignSelf(hippy_value ? GetFlexAlign(hippy_value->ToStringChecked()) : YGAlignAuto);
+        break;
+      case LayoutStyle::kAlignItems:
+        SetAlignItems(hippy_value ? GetFlexAlign(hippy_value->ToStringChecked()) : YGAlignStretch);
+        break;
+      case LayoutStyle::kJustifyContent:
+        SetJustifyContent(hippy_value ? GetFlexJustify(hippy_value->ToStringChecked()) : YGJustifyFlexStart);
+        break;
+      case LayoutStyle::kOverflow:
+        SetOverflow(hippy_value ? GetFlexOverflow(hippy_value->ToStringChecked()) : YGOverflowVisible);
+        break;
+      case LayoutStyle::kDisplay:
+        SetDisplay(hippy_value ? GetDisplayType(hippy_value->ToStringChecked()) : YGDisplayFlex);
+        break;
+      case LayoutStyle::kMargin:
+      case LayoutStyle::kMarginVertical:
+      case LayoutStyle::kMarginHorizontal:
+      case LayoutStyle::kMarginLeft:
+      case LayoutStyle::kMarginRight:
+      case LayoutStyle::kMarginTop:
+      case LayoutStyle::kMarginBottom: {
+        auto edge = GetMarginEdge(style);
+        hippy_value ? SetYGMargin(edge, *hippy_value) : YGNodeStyleSetMargin(yoga_node_, edge, 0);
+        break;
+      }
+      case LayoutStyle::kPadding:
+      case LayoutStyle::kPaddingVertical:
+      case LayoutStyle::kPaddingHorizontal:
+      case LayoutStyle::kPaddingLeft:
+      case LayoutStyle::kPaddingRight:
+      case LayoutStyle::kPaddingTop:
+      case LayoutStyle::kPaddingBottom: {
+        auto edge = GetPaddingEdge(style);
+        hippy_value ? SetYGPadding(edge, *hippy_value) : YGNodeStyleSetPadding(yoga_node_, edge, 0);
+        break;
+      }
+      case LayoutStyle::kBorderWidth:
+      case LayoutStyle::kBorderLeftWidth:
+      case LayoutStyle::kBorderTopWidth:
+      case LayoutStyle::kBorderRightWidth:
+      case LayoutStyle::kBorderBottomWidth: {
+        auto edge = GetBorderEdge(style);
+        hippy_value ? SetYGBorder(edge, *hippy_value) : YGNodeStyleSetBorder(yoga_node_, edge, 0);
+        break;
+      }
+      case LayoutStyle::kLeft:
+      case LayoutStyle::kRight:
+      case LayoutStyle::kTop:
+      case LayoutStyle::kBottom: {
+        auto edge = GetPositionEdge(style);
+        hippy_value ? SetYGPosition(edge, *hippy_value) : YGNodeStyleSetPosition(yoga_node_, edge, 0);
+        break;
+      }
+      case LayoutStyle::kPosition:
+        SetPositionType(hippy_value ? GetPositionType(hippy_value->ToStringChecked()) : YGPositionTypeRelative);
+        break;
+      case LayoutStyle::kAspectRatio:
+        SetAspectRatio(hippy_value ? static_cast<float>(hippy_value->ToDoubleChecked()) : 0);
+        break;
+      case LayoutStyle::kAlignContent:
+        if (hippy_value) SetAlignContent(GetFlexAlign(hippy_value->ToStringChecked()));
+        break;
+      default:
+        break;
+    }
+  });
 }
 
 YG_SET_NUMBER_PERCENT_AUTO_DECL(FlexBasis)
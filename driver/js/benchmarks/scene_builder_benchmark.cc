@@ -0,0 +1,160 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dom/diff_utils.h"
+#include "driver/base/js_convert_utils.h"
+#include "driver/napi/js_ctx.h"
+#include "driver/vm/js_vm.h"
+#include "footstone/hippy_value.h"
+#include "footstone/logging.h"
+#include "footstone/string_view.h"
+
+#ifdef JS_V8
+#include "driver/vm/v8/v8_vm.h"
+#endif
+
+/*
+ * SceneBuilder.create 的 props 转换基准：1k 个节点，每个节点带 10 项 style 与若干 ext 属性，
+ * 与 scene_builder_module.cc 中 GetNodeProps 的单遍转换相同，并与此前先 ToDomValue 整体转换再拆分的做法对比
+ */
+
+using Ctx = hippy::napi::Ctx;
+using CtxValue = hippy::napi::CtxValue;
+using DomValueMap = hippy::dom::DomValueMap;
+using HippyValue = footstone::value::HippyValue;
+using string_view = footstone::stringview::string_view;
+
+constexpr uint32_t kNodeCount = 1000;
+constexpr int kIterations = 50;
+constexpr char kNodePropertyProps[] = "props";
+constexpr char kNodePropertyStyle[] = "style";
+
+constexpr char kCreateNodesScript[] = R"((function() {
+  var nodes = [];
+  for (var i = 0; i < 1000; i++) {
+    nodes.push({
+      id: i + 2, pId: 1, index: i, name: 'View', tagName: 'div',
+      props: {
+        style: {
+          width: 100, height: 50, marginTop: 4, paddingLeft: 8, flexDirection: 'row',
+          alignItems: 'center', backgroundColor: 4294967295, borderRadius: 6, opacity: 1,
+          transform: [{ translateX: i }],
+        },
+        attributes: { id: 'item' + i, class: 'list-item' },
+        text: 'item ' + i,
+        onClick: true,
+        accessible: true,
+      },
+    });
+  }
+  return nodes;
+})())";
+
+namespace {
+
+std::shared_ptr<hippy::VM> CreateBenchmarkVM() {
+#ifdef JS_V8
+  auto param = std::make_shared<hippy::V8VMInitParam>();
+#else
+  auto param = std::make_shared<hippy::VM::VMInitParam>();
+#endif
+  return hippy::CreateVM(param);
+}
+
+// 此前的做法：整体转换为 HippyValue，再拷贝到 style 与 ext 两个 map
+bool ConvertByDomValue(const std::shared_ptr<Ctx>& ctx, const std::shared_ptr<CtxValue>& props,
+                       DomValueMap& style_map, DomValueMap& ext_map) {
+  auto props_obj = hippy::ToDomValue(ctx, props);
+  if (!props_obj || !props_obj->IsObject()) {
+    return false;
+  }
+  for (const auto& [key, value] : props_obj->ToObjectChecked()) {
+    if (key == kNodePropertyStyle) {
+      if (value.IsObject()) {
+        for (const auto& [style_key, style_value] : value.ToObjectChecked()) {
+          style_map[style_key] = std::make_shared<HippyValue>(style_value);
+        }
+      }
+      continue;
+    }
+    ext_map[key] = std::make_shared<HippyValue>(value);
+  }
+  return true;
+}
+
+template <typename Convert>
+double RunIterations(const std::vector<std::shared_ptr<CtxValue>>& props_list, Convert&& convert) {
+  size_t entry_count = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; ++i) {
+    for (const auto& props : props_list) {
+      DomValueMap style_map;
+      DomValueMap ext_map;
+      if (!convert(props, style_map, ext_map)) {
+        FOOTSTONE_LOG(ERROR) << "convert props failed";
+        return -1;
+      }
+      entry_count += style_map.size() + ext_map.size();
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  FOOTSTONE_DCHECK(entry_count == static_cast<size_t>(kIterations) * kNodeCount * 14);
+  return std::chrono::duration<double, std::micro>(end - begin).count() / kIterations;
+}
+
+}  // namespace
+
+int main() {
+  auto vm = CreateBenchmarkVM();
+  auto ctx = vm->CreateContext();
+  auto nodes = ctx->RunScript(string_view::new_from_utf8(kCreateNodesScript, sizeof(kCreateNodesScript) - 1),
+                              "scene_builder_benchmark.js");
+  if (!nodes || ctx->GetArrayLength(nodes) != kNodeCount) {
+    std::fprintf(stderr, "create nodes failed\n");
+    return 1;
+  }
+  std::vector<std::shared_ptr<CtxValue>> props_list;
+  props_list.reserve(kNodeCount);
+  for (uint32_t i = 0; i < kNodeCount; ++i) {
+    props_list.push_back(ctx->GetProperty(ctx->CopyArrayElement(nodes, i), kNodePropertyProps));
+  }
+
+  // 预热一轮，排除引擎首次访问属性时的开销
+  RunIterations(props_list, [&ctx](const auto& props, auto& style_map, auto& ext_map) {
+    return hippy::ToDomNodeProps(ctx, props, kNodePropertyStyle, style_map, ext_map);
+  });
+  auto single_pass = RunIterations(props_list, [&ctx](const auto& props, auto& style_map, auto& ext_map) {
+    return hippy::ToDomNodeProps(ctx, props, kNodePropertyStyle, style_map, ext_map);
+  });
+  auto dom_value = RunIterations(props_list, [&ctx](const auto& props, auto& style_map, auto& ext_map) {
+    return ConvertByDomValue(ctx, props, style_map, ext_map);
+  });
+  std::printf("SceneBuilder.create props, %u nodes: ToDomNodeProps = %.1fus, ToDomValue + split = %.1fus\n",
+              kNodeCount, single_pass, dom_value);
+  return 0;
+}
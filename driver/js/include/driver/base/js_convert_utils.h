@@ -22,10 +22,16 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+
 #include "driver/base/js_value_wrapper.h"
 #include "driver/napi/js_ctx.h"
 #include "driver/napi/js_ctx_value.h"
+#include "footstone/deserializer.h"
 #include "footstone/hippy_value.h"
+#include "footstone/serializer.h"
+#include "dom/diff_utils.h"
 #include "dom/dom_argument.h"
 
 namespace hippy {
@@ -34,10 +40,31 @@ inline namespace base {
 
 std::shared_ptr<footstone::HippyValue> ToDomValue(const std::shared_ptr<hippy::Ctx>& ctx,
                                                   const std::shared_ptr<hippy::CtxValue>& value);
+/**
+ * 单遍转换节点的 props 对象：style_key 对应的对象逐项写入 style_map，其余属性写入 ext_map
+ * 相比先用 ToDomValue 整体转换再拆分，省去了中间 HippyValue 树的构造与拷贝
+ */
+bool ToDomNodeProps(const std::shared_ptr<hippy::Ctx>& ctx,
+                    const std::shared_ptr<hippy::CtxValue>& props,
+                    const std::string& style_key,
+                    hippy::dom::DomValueMap& style_map,
+                    hippy::dom::DomValueMap& ext_map);
 std::shared_ptr<hippy::DomArgument> ToDomArgument(const std::shared_ptr<hippy::Ctx>& ctx,
                                                   const std::shared_ptr<CtxValue>& value);
 std::shared_ptr<hippy::CtxValue> CreateCtxValue(const std::shared_ptr<hippy::Ctx>& ctx,
                                                 const std::shared_ptr<footstone::HippyValue>& value);
+/**
+ * 遍历 js 值直接写入 serializer，产生与 v8 序列化相同的格式，供不使用 v8 序列化的引擎与平台层交换数据
+ * 循环引用的值写为 undefined
+ */
+bool SerializeCtxValue(const std::shared_ptr<hippy::Ctx>& ctx,
+                       const std::shared_ptr<hippy::CtxValue>& value,
+                       footstone::Serializer& serializer);
+/**
+ * 由序列化数据的视图直接创建 js 值，字符串按源数据的编码创建，不经过 HippyValue
+ */
+std::shared_ptr<hippy::CtxValue> CreateCtxValue(const std::shared_ptr<hippy::Ctx>& ctx,
+                                                const footstone::HippyValueView& view);
 
 }
 }
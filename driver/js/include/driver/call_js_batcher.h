@@ -0,0 +1,75 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "driver/js_driver_utils.h"
+#include "footstone/string_view.h"
+
+namespace hippy {
+inline namespace driver {
+
+/**
+ * 合并 native 到 js 的调用
+ * 开启后 JsDriverUtils::CallJs 不再为每次调用单独投递任务，而是把调用放入队列，
+ * 由 js 线程在每个 tick（或 vsync 帧回调之前）一次性取出，并以一个 (action, params) 数组调用一次 hippyBridge
+ * 对于可去重的 action，同一 tick 内 action 与参数都相同的调用只下发一次，各调用的回调仍会分别执行
+ */
+class CallJsBatcher {
+ public:
+  using byte_string = std::string;
+  using string_view = footstone::stringview::string_view;
+  using CallJsCallback = std::function<void(CALL_FUNCTION_CB_STATE, string_view)>;
+
+  struct Call {
+    string_view action;
+    byte_string buffer_data;
+    CallJsCallback cb;
+    std::function<void()> on_js_runner;
+  };
+
+  explicit CallJsBatcher(std::unordered_set<std::string> idempotent_actions)
+      : idempotent_actions_(std::move(idempotent_actions)) {}
+
+  /**
+   * 任意线程调用，返回 true 表示加入前队列为空，调用方需要安排一次 flush
+   */
+  bool Push(Call&& call);
+  /**
+   * js 线程调用，取出当前队列中的全部调用
+   */
+  std::vector<Call> Drain();
+
+ private:
+  std::mutex mutex_;
+  std::vector<Call> calls_;
+  std::unordered_set<std::string> idempotent_actions_;
+};
+
+}  // namespace driver
+}  // namespace hippy
@@ -0,0 +1,122 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace hippy {
+inline namespace driver {
+
+/**
+ * 按内容寻址的 code cache 存储
+ * 1. key 由脚本内容的哈希、长度与引擎标识（版本与编译相关 flag）计算得到，与文件名、修改时间无关，
+ *    远程下载的 bundle 同样可以命中，引擎升级或 flag 变化后旧缓存自然失效
+ * 2. 每个条目是目录下的一个文件，文件头记录数据长度与校验和，读取时校验不通过的条目会被删除
+ * 3. 写入先写临时文件、fsync 后再 rename，进程在写入过程中退出不会留下不完整的条目
+ * 4. 目录总大小超过 capacity 时按最近使用时间淘汰，命中时会刷新文件的修改时间，淘汰顺序在重启后仍然有效
+ * 5. Prewarm 把条目提前读入内存，随后的 Load 直接取走，不再读盘。内存中的条目总大小不超过 capacity 的
+ *    1/4，超出时不再预读
+ *
+ * 同一目录共用一个实例，可在任意线程调用。Load 只读取单个条目，不会触发目录扫描，
+ * 建立索引、清理旧文件与淘汰都发生在 Store、Prewarm、Remove、GetStatistics 中，应在 worker 线程调用
+ */
+class CodeCacheStore {
+ public:
+  static constexpr uint64_t kDefaultCapacity = 32 * 1024 * 1024;
+  static constexpr char kFileSuffix[] = ".hcc";
+
+  struct Statistics {
+    uint32_t hit_count = 0;
+    uint32_t miss_count = 0;
+    uint32_t corrupt_count = 0;  // 校验失败被删除的条目数
+    uint32_t evict_count = 0;
+    uint64_t size = 0;  // 目录中条目的总大小
+  };
+
+  CodeCacheStore(std::string dir, uint64_t capacity);
+
+  /**
+   * 返回 dir 对应的共享实例，dir 不存在时会被创建。该目录由 code cache 独占，
+   * 首次使用时会清理目录中旧格式的缓存与残留的临时文件
+   */
+  static std::shared_ptr<CodeCacheStore> Open(const std::string& dir, uint64_t capacity = kDefaultCapacity);
+  static std::string MakeKey(const char* content, size_t length, const std::string& engine_tag);
+  static std::string MakeKey(const std::string& content, const std::string& engine_tag) {
+    return MakeKey(content.c_str(), content.length(), engine_tag);
+  }
+
+  bool Load(const std::string& key, std::string& data);
+  bool Store(const std::string& key, const std::string& data);
+  /**
+   * 把条目读入内存，返回条目是否存在
+   */
+  bool Prewarm(const std::string& key);
+  void Remove(const std::string& key);
+
+  Statistics GetStatistics();
+  const std::string& GetDir() const { return dir_; }
+
+ private:
+  struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t data_size;
+    uint64_t checksum;
+  };
+
+  struct Entry {
+    uint64_t size;
+    uint64_t tick;  // 越大表示越近使用
+  };
+
+  enum class ReadResult { kOk, kMissing, kCorrupt };
+
+  static constexpr uint32_t kFileMagic = 0x43434848;  // "HHCC"
+  static constexpr uint32_t kFileVersion = 1;
+
+  std::string GetPath(const std::string& key) const;
+  ReadResult ReadEntry(const std::string& key, std::string& data);
+  void EnsureIndex();
+  void Touch(const std::string& key);
+  void Evict(const std::string& keep_key);
+  bool TakePrewarmed(const std::string& key, std::string& data);
+  void DropPrewarmed(const std::string& key);
+
+  std::string dir_;
+  uint64_t capacity_;
+  std::mutex mutex_;
+  bool index_ready_ = false;
+  uint64_t tick_ = 0;
+  uint64_t temp_file_id_ = 0;
+  std::unordered_map<std::string, Entry> index_;
+  std::unordered_map<std::string, std::string> prewarmed_;
+  uint64_t prewarmed_size_ = 0;
+  Statistics statistics_;
+};
+
+}  // namespace driver
+}  // namespace hippy
@@ -24,6 +24,8 @@
 
 #include <functional>
 #include <memory>
+#include <string>
+#include <unordered_set>
 
 #include "driver/scope.h"
 #include "footstone/string_view.h"
@@ -63,12 +65,32 @@ class JsDriverUtils {
                         const string_view& code_cache_dir,
                         const string_view& uri,
                         bool is_local_file);
+  /**
+   * 在实例创建前预热 uri 对应 bundle 的 code cache：在 worker 线程加载 bundle，已有缓存时读入内存，
+   * 供随后使用同一 code_cache_dir 的 RunScript 直接使用。没有缓存时在该 worker 线程用临时 isolate 编译并写入缓存，
+   * V8 platform 尚未初始化（引擎还未创建）时跳过，缓存由首次 RunScript 生成
+   */
+  static void PrewarmCodeCache(const std::shared_ptr<UriLoader>& loader,
+                               const string_view& code_cache_dir,
+                               const string_view& uri);
   static void CallJs(const string_view& action,
                      const std::shared_ptr<Scope>& scope,
                      std::function<void(CALL_FUNCTION_CB_STATE, string_view)> cb,
                      byte_string buffer_data,
                      std::function<void()> on_js_runner
     );
+  /**
+   * 开启 CallJs 合并，需在首次 CallJs 之前调用
+   * idempotent_actions 中的 action 在同一 tick 内参数相同的调用只下发一次
+   * 合并后的调用以 hippyBridge('batchedCalls', ...) 下发，需要 native2js 支持；iOS（JSC）的 native2js
+   * 不经过 hippyBridge，不支持合并，返回 false
+   */
+  static bool EnableCallJsBatch(const std::shared_ptr<Scope>& scope,
+                                std::unordered_set<std::string> idempotent_actions);
+  /**
+   * 在 js 线程调用，把已合并的 CallJs 以一次 hippyBridge 调用下发
+   */
+  static void FlushCallJs(const std::shared_ptr<Scope>& scope);
 
   static void CallNative(hippy::napi::CallbackInfo& info,
                          const std::function<void(std::shared_ptr<Scope>,
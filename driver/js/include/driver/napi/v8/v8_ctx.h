@@ -164,6 +164,17 @@ class V8Ctx : public Ctx {
       bool is_use_code_cache,
       unicode_string_view* cache,
       bool is_copy);
+  /**
+   * 执行 data 指向的 utf8 脚本，owner 保证 data 在 V8 使用期间有效
+   * ASCII 脚本以外部单字节字符串交给 V8，不拷贝；其他脚本由 V8 解码到堆中
+   */
+  std::shared_ptr<CtxValue> RunScript(
+      const std::shared_ptr<void>& owner,
+      const char* data,
+      size_t length,
+      const unicode_string_view& file_name,
+      bool is_use_code_cache,
+      unicode_string_view* cache);
 
   virtual void SetDefaultContext(const std::shared_ptr<v8::SnapshotCreator>& creator);
 
@@ -197,6 +208,7 @@ class V8Ctx : public Ctx {
       const unicode_string_view& file_name,
       bool is_use_code_cache,
       unicode_string_view* cache);
+  unicode_string_view CreateCodeCache(v8::Local<v8::Script> script);
 };
 
 }
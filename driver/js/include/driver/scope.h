@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -56,6 +57,7 @@ class ModuleBase;
 }
 
 class Scope;
+class CallJsBatcher;
 
 class ScopeWrapper {
  public:
@@ -161,6 +163,11 @@ class Scope : public std::enable_shared_from_this<Scope> {
   inline std::shared_ptr<Ctx> GetContext() { return context_; }
   inline std::shared_ptr<CtxValue> GetBridgeObject() { return bridge_object_; }
   inline void SetBridgeObject(std::shared_ptr<CtxValue> bridge_object) { bridge_object_ = bridge_object; }
+  // CallJs 可在任意线程调用，batcher 的读写使用原子操作
+  inline std::shared_ptr<CallJsBatcher> GetCallJsBatcher() { return std::atomic_load(&call_js_batcher_); }
+  inline void SetCallJsBatcher(std::shared_ptr<CallJsBatcher> batcher) {
+    std::atomic_store(&call_js_batcher_, std::move(batcher));
+  }
   inline std::any GetBridge() { return bridge_; }
   inline void SetBridge(std::any bridge) { bridge_ = bridge; }
   inline std::any GetTurbo() { return turbo_; }
@@ -463,6 +470,7 @@ class Scope : public std::enable_shared_from_this<Scope> {
   std::weak_ptr<Engine> engine_;
   std::shared_ptr<Ctx> context_;
   std::shared_ptr<CtxValue> bridge_object_;
+  std::shared_ptr<CallJsBatcher> call_js_batcher_;
   std::any bridge_;
   std::any turbo_;
   std::string name_;
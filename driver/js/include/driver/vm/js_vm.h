@@ -26,6 +26,7 @@
 
 #include "driver/napi/js_ctx.h"
 #include "footstone/logging.h"
+#include "footstone/serializer.h"
 
 namespace hippy {
 #ifdef ENABLE_INSPECTOR
@@ -40,6 +41,7 @@ class VM {
  public:
   static const int64_t kDefaultGroupId = -1;
   static const int64_t kDebuggerGroupId = -2;
+  static constexpr size_t kSerializerBufferHighWaterMark = 1024 * 1024;
   using string_view = footstone::string_view;
   using Ctx = hippy::napi::Ctx;
   using CtxValue = hippy::napi::CtxValue;
@@ -51,6 +53,8 @@ class VM {
    public:
     bool is_debug;
     int64_t group_id;
+    // 与平台层交换数据时使用 v8 序列化格式（footstone::Serializer 兼容）而非 json，非 v8 引擎同样适用
+    bool enable_v8_serialization = false;
 #ifdef ENABLE_INSPECTOR
     std::shared_ptr<DevtoolsDataSource> devtools_data_source;
 #endif
@@ -66,7 +70,9 @@ class VM {
   };
 
   VM(std::shared_ptr<VMInitParam> param = std::make_shared<VMInitParam>())
-      : is_debug_(param->is_debug), group_id_(param->group_id), uncaught_exception_callback_(param->uncaught_exception_callback) {}
+      : is_debug_(param->is_debug), group_id_(param->group_id),
+        enable_v8_serialization_(param->enable_v8_serialization),
+        uncaught_exception_callback_(param->uncaught_exception_callback) {}
   virtual ~VM() { FOOTSTONE_DLOG(INFO) << "~VM"; }
 
   inline void SetDebug(bool is_debug) {
@@ -80,10 +86,19 @@ class VM {
     return group_id_;
   }
 
+  inline bool IsEnableV8Serialization() {
+    return enable_v8_serialization_;
+  }
+
   inline const auto& GetUncaughtExceptionCallback() {
     return uncaught_exception_callback_;
   }
 
+  // 非 v8 引擎序列化 CallNative 参数时复用的缓冲区，避免每次调用重新分配并逐步扩容
+  inline const std::shared_ptr<footstone::SerializerBufferPool>& GetSerializerBufferPool() {
+    return serializer_buffer_pool_;
+  }
+
   static void HandleException(const std::shared_ptr<Ctx>& ctx, const string_view& event_name, const std::shared_ptr<CtxValue>& exception);
 
   virtual std::shared_ptr<CtxValue> ParseJson(const std::shared_ptr<Ctx>& ctx, const string_view& json) = 0;
@@ -91,9 +106,12 @@ class VM {
  private:
   bool is_debug_;
   int64_t group_id_;
+  bool enable_v8_serialization_;
   std::function<void(const std::any& bridge,
                      const string_view& description,
                      const string_view& stack)> uncaught_exception_callback_;
+  std::shared_ptr<footstone::SerializerBufferPool> serializer_buffer_pool_ =
+      std::make_shared<footstone::SerializerBufferPool>(kSerializerBufferHighWaterMark);
 };
 
 std::shared_ptr<VM> CreateVM(const std::shared_ptr<VM::VMInitParam>& param);
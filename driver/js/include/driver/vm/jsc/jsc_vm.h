@@ -41,6 +41,7 @@ inline namespace vm {
 class JSCVM : public VM, public std::enable_shared_from_this<JSCVM> {
 public:
   JSCVM(): VM() { vm_ = JSContextGroupCreate(); }
+  explicit JSCVM(const std::shared_ptr<VMInitParam>& param): VM(param) { vm_ = JSContextGroupCreate(); }
   
   ~JSCVM() {
     JSContextGroupRelease(vm_);
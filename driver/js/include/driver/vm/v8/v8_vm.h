@@ -55,7 +55,6 @@ struct V8VMInitParam : public VM::VMInitParam {
   std::shared_ptr<v8::StartupData> snapshot_blob;
   std::any holder;
   std::basic_string<uint8_t> buffer;
-  bool enable_v8_serialization;
 
   static size_t HeapLimitSlowGrowthStrategy(void* data, size_t current_heap_limit,
                                             size_t initial_heap_limit) {
@@ -103,7 +102,6 @@ class V8VM : public VM {
   inline void SaveUncaughtExceptionCallback(std::unique_ptr<FunctionWrapper>&& wrapper) {
     uncaught_exception_ = std::move(wrapper);
   }
-  inline bool IsEnableV8Serialization() { return enable_v8_serialization_; }
   inline std::string& GetBuffer() { return serializer_reused_buffer_; }
 
 #if defined(ENABLE_INSPECTOR) && defined(JS_V8) && !defined(V8_WITHOUT_INSPECTOR)
@@ -132,12 +130,16 @@ class V8VM : public VM {
                                    v8::Local<v8::Context> context,
                                    v8::Local<v8::StackTrace> trace);
   static void PlatformDestroy();
+  /**
+   * 可在任意线程调用，使用临时 isolate 只编译不执行脚本，返回生成的 code cache。code cache 不绑定 isolate，
+   * 引擎的 isolate 可以直接使用。V8 platform 尚未初始化或编译失败时返回空串
+   */
+  static std::string CreateCodeCache(const char* data, size_t length, const string_view& file_name);
 
   v8::Isolate* isolate_;
   v8::Isolate::CreateParams create_params_;
   std::unique_ptr<FunctionWrapper> uncaught_exception_;
   std::string serializer_reused_buffer_;
-  bool enable_v8_serialization_;
 
 #if defined(ENABLE_INSPECTOR) && !defined(V8_WITHOUT_INSPECTOR)
   std::shared_ptr<V8InspectorClientImpl> inspector_client_;
@@ -19,6 +19,22 @@
  */
 
 global.hippyBridge = (_action, _callObj) => {
+  if (_action === 'batchedCalls') {
+    return _callObj.map(([action, callObj]) => {
+      try {
+        return global.hippyBridge(action, callObj);
+      } catch (err) {
+        if (global.Hippy) {
+          global.Hippy.emit('uncaughtException', err);
+        } else {
+          /* eslint-disable-next-line no-console */
+          console.error('uncaughtException', err);
+        }
+        return `native2js error: ${err}`;
+      }
+    });
+  }
+
   let resp = 'success';
 
   let action = _action;
@@ -22,6 +22,11 @@
 
 #include "driver/base/js_convert_utils.h"
 
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "footstone/logging.h"
 #include "footstone/string_view.h"
 #include "footstone/string_view_utils.h"
@@ -49,13 +54,6 @@ using Ctx = hippy::Ctx;
 using CtxValue = hippy::CtxValue;
 using DomArgument = hippy::DomArgument;
 
-static std::string IntToString(int v) {
-  const int buf_len = 16;
-  char buf[buf_len] = {0};
-  snprintf(buf, buf_len, "%d", v);
-  return buf;
-}
-
 bool IsEqualCtxValue(const std::shared_ptr<CtxValue>& value1, const std::shared_ptr<CtxValue>& value2) {
 #ifdef JS_V8
   auto v1 = std::static_pointer_cast<V8CtxValue>(value1);
@@ -70,98 +68,324 @@ bool IsEqualCtxValue(const std::shared_ptr<CtxValue>& value1, const std::shared_
 #endif
 }
 
-std::shared_ptr<HippyValue> ToDomValueWithCycleCheck(const std::shared_ptr<Ctx>& ctx,
-                                                     const std::shared_ptr<CtxValue>& value,
-                                                     std::vector<std::string>& key_stack,
-                                                     std::vector<std::shared_ptr<CtxValue>>& value_stack) {
-  int stack_len = static_cast<int>(value_stack.size());
-  for (int i = 0; i < stack_len - 1; i++) {
-    if(IsEqualCtxValue(value, value_stack[static_cast<uint32_t>(i)])) {
-      std::string str = "value stack: ";
-      for (int t = 0; t < stack_len; t++) {
-        str.append(IntToString(t));
-        str.append(":");
-        str.append(key_stack[static_cast<uint32_t>(t)]);
-        if (t < stack_len - 1) {
-          str.append(" - ");
-        }
+// 对象的标识哈希，同一对象总是相同，不同对象可能冲突，需再用 IsEqualCtxValue 比较
+size_t GetCtxValueIdentityHash(const std::shared_ptr<Ctx>& ctx, const std::shared_ptr<CtxValue>& value) {
+#ifdef JS_V8
+  auto v8_ctx = std::static_pointer_cast<hippy::V8Ctx>(ctx);
+  auto isolate = v8_ctx->isolate_;
+  auto ctx_value = std::static_pointer_cast<V8CtxValue>(value);
+  auto handle_value = v8::Local<v8::Value>::New(isolate, ctx_value->global_value_);
+  return handle_value->IsObject() ? static_cast<size_t>(handle_value.As<v8::Object>()->GetIdentityHash()) : 0;
+#elif JS_JSC
+  return reinterpret_cast<size_t>(std::static_pointer_cast<JSCCtxValue>(value)->value_);
+#else
+  FOOTSTONE_UNREACHABLE();
+#endif
+}
+
+std::string ToUtf8String(const string_view& str) {
+  return StringViewUtils::ToStdString(StringViewUtils::ConvertEncoding(str, string_view::Encoding::Utf8).utf8_value());
+}
+
+/**
+ * 记录遍历路径上的数组与对象，遇到祖先即为循环引用，每层检测为 O(1)
+ */
+class CtxValueAncestors {
+ public:
+  explicit CtxValueAncestors(const std::shared_ptr<Ctx>& ctx) : ctx_(ctx) {}
+
+  bool Enter(const std::shared_ptr<CtxValue>& value) {
+    auto hash = GetCtxValueIdentityHash(ctx_, value);
+    auto range = ancestors_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (IsEqualCtxValue(value, it->second)) {
+        FOOTSTONE_LOG(ERROR) << "Js value setting error, cycle is found, depth = " << ancestors_.size();
+        FOOTSTONE_DCHECK(false);
+        return false;
       }
-      str.append(", cycle with position: ");
-      str.append(IntToString(i));
-      FOOTSTONE_LOG(ERROR) << "Js value setting error, cycle is found, " << str;
-      FOOTSTONE_DCHECK(false);
-      return nullptr;
     }
+    ancestors_.emplace(hash, value);
+    return true;
   }
 
-  if (ctx->IsUndefined(value)) {
-    return std::make_shared<HippyValue>(HippyValue::Undefined());
-  } else if (ctx->IsNull(value)) {
-    return std::make_shared<HippyValue>(HippyValue::Null());
-  } else if (ctx->IsBoolean(value)) {
-    bool ret;
-    ctx->GetValueBoolean(value, &ret);
-    return std::make_shared<HippyValue>(ret);
-  } else if (ctx->IsString(value)) {
-    footstone::string_view ret;
-    ctx->GetValueString(value, &ret);
-    auto str = StringViewUtils::ToStdString(StringViewUtils::ConvertEncoding(ret, string_view::Encoding::Utf8).utf8_value());
-    return std::make_shared<HippyValue>(std::move(str));
-  } else if (ctx->IsNumber(value)) {
-    double ret;
-    ctx->GetValueNumber(value, &ret);
-    return std::make_shared<HippyValue>(ret);
-  } else if (ctx->IsArray(value)) {
-    auto len = ctx->GetArrayLength(value);
-    HippyValue::HippyValueArrayType ret;
-    for (uint32_t i = 0; i < len; ++i) {
-      std::string value_key = "array";
-      value_key.append(IntToString(static_cast<int>(i)));
-      auto value_object = ctx->CopyArrayElement(value, i);
-      key_stack.push_back(value_key);
-      value_stack.push_back(value_object);
-      auto value_obj = ToDomValueWithCycleCheck(ctx, value_object, key_stack, value_stack);
-      key_stack.pop_back();
-      value_stack.pop_back();
-      if (value_obj) {
-        ret.push_back(*value_obj);
+  void Leave(const std::shared_ptr<CtxValue>& value) {
+    auto range = ancestors_.equal_range(GetCtxValueIdentityHash(ctx_, value));
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == value) {
+        ancestors_.erase(it);
+        return;
       }
     }
-    return std::make_shared<HippyValue>(std::move(ret));
-  } else if (ctx->IsObject(value)) {
-    HippyValue::HippyValueObjectType ret;
+  }
+
+ private:
+  std::shared_ptr<Ctx> ctx_;
+  std::unordered_multimap<size_t, std::shared_ptr<CtxValue>> ancestors_;
+};
+
+/**
+ * 单遍将 js 值转换为 HippyValue，子节点直接构造在父容器中，不产生中间的 shared_ptr
+ */
+class DomValueConverter {
+ public:
+  explicit DomValueConverter(const std::shared_ptr<Ctx>& ctx) : ctx_(ctx), ancestors_(ctx) {}
+
+  bool Convert(const std::shared_ptr<CtxValue>& value, HippyValue& result) {
+    if (ctx_->IsUndefined(value)) {
+      result = HippyValue::Undefined();
+    } else if (ctx_->IsNull(value)) {
+      result = HippyValue::Null();
+    } else if (ctx_->IsBoolean(value)) {
+      bool ret;
+      ctx_->GetValueBoolean(value, &ret);
+      result = ret;
+    } else if (ctx_->IsString(value)) {
+      string_view ret;
+      ctx_->GetValueString(value, &ret);
+      result = HippyValue(ToUtf8String(ret));
+    } else if (ctx_->IsNumber(value)) {
+      double ret;
+      ctx_->GetValueNumber(value, &ret);
+      result = ret;
+    } else if (ctx_->IsArray(value)) {
+      if (!ancestors_.Enter(value)) {
+        return false;
+      }
+      auto len = ctx_->GetArrayLength(value);
+      HippyValue::HippyValueArrayType ret;
+      ret.reserve(len);
+      for (uint32_t i = 0; i < len; ++i) {
+        HippyValue element;
+        if (Convert(ctx_->CopyArrayElement(value, i), element)) {
+          ret.push_back(std::move(element));
+        }
+      }
+      ancestors_.Leave(value);
+      result = HippyValue(std::move(ret));
+    } else if (ctx_->IsObject(value)) {
+      HippyValue::HippyValueObjectType ret;
+      auto flag = ConvertEntries(value, [this, &ret](std::string&& key, const std::shared_ptr<CtxValue>& element) {
+        HippyValue element_value;
+        if (Convert(element, element_value)) {
+          ret[std::move(key)] = std::move(element_value);
+        }
+      });
+      if (!flag) {
+        return false;
+      }
+      result = HippyValue(std::move(ret));
+    } else {
+      FOOTSTONE_UNREACHABLE();
+    }
+    return true;
+  }
+
+  template <typename Visitor>
+  bool ConvertEntries(const std::shared_ptr<CtxValue>& object, Visitor&& visitor) {
+    if (!ancestors_.Enter(object)) {
+      return false;
+    }
     std::unordered_map<std::shared_ptr<CtxValue>, std::shared_ptr<CtxValue>> map;
-    auto flag = ctx->GetEntriesFromObject(value, map);
+    auto flag = ctx_->GetEntriesFromObject(object, map);
     FOOTSTONE_CHECK(flag);
     for (const auto& [key_object, value_object]: map) {
       string_view key_string_view;
-      flag = ctx->GetValueString(key_object, &key_string_view);
-      if (!flag) {
+      if (!ctx_->GetValueString(key_object, &key_string_view)) {
         continue;
       }
-      std::string key_string = StringViewUtils::ToStdString(
-          StringViewUtils::ConvertEncoding(key_string_view, string_view::Encoding::Utf8).utf8_value());
-      key_stack.push_back(key_string);
-      value_stack.push_back(value_object);
-      auto value_obj = ToDomValueWithCycleCheck(ctx, value_object, key_stack, value_stack);
-      key_stack.pop_back();
-      value_stack.pop_back();
-      if (value_obj) {
-        ret[key_string] = *value_obj;
+      visitor(ToUtf8String(key_string_view), value_object);
+    }
+    ancestors_.Leave(object);
+    return true;
+  }
+
+ private:
+  std::shared_ptr<Ctx> ctx_;
+  CtxValueAncestors ancestors_;
+};
+
+/**
+ * 遍历 js 值直接写入 footstone::Serializer，不经过 json 与转码
+ */
+class CtxValueSerializer {
+ public:
+  CtxValueSerializer(const std::shared_ptr<Ctx>& ctx, footstone::Serializer& serializer)
+      : ctx_(ctx), serializer_(serializer), ancestors_(ctx) {}
+
+  bool Write(const std::shared_ptr<CtxValue>& value) {
+    if (ctx_->IsUndefined(value)) {
+      serializer_.WriteUndefined();
+    } else if (ctx_->IsNull(value)) {
+      serializer_.WriteNull();
+    } else if (ctx_->IsBoolean(value)) {
+      bool ret;
+      ctx_->GetValueBoolean(value, &ret);
+      serializer_.WriteBoolean(ret);
+    } else if (ctx_->IsString(value)) {
+      string_view ret;
+      ctx_->GetValueString(value, &ret);
+      serializer_.WriteString(ret);
+    } else if (ctx_->IsNumber(value)) {
+      double ret;
+      ctx_->GetValueNumber(value, &ret);
+      serializer_.WriteNumber(ret);
+    } else if (ctx_->IsArray(value)) {
+      if (!ancestors_.Enter(value)) {
+        return false;
+      }
+      auto len = ctx_->GetArrayLength(value);
+      serializer_.WriteBeginDenseJSArray(len);
+      for (uint32_t i = 0; i < len; ++i) {
+        // 长度已经写入，循环引用的元素写为 undefined
+        if (!Write(ctx_->CopyArrayElement(value, i))) {
+          serializer_.WriteUndefined();
+        }
+      }
+      serializer_.WriteEndDenseJSArray(len);
+      ancestors_.Leave(value);
+    } else if (ctx_->IsObject(value)) {
+      if (!ancestors_.Enter(value)) {
+        return false;
       }
+      std::unordered_map<std::shared_ptr<CtxValue>, std::shared_ptr<CtxValue>> map;
+      auto flag = ctx_->GetEntriesFromObject(value, map);
+      FOOTSTONE_CHECK(flag);
+      serializer_.WriteBeginJSObject();
+      uint32_t number_properties = 0;
+      for (const auto& [key_object, value_object]: map) {
+        string_view key;
+        if (!ctx_->GetValueString(key_object, &key)) {
+          continue;
+        }
+        serializer_.WriteString(key);
+        if (!Write(value_object)) {
+          serializer_.WriteUndefined();
+        }
+        ++number_properties;
+      }
+      serializer_.WriteEndJSObject(number_properties);
+      ancestors_.Leave(value);
+    } else {
+      FOOTSTONE_UNREACHABLE();
     }
-    return std::make_shared<HippyValue>(std::move(ret));
-  } else {
-    FOOTSTONE_UNREACHABLE();
+    return true;
   }
-}
+
+ private:
+  std::shared_ptr<Ctx> ctx_;
+  footstone::Serializer& serializer_;
+  CtxValueAncestors ancestors_;
+};
 
 std::shared_ptr<HippyValue> ToDomValue(const std::shared_ptr<Ctx>& ctx, const std::shared_ptr<CtxValue>& value) {
-  std::vector<std::string> key_stack;
-  std::vector<std::shared_ptr<CtxValue>> value_stack;
-  key_stack.push_back("root");
-  value_stack.push_back(value);
-  return ToDomValueWithCycleCheck(ctx, value, key_stack, value_stack);
+  DomValueConverter converter(ctx);
+  auto result = std::make_shared<HippyValue>();
+  if (!converter.Convert(value, *result)) {
+    return nullptr;
+  }
+  return result;
+}
+
+bool ToDomNodeProps(const std::shared_ptr<Ctx>& ctx,
+                    const std::shared_ptr<CtxValue>& props,
+                    const std::string& style_key,
+                    hippy::dom::DomValueMap& style_map,
+                    hippy::dom::DomValueMap& ext_map) {
+  if (!ctx->IsObject(props) || ctx->IsArray(props)) {
+    return false;
+  }
+  DomValueConverter converter(ctx);
+  return converter.ConvertEntries(props, [&](std::string&& key, const std::shared_ptr<CtxValue>& value) {
+    if (key == style_key) {
+      if (ctx->IsObject(value) && !ctx->IsArray(value)) {
+        converter.ConvertEntries(value, [&converter, &style_map](std::string&& style_name,
+                                                                 const std::shared_ptr<CtxValue>& style_value) {
+          auto hippy_value = std::make_shared<HippyValue>();
+          if (converter.Convert(style_value, *hippy_value)) {
+            style_map[std::move(style_name)] = std::move(hippy_value);
+          }
+        });
+      }
+      return;
+    }
+    auto hippy_value = std::make_shared<HippyValue>();
+    if (converter.Convert(value, *hippy_value)) {
+      ext_map[std::move(key)] = std::move(hippy_value);
+    }
+  });
+}
+
+bool SerializeCtxValue(const std::shared_ptr<Ctx>& ctx,
+                       const std::shared_ptr<CtxValue>& value,
+                       footstone::Serializer& serializer) {
+  CtxValueSerializer writer(ctx, serializer);
+  return writer.Write(value);
+}
+
+static string_view ToStringView(const footstone::HippyValueView& view) {
+  const uint8_t* data;
+  size_t length;
+  footstone::HippyValueView::Encoding encoding;
+  if (!view.GetStringSpan(data, length, encoding)) {
+    return string_view();
+  }
+  switch (encoding) {
+    case string_view::Encoding::Latin1:
+      return string_view(reinterpret_cast<const char*>(data), length);
+    case string_view::Encoding::Utf16: {
+      // 源数据中的 two byte string 不保证按 char16_t 对齐
+      std::u16string str(length / sizeof(char16_t), u'\0');
+      memcpy(&str[0], data, str.length() * sizeof(char16_t));
+      return string_view(std::move(str));
+    }
+    default:
+      return string_view::new_from_utf8(reinterpret_cast<const char*>(data), length);
+  }
+}
+
+std::shared_ptr<CtxValue> CreateCtxValue(const std::shared_ptr<Ctx>& ctx, const footstone::HippyValueView& view) {
+  switch (view.GetType()) {
+    case HippyValue::Type::kUndefined:
+      return ctx->CreateUndefined();
+    case HippyValue::Type::kNull:
+      return ctx->CreateNull();
+    case HippyValue::Type::kBoolean: {
+      bool b = false;
+      view.ToBoolean(b);
+      return ctx->CreateBoolean(b);
+    }
+    case HippyValue::Type::kNumber: {
+      double d = 0;
+      view.ToDouble(d);
+      return ctx->CreateNumber(d);
+    }
+    case HippyValue::Type::kString:
+      return ctx->CreateString(ToStringView(view));
+    case HippyValue::Type::kArray: {
+      auto len = view.GetLength();
+      std::vector<std::shared_ptr<CtxValue>> elements;
+      elements.reserve(len);
+      footstone::HippyValueView element;
+      for (size_t i = 0; i < len; ++i) {
+        elements.push_back(view.GetElement(i, element) ? CreateCtxValue(ctx, element) : ctx->CreateUndefined());
+      }
+      return ctx->CreateArray(elements.size(), elements.data());
+    }
+    case HippyValue::Type::kObject: {
+      auto obj = ctx->CreateObject();
+      auto len = view.GetLength();
+      footstone::HippyValueView key;
+      footstone::HippyValueView value;
+      for (size_t i = 0; i < len; ++i) {
+        if (view.GetPropertyAt(i, key, value)) {
+          ctx->SetProperty(obj, ctx->CreateString(ToStringView(key)), CreateCtxValue(ctx, value));
+        }
+      }
+      return obj;
+    }
+    default:
+      FOOTSTONE_UNREACHABLE();
+  }
 }
 
 std::shared_ptr<DomArgument> ToDomArgument(
@@ -196,14 +420,14 @@ std::shared_ptr<CtxValue> CreateCtxValue(const std::shared_ptr<Ctx>& ctx,
   } else if (value->IsNull()) {
     return ctx->CreateNull();
   } else if (value->IsString()) {
-    const auto& str = value->ToStringChecked();
+    const auto& str = std::as_const(*value).ToStringChecked();
     return ctx->CreateString(string_view::new_from_utf8(str.c_str(), str.length()));
   } else if (value->IsNumber()) {
     return ctx->CreateNumber(value->ToDoubleChecked());
   } else if (value->IsBoolean()) {
     return ctx->CreateBoolean(value->ToBooleanChecked());
   } else if (value->IsArray()) {
-    auto array = value->ToArrayChecked();
+    const auto& array = std::as_const(*value).ToArrayChecked();
     auto len = array.size();
     std::shared_ptr<CtxValue> argv[len];
     for (size_t i = 0; i < len; ++i) {
@@ -212,7 +436,7 @@ std::shared_ptr<CtxValue> CreateCtxValue(const std::shared_ptr<Ctx>& ctx,
     return ctx->CreateArray(array.size(), argv);
   } else if (value->IsObject()) {
     auto obj = ctx->CreateObject();
-    auto object = value->ToObjectChecked();
+    const auto& object = std::as_const(*value).ToObjectChecked();
     for (const auto& p : object) {
       auto key_str = string_view::new_from_utf8(p.first.c_str(), p.first.length());
       auto prop_key = ctx->CreateString(key_str);
@@ -0,0 +1,85 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "driver/call_js_batcher.h"
+
+#include <unordered_map>
+#include <utility>
+
+#include "footstone/string_view_utils.h"
+
+namespace hippy {
+inline namespace driver {
+
+using StringViewUtils = footstone::stringview::StringViewUtils;
+
+bool CallJsBatcher::Push(Call&& call) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  calls_.push_back(std::move(call));
+  return calls_.size() == 1;
+}
+
+std::vector<CallJsBatcher::Call> CallJsBatcher::Drain() {
+  std::vector<Call> calls;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    calls.swap(calls_);
+  }
+  if (idempotent_actions_.empty() || calls.size() < 2) {
+    return calls;
+  }
+  std::vector<Call> result;
+  result.reserve(calls.size());
+  // key 为 action 与参数，value 为首次出现的调用在 result 中的位置
+  std::unordered_map<std::string, size_t> first_calls;
+  for (auto& call : calls) {
+    auto action = StringViewUtils::ToStdString(
+        StringViewUtils::ConvertEncoding(call.action, string_view::Encoding::Utf8).utf8_value());
+    if (idempotent_actions_.find(action) == idempotent_actions_.end()) {
+      result.push_back(std::move(call));
+      continue;
+    }
+    auto key = std::move(action);
+    key.push_back('\0');
+    key.append(call.buffer_data);
+    auto [it, inserted] = first_calls.try_emplace(std::move(key), result.size());
+    if (inserted) {
+      result.push_back(std::move(call));
+      continue;
+    }
+    auto& first = result[it->second];
+    first.cb = [first_cb = std::move(first.cb), cb = std::move(call.cb)](CALL_FUNCTION_CB_STATE state,
+                                                                        string_view msg) {
+      first_cb(state, msg);
+      cb(state, msg);
+    };
+    first.on_js_runner = [first_on_js_runner = std::move(first.on_js_runner),
+                          on_js_runner = std::move(call.on_js_runner)] {
+      first_on_js_runner();
+      on_js_runner();
+    };
+  }
+  return result;
+}
+
+}  // namespace driver
+}  // namespace hippy
@@ -0,0 +1,121 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+#include "driver/call_js_batcher.h"
+
+namespace hippy {
+namespace driver {
+namespace testing {
+
+using CallJsBatcher = hippy::driver::CallJsBatcher;
+using string_view = footstone::stringview::string_view;
+
+// 记录回调与 on_js_runner 的执行顺序
+CallJsBatcher::Call MakeCall(const char* action, std::string params, std::vector<std::string>& log,
+                             const std::string& name) {
+  CallJsBatcher::Call call;
+  call.action = string_view(action);
+  call.buffer_data = std::move(params);
+  call.cb = [&log, name](CALL_FUNCTION_CB_STATE state, const string_view&) {
+    log.push_back("cb:" + name);
+  };
+  call.on_js_runner = [&log, name] { log.push_back("runner:" + name); };
+  return call;
+}
+
+TEST(CallJsBatcherTest, PushReportsFirstCall) {
+  CallJsBatcher batcher({});
+  std::vector<std::string> log;
+  EXPECT_TRUE(batcher.Push(MakeCall("callJsModule", "1", log, "a")));
+  EXPECT_FALSE(batcher.Push(MakeCall("callJsModule", "2", log, "b")));
+  EXPECT_EQ(batcher.Drain().size(), 2);
+  EXPECT_TRUE(batcher.Drain().empty());
+  // 取空后的下一次调用需要重新安排 flush
+  EXPECT_TRUE(batcher.Push(MakeCall("callJsModule", "3", log, "c")));
+}
+
+TEST(CallJsBatcherTest, DrainKeepsOrder) {
+  CallJsBatcher batcher({});
+  std::vector<std::string> log;
+  batcher.Push(MakeCall("callJsModule", "1", log, "a"));
+  batcher.Push(MakeCall("callBack", "2", log, "b"));
+  batcher.Push(MakeCall("callJsModule", "1", log, "c"));
+  auto calls = batcher.Drain();
+  ASSERT_EQ(calls.size(), 3);
+  // 没有指定可去重的 action 时，相同的调用也不会合并
+  EXPECT_EQ(calls[0].buffer_data, "1");
+  EXPECT_EQ(calls[1].buffer_data, "2");
+  EXPECT_EQ(calls[2].buffer_data, "1");
+  EXPECT_EQ(calls[1].action, string_view("callBack"));
+}
+
+TEST(CallJsBatcherTest, DrainMergesIdempotentCalls) {
+  CallJsBatcher batcher({"resumeInstance"});
+  std::vector<std::string> log;
+  batcher.Push(MakeCall("resumeInstance", "1", log, "a"));
+  batcher.Push(MakeCall("callJsModule", "1", log, "b"));
+  batcher.Push(MakeCall("resumeInstance", "2", log, "c"));
+  batcher.Push(MakeCall("resumeInstance", "1", log, "d"));
+  batcher.Push(MakeCall("callJsModule", "1", log, "e"));
+  batcher.Push(MakeCall("resumeInstance", "1", log, "f"));
+  auto calls = batcher.Drain();
+  // 合并后的调用保留首次出现的位置，参数不同的调用不合并
+  ASSERT_EQ(calls.size(), 4);
+  EXPECT_EQ(calls[0].action, string_view("resumeInstance"));
+  EXPECT_EQ(calls[0].buffer_data, "1");
+  EXPECT_EQ(calls[1].action, string_view("callJsModule"));
+  EXPECT_EQ(calls[2].action, string_view("resumeInstance"));
+  EXPECT_EQ(calls[2].buffer_data, "2");
+  EXPECT_EQ(calls[3].action, string_view("callJsModule"));
+
+  // 被合并调用的回调依次串在首次调用之后
+  for (const auto& call : calls) {
+    call.on_js_runner();
+  }
+  for (const auto& call : calls) {
+    call.cb(CALL_FUNCTION_CB_STATE::SUCCESS, "");
+  }
+  std::vector<std::string> expected = {"runner:a", "runner:d", "runner:f", "runner:b", "runner:c", "runner:e",
+                                       "cb:a", "cb:d", "cb:f", "cb:b", "cb:c", "cb:e"};
+  EXPECT_EQ(log, expected);
+}
+
+TEST(CallJsBatcherTest, DrainMatchesUtf16Action) {
+  CallJsBatcher batcher({"resumeInstance"});
+  std::vector<std::string> log;
+  batcher.Push(MakeCall("resumeInstance", "1", log, "a"));
+  auto call = MakeCall("resumeInstance", "1", log, "b");
+  call.action = string_view(u"resumeInstance");
+  batcher.Push(std::move(call));
+  auto calls = batcher.Drain();
+  ASSERT_EQ(calls.size(), 1);
+  calls[0].cb(CALL_FUNCTION_CB_STATE::SUCCESS, "");
+  std::vector<std::string> expected = {"cb:a", "cb:b"};
+  EXPECT_EQ(log, expected);
+}
+
+}  // namespace testing
+}  // namespace driver
+}  // namespace hippy
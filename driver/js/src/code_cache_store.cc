@@ -0,0 +1,406 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "driver/code_cache_store.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "footstone/logging.h"
+
+namespace hippy {
+inline namespace driver {
+
+namespace {
+
+constexpr uint64_t kHashMultiplier = 0xc6a4a7935bd1e995ULL;
+constexpr int kHashShift = 47;
+
+// MurmurHash64A，按 8 字节分块处理，bundle 通常有数 MB，逐字节的哈希在这里开销明显
+uint64_t Hash64(const char* data, size_t size, uint64_t seed) {
+  uint64_t hash = seed ^ (static_cast<uint64_t>(size) * kHashMultiplier);
+  size_t block_count = size / sizeof(uint64_t);
+  for (size_t i = 0; i < block_count; ++i) {
+    uint64_t block;
+    std::memcpy(&block, data + i * sizeof(uint64_t), sizeof(block));
+    block *= kHashMultiplier;
+    block ^= block >> kHashShift;
+    block *= kHashMultiplier;
+    hash ^= block;
+    hash *= kHashMultiplier;
+  }
+  size_t tail_size = size % sizeof(uint64_t);
+  if (tail_size) {
+    uint64_t tail = 0;
+    std::memcpy(&tail, data + block_count * sizeof(uint64_t), tail_size);
+    hash ^= tail;
+    hash *= kHashMultiplier;
+  }
+  hash ^= hash >> kHashShift;
+  hash *= kHashMultiplier;
+  hash ^= hash >> kHashShift;
+  return hash;
+}
+
+bool EndsWith(const std::string& str, const char* suffix) {
+  auto suffix_size = std::strlen(suffix);
+  return str.size() >= suffix_size && str.compare(str.size() - suffix_size, suffix_size, suffix) == 0;
+}
+
+bool CreateDirs(const std::string& dir) {
+  for (size_t pos = dir.find('/', 1); ; pos = dir.find('/', pos + 1)) {
+    auto sub_dir = dir.substr(0, pos);
+    if (mkdir(sub_dir.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+      FOOTSTONE_LOG(ERROR) << "CodeCacheStore create dir failed, dir = " << sub_dir << ", errno = " << errno;
+      return false;
+    }
+    if (pos == std::string::npos) {
+      return true;
+    }
+  }
+}
+
+void RemoveAll(const std::string& path) {
+  struct stat st{};
+  if (lstat(path.c_str(), &st) != 0) {
+    return;
+  }
+  if (S_ISDIR(st.st_mode)) {
+    DIR* dir = opendir(path.c_str());
+    if (dir) {
+      struct dirent* ent;
+      while ((ent = readdir(dir)) != nullptr) {
+        if (std::strcmp(ent->d_name, ".") != 0 && std::strcmp(ent->d_name, "..") != 0) {
+          RemoveAll(path + '/' + ent->d_name);
+        }
+      }
+      closedir(dir);
+    }
+    rmdir(path.c_str());
+  } else {
+    unlink(path.c_str());
+  }
+}
+
+bool WriteAll(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    auto written = write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+bool ReadAll(int fd, char* data, size_t size) {
+  while (size > 0) {
+    auto bytes = read(fd, data, size);
+    if (bytes < 0 && errno == EINTR) {
+      continue;
+    }
+    if (bytes <= 0) {
+      return false;
+    }
+    data += bytes;
+    size -= static_cast<size_t>(bytes);
+  }
+  return true;
+}
+
+}  // namespace
+
+CodeCacheStore::CodeCacheStore(std::string dir, uint64_t capacity) : dir_(std::move(dir)), capacity_(capacity) {}
+
+std::shared_ptr<CodeCacheStore> CodeCacheStore::Open(const std::string& dir, uint64_t capacity) {
+  static std::mutex stores_mutex;
+  static std::unordered_map<std::string, std::weak_ptr<CodeCacheStore>> stores;
+
+  auto normalized_dir = dir;
+  while (normalized_dir.size() > 1 && normalized_dir.back() == '/') {
+    normalized_dir.pop_back();
+  }
+  if (normalized_dir.empty()) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(stores_mutex);
+  auto store = stores[normalized_dir].lock();
+  if (!store) {
+    if (!CreateDirs(normalized_dir)) {
+      return nullptr;
+    }
+    store = std::make_shared<CodeCacheStore>(normalized_dir, capacity);
+    stores[normalized_dir] = store;
+  }
+  return store;
+}
+
+std::string CodeCacheStore::MakeKey(const char* content, size_t length, const std::string& engine_tag) {
+  auto seed = Hash64(engine_tag.c_str(), engine_tag.size(), 0);
+  auto hash = Hash64(content, length, seed);
+  char key[40];
+  std::snprintf(key, sizeof(key), "%016llx_%llx", static_cast<unsigned long long>(hash),
+                static_cast<unsigned long long>(length));
+  return key;
+}
+
+bool CodeCacheStore::Load(const std::string& key, std::string& data) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (TakePrewarmed(key, data)) {
+      ++statistics_.hit_count;
+      Touch(key);
+      return true;
+    }
+  }
+  auto ret = ReadEntry(key, data);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (ret == ReadResult::kOk) {
+    ++statistics_.hit_count;
+    Touch(key);
+    return true;
+  }
+  ++statistics_.miss_count;
+  if (ret == ReadResult::kCorrupt) {
+    FOOTSTONE_LOG(WARNING) << "CodeCacheStore drop corrupt entry, key = " << key;
+    ++statistics_.corrupt_count;
+    unlink(GetPath(key).c_str());
+    // 索引尚未建立时无需处理，建立索引时文件已不存在
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      statistics_.size -= it->second.size;
+      index_.erase(it);
+    }
+  }
+  return false;
+}
+
+bool CodeCacheStore::Store(const std::string& key, const std::string& data) {
+  if (key.empty() || data.empty()) {
+    return false;
+  }
+  std::string temp_path;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    EnsureIndex();
+    temp_path = GetPath(key) + "." + std::to_string(getpid()) + "_" + std::to_string(++temp_file_id_) + ".tmp";
+  }
+  FileHeader header{kFileMagic, kFileVersion, data.size(), Hash64(data.c_str(), data.size(), kFileVersion)};
+  int fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    FOOTSTONE_LOG(ERROR) << "CodeCacheStore open failed, path = " << temp_path << ", errno = " << errno;
+    return false;
+  }
+  bool ok = WriteAll(fd, reinterpret_cast<const char*>(&header), sizeof(header)) &&
+      WriteAll(fd, data.c_str(), data.size()) && fsync(fd) == 0;
+  ok = (close(fd) == 0) && ok;
+  auto path = GetPath(key);
+  if (!ok || std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    FOOTSTONE_LOG(ERROR) << "CodeCacheStore write failed, path = " << path << ", errno = " << errno;
+    unlink(temp_path.c_str());
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& entry = index_[key];
+  statistics_.size = statistics_.size - entry.size + sizeof(header) + data.size();
+  entry.size = sizeof(header) + data.size();
+  entry.tick = ++tick_;
+  Evict(key);
+  return true;
+}
+
+bool CodeCacheStore::Prewarm(const std::string& key) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    EnsureIndex();
+    if (prewarmed_.find(key) != prewarmed_.end()) {
+      return true;
+    }
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return false;
+    }
+    if (prewarmed_size_ + it->second.size > capacity_ / 4) {
+      FOOTSTONE_LOG(WARNING) << "CodeCacheStore prewarm skipped, prewarmed_size = " << prewarmed_size_
+                             << ", entry_size = " << it->second.size;
+      return true;
+    }
+  }
+  std::string data;
+  if (ReadEntry(key, data) != ReadResult::kOk) {
+    // 损坏的条目留给 Load 处理
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (prewarmed_.find(key) == prewarmed_.end()) {
+    prewarmed_size_ += data.size();
+    prewarmed_[key] = std::move(data);
+  }
+  return true;
+}
+
+void CodeCacheStore::Remove(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  EnsureIndex();
+  unlink(GetPath(key).c_str());
+  DropPrewarmed(key);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    statistics_.size -= it->second.size;
+    index_.erase(it);
+  }
+}
+
+CodeCacheStore::Statistics CodeCacheStore::GetStatistics() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  EnsureIndex();
+  return statistics_;
+}
+
+std::string CodeCacheStore::GetPath(const std::string& key) const {
+  return dir_ + "/" + key + kFileSuffix;
+}
+
+CodeCacheStore::ReadResult CodeCacheStore::ReadEntry(const std::string& key, std::string& data) {
+  int fd = open(GetPath(key).c_str(), O_RDONLY);
+  if (fd < 0) {
+    return ReadResult::kMissing;
+  }
+  auto ret = ReadResult::kCorrupt;
+  struct stat st{};
+  FileHeader header{};
+  if (fstat(fd, &st) == 0 && static_cast<uint64_t>(st.st_size) >= sizeof(header) &&
+      ReadAll(fd, reinterpret_cast<char*>(&header), sizeof(header)) &&
+      header.magic == kFileMagic && header.version == kFileVersion &&
+      header.data_size == static_cast<uint64_t>(st.st_size) - sizeof(header)) {
+    data.resize(header.data_size);
+    if (ReadAll(fd, &data[0], data.size()) && Hash64(data.c_str(), data.size(), kFileVersion) == header.checksum) {
+      ret = ReadResult::kOk;
+    } else {
+      data.clear();
+    }
+  }
+  close(fd);
+  return ret;
+}
+
+// 首次使用时扫描目录建立索引，按文件修改时间恢复使用顺序
+void CodeCacheStore::EnsureIndex() {
+  if (index_ready_) {
+    return;
+  }
+  index_ready_ = true;
+  DIR* dir = opendir(dir_.c_str());
+  if (!dir) {
+    return;
+  }
+  std::vector<std::pair<time_t, std::string>> entries;
+  struct dirent* ent;
+  while ((ent = readdir(dir)) != nullptr) {
+    std::string name = ent->d_name;
+    if (name == "." || name == "..") {
+      continue;
+    }
+    auto path = dir_ + "/" + name;
+    struct stat st{};
+    if (lstat(path.c_str(), &st) != 0) {
+      continue;
+    }
+    if (!S_ISREG(st.st_mode) || !EndsWith(name, kFileSuffix)) {
+      // 旧版本按文件名与修改时间保存的缓存，以及写入中断残留的临时文件
+      RemoveAll(path);
+      continue;
+    }
+    auto key = name.substr(0, name.size() - std::strlen(kFileSuffix));
+    index_[key] = Entry{static_cast<uint64_t>(st.st_size), 0};
+    statistics_.size += static_cast<uint64_t>(st.st_size);
+    entries.emplace_back(st.st_mtime, std::move(key));
+  }
+  closedir(dir);
+  std::sort(entries.begin(), entries.end());
+  for (const auto& [mtime, key] : entries) {
+    index_[key].tick = ++tick_;
+  }
+  Evict("");
+}
+
+// 索引尚未建立时只刷新文件的修改时间，建立索引时按修改时间恢复使用顺序
+void CodeCacheStore::Touch(const std::string& key) {
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    it->second.tick = ++tick_;
+  }
+  utime(GetPath(key).c_str(), nullptr);
+}
+
+void CodeCacheStore::Evict(const std::string& keep_key) {
+  while (statistics_.size > capacity_) {
+    auto victim = index_.end();
+    for (auto it = index_.begin(); it != index_.end(); ++it) {
+      if (it->first != keep_key && (victim == index_.end() || it->second.tick < victim->second.tick)) {
+        victim = it;
+      }
+    }
+    if (victim == index_.end()) {
+      break;
+    }
+    unlink(GetPath(victim->first).c_str());
+    DropPrewarmed(victim->first);
+    statistics_.size -= victim->second.size;
+    index_.erase(victim);
+    ++statistics_.evict_count;
+  }
+}
+
+bool CodeCacheStore::TakePrewarmed(const std::string& key, std::string& data) {
+  auto it = prewarmed_.find(key);
+  if (it == prewarmed_.end()) {
+    return false;
+  }
+  prewarmed_size_ -= it->second.size();
+  data = std::move(it->second);
+  prewarmed_.erase(it);
+  return true;
+}
+
+void CodeCacheStore::DropPrewarmed(const std::string& key) {
+  std::string data;
+  TakePrewarmed(key, data);
+}
+
+}  // namespace driver
+}  // namespace hippy
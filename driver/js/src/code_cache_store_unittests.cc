@@ -0,0 +1,258 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "driver/code_cache_store.h"
+
+namespace hippy {
+namespace driver {
+namespace testing {
+
+using CodeCacheStore = hippy::driver::CodeCacheStore;
+
+constexpr char kEngineTag[] = "engine";
+// 条目文件头的大小：magic、version、data_size、checksum
+constexpr uint64_t kHeaderSize = 24;
+
+bool Exists(const std::string& path) {
+  struct stat st{};
+  return lstat(path.c_str(), &st) == 0;
+}
+
+void WriteFile(const std::string& path, const std::string& content) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file << content;
+}
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+class CodeCacheStoreTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char dir[] = "/tmp/code_cache_store_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    root_ = dir;
+    dir_ = root_ + "/cache";
+    ASSERT_EQ(mkdir(dir_.c_str(), S_IRWXU), 0);
+  }
+
+  void TearDown() override {
+    std::string command = "rm -rf " + root_;
+    std::system(command.c_str());
+  }
+
+  std::string EntryPath(const std::string& key) const {
+    return dir_ + "/" + key + CodeCacheStore::kFileSuffix;
+  }
+
+  std::string root_;
+  std::string dir_;
+};
+
+TEST_F(CodeCacheStoreTest, MakeKey) {
+  auto key = CodeCacheStore::MakeKey("var a = 1;", kEngineTag);
+  EXPECT_EQ(key, CodeCacheStore::MakeKey("var a = 1;", kEngineTag));
+  // 内容或引擎标识变化后 key 随之变化
+  EXPECT_NE(key, CodeCacheStore::MakeKey("var a = 2;", kEngineTag));
+  EXPECT_NE(key, CodeCacheStore::MakeKey("var a = 1;", "engine_v2"));
+}
+
+TEST_F(CodeCacheStoreTest, StoreAndLoad) {
+  CodeCacheStore store(dir_, CodeCacheStore::kDefaultCapacity);
+  auto key = CodeCacheStore::MakeKey("var a = 1;", kEngineTag);
+  std::string data;
+  EXPECT_FALSE(store.Load(key, data));
+
+  std::string code_cache(1000, '\0');
+  for (size_t i = 0; i < code_cache.size(); ++i) {
+    code_cache[i] = static_cast<char>(i * 31);
+  }
+  ASSERT_TRUE(store.Store(key, code_cache));
+  ASSERT_TRUE(store.Load(key, data));
+  EXPECT_EQ(data, code_cache);
+
+  // 重新打开目录后仍能读取
+  CodeCacheStore reopened(dir_, CodeCacheStore::kDefaultCapacity);
+  ASSERT_TRUE(reopened.Load(key, data));
+  EXPECT_EQ(data, code_cache);
+  auto statistics = reopened.GetStatistics();
+  EXPECT_EQ(statistics.hit_count, 1);
+  EXPECT_EQ(statistics.size, kHeaderSize + code_cache.size());
+
+  EXPECT_FALSE(store.Store("", code_cache));
+  EXPECT_FALSE(store.Store(key, ""));
+}
+
+TEST_F(CodeCacheStoreTest, DropCorruptEntry) {
+  CodeCacheStore store(dir_, CodeCacheStore::kDefaultCapacity);
+  auto key = CodeCacheStore::MakeKey("var a = 1;", kEngineTag);
+  ASSERT_TRUE(store.Store(key, std::string(100, 'a')));
+
+  auto content = ReadFile(EntryPath(key));
+  content[content.size() - 1] = 'b';
+  WriteFile(EntryPath(key), content);
+  std::string data;
+  EXPECT_FALSE(store.Load(key, data));
+  EXPECT_TRUE(data.empty());
+  EXPECT_FALSE(Exists(EntryPath(key)));
+
+  // 截断的条目同样被删除
+  ASSERT_TRUE(store.Store(key, std::string(100, 'a')));
+  WriteFile(EntryPath(key), ReadFile(EntryPath(key)).substr(0, 50));
+  EXPECT_FALSE(store.Load(key, data));
+  EXPECT_FALSE(Exists(EntryPath(key)));
+
+  auto statistics = store.GetStatistics();
+  EXPECT_EQ(statistics.corrupt_count, 2);
+  EXPECT_EQ(statistics.miss_count, 2);
+  EXPECT_EQ(statistics.size, 0);
+}
+
+TEST_F(CodeCacheStoreTest, EvictLeastRecentlyUsed) {
+  constexpr uint64_t kDataSize = 100;
+  // 最多容纳两个条目
+  CodeCacheStore store(dir_, (kHeaderSize + kDataSize) * 2);
+  std::string data(kDataSize, 'a');
+  ASSERT_TRUE(store.Store("a", data));
+  ASSERT_TRUE(store.Store("b", data));
+  std::string loaded;
+  ASSERT_TRUE(store.Load("a", loaded));
+  ASSERT_TRUE(store.Store("c", data));
+
+  EXPECT_TRUE(Exists(EntryPath("a")));
+  EXPECT_FALSE(Exists(EntryPath("b")));
+  EXPECT_TRUE(Exists(EntryPath("c")));
+  auto statistics = store.GetStatistics();
+  EXPECT_EQ(statistics.evict_count, 1);
+  EXPECT_EQ(statistics.size, (kHeaderSize + kDataSize) * 2);
+
+  // 比容量还大的条目写入后保留，淘汰其余条目
+  ASSERT_TRUE(store.Store("d", std::string(kDataSize * 3, 'd')));
+  EXPECT_TRUE(Exists(EntryPath("d")));
+  EXPECT_FALSE(Exists(EntryPath("a")));
+  EXPECT_FALSE(Exists(EntryPath("c")));
+}
+
+TEST_F(CodeCacheStoreTest, RestoreOrderFromModifyTime) {
+  constexpr uint64_t kDataSize = 100;
+  std::string data(kDataSize, 'a');
+  {
+    CodeCacheStore store(dir_, CodeCacheStore::kDefaultCapacity);
+    ASSERT_TRUE(store.Store("a", data));
+    ASSERT_TRUE(store.Store("b", data));
+  }
+  // 修改时间精度为秒，直接设置以区分先后
+  struct utimbuf older = {1000, 1000};
+  struct utimbuf newer = {2000, 2000};
+  utime(EntryPath("a").c_str(), &newer);
+  utime(EntryPath("b").c_str(), &older);
+
+  CodeCacheStore store(dir_, (kHeaderSize + kDataSize) * 2);
+  ASSERT_TRUE(store.Store("c", data));
+  EXPECT_TRUE(Exists(EntryPath("a")));
+  EXPECT_FALSE(Exists(EntryPath("b")));
+  EXPECT_TRUE(Exists(EntryPath("c")));
+}
+
+TEST_F(CodeCacheStoreTest, CleanLegacyFiles) {
+  {
+    CodeCacheStore store(dir_, CodeCacheStore::kDefaultCapacity);
+    ASSERT_TRUE(store.Store("a", std::string(100, 'a')));
+  }
+  // 旧版本按 tag 建立的子目录、按文件名保存的缓存与写入中断残留的临时文件
+  auto legacy_dir = dir_ + "/tag";
+  ASSERT_EQ(mkdir(legacy_dir.c_str(), S_IRWXU), 0);
+  WriteFile(legacy_dir + "/index.android.js_1700000000", "legacy");
+  WriteFile(dir_ + "/vendor.android.js_1700000000", "legacy");
+  WriteFile(EntryPath("b") + ".123_1.tmp", "partial");
+  // 目录外的内容通过符号链接出现在目录中时，只删除链接本身
+  auto outside_dir = root_ + "/outside";
+  ASSERT_EQ(mkdir(outside_dir.c_str(), S_IRWXU), 0);
+  WriteFile(outside_dir + "/keep", "keep");
+  ASSERT_EQ(symlink(outside_dir.c_str(), (dir_ + "/link").c_str()), 0);
+
+  CodeCacheStore store(dir_, CodeCacheStore::kDefaultCapacity);
+  // Load 不扫描目录
+  std::string data;
+  ASSERT_TRUE(store.Load("a", data));
+  EXPECT_TRUE(Exists(legacy_dir));
+
+  auto statistics = store.GetStatistics();
+  EXPECT_EQ(statistics.size, kHeaderSize + 100);
+  EXPECT_TRUE(Exists(EntryPath("a")));
+  EXPECT_FALSE(Exists(legacy_dir));
+  EXPECT_FALSE(Exists(dir_ + "/vendor.android.js_1700000000"));
+  EXPECT_FALSE(Exists(EntryPath("b") + ".123_1.tmp"));
+  EXPECT_FALSE(Exists(dir_ + "/link"));
+  EXPECT_TRUE(Exists(outside_dir + "/keep"));
+}
+
+TEST_F(CodeCacheStoreTest, Prewarm) {
+  constexpr uint64_t kDataSize = 100;
+  // 预热的条目总大小不超过容量的 1/4，即一个条目
+  CodeCacheStore store(dir_, (kHeaderSize + kDataSize) * 4);
+  ASSERT_TRUE(store.Store("a", std::string(kDataSize, 'a')));
+  ASSERT_TRUE(store.Store("b", std::string(kDataSize, 'b')));
+  EXPECT_FALSE(store.Prewarm("c"));
+  EXPECT_TRUE(store.Prewarm("a"));
+  // 超出上限时跳过，条目仍然存在
+  EXPECT_TRUE(store.Prewarm("b"));
+
+  // 预热的条目直接从内存取走，不再读盘
+  unlink(EntryPath("a").c_str());
+  unlink(EntryPath("b").c_str());
+  std::string data;
+  ASSERT_TRUE(store.Load("a", data));
+  EXPECT_EQ(data, std::string(kDataSize, 'a'));
+  EXPECT_FALSE(store.Load("b", data));
+  // 取走后释放占用，可以继续预热
+  ASSERT_TRUE(store.Store("b", std::string(kDataSize, 'b')));
+  EXPECT_TRUE(store.Prewarm("b"));
+  unlink(EntryPath("b").c_str());
+  ASSERT_TRUE(store.Load("b", data));
+  EXPECT_EQ(data, std::string(kDataSize, 'b'));
+}
+
+TEST_F(CodeCacheStoreTest, OpenSharesInstance) {
+  auto store = CodeCacheStore::Open(dir_ + "/sub/dir/");
+  ASSERT_NE(store, nullptr);
+  EXPECT_EQ(store, CodeCacheStore::Open(dir_ + "/sub/dir"));
+  EXPECT_EQ(store->GetDir(), dir_ + "/sub/dir");
+  EXPECT_TRUE(Exists(dir_ + "/sub/dir"));
+  EXPECT_EQ(CodeCacheStore::Open(""), nullptr);
+}
+
+}  // namespace testing
+}  // namespace driver
+}  // namespace hippy
@@ -20,13 +20,13 @@
 
 #include "driver/js_driver_utils.h"
 
-#include <sys/stat.h>
-
 #include <any>
 #include <functional>
-#include <future>
 #include <utility>
 
+#include "driver/base/js_convert_utils.h"
+#include "driver/call_js_batcher.h"
+#include "driver/code_cache_store.h"
 #include "driver/napi/callback_info.h"
 #include "driver/napi/js_ctx.h"
 #include "driver/napi/js_ctx_value.h"
@@ -36,6 +36,7 @@
 #include "footstone/deserializer.h"
 #include "footstone/hippy_value.h"
 #include "footstone/logging.h"
+#include "footstone/serializer.h"
 #include "footstone/string_view_utils.h"
 #include "footstone/task.h"
 #include "footstone/task_runner.h"
@@ -64,10 +65,10 @@ using Ctx = hippy::Ctx;
 using CtxValue = hippy::napi::CtxValue;
 using Deserializer = footstone::value::Deserializer;
 using HippyValue = footstone::value::HippyValue;
-using HippyFile = hippy::vfs::HippyFile;
 using VMInitParam = hippy::VM::VMInitParam;
 using ScopeWrapper = hippy::ScopeWrapper;
 using CallbackInfo = hippy::CallbackInfo;
+using MappedFile = hippy::vfs::MappedFile;
 
 #ifdef JS_V8
 using V8VM = hippy::V8VM;
@@ -75,6 +76,7 @@ using V8Ctx = hippy::V8Ctx;
 #endif
 
 constexpr char kBridgeName[] = "hippyBridge";
+constexpr char kBatchedCallsAction[] = "batchedCalls";
 constexpr char kWorkerRunnerName[] = "hippy_worker";
 constexpr char kGlobalKey[] = "global";
 constexpr char kHippyKey[] = "Hippy";
@@ -89,6 +91,13 @@ using V8InspectorClientImpl = hippy::inspector::V8InspectorClientImpl;
 using DevtoolsDataSource = hippy::devtools::DevtoolsDataSource;
 #endif
 
+#ifdef JS_V8
+// 引擎版本与影响编译结果的 flag 共同决定 code cache 能否被复用
+std::string GetCodeCacheTag() {
+  return std::to_string(v8::ScriptCompiler::CachedDataVersionTag());
+}
+#endif
+
 static std::unordered_map<int64_t, std::pair<std::shared_ptr<Engine>, uint32_t>> reuse_engine_map;
 static std::mutex engine_mutex;
 
@@ -276,95 +285,105 @@ bool JsDriverUtils::RunScript(const std::shared_ptr<Scope>& scope,
                       << ", code_cache_dir = " << code_cache_dir
                       << ", uri = " << uri
                       << ", is_local_file = " << is_local_file;
-  string_view code_cache_content;
-  uint64_t modify_time = 0;
-  string_view code_cache_path;
-  std::future<u8string> read_file_future;
   auto loader = scope->GetUriLoader().lock();
   FOOTSTONE_CHECK(loader);
-  auto& worker_manager = loader->GetWorkerManager();
-  auto worker_task_runner = worker_manager->CreateTaskRunner(kWorkerRunnerName);
-  if (is_use_code_cache) {
-    if (is_local_file) {
-      modify_time = HippyFile::GetFileModifyTime(uri);
-    }
-    code_cache_path = code_cache_dir + file_name + string_view("_") + string_view(std::to_string(modify_time));
-    std::promise<u8string> read_file_promise;
-    read_file_future = read_file_promise.get_future();
-    auto engine = scope->GetEngine().lock();
-    FOOTSTONE_CHECK(engine);
-    auto func = hippy::base::MakeCopyable([p = std::move(read_file_promise), code_cache_path, code_cache_dir]() mutable {
-      u8string content;
-      HippyFile::ReadFile(code_cache_path, content, true);
-      if (content.empty()) {
-        FOOTSTONE_DLOG(INFO) << "Read code cache failed";
-        int ret = HippyFile::RmFullPath(code_cache_dir);
-        FOOTSTONE_DLOG(INFO) << "RmFullPath ret = " << ret;
-        FOOTSTONE_USE(ret);
-      } else {
-        FOOTSTONE_DLOG(INFO) << "Read code cache succ";
-      }
-      p.set_value(std::move(content));
-    });
-    worker_task_runner->PostTask(std::move(func));
+  std::shared_ptr<MappedFile> mapped_file;
+#ifdef JS_V8
+  // 本地文件在处理链允许时直接映射，由 V8 以外部字符串引用，避免整份 bundle 在堆中被多次拷贝
+  // 调试时仍经过 UriLoader，保留 devtools 的网络记录
+  auto engine = scope->GetEngine().lock();
+  if (engine && !engine->GetVM()->IsDebug()) {
+    mapped_file = loader->MapLocalFile(uri);
   }
-  UriLoader::RetCode code;
-  std::unordered_map<std::string, std::string> meta;
+#endif
   UriLoader::bytes content;
-  loader->RequestUntrustedContent(uri, {}, code, meta, content);
-  auto script_content = string_view::new_from_utf8(content.c_str(), content.length());
-  auto read_script_flag = false;
-  if (code == UriLoader::RetCode::Success && !StringViewUtils::IsEmpty(script_content)) {
-    read_script_flag = true;
-  }
-  if (is_use_code_cache) {
-    code_cache_content = read_file_future.get();
+  auto load_content = [&loader, &uri, &content]() {
+    UriLoader::RetCode code;
+    std::unordered_map<std::string, std::string> meta;
+    loader->RequestUntrustedContent(uri, {}, code, meta, content);
+    if (code != UriLoader::RetCode::Success) {
+      content.clear();
+    }
+  };
+  if (!mapped_file) {
+    load_content();
   }
+  auto script_length = mapped_file ? mapped_file->size() : content.length();
 
   FOOTSTONE_DLOG(INFO) << "uri = " << uri
-                       << ", read_script_flag = " << read_script_flag
-                       << ", script content = " << script_content;
+                       << ", script length = " << script_length
+                       << ", is_mapped = " << (mapped_file != nullptr);
 
-  if (!read_script_flag || StringViewUtils::IsEmpty(script_content)) {
-    FOOTSTONE_LOG(WARNING) << "read_script_flag = " << read_script_flag
-                           << ", script content empty, uri = " << uri;
+  if (!script_length) {
+    FOOTSTONE_LOG(WARNING) << "script content empty, uri = " << uri;
     return false;
   }
 
+#ifdef JS_V8
+  std::shared_ptr<CodeCacheStore> code_cache_store;
+  if (is_use_code_cache) {
+    code_cache_store = CodeCacheStore::Open(StringViewUtils::ToStdString(
+        StringViewUtils::ConvertEncoding(code_cache_dir, string_view::Encoding::Utf8).utf8_value()));
+  }
+  // code cache 按脚本内容寻址，远程 bundle 与本地文件一样可以命中
+  std::string code_cache_key;
+  if (code_cache_store && mapped_file) {
+    code_cache_key = CodeCacheStore::MakeKey(mapped_file->data(), mapped_file->size(), GetCodeCacheTag());
+  }
+  // 交给 V8 之前确认文件未被替换或改写（如热更新正在覆盖），否则改为拷贝读取，保证编译的内容与 key 一致
+  if (mapped_file && mapped_file->IsModified()) {
+    FOOTSTONE_LOG(WARNING) << "mapped script modified, reload by uri loader, uri = " << uri;
+    mapped_file = nullptr;
+    load_content();
+    script_length = content.length();
+    if (!script_length) {
+      FOOTSTONE_LOG(WARNING) << "script content empty, uri = " << uri;
+      return false;
+    }
+  }
+  // 脚本内存由 owner 持有，直到 V8 释放外部字符串
+  std::shared_ptr<void> script_owner = mapped_file;
+  const char* script_data;
+  if (mapped_file) {
+    script_data = mapped_file->data();
+  } else {
+    auto bytes = std::make_shared<UriLoader::bytes>(std::move(content));
+    script_data = bytes->c_str();
+    script_owner = std::move(bytes);
+    if (code_cache_store) {
+      code_cache_key = CodeCacheStore::MakeKey(script_data, script_length, GetCodeCacheTag());
+    }
+  }
+  string_view code_cache_content;
+  if (code_cache_store) {
+    std::string code_cache_data;
+    if (code_cache_store->Load(code_cache_key, code_cache_data)) {
+      code_cache_content = string_view(reinterpret_cast<const string_view::char8_t_*>(code_cache_data.c_str()),
+                                       code_cache_data.length());
+    }
+    FOOTSTONE_DLOG(INFO) << "code cache key = " << code_cache_key
+                         << ", hit = " << !StringViewUtils::IsEmpty(code_cache_content);
+  }
+#else
+  auto script_content = string_view::new_from_utf8(content.c_str(), content.length());
+#endif
+
   // perfromance start time
   auto entry = scope->GetPerformance()->PerformanceNavigation(kPerfNavigationHippyInit);
   entry->BundleInfoOfUrl(uri).execute_source_start_ = footstone::TimePoint::SystemNow();
 
 #ifdef JS_V8
   auto ret = std::static_pointer_cast<V8Ctx>(scope->GetContext())->RunScript(
-      script_content, file_name, is_use_code_cache,&code_cache_content, true);
-  if (is_use_code_cache) {
-    if (!StringViewUtils::IsEmpty(code_cache_content)) {
-      auto func = [code_cache_path, code_cache_dir, code_cache_content] {
-        int check_dir_ret = HippyFile::CheckDir(code_cache_dir, F_OK);
-        FOOTSTONE_DLOG(INFO) << "check_parent_dir_ret = " << check_dir_ret;
-        if (check_dir_ret) {
-          HippyFile::CreateDir(code_cache_dir, S_IRWXU);
-        }
-
-        size_t pos = StringViewUtils::FindLastOf(code_cache_path, EXTEND_LITERAL('/'));
-        string_view code_cache_parent_dir = StringViewUtils::SubStr(code_cache_path, 0, pos);
-        int check_parent_dir_ret = HippyFile::CheckDir(code_cache_parent_dir, F_OK);
-        FOOTSTONE_DLOG(INFO) << "check_parent_dir_ret = " << check_parent_dir_ret;
-        if (check_parent_dir_ret) {
-          HippyFile::CreateDir(code_cache_parent_dir, S_IRWXU);
-        }
-
-        auto u8_code_cache_content = StringViewUtils::ToStdString(StringViewUtils::ConvertEncoding(
-            code_cache_content, string_view::Encoding::Utf8).utf8_value());
-        bool save_file_ret = HippyFile::SaveFile(code_cache_path, u8_code_cache_content);
-        FOOTSTONE_LOG(INFO) << "code cache save_file_ret = " << save_file_ret;
-        FOOTSTONE_USE(save_file_ret);
-      };
-      auto engine = scope->GetEngine().lock();
-      FOOTSTONE_CHECK(engine);
-      worker_task_runner->PostTask(std::move(func));
-    }
+      script_owner, script_data, script_length, file_name, code_cache_store != nullptr, &code_cache_content);
+  // 缓存命中时 code_cache_content 被置空，只有首次编译或缓存被拒绝时才需要写入
+  if (code_cache_store && !StringViewUtils::IsEmpty(code_cache_content)) {
+    auto code_cache_data = StringViewUtils::ToStdString(code_cache_content.utf8_value());
+    auto worker_task_runner = loader->GetWorkerManager()->CreateTaskRunner(kWorkerRunnerName);
+    worker_task_runner->PostTask([code_cache_store, code_cache_key, code_cache_data = std::move(code_cache_data)] {
+      bool store_ret = code_cache_store->Store(code_cache_key, code_cache_data);
+      FOOTSTONE_LOG(INFO) << "code cache store_ret = " << store_ret;
+      FOOTSTONE_USE(store_ret);
+    });
   }
 #else
   auto ret = scope->GetContext()->RunScript(script_content, file_name);
@@ -379,6 +398,49 @@ bool JsDriverUtils::RunScript(const std::shared_ptr<Scope>& scope,
   return flag;
 }
 
+void JsDriverUtils::PrewarmCodeCache(const std::shared_ptr<UriLoader>& loader,
+                                     const string_view& code_cache_dir,
+                                     const string_view& uri) {
+#ifdef JS_V8
+  FOOTSTONE_CHECK(loader);
+  auto code_cache_store = CodeCacheStore::Open(StringViewUtils::ToStdString(
+      StringViewUtils::ConvertEncoding(code_cache_dir, string_view::Encoding::Utf8).utf8_value()));
+  if (!code_cache_store) {
+    return;
+  }
+  auto worker_task_runner = loader->GetWorkerManager()->CreateTaskRunner(kWorkerRunnerName);
+  std::weak_ptr<UriLoader> weak_loader = loader;
+  worker_task_runner->PostTask([weak_loader, code_cache_store, uri]() {
+    auto loader = weak_loader.lock();
+    if (!loader) {
+      return;
+    }
+    UriLoader::RetCode code;
+    std::unordered_map<std::string, std::string> meta;
+    UriLoader::bytes content;
+    loader->RequestUntrustedContent(uri, {}, code, meta, content);
+    if (code != UriLoader::RetCode::Success || content.empty()) {
+      FOOTSTONE_LOG(WARNING) << "PrewarmCodeCache load failed, uri = " << uri;
+      return;
+    }
+    auto key = CodeCacheStore::MakeKey(content, GetCodeCacheTag());
+    if (code_cache_store->Prewarm(key)) {
+      return;
+    }
+    // 没有缓存时在当前 worker 线程用临时 isolate 编译生成，不占用 js 线程
+    auto code_cache = V8VM::CreateCodeCache(content.c_str(), content.length(), uri);
+    bool store_ret = !code_cache.empty() && code_cache_store->Store(key, code_cache);
+    FOOTSTONE_DLOG(INFO) << "PrewarmCodeCache store_ret = " << store_ret << ", uri = " << uri;
+    FOOTSTONE_USE(store_ret);
+  });
+#else
+  // JSC 的字节码缓存由系统管理
+  FOOTSTONE_USE(loader);
+  FOOTSTONE_DLOG(INFO) << "PrewarmCodeCache unsupported, code_cache_dir = " << code_cache_dir
+                       << ", uri = " << uri;
+#endif
+}
+
 void JsDriverUtils::DestroyInstance(std::shared_ptr<Engine>&& engine,
                                     std::shared_ptr<Scope>&& scope,
                                     const std::function<void(bool)>& callback,
@@ -437,6 +499,71 @@ void JsDriverUtils::DestroyInstance(std::shared_ptr<Engine>&& engine,
   FOOTSTONE_DLOG(INFO) << "destroy, group = " << group;
 }
 
+// 返回 false 表示 hippyBridge 不存在
+static bool InitBridgeObject(const std::shared_ptr<Scope>& scope) {
+  if (scope->GetBridgeObject()) {
+    return true;
+  }
+  FOOTSTONE_DLOG(INFO) << "init bridge func";
+  auto context = scope->GetContext();
+  auto func_name = context->CreateString(kBridgeName);
+  auto global_object = context->GetGlobalObject();
+  auto function = context->GetProperty(global_object, func_name);
+  bool is_function = context->IsFunction(function);
+  FOOTSTONE_DLOG(INFO) << "is_fn = " << is_function;
+  if (!is_function) {
+    return false;
+  }
+  scope->SetBridgeObject(function);
+  return true;
+}
+
+// 返回 false 表示反序列化失败，此时已通过 cb 通知调用方
+static bool ToCallJsParams(const std::shared_ptr<Scope>& scope,
+                           const std::shared_ptr<VM>& vm,
+                           const string_view& action,
+                           const byte_string& buffer_data,
+                           const std::function<void(CALL_FUNCTION_CB_STATE, string_view)>& cb,
+                           std::shared_ptr<CtxValue>& params) {
+  auto context = scope->GetContext();
+  if (vm->IsEnableV8Serialization()) {
+#ifdef JS_V8
+    auto v8_vm = std::static_pointer_cast<V8VM>(vm);
+    auto result = v8_vm->Deserializer(context, buffer_data);
+    if (result.flag) {
+      params = result.result;
+    } else {
+      auto msg = u"deserializer error";
+      if (!StringViewUtils::IsEmpty(result.message)) {
+        msg = StringViewUtils::ConvertEncoding(result.message,
+                                               string_view::Encoding::Utf16).utf16_value().c_str();
+      }
+      cb(CALL_FUNCTION_CB_STATE::DESERIALIZER_FAILED, msg);
+      return false;
+    }
+#else
+    // 其他引擎按同样的格式解析，直接由序列化数据创建 js 值
+    Deserializer deserializer(reinterpret_cast<const uint8_t*>(buffer_data.data()), buffer_data.length());
+    footstone::HippyValueView view;
+    if (!deserializer.ReadHeader() || !deserializer.ReadValueView(view)) {
+      cb(CALL_FUNCTION_CB_STATE::DESERIALIZER_FAILED, u"deserializer error");
+      return false;
+    }
+    params = CreateCtxValue(context, view);
+#endif
+  } else {
+    std::u16string str(reinterpret_cast<const char16_t*>(&buffer_data[0]),
+                       buffer_data.length() / sizeof(char16_t));
+    string_view buf_str(std::move(str));
+    FOOTSTONE_DLOG(INFO) << "action = " << action << ", buf_str = " << buf_str;
+    params = vm->ParseJson(context, buf_str);
+  }
+  if (!params) {
+    params = context->CreateNull();
+  }
+  return true;
+}
+
 void JsDriverUtils::CallJs(const string_view& action,
                            const std::shared_ptr<Scope>& scope,
                            std::function<void(CALL_FUNCTION_CB_STATE, string_view)> cb,
@@ -445,6 +572,19 @@ void JsDriverUtils::CallJs(const string_view& action,
                            ) {
   auto runner = scope->GetTaskRunner();
   std::weak_ptr<Scope> weak_scope = scope;
+  auto batcher = scope->GetCallJsBatcher();
+  if (batcher) {
+    // 只有队列由空变为非空时投递 flush，同一 tick 内的后续调用由这次 flush 一并下发
+    if (batcher->Push({action, std::move(buffer_data), std::move(cb), std::move(on_js_runner)})) {
+      runner->PostTask([weak_scope] {
+        auto scope = weak_scope.lock();
+        if (scope) {
+          FlushCallJs(scope);
+        }
+      });
+    }
+    return;
+  }
   auto callback = [weak_scope, cb = std::move(cb), action,
       buffer_data_ = std::move(buffer_data),
       on_js_runner = std::move(on_js_runner)] {
@@ -460,50 +600,14 @@ void JsDriverUtils::CallJs(const string_view& action,
       return;
     }
     auto context = scope->GetContext();
-    if (!scope->GetBridgeObject()) {
-      FOOTSTONE_DLOG(INFO) << "init bridge func";
-      auto func_name = context->CreateString(kBridgeName);
-      auto global_object = context->GetGlobalObject();
-      auto function = context->GetProperty(global_object, func_name);
-      bool is_function = context->IsFunction(function);
-      FOOTSTONE_DLOG(INFO) << "is_fn = " << is_function;
-      if (!is_function) {
-        cb(CALL_FUNCTION_CB_STATE::NO_METHOD_ERROR, u"hippyBridge not find");
-        return;
-      } else {
-        scope->SetBridgeObject(function);
-      }
+    if (!InitBridgeObject(scope)) {
+      cb(CALL_FUNCTION_CB_STATE::NO_METHOD_ERROR, u"hippyBridge not find");
+      return;
     }
     std::shared_ptr<CtxValue> action_value = context->CreateString(action);
     std::shared_ptr<CtxValue> params;
-    auto vm = engine->GetVM();
-#ifdef JS_V8
-    auto v8_vm = std::static_pointer_cast<V8VM>(vm);
-    if (v8_vm->IsEnableV8Serialization()) {
-      auto result = v8_vm->Deserializer(scope->GetContext(), buffer_data_);
-      if (result.flag) {
-        params = result.result;
-      } else {
-        auto msg = u"deserializer error";
-        if (!StringViewUtils::IsEmpty(result.message)) {
-          msg = StringViewUtils::ConvertEncoding(result.message,
-                                                 string_view::Encoding::Utf16).utf16_value().c_str();
-        }
-        cb(CALL_FUNCTION_CB_STATE::DESERIALIZER_FAILED, msg);
-        return;
-      }
-    } else {
-#endif
-      std::u16string str(reinterpret_cast<const char16_t*>(&buffer_data_[0]),
-                         buffer_data_.length() / sizeof(char16_t));
-      string_view buf_str(std::move(str));
-      FOOTSTONE_DLOG(INFO) << "action = " << action << ", buf_str = " << buf_str;
-      params = vm->ParseJson(context, buf_str);
-#ifdef JS_V8
-    }
-#endif
-    if (!params) {
-      params = context->CreateNull();
+    if (!ToCallJsParams(scope, engine->GetVM(), action, buffer_data_, cb, params)) {
+      return;
     }
     std::shared_ptr<CtxValue> argv[] = {action_value, params};
     context->CallFunction(scope->GetBridgeObject(), context->GetGlobalObject(), 2, argv);
@@ -513,6 +617,95 @@ void JsDriverUtils::CallJs(const string_view& action,
   runner->PostTask(std::move(callback));
 }
 
+bool JsDriverUtils::EnableCallJsBatch(const std::shared_ptr<Scope>& scope,
+                                      std::unordered_set<std::string> idempotent_actions) {
+#ifdef JS_JSC
+  FOOTSTONE_DLOG(FATAL) << "EnableCallJsBatch, native2js of JSC does not handle batchedCalls";
+  return false;
+#else
+  scope->SetCallJsBatcher(std::make_shared<CallJsBatcher>(std::move(idempotent_actions)));
+  return true;
+#endif
+}
+
+void JsDriverUtils::FlushCallJs(const std::shared_ptr<Scope>& scope) {
+  auto batcher = scope->GetCallJsBatcher();
+  if (!batcher) {
+    return;
+  }
+  auto calls = batcher->Drain();
+  if (calls.empty()) {
+    return;
+  }
+  for (const auto& call : calls) {
+    call.on_js_runner();
+  }
+  auto engine = scope->GetEngine().lock();
+  FOOTSTONE_DCHECK(engine);
+  if (!engine) {
+    return;
+  }
+  auto context = scope->GetContext();
+  if (!InitBridgeObject(scope)) {
+    for (const auto& call : calls) {
+      call.cb(CALL_FUNCTION_CB_STATE::NO_METHOD_ERROR, u"hippyBridge not find");
+    }
+    return;
+  }
+  auto vm = engine->GetVM();
+  std::shared_ptr<CtxValue> batch;
+  if (!vm->IsEnableV8Serialization()) {
+    // 各调用的参数都是 json，拼接为 [["action",params],...] 后只解析一次
+    std::u16string json(u"[");
+    for (const auto& call : calls) {
+      if (json.size() > 1) {
+        json.push_back(u',');
+      }
+      json.append(u"[\"");
+      json.append(StringViewUtils::ConvertEncoding(call.action, string_view::Encoding::Utf16).utf16_value());
+      json.append(u"\",");
+      if (call.buffer_data.empty()) {
+        json.append(u"null");
+      } else {
+        json.append(reinterpret_cast<const char16_t*>(call.buffer_data.data()),
+                    call.buffer_data.length() / sizeof(char16_t));
+      }
+      json.push_back(u']');
+    }
+    json.push_back(u']');
+    batch = vm->ParseJson(context, string_view(std::move(json)));
+  }
+  std::vector<CallJsBatcher::Call*> delivered;
+  delivered.reserve(calls.size());
+  if (batch) {
+    for (auto& call : calls) {
+      delivered.push_back(&call);
+    }
+  } else {
+    // 使用二进制格式，或某个调用的参数不是合法 json 时逐个转换，与单独调用时的行为一致
+    std::vector<std::shared_ptr<CtxValue>> items;
+    items.reserve(calls.size());
+    for (auto& call : calls) {
+      std::shared_ptr<CtxValue> params;
+      if (!ToCallJsParams(scope, vm, call.action, call.buffer_data, call.cb, params)) {
+        continue;
+      }
+      std::shared_ptr<CtxValue> item[] = {context->CreateString(call.action), params};
+      items.push_back(context->CreateArray(2, item));
+      delivered.push_back(&call);
+    }
+    if (items.empty()) {
+      return;
+    }
+    batch = context->CreateArray(items.size(), items.data());
+  }
+  std::shared_ptr<CtxValue> argv[] = {context->CreateString(kBatchedCallsAction), batch};
+  context->CallFunction(scope->GetBridgeObject(), context->GetGlobalObject(), 2, argv);
+  for (auto call : delivered) {
+    call->cb(CALL_FUNCTION_CB_STATE::SUCCESS, "");
+  }
+}
+
 void JsDriverUtils::CallNative(hippy::napi::CallbackInfo& info, const std::function<void(
     std::shared_ptr<Scope>,
     string_view,
@@ -563,17 +756,27 @@ void JsDriverUtils::CallNative(hippy::napi::CallbackInfo& info, const std::funct
 
   std::string buffer_data;
   if (info[3] && context->IsObject(info[3])) {
-#ifdef JS_V8
     auto engine = scope->GetEngine().lock();
     FOOTSTONE_DCHECK(engine);
     if (!engine) {
       return;
     }
     auto vm = engine->GetVM();
-    auto v8_vm = std::static_pointer_cast<V8VM>(vm);
-    if (v8_vm->IsEnableV8Serialization()) {
+    if (vm->IsEnableV8Serialization()) {
+#ifdef JS_V8
+      auto v8_vm = std::static_pointer_cast<V8VM>(vm);
       auto v8_ctx = std::static_pointer_cast<hippy::napi::V8Ctx>(context);
       buffer_data = v8_ctx->GetSerializationBuffer(info[3], v8_vm->GetBuffer());
+#else
+      // 其他引擎遍历 js 值写成同样的格式，省去 JSON.stringify 与 utf8 转码
+      footstone::Serializer serializer(vm->GetSerializerBufferPool());
+      serializer.WriteHeader();
+      if (!SerializeCtxValue(context, info[3], serializer)) {
+        info.GetExceptionValue()->Set(context, "CallNative param serialize error");
+        return;
+      }
+      auto [buffer, size] = serializer.GetBuffer();
+      buffer_data.assign(reinterpret_cast<const char*>(buffer), size);
 #endif
     } else {
       string_view json;
@@ -582,9 +785,7 @@ void JsDriverUtils::CallNative(hippy::napi::CallbackInfo& info, const std::funct
       FOOTSTONE_DLOG(INFO) << "CallJava json = " << json;
       buffer_data = StringViewUtils::ToStdString(
           StringViewUtils::ConvertEncoding(json, string_view::Encoding::Utf8).utf8_value());
-#ifdef JS_V8
     }
-#endif
   }
 
   int32_t transfer_type = 0;
@@ -24,6 +24,7 @@
 
 #include <string>
 
+#include "driver/js_driver_utils.h"
 #include "driver/modules/module_register.h"
 #include "driver/napi/js_ctx.h"
 #include "driver/napi/js_ctx_value.h"
@@ -148,6 +149,9 @@ void AnimationFrameModule::UpdateFrame(const std::shared_ptr<Scope>& scope) {
   }
   enable_update_frame_ = false;
 
+  // 先下发本帧之前合并的 native 调用，保证事件在帧回调之前到达 js
+  JsDriverUtils::FlushCallJs(scope);
+
   std::shared_ptr<hippy::napi::Ctx> context = scope->GetContext();
 
 #ifdef ANDROID
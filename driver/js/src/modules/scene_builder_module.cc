@@ -148,73 +148,22 @@ GetNodeTagName(const std::shared_ptr<Ctx> &context,
   return std::make_tuple(true, "", std::move(tag_name));
 }
 
-std::tuple<bool, std::string, std::unordered_map<std::string, std::shared_ptr<HippyValue>>>
-GetNodeStyle(const std::shared_ptr<Ctx> &context,
-             std::unordered_map<std::string, HippyValue> &props) {
-  std::unordered_map<std::string, std::shared_ptr<HippyValue>> ret;
-  // parse style
-  auto style_it = props.find(kNodePropertyStyle);
-  if (style_it != props.end()) {
-    if (style_it->second.IsObject()) {
-      std::unordered_map<std::string, HippyValue> style_obj = style_it->second.ToObjectChecked();
-      for (const auto &p : style_obj) {
-        ret[p.first] = std::make_shared<HippyValue>(p.second);
-      }
-    }
-    props.erase(style_it);
-    return std::make_tuple(true, "", std::move(ret));
-  }
-  return std::make_tuple(false, "props does not contain style", std::move(ret));
-}
-
-std::tuple<bool, std::string,
-           std::unordered_map<std::string, std::shared_ptr<HippyValue>>>
-GetNodeExtValue(const std::shared_ptr<Ctx> &context,
-                std::unordered_map<std::string, HippyValue> &props) {
-  std::unordered_map<std::string, std::shared_ptr<HippyValue>> dom_ext_map;
-  // parse ext value
-  for (const auto &p : props) {
-    dom_ext_map[p.first] = std::make_shared<HippyValue>(p.second);
-  }
-  return std::make_tuple(true, "", std::move(dom_ext_map));
-}
-
-std::tuple<bool, std::string,
-           std::unordered_map<std::string, std::shared_ptr<HippyValue>>,
-           std::unordered_map<std::string, std::shared_ptr<HippyValue>>>
+std::tuple<bool, std::string, DomValueMap, DomValueMap>
 GetNodeProps(const std::shared_ptr<Ctx> &context, const std::shared_ptr<CtxValue> &node) {
-  std::unordered_map<std::string, std::shared_ptr<HippyValue>> style_map;
-  std::unordered_map<std::string, std::shared_ptr<HippyValue>> dom_ext_map;
+  DomValueMap style_map;
+  DomValueMap dom_ext_map;
   std::shared_ptr<CtxValue> props = context->GetProperty(node, kNodePropertyProps);
   if (!props) {
     return std::make_tuple(false, "node does not contain props",
                            std::move(style_map),
                            std::move(dom_ext_map));
   }
-  std::shared_ptr<HippyValue> props_obj = hippy::ToDomValue(context, props);
-  if (!props_obj) {
+  // style 与 ext 直接从 js 对象转换到各自的 map 中
+  if (!hippy::ToDomNodeProps(context, props, kNodePropertyStyle, style_map, dom_ext_map)) {
     return std::make_tuple(false, "to dom value failed",
                            std::move(style_map),
                            std::move(dom_ext_map));
   }
-
-  if (!props_obj->IsObject()) {
-    return std::make_tuple(false, "props_obj type error",
-                           std::move(style_map),
-                           std::move(dom_ext_map));
-  }
-
-  std::unordered_map<std::string, HippyValue> props_map = props_obj->ToObjectChecked();
-  auto style_tuple = GetNodeStyle(context, props_map);
-  if (!std::get<2>(style_tuple).empty()) {
-    style_map = std::move(std::get<2>(style_tuple));
-  }
-  auto ext_tuple = GetNodeExtValue(context, props_map);
-  if (std::get<0>(ext_tuple)) {
-    if (!std::get<2>(ext_tuple).empty()) {
-      dom_ext_map = std::move(std::get<2>(ext_tuple));
-    }
-  }
   return std::make_tuple(true, "", std::move(style_map), std::move(dom_ext_map));
 }
 
@@ -282,10 +231,8 @@ CreateNode(const std::shared_ptr<Ctx> &context,
   std::string u8_view_name = StringViewUtils::ToStdString(
       StringViewUtils::ConvertEncoding(std::get<2>(view_name_tuple),
           string_view::Encoding::Utf8).utf8_value());
-  auto style = std::make_shared<std::unordered_map<std::string, std::shared_ptr<HippyValue>>>(
-      std::move(std::get<2>(props_tuple)));
-  auto ext = std::make_shared<std::unordered_map<std::string, std::shared_ptr<HippyValue>>>(
-      std::move(std::get<3>(props_tuple)));
+  auto style = std::make_shared<DomValueMap>(std::move(std::get<2>(props_tuple)));
+  auto ext = std::make_shared<DomValueMap>(std::move(std::get<3>(props_tuple)));
   FOOTSTONE_CHECK(!scope->GetDomManager().expired());
   dom_node = std::make_shared<DomNode>(std::get<2>(id_tuple),
                                        std::get<2>(pid_tuple),
@@ -22,6 +22,8 @@
 
 #include "driver/napi/v8/v8_ctx.h"
 
+#include <cstring>
+
 #include "driver/base/js_value_wrapper.h"
 #include "driver/napi/v8/v8_ctx_value.h"
 #include "driver/napi/v8/v8_class_definition.h"
@@ -194,6 +196,10 @@ class ExternalOneByteStringResourceImpl
     length_ = str_data_.length();
   }
 
+  // owner 持有 data 所在的内存（如文件映射），随外部字符串一起释放
+  ExternalOneByteStringResourceImpl(std::shared_ptr<void> owner, const uint8_t* data, size_t length)
+      : data_(data), length_(length), owner_(std::move(owner)) {}
+
   ~ExternalOneByteStringResourceImpl() override = default;
   ExternalOneByteStringResourceImpl(const ExternalOneByteStringResourceImpl&) = delete;
   const ExternalOneByteStringResourceImpl& operator=(const ExternalOneByteStringResourceImpl&) = delete;
@@ -211,8 +217,28 @@ class ExternalOneByteStringResourceImpl
   const uint8_t* data_;
   std::string str_data_;
   size_t length_;
+  std::shared_ptr<void> owner_;
 };
 
+// ASCII 文本按 Latin1 解释时内容不变，可以直接作为单字节字符串使用
+static bool IsAscii(const char* data, size_t length) {
+  constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t block;
+    memcpy(&block, data + i, sizeof(block));
+    if (block & kHighBits) {
+      return false;
+    }
+  }
+  for (; i < length; ++i) {
+    if (static_cast<uint8_t>(data[i]) & 0x80) {
+      return false;
+    }
+  }
+  return true;
+}
+
 class ExternalStringResourceImpl : public v8::String::ExternalStringResource {
  public:
   ExternalStringResourceImpl(const uint16_t* data, size_t length)
@@ -397,6 +423,33 @@ std::shared_ptr<CtxValue> V8Ctx::RunScript(const string_view& str_view,
   return InternalRunScript(context, source.ToLocalChecked(), file_name, is_use_code_cache, cache);
 }
 
+std::shared_ptr<CtxValue> V8Ctx::RunScript(const std::shared_ptr<void>& owner,
+                                           const char* data,
+                                           size_t length,
+                                           const string_view& file_name,
+                                           bool is_use_code_cache,
+                                           string_view* cache) {
+  FOOTSTONE_LOG(INFO) << "V8Ctx::RunScript file_name = " << file_name << ", length = " << length
+                      << ", is_use_code_cache = " << is_use_code_cache;
+  v8::HandleScope handle_scope(isolate_);
+  v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
+  v8::Context::Scope context_scope(context);
+  v8::MaybeLocal<v8::String> source;
+  if (IsAscii(data, length)) {
+    auto* one_byte = new ExternalOneByteStringResourceImpl(owner, reinterpret_cast<const uint8_t*>(data), length);
+    source = v8::String::NewExternalOneByte(isolate_, one_byte);
+  } else {
+    // 含非 ASCII 字符时需要转码，由 V8 直接从 data 解码到堆中，只拷贝一次
+    source = v8::String::NewFromUtf8(isolate_, data, v8::NewStringType::kNormal,
+                                     footstone::checked_numeric_cast<size_t, int>(length));
+  }
+  if (source.IsEmpty()) {
+    FOOTSTONE_DLOG(WARNING) << "v8_source empty, file_name = " << file_name;
+    return nullptr;
+  }
+  return InternalRunScript(context, source.ToLocalChecked(), file_name, is_use_code_cache, cache);
+}
+
 void V8Ctx::SetDefaultContext(const std::shared_ptr<v8::SnapshotCreator>& creator) {
   FOOTSTONE_CHECK(creator);
   v8::HandleScope handle_scope(isolate_);
@@ -430,6 +483,13 @@ std::shared_ptr<CtxValue> V8Ctx::InternalRunScript(
       v8::ScriptCompiler::Source script_source(source, origin, cached_data);
       script = v8::ScriptCompiler::Compile(
           context, &script_source, v8::ScriptCompiler::kConsumeCodeCache);
+      // 缓存被接受时无需回写，置空 cache；被拒绝（如引擎版本或 flag 变化）时重新生成，由调用方覆盖旧条目
+      if (!script.IsEmpty() && script_source.GetCachedData()->rejected) {
+        FOOTSTONE_LOG(WARNING) << "code cache rejected, file_name = " << file_name;
+        *cache = CreateCodeCache(script.ToLocalChecked());
+      } else {
+        *cache = string_view();
+      }
     } else {
       FOOTSTONE_UNREACHABLE();
     }
@@ -440,12 +500,7 @@ std::shared_ptr<CtxValue> V8Ctx::InternalRunScript(
       if (script.IsEmpty()) {
         return nullptr;
       }
-      const v8::ScriptCompiler::CachedData* cached_data =
-          v8::ScriptCompiler::CreateCodeCache(
-              script.ToLocalChecked()->GetUnboundScript());
-      *cache = string_view(cached_data->data,
-                                   footstone::checked_numeric_cast<int,
-                                                                     size_t>(cached_data->length));
+      *cache = CreateCodeCache(script.ToLocalChecked());
     } else {
       script = v8::Script::Compile(context, source, &origin);
     }
@@ -463,6 +518,16 @@ std::shared_ptr<CtxValue> V8Ctx::InternalRunScript(
   return std::make_shared<V8CtxValue>(isolate_, v8_value);
 }
 
+string_view V8Ctx::CreateCodeCache(v8::Local<v8::Script> script) {
+  std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data(
+      v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+  if (!cached_data) {
+    return string_view();
+  }
+  return string_view(reinterpret_cast<const string_view::char8_t_*>(cached_data->data),
+                     footstone::checked_numeric_cast<int, size_t>(cached_data->length));
+}
+
 void V8Ctx::ThrowException(const std::shared_ptr<CtxValue>& exception) {
   v8::HandleScope handle_scope(isolate_);
   auto context = context_persistent_.Get(isolate_);
@@ -40,7 +40,7 @@ namespace {
   const uint8_t k_Dimensions[] = { 40,102,117,110,99,116,105,111,110,40,101,120,112,111,114,116,115,44,32,114,101,113,117,105,114,101,44,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,41,32,123,102,117,110,99,116,105,111,110,32,116,114,97,110,115,102,101,114,84,111,85,110,105,102,105,101,100,68,105,109,101,110,115,105,111,110,115,40,110,97,116,105,118,101,68,105,109,101,110,115,105,111,110,115,41,32,123,10,32,32,108,101,116,32,110,97,116,105,118,101,87,105,110,100,111,119,59,10,32,32,108,101,116,32,110,97,116,105,118,101,83,99,114,101,101,110,59,10,32,32,105,102,32,40,103,108,111,98,97,108,46,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,46,79,83,32,61,61,61,32,39,105,111,115,39,41,32,123,10,32,32,32,32,40,123,10,32,32,32,32,32,32,119,105,110,100,111,119,58,32,110,97,116,105,118,101,87,105,110,100,111,119,44,10,32,32,32,32,32,32,115,99,114,101,101,110,58,32,110,97,116,105,118,101,83,99,114,101,101,110,10,32,32,32,32,125,32,61,32,110,97,116,105,118,101,68,105,109,101,110,115,105,111,110,115,41,59,10,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,40,123,10,32,32,32,32,32,32,119,105,110,100,111,119,80,104,121,115,105,99,97,108,80,105,120,101,108,115,58,32,110,97,116,105,118,101,87,105,110,100,111,119,44,10,32,32,32,32,32,32,115,99,114,101,101,110,80,104,121,115,105,99,97,108,80,105,120,101,108,115,58,32,110,97,116,105,118,101,83,99,114,101,101,110,10,32,32,32,32,125,32,61,32,110,97,116,105,118,101,68,105,109,101,110,115,105,111,110,115,41,59,10,32,32,125,10,32,32,114,101,116,117,114,110,32,123,10,32,32,32,32,110,97,116,105,118,101,87,105,110,100,111,119,44,10,32,32,32,32,110,97,116,105,118,101,83,99,114,101,101,110,10,32,32,125,59,10,125,10,102,117,110,99,116,105,111,110,32,103,101,116,80,114,111,99,101,115,115,101,100,68,105,109,101,110,115,105,111,110,115,40,110,97,116,105,118,101,68,105,109,101,110,115,105,111,110,115,41,32,123,10,32,32,108,101,116,32,119,105,110,100,111,119,32,61,32,123,125,59,10,32,32,108,101,116,32,115,99,114,101,101,110,32,61,32,123,125,59,10,32,32,99,111,110,115,116,32,123,10,32,32,32,32,110,97,116,105,118,101,87,105,110,100,111,119,44,10,32,32,32,32,110,97,116,105,118,101,83,99,114,101,101,110,10,32,32,125,32,61,32,116,114,97,110,115,102,101,114,84,111,85,110,105,102,105,101,100,68,105,109,101,110,115,105,111,110,115,40,110,97,116,105,118,101,68,105,109,101,110,115,105,111,110,115,41,59,10,32,32,105,102,32,40,110,97,116,105,118,101,87,105,110,100,111,119,41,32,123,10,32,32,32,32,103,108,111,98,97,108,46,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,46,79,83,32,61,61,61,32,39,105,111,115,39,32,63,32,119,105,110,100,111,119,32,61,32,110,97,116,105,118,101,87,105,110,100,111,119,32,58,32,119,105,110,100,111,119,32,61,32,123,10,32,32,32,32,32,32,119,105,100,116,104,58,32,110,97,116,105,118,101,87,105,110,100,111,119,46,119,105,100,116,104,44,10,32,32,32,32,32,32,104,101,105,103,104,116,58,32,110,97,116,105,118,101,87,105,110,100,111,119,46,104,101,105,103,104,116,44,10,32,32,32,32,32,32,115,99,97,108,101,58,32,110,97,116,105,118,101,87,105,110,100,111,119,46,115,99,97,108,101,44,10,32,32,32,32,32,32,102,111,110,116,83,99,97,108,101,58,32,110,97,116,105,118,101,87,105,110,100,111,119,46,102,111,110,116,83,99,97,108,101,44,10,32,32,32,32,32,32,115,116,97,116,117,115,66,97,114,72,101,105,103,104,116,58,32,110,97,116,105,118,101,87,105,110,100,111,119,46,115,116,97,116,117,115,66,97,114,72,101,105,103,104,116,44,10,32,32,32,32,32,32,110,97,118,105,103,97,116,111,114,66,97,114,72,101,105,103,104,116,58,32,110,97,116,105,118,101,87,105,110,100,111,119,46,110,97,118,105,103,97,116,105,111,110,66,97,114,72,101,105,103,104,116,10,32,32,32,32,125,59,10,32,32,125,10,32,32,105,102,32,40,110,97,116,105,118,101,83,99,114,101,101,110,41,32,123,10,32,32,32,32,103,108,111,98,97,108,46,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,46,79,83,32,61,61,61,32,39,105,111,115,39,32,63,32,115,99,114,101,101,110,32,61,32,110,97,116,105,118,101,83,99,114,101,101,110,32,58,32,115,99,114,101,101,110,32,61,32,123,10,32,32,32,32,32,32,119,105,100,116,104,58,32,110,97,116,105,118,101,83,99,114,101,101,110,46,119,105,100,116,104,44,10,32,32,32,32,32,32,104,101,105,103,104,116,58,32,110,97,116,105,118,101,83,99,114,101,101,110,46,104,101,105,103,104,116,44,10,32,32,32,32,32,32,115,99,97,108,101,58,32,110,97,116,105,118,101,83,99,114,101,101,110,46,115,99,97,108,101,44,10,32,32,32,32,32,32,102,111,110,116,83,99,97,108,101,58,32,110,97,116,105,118,101,83,99,114,101,101,110,46,102,111,110,116,83,99,97,108,101,44,10,32,32,32,32,32,32,115,116,97,116,117,115,66,97,114,72,101,105,103,104,116,58,32,110,97,116,105,118,101,83,99,114,101,101,110,46,115,116,97,116,117,115,66,97,114,72,101,105,103,104,116,44,10,32,32,32,32,32,32,110,97,118,105,103,97,116,111,114,66,97,114,72,101,105,103,104,116,58,32,110,97,116,105,118,101,83,99,114,101,101,110,46,110,97,118,105,103,97,116,105,111,110,66,97,114,72,101,105,103,104,116,10,32,32,32,32,125,59,10,32,32,125,10,32,32,114,101,116,117,114,110,32,123,10,32,32,32,32,119,105,110,100,111,119,44,10,32,32,32,32,115,99,114,101,101,110,10,32,32,125,59,10,125,10,99,111,110,115,116,32,68,105,109,101,110,115,105,111,110,115,32,61,32,123,10,32,32,103,101,116,40,107,101,121,41,32,123,10,32,32,32,32,99,111,110,115,116,32,100,101,118,105,99,101,32,61,32,72,105,112,112,121,46,100,101,118,105,99,101,32,124,124,32,123,125,59,10,32,32,32,32,114,101,116,117,114,110,32,100,101,118,105,99,101,91,107,101,121,93,59,10,32,32,125,44,10,32,32,115,101,116,40,110,97,116,105,118,101,68,105,109,101,110,115,105,111,110,115,41,32,123,10,32,32,32,32,105,102,32,40,33,110,97,116,105,118,101,68,105,109,101,110,115,105,111,110,115,41,32,123,10,32,32,32,32,32,32,114,101,116,117,114,110,59,10,32,32,32,32,125,10,32,32,32,32,99,111,110,115,116,32,123,10,32,32,32,32,32,32,119,105,110,100,111,119,44,10,32,32,32,32,32,32,115,99,114,101,101,110,10,32,32,32,32,125,32,61,32,103,101,116,80,114,111,99,101,115,115,101,100,68,105,109,101,110,115,105,111,110,115,40,110,97,116,105,118,101,68,105,109,101,110,115,105,111,110,115,41,59,10,32,32,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,119,105,110,100,111,119,32,61,32,119,105,110,100,111,119,59,10,32,32,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,115,99,114,101,101,110,32,61,32,115,99,114,101,101,110,59,10,32,32,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,112,105,120,101,108,82,97,116,105,111,32,61,32,72,105,112,112,121,46,100,101,118,105,99,101,46,119,105,110,100,111,119,46,115,99,97,108,101,59,10,32,32,125,44,10,32,32,105,110,105,116,40,41,32,123,10,32,32,32,32,116,104,105,115,46,115,101,116,40,95,95,72,73,80,80,89,78,65,84,73,86,69,71,76,79,66,65,76,95,95,46,68,105,109,101,110,115,105,111,110,115,41,59,10,32,32,125,10,125,59,10,68,105,109,101,110,115,105,111,110,115,46,105,110,105,116,40,41,59,10,95,95,71,76,79,66,65,76,95,95,46,106,115,77,111,100,117,108,101,76,105,115,116,32,61,32,123,10,32,32,68,105,109,101,110,115,105,111,110,115,10,125,59,125,41,59,0 };  // NOLINT
   const uint8_t k_UtilsModule[] = { 40,102,117,110,99,116,105,111,110,40,101,120,112,111,114,116,115,44,32,114,101,113,117,105,114,101,44,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,41,32,123,105,102,32,40,72,105,112,112,121,46,100,101,118,105,99,101,46,112,108,97,116,102,111,114,109,46,79,83,32,61,61,61,32,39,97,110,100,114,111,105,100,39,41,32,123,10,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,118,105,98,114,97,116,101,32,61,32,40,112,97,116,116,101,114,110,44,32,114,101,112,101,97,116,41,32,61,62,32,123,10,32,32,32,32,108,101,116,32,95,112,97,116,116,101,114,110,32,61,32,112,97,116,116,101,114,110,59,10,32,32,32,32,108,101,116,32,95,114,101,112,101,97,116,32,61,32,114,101,112,101,97,116,59,10,32,32,32,32,105,102,32,40,116,121,112,101,111,102,32,112,97,116,116,101,114,110,32,61,61,61,32,39,110,117,109,98,101,114,39,41,32,123,10,32,32,32,32,32,32,95,112,97,116,116,101,114,110,32,61,32,91,48,44,32,112,97,116,116,101,114,110,93,59,10,32,32,32,32,125,10,32,32,32,32,105,102,32,40,114,101,112,101,97,116,32,61,61,61,32,117,110,100,101,102,105,110,101,100,41,32,123,10,32,32,32,32,32,32,95,114,101,112,101,97,116,32,61,32,45,49,59,10,32,32,32,32,125,10,32,32,32,32,72,105,112,112,121,46,98,114,105,100,103,101,46,99,97,108,108,78,97,116,105,118,101,87,105,116,104,67,97,108,108,98,97,99,107,73,100,40,39,85,116,105,108,115,77,111,100,117,108,101,39,44,32,39,118,105,98,114,97,116,101,39,44,32,116,114,117,101,44,32,95,112,97,116,116,101,114,110,44,32,95,114,101,112,101,97,116,41,59,10,32,32,125,59,10,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,99,97,110,99,101,108,86,105,98,114,97,116,101,32,61,32,40,41,32,61,62,32,123,10,32,32,32,32,72,105,112,112,121,46,98,114,105,100,103,101,46,99,97,108,108,78,97,116,105,118,101,87,105,116,104,67,97,108,108,98,97,99,107,73,100,40,39,85,116,105,108,115,77,111,100,117,108,101,39,44,32,39,99,97,110,99,101,108,39,44,32,116,114,117,101,41,59,10,32,32,125,59,10,125,32,101,108,115,101,32,105,102,32,40,72,105,112,112,121,46,100,101,118,105,99,101,46,112,108,97,116,102,111,114,109,46,79,83,32,61,61,61,32,39,105,111,115,39,41,32,123,10,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,118,105,98,114,97,116,101,32,61,32,40,41,32,61,62,32,123,125,59,10,32,32,72,105,112,112,121,46,100,101,118,105,99,101,46,99,97,110,99,101,108,86,105,98,114,97,116,101,32,61,32,40,41,32,61,62,32,123,125,59,10,125,125,41,59,0 };  // NOLINT
   const uint8_t k_global[] = { 40,102,117,110,99,116,105,111,110,40,101,120,112,111,114,116,115,44,32,114,101,113,117,105,114,101,44,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,41,32,123,95,95,71,76,79,66,65,76,95,95,46,97,112,112,82,101,103,105,115,116,101,114,32,61,32,123,125,59,10,95,95,71,76,79,66,65,76,95,95,46,109,111,100,117,108,101,67,97,108,108,73,100,32,61,32,48,59,10,95,95,71,76,79,66,65,76,95,95,46,109,111,100,117,108,101,67,97,108,108,76,105,115,116,32,61,32,123,125,59,10,95,95,71,76,79,66,65,76,95,95,46,99,97,110,82,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,32,61,32,116,114,117,101,59,10,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,73,100,32,61,32,48,59,10,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,81,117,101,117,101,32,61,32,123,125,59,125,41,59,0 };  // NOLINT
-  const uint8_t k_native2js[] = { 40,102,117,110,99,116,105,111,110,40,101,120,112,111,114,116,115,44,32,114,101,113,117,105,114,101,44,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,41,32,123,103,108,111,98,97,108,46,104,105,112,112,121,66,114,105,100,103,101,32,61,32,40,95,97,99,116,105,111,110,44,32,95,99,97,108,108,79,98,106,41,32,61,62,32,123,10,32,32,108,101,116,32,114,101,115,112,32,61,32,39,115,117,99,99,101,115,115,39,59,10,32,32,108,101,116,32,97,99,116,105,111,110,32,61,32,95,97,99,116,105,111,110,59,10,32,32,108,101,116,32,99,97,108,108,79,98,106,32,61,32,95,99,97,108,108,79,98,106,59,10,32,32,105,102,32,40,97,99,116,105,111,110,32,61,61,61,32,39,112,97,117,115,101,73,110,115,116,97,110,99,101,39,41,32,123,10,32,32,32,32,97,99,116,105,111,110,32,61,32,39,99,97,108,108,74,115,77,111,100,117,108,101,39,59,10,32,32,32,32,99,97,108,108,79,98,106,32,61,32,123,10,32,32,32,32,32,32,109,101,116,104,111,100,78,97,109,101,58,32,39,114,101,99,101,105,118,101,78,97,116,105,118,101,69,118,101,110,116,39,44,10,32,32,32,32,32,32,109,111,100,117,108,101,78,97,109,101,58,32,39,69,118,101,110,116,68,105,115,112,97,116,99,104,101,114,39,44,10,32,32,32,32,32,32,112,97,114,97,109,115,58,32,91,39,64,104,105,112,112,121,58,112,97,117,115,101,73,110,115,116,97,110,99,101,39,44,32,110,117,108,108,93,10,32,32,32,32,125,59,10,32,32,125,10,32,32,105,102,32,40,97,99,116,105,111,110,32,61,61,61,32,39,114,101,115,117,109,101,73,110,115,116,97,110,99,101,39,41,32,123,10,32,32,32,32,97,99,116,105,111,110,32,61,32,39,99,97,108,108,74,115,77,111,100,117,108,101,39,59,10,32,32,32,32,99,97,108,108,79,98,106,32,61,32,123,10,32,32,32,32,32,32,109,101,116,104,111,100,78,97,109,101,58,32,39,114,101,99,101,105,118,101,78,97,116,105,118,101,69,118,101,110,116,39,44,10,32,32,32,32,32,32,109,111,100,117,108,101,78,97,109,101,58,32,39,69,118,101,110,116,68,105,115,112,97,116,99,104,101,114,39,44,10,32,32,32,32,32,32,112,97,114,97,109,115,58,32,91,39,64,104,105,112,112,121,58,114,101,115,117,109,101,73,110,115,116,97,110,99,101,39,44,32,110,117,108,108,93,10,32,32,32,32,125,59,10,32,32,125,10,32,32,115,119,105,116,99,104,32,40,97,99,116,105,111,110,41,32,123,10,32,32,32,32,99,97,115,101,32,39,99,97,108,108,66,97,99,107,39,58,10,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,105,102,32,40,99,97,108,108,79,98,106,46,109,111,100,117,108,101,78,97,109,101,32,61,61,61,32,39,65,110,105,109,97,116,105,111,110,70,114,97,109,101,77,111,100,117,108,101,39,32,38,38,32,99,97,108,108,79,98,106,46,109,111,100,117,108,101,70,117,110,99,32,61,61,61,32,39,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,39,41,32,123,10,32,32,32,32,32,32,32,32,32,32,105,102,32,40,99,97,108,108,79,98,106,46,114,101,115,117,108,116,32,33,61,61,32,48,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,114,101,115,112,32,61,32,39,110,97,116,105,118,101,50,106,115,32,101,114,114,111,114,58,32,110,97,116,105,118,101,32,102,97,105,108,101,100,32,116,111,32,99,97,108,108,32,65,110,105,109,97,116,105,111,110,70,114,97,109,101,77,111,100,117,108,101,32,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,40,41,39,59,10,32,32,32,32,32,32,32,32,32,32,32,32,98,114,101,97,107,59,10,32,32,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,99,97,110,82,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,32,61,32,116,114,117,101,59,10,32,32,32,32,32,32,32,32,32,32,105,102,32,40,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,81,117,101,117,101,91,99,97,108,108,79,98,106,46,102,114,97,109,101,73,100,93,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,81,117,101,117,101,91,99,97,108,108,79,98,106,46,102,114,97,109,101,73,100,93,46,102,111,114,69,97,99,104,40,99,98,32,61,62,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,116,121,112,101,111,102,32,99,98,32,61,61,61,32,39,102,117,110,99,116,105,111,110,39,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,99,98,40,99,97,108,108,79,98,106,46,112,97,114,97,109,115,41,59,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,32,32,32,32,125,41,59,10,32,32,32,32,32,32,32,32,32,32,32,32,100,101,108,101,116,101,32,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,81,117,101,117,101,91,99,97,108,108,79,98,106,46,102,114,97,109,101,73,100,93,59,10,32,32,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,125,32,101,108,115,101,32,105,102,32,40,95,95,71,76,79,66,65,76,95,95,46,109,111,100,117,108,101,67,97,108,108,76,105,115,116,91,99,97,108,108,79,98,106,46,99,97,108,108,73,100,93,41,32,123,10,32,32,32,32,32,32,32,32,32,32,99,111,110,115,116,32,99,97,108,108,98,97,99,107,79,98,106,32,61,32,95,95,71,76,79,66,65,76,95,95,46,109,111,100,117,108,101,67,97,108,108,76,105,115,116,91,99,97,108,108,79,98,106,46,99,97,108,108,73,100,93,59,10,32,32,32,32,32,32,32,32,32,32,105,102,32,40,99,97,108,108,79,98,106,46,114,101,115,117,108,116,32,33,61,61,32,48,32,38,38,32,116,121,112,101,111,102,32,99,97,108,108,98,97,99,107,79,98,106,46,114,101,106,101,99,116,32,61,61,61,32,39,102,117,110,99,116,105,111,110,39,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,99,97,108,108,98,97,99,107,79,98,106,46,114,101,106,101,99,116,40,99,97,108,108,79,98,106,46,112,97,114,97,109,115,41,59,10,32,32,32,32,32,32,32,32,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,116,121,112,101,111,102,32,99,97,108,108,98,97,99,107,79,98,106,46,99,98,32,61,61,61,32,39,102,117,110,99,116,105,111,110,39,32,38,38,32,99,97,108,108,98,97,99,107,79,98,106,46,99,98,40,99,97,108,108,79,98,106,46,112,97,114,97,109,115,41,59,10,32,32,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,32,32,105,102,32,40,99,97,108,108,98,97,99,107,79,98,106,46,116,121,112,101,32,61,61,61,32,48,32,124,124,32,99,97,108,108,98,97,99,107,79,98,106,46,116,121,112,101,32,61,61,61,32,49,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,100,101,108,101,116,101,32,95,95,71,76,79,66,65,76,95,95,46,109,111,100,117,108,101,67,97,108,108,76,105,115,116,91,99,97,108,108,79,98,106,46,99,97,108,108,73,100,93,59,10,32,32,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,32,32,32,32,32,32,114,101,115,112,32,61,32,39,110,97,116,105,118,101,50,106,115,32,101,114,114,111,114,58,32,110,97,116,105,118,101,32,99,97,108,108,98,97,99,107,32,105,100,32,105,115,32,110,111,116,32,114,101,103,105,115,116,101,114,101,100,32,105,110,32,106,115,39,59,10,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,98,114,101,97,107,59,10,32,32,32,32,32,32,125,10,32,32,32,32,99,97,115,101,32,39,99,97,108,108,74,115,77,111,100,117,108,101,39,58,10,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,105,102,32,40,33,99,97,108,108,79,98,106,32,124,124,32,33,99,97,108,108,79,98,106,46,109,111,100,117,108,101,78,97,109,101,32,124,124,32,33,99,97,108,108,79,98,106,46,109,101,116,104,111,100,78,97,109,101,41,32,123,10,32,32,32,32,32,32,32,32,32,32,114,101,115,112,32,61,32,39,110,97,116,105,118,101,50,106,115,32,101,114,114,111,114,58,32,99,97,108,108,74,115,77,111,100,117,108,101,32,112,97,114,97,109,32,105,115,32,105,110,118,97,108,105,100,39,59,10,32,32,32,32,32,32,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,32,32,32,32,32,32,99,111,110,115,116,32,116,97,114,103,101,116,77,111,100,117,108,101,32,61,32,95,95,71,76,79,66,65,76,95,95,46,106,115,77,111,100,117,108,101,76,105,115,116,91,99,97,108,108,79,98,106,46,109,111,100,117,108,101,78,97,109,101,93,59,10,32,32,32,32,32,32,32,32,32,32,105,102,32,40,33,116,97,114,103,101,116,77,111,100,117,108,101,32,124,124,32,116,121,112,101,111,102,32,116,97,114,103,101,116,77,111,100,117,108,101,91,99,97,108,108,79,98,106,46,109,101,116,104,111,100,78,97,109,101,93,32,33,61,61,32,39,102,117,110,99,116,105,111,110,39,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,114,101,115,112,32,61,32,39,110,97,116,105,118,101,50,106,115,32,101,114,114,111,114,58,32,99,97,108,108,74,115,77,111,100,117,108,101,32,105,115,32,116,97,114,103,101,116,105,110,103,32,97,110,32,117,110,100,101,102,105,110,101,100,32,109,111,100,117,108,101,32,111,114,32,109,101,116,104,111,100,39,59,10,32,32,32,32,32,32,32,32,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,116,97,114,103,101,116,77,111,100,117,108,101,91,99,97,108,108,79,98,106,46,109,101,116,104,111,100,78,97,109,101,93,40,99,97,108,108,79,98,106,46,112,97,114,97,109,115,41,59,10,32,32,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,98,114,101,97,107,59,10,32,32,32,32,32,32,125,10,32,32,32,32,100,101,102,97,117,108,116,58,10,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,114,101,115,112,32,61,32,39,110,97,116,105,118,101,50,106,115,32,101,114,114,111,114,58,32,110,97,116,105,118,101,50,106,115,32,97,99,116,105,111,110,32,105,115,32,110,111,116,32,100,101,102,105,110,101,100,39,59,10,32,32,32,32,32,32,32,32,98,114,101,97,107,59,10,32,32,32,32,32,32,125,10,32,32,125,10,32,32,114,101,116,117,114,110,32,114,101,115,112,59,10,125,59,125,41,59,0 };  // NOLINT
+  const uint8_t k_native2js[] = { 40,102,117,110,99,116,105,111,110,40,101,120,112,111,114,116,115,44,32,114,101,113,117,105,114,101,44,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,41,32,123,103,108,111,98,97,108,46,104,105,112,112,121,66,114,105,100,103,101,32,61,32,40,95,97,99,116,105,111,110,44,32,95,99,97,108,108,79,98,106,41,32,61,62,32,123,10,32,32,105,102,32,40,95,97,99,116,105,111,110,32,61,61,61,32,39,98,97,116,99,104,101,100,67,97,108,108,115,39,41,32,123,10,32,32,32,32,114,101,116,117,114,110,32,95,99,97,108,108,79,98,106,46,109,97,112,40,40,91,97,99,116,105,111,110,44,32,99,97,108,108,79,98,106,93,41,32,61,62,32,123,10,32,32,32,32,32,32,116,114,121,32,123,10,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,103,108,111,98,97,108,46,104,105,112,112,121,66,114,105,100,103,101,40,97,99,116,105,111,110,44,32,99,97,108,108,79,98,106,41,59,10,32,32,32,32,32,32,125,32,99,97,116,99,104,32,40,101,114,114,41,32,123,10,32,32,32,32,32,32,32,32,105,102,32,40,103,108,111,98,97,108,46,72,105,112,112,121,41,32,123,10,32,32,32,32,32,32,32,32,32,32,103,108,111,98,97,108,46,72,105,112,112,121,46,101,109,105,116,40,39,117,110,99,97,117,103,104,116,69,120,99,101,112,116,105,111,110,39,44,32,101,114,114,41,59,10,32,32,32,32,32,32,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,32,32,32,32,32,32,99,111,110,115,111,108,101,46,101,114,114,111,114,40,39,117,110,99,97,117,103,104,116,69,120,99,101,112,116,105,111,110,39,44,32,101,114,114,41,59,10,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,114,101,116,117,114,110,32,96,110,97,116,105,118,101,50,106,115,32,101,114,114,111,114,58,32,36,123,101,114,114,125,96,59,10,32,32,32,32,32,32,125,10,32,32,32,32,125,41,59,10,32,32,125,10,32,32,108,101,116,32,114,101,115,112,32,61,32,39,115,117,99,99,101,115,115,39,59,10,32,32,108,101,116,32,97,99,116,105,111,110,32,61,32,95,97,99,116,105,111,110,59,10,32,32,108,101,116,32,99,97,108,108,79,98,106,32,61,32,95,99,97,108,108,79,98,106,59,10,32,32,105,102,32,40,97,99,116,105,111,110,32,61,61,61,32,39,112,97,117,115,101,73,110,115,116,97,110,99,101,39,41,32,123,10,32,32,32,32,97,99,116,105,111,110,32,61,32,39,99,97,108,108,74,115,77,111,100,117,108,101,39,59,10,32,32,32,32,99,97,108,108,79,98,106,32,61,32,123,10,32,32,32,32,32,32,109,101,116,104,111,100,78,97,109,101,58,32,39,114,101,99,101,105,118,101,78,97,116,105,118,101,69,118,101,110,116,39,44,10,32,32,32,32,32,32,109,111,100,117,108,101,78,97,109,101,58,32,39,69,118,101,110,116,68,105,115,112,97,116,99,104,101,114,39,44,10,32,32,32,32,32,32,112,97,114,97,109,115,58,32,91,39,64,104,105,112,112,121,58,112,97,117,115,101,73,110,115,116,97,110,99,101,39,44,32,110,117,108,108,93,10,32,32,32,32,125,59,10,32,32,125,10,32,32,105,102,32,40,97,99,116,105,111,110,32,61,61,61,32,39,114,101,115,117,109,101,73,110,115,116,97,110,99,101,39,41,32,123,10,32,32,32,32,97,99,116,105,111,110,32,61,32,39,99,97,108,108,74,115,77,111,100,117,108,101,39,59,10,32,32,32,32,99,97,108,108,79,98,106,32,61,32,123,10,32,32,32,32,32,32,109,101,116,104,111,100,78,97,109,101,58,32,39,114,101,99,101,105,118,101,78,97,116,105,118,101,69,118,101,110,116,39,44,10,32,32,32,32,32,32,109,111,100,117,108,101,78,97,109,101,58,32,39,69,118,101,110,116,68,105,115,112,97,116,99,104,101,114,39,44,10,32,32,32,32,32,32,112,97,114,97,109,115,58,32,91,39,64,104,105,112,112,121,58,114,101,115,117,109,101,73,110,115,116,97,110,99,101,39,44,32,110,117,108,108,93,10,32,32,32,32,125,59,10,32,32,125,10,32,32,115,119,105,116,99,104,32,40,97,99,116,105,111,110,41,32,123,10,32,32,32,32,99,97,115,101,32,39,99,97,108,108,66,97,99,107,39,58,10,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,105,102,32,40,99,97,108,108,79,98,106,46,109,111,100,117,108,101,78,97,109,101,32,61,61,61,32,39,65,110,105,109,97,116,105,111,110,70,114,97,109,101,77,111,100,117,108,101,39,32,38,38,32,99,97,108,108,79,98,106,46,109,111,100,117,108,101,70,117,110,99,32,61,61,61,32,39,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,39,41,32,123,10,32,32,32,32,32,32,32,32,32,32,105,102,32,40,99,97,108,108,79,98,106,46,114,101,115,117,108,116,32,33,61,61,32,48,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,114,101,115,112,32,61,32,39,110,97,116,105,118,101,50,106,115,32,101,114,114,111,114,58,32,110,97,116,105,118,101,32,102,97,105,108,101,100,32,116,111,32,99,97,108,108,32,65,110,105,109,97,116,105,111,110,70,114,97,109,101,77,111,100,117,108,101,32,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,40,41,39,59,10,32,32,32,32,32,32,32,32,32,32,32,32,98,114,101,97,107,59,10,32,32,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,99,97,110,82,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,32,61,32,116,114,117,101,59,10,32,32,32,32,32,32,32,32,32,32,105,102,32,40,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,81,117,101,117,101,91,99,97,108,108,79,98,106,46,102,114,97,109,101,73,100,93,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,81,117,101,117,101,91,99,97,108,108,79,98,106,46,102,114,97,109,101,73,100,93,46,102,111,114,69,97,99,104,40,99,98,32,61,62,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,102,32,40,116,121,112,101,111,102,32,99,98,32,61,61,61,32,39,102,117,110,99,116,105,111,110,39,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,99,98,40,99,97,108,108,79,98,106,46,112,97,114,97,109,115,41,59,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,32,32,32,32,125,41,59,10,32,32,32,32,32,32,32,32,32,32,32,32,100,101,108,101,116,101,32,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,81,117,101,117,101,91,99,97,108,108,79,98,106,46,102,114,97,109,101,73,100,93,59,10,32,32,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,125,32,101,108,115,101,32,105,102,32,40,95,95,71,76,79,66,65,76,95,95,46,109,111,100,117,108,101,67,97,108,108,76,105,115,116,91,99,97,108,108,79,98,106,46,99,97,108,108,73,100,93,41,32,123,10,32,32,32,32,32,32,32,32,32,32,99,111,110,115,116,32,99,97,108,108,98,97,99,107,79,98,106,32,61,32,95,95,71,76,79,66,65,76,95,95,46,109,111,100,117,108,101,67,97,108,108,76,105,115,116,91,99,97,108,108,79,98,106,46,99,97,108,108,73,100,93,59,10,32,32,32,32,32,32,32,32,32,32,105,102,32,40,99,97,108,108,79,98,106,46,114,101,115,117,108,116,32,33,61,61,32,48,32,38,38,32,116,121,112,101,111,102,32,99,97,108,108,98,97,99,107,79,98,106,46,114,101,106,101,99,116,32,61,61,61,32,39,102,117,110,99,116,105,111,110,39,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,99,97,108,108,98,97,99,107,79,98,106,46,114,101,106,101,99,116,40,99,97,108,108,79,98,106,46,112,97,114,97,109,115,41,59,10,32,32,32,32,32,32,32,32,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,116,121,112,101,111,102,32,99,97,108,108,98,97,99,107,79,98,106,46,99,98,32,61,61,61,32,39,102,117,110,99,116,105,111,110,39,32,38,38,32,99,97,108,108,98,97,99,107,79,98,106,46,99,98,40,99,97,108,108,79,98,106,46,112,97,114,97,109,115,41,59,10,32,32,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,32,32,105,102,32,40,99,97,108,108,98,97,99,107,79,98,106,46,116,121,112,101,32,61,61,61,32,48,32,124,124,32,99,97,108,108,98,97,99,107,79,98,106,46,116,121,112,101,32,61,61,61,32,49,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,100,101,108,101,116,101,32,95,95,71,76,79,66,65,76,95,95,46,109,111,100,117,108,101,67,97,108,108,76,105,115,116,91,99,97,108,108,79,98,106,46,99,97,108,108,73,100,93,59,10,32,32,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,32,32,32,32,32,32,114,101,115,112,32,61,32,39,110,97,116,105,118,101,50,106,115,32,101,114,114,111,114,58,32,110,97,116,105,118,101,32,99,97,108,108,98,97,99,107,32,105,100,32,105,115,32,110,111,116,32,114,101,103,105,115,116,101,114,101,100,32,105,110,32,106,115,39,59,10,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,98,114,101,97,107,59,10,32,32,32,32,32,32,125,10,32,32,32,32,99,97,115,101,32,39,99,97,108,108,74,115,77,111,100,117,108,101,39,58,10,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,105,102,32,40,33,99,97,108,108,79,98,106,32,124,124,32,33,99,97,108,108,79,98,106,46,109,111,100,117,108,101,78,97,109,101,32,124,124,32,33,99,97,108,108,79,98,106,46,109,101,116,104,111,100,78,97,109,101,41,32,123,10,32,32,32,32,32,32,32,32,32,32,114,101,115,112,32,61,32,39,110,97,116,105,118,101,50,106,115,32,101,114,114,111,114,58,32,99,97,108,108,74,115,77,111,100,117,108,101,32,112,97,114,97,109,32,105,115,32,105,110,118,97,108,105,100,39,59,10,32,32,32,32,32,32,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,32,32,32,32,32,32,99,111,110,115,116,32,116,97,114,103,101,116,77,111,100,117,108,101,32,61,32,95,95,71,76,79,66,65,76,95,95,46,106,115,77,111,100,117,108,101,76,105,115,116,91,99,97,108,108,79,98,106,46,109,111,100,117,108,101,78,97,109,101,93,59,10,32,32,32,32,32,32,32,32,32,32,105,102,32,40,33,116,97,114,103,101,116,77,111,100,117,108,101,32,124,124,32,116,121,112,101,111,102,32,116,97,114,103,101,116,77,111,100,117,108,101,91,99,97,108,108,79,98,106,46,109,101,116,104,111,100,78,97,109,101,93,32,33,61,61,32,39,102,117,110,99,116,105,111,110,39,41,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,114,101,115,112,32,61,32,39,110,97,116,105,118,101,50,106,115,32,101,114,114,111,114,58,32,99,97,108,108,74,115,77,111,100,117,108,101,32,105,115,32,116,97,114,103,101,116,105,110,103,32,97,110,32,117,110,100,101,102,105,110,101,100,32,109,111,100,117,108,101,32,111,114,32,109,101,116,104,111,100,39,59,10,32,32,32,32,32,32,32,32,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,32,32,32,32,32,32,32,32,116,97,114,103,101,116,77,111,100,117,108,101,91,99,97,108,108,79,98,106,46,109,101,116,104,111,100,78,97,109,101,93,40,99,97,108,108,79,98,106,46,112,97,114,97,109,115,41,59,10,32,32,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,125,10,32,32,32,32,32,32,32,32,98,114,101,97,107,59,10,32,32,32,32,32,32,125,10,32,32,32,32,100,101,102,97,117,108,116,58,10,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,114,101,115,112,32,61,32,39,110,97,116,105,118,101,50,106,115,32,101,114,114,111,114,58,32,110,97,116,105,118,101,50,106,115,32,97,99,116,105,111,110,32,105,115,32,110,111,116,32,100,101,102,105,110,101,100,39,59,10,32,32,32,32,32,32,32,32,98,114,101,97,107,59,10,32,32,32,32,32,32,125,10,32,32,125,10,32,32,114,101,116,117,114,110,32,114,101,115,112,59,10,125,59,125,41,59,0 };  // NOLINT
   const uint8_t k_Event[] = { 40,102,117,110,99,116,105,111,110,40,101,120,112,111,114,116,115,44,32,114,101,113,117,105,114,101,44,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,41,32,123,103,108,111,98,97,108,46,72,105,112,112,121,68,101,97,108,108,111,99,32,61,32,40,41,32,61,62,32,123,10,32,32,105,102,32,40,103,108,111,98,97,108,46,72,105,112,112,121,41,32,123,10,32,32,32,32,103,108,111,98,97,108,46,72,105,112,112,121,46,101,109,105,116,40,39,100,101,97,108,108,111,99,39,41,59,10,32,32,125,10,125,59,10,103,108,111,98,97,108,46,95,95,108,111,97,100,73,110,115,116,97,110,99,101,95,95,32,61,32,111,98,106,32,61,62,32,123,10,32,32,99,111,110,115,116,32,123,10,32,32,32,32,110,97,109,101,44,10,32,32,32,32,105,100,44,10,32,32,32,32,112,97,114,97,109,115,32,61,32,123,125,10,32,32,125,32,61,32,111,98,106,32,124,124,32,123,125,59,10,32,32,105,102,32,40,95,95,71,76,79,66,65,76,95,95,46,97,112,112,82,101,103,105,115,116,101,114,91,110,97,109,101,93,41,32,123,10,32,32,32,32,79,98,106,101,99,116,46,97,115,115,105,103,110,40,112,97,114,97,109,115,44,32,123,10,32,32,32,32,32,32,95,95,105,110,115,116,97,110,99,101,78,97,109,101,95,95,58,32,110,97,109,101,44,10,32,32,32,32,32,32,95,95,105,110,115,116,97,110,99,101,73,100,95,95,58,32,105,100,10,32,32,32,32,125,41,59,10,32,32,32,32,79,98,106,101,99,116,46,97,115,115,105,103,110,40,95,95,71,76,79,66,65,76,95,95,46,97,112,112,82,101,103,105,115,116,101,114,91,110,97,109,101,93,44,32,123,10,32,32,32,32,32,32,105,100,44,10,32,32,32,32,32,32,115,117,112,101,114,80,114,111,112,115,58,32,112,97,114,97,109,115,10,32,32,32,32,125,41,59,10,32,32,32,32,99,111,110,115,116,32,69,118,101,110,116,77,111,100,117,108,101,32,61,32,95,95,71,76,79,66,65,76,95,95,46,106,115,77,111,100,117,108,101,76,105,115,116,46,69,118,101,110,116,68,105,115,112,97,116,99,104,101,114,59,10,32,32,32,32,105,102,32,40,69,118,101,110,116,77,111,100,117,108,101,32,38,38,32,116,121,112,101,111,102,32,69,118,101,110,116,77,111,100,117,108,101,46,114,101,99,101,105,118,101,78,97,116,105,118,101,69,118,101,110,116,32,61,61,61,32,39,102,117,110,99,116,105,111,110,39,41,32,123,10,32,32,32,32,32,32,69,118,101,110,116,77,111,100,117,108,101,46,114,101,99,101,105,118,101,78,97,116,105,118,101,69,118,101,110,116,40,91,39,64,104,112,58,108,111,97,100,73,110,115,116,97,110,99,101,39,44,32,112,97,114,97,109,115,93,41,59,10,32,32,32,32,125,10,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,97,112,112,82,101,103,105,115,116,101,114,91,110,97,109,101,93,46,114,117,110,40,112,97,114,97,109,115,41,59,10,32,32,125,32,101,108,115,101,32,123,10,32,32,32,32,116,104,114,111,119,32,110,101,119,32,69,114,114,111,114,40,96,108,111,97,100,32,105,110,115,116,97,110,99,101,32,101,114,114,111,114,58,32,91,36,123,110,97,109,101,125,93,32,105,115,32,110,111,116,32,114,101,103,105,115,116,101,114,101,100,32,105,110,32,106,115,96,41,59,10,32,32,125,10,125,59,10,103,108,111,98,97,108,46,95,95,117,110,108,111,97,100,73,110,115,116,97,110,99,101,95,95,32,61,32,111,98,106,32,61,62,32,123,10,32,32,99,111,110,115,116,32,123,10,32,32,32,32,105,100,10,32,32,125,32,61,32,111,98,106,32,124,124,32,123,125,59,10,32,32,103,108,111,98,97,108,46,72,105,112,112,121,46,101,109,105,116,40,39,100,101,115,116,114,111,121,73,110,115,116,97,110,99,101,39,44,32,105,100,41,59,10,32,32,72,105,112,112,121,46,98,114,105,100,103,101,46,99,97,108,108,78,97,116,105,118,101,40,39,82,111,111,116,86,105,101,119,77,97,110,97,103,101,114,39,44,32,39,114,101,109,111,118,101,82,111,111,116,86,105,101,119,39,44,32,105,100,41,59,10,125,59,125,41,59,0 };  // NOLINT
   const uint8_t k_AnimationFrameModule[] = { 40,102,117,110,99,116,105,111,110,40,101,120,112,111,114,116,115,44,32,114,101,113,117,105,114,101,44,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,41,32,123,99,111,110,115,116,32,65,110,105,109,97,116,105,111,110,70,114,97,109,101,77,111,100,117,108,101,32,61,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,40,39,65,110,105,109,97,116,105,111,110,70,114,97,109,101,77,111,100,117,108,101,39,41,59,10,103,108,111,98,97,108,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,32,61,32,99,98,32,61,62,32,123,10,32,32,105,102,32,40,99,98,41,32,123,10,32,32,32,32,105,102,32,40,95,95,71,76,79,66,65,76,95,95,46,99,97,110,82,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,41,32,123,10,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,99,97,110,82,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,32,61,32,102,97,108,115,101,59,10,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,73,100,32,43,61,32,49,59,10,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,81,117,101,117,101,91,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,73,100,93,32,61,32,91,93,59,10,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,81,117,101,117,101,91,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,73,100,93,46,112,117,115,104,40,99,98,41,59,10,32,32,32,32,32,32,65,110,105,109,97,116,105,111,110,70,114,97,109,101,77,111,100,117,108,101,46,82,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,40,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,73,100,41,59,10,32,32,32,32,125,32,101,108,115,101,32,105,102,32,40,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,81,117,101,117,101,91,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,73,100,93,41,32,123,10,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,81,117,101,117,101,91,95,95,71,76,79,66,65,76,95,95,46,114,101,113,117,101,115,116,65,110,105,109,97,116,105,111,110,70,114,97,109,101,73,100,93,46,112,117,115,104,40,99,98,41,59,10,32,32,32,32,125,10,32,32,32,32,114,101,116,117,114,110,32,39,39,59,10,32,32,125,10,32,32,116,104,114,111,119,32,110,101,119,32,84,121,112,101,69,114,114,111,114,40,39,73,110,118,97,108,105,100,32,97,114,103,117,109,101,110,116,115,39,41,59,10,125,59,10,103,108,111,98,97,108,46,99,97,110,99,101,108,65,110,105,109,97,116,105,111,110,70,114,97,109,101,32,61,32,40,41,32,61,62,32,123,10,32,32,65,110,105,109,97,116,105,111,110,70,114,97,109,101,77,111,100,117,108,101,46,67,97,110,99,101,108,65,110,105,109,97,116,105,111,110,70,114,97,109,101,40,41,59,10,125,59,125,41,59,0 };  // NOLINT
   const uint8_t k_Turbo[] = { 40,102,117,110,99,116,105,111,110,40,101,120,112,111,114,116,115,44,32,114,101,113,117,105,114,101,44,32,105,110,116,101,114,110,97,108,66,105,110,100,105,110,103,41,32,123,102,117,110,99,116,105,111,110,32,116,117,114,98,111,80,114,111,109,105,115,101,40,102,117,110,99,41,32,123,10,32,32,114,101,116,117,114,110,32,102,117,110,99,116,105,111,110,32,40,46,46,46,97,114,103,115,41,32,123,10,32,32,32,32,114,101,116,117,114,110,32,110,101,119,32,80,114,111,109,105,115,101,40,40,114,101,115,111,108,118,101,44,32,114,101,106,101,99,116,41,32,61,62,32,123,10,32,32,32,32,32,32,99,111,110,115,116,32,99,97,108,108,98,97,99,107,73,100,32,61,32,95,95,71,76,79,66,65,76,95,95,46,109,111,100,117,108,101,67,97,108,108,73,100,59,10,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,109,111,100,117,108,101,67,97,108,108,73,100,32,43,61,32,49,59,10,32,32,32,32,32,32,95,95,71,76,79,66,65,76,95,95,46,109,111,100,117,108,101,67,97,108,108,76,105,115,116,91,99,97,108,108,98,97,99,107,73,100,93,32,61,32,123,10,32,32,32,32,32,32,32,32,99,98,58,32,114,101,115,117,108,116,32,61,62,32,114,101,115,111,108,118,101,40,114,101,115,117,108,116,41,44,10,32,32,32,32,32,32,32,32,114,101,106,101,99,116,44,10,32,32,32,32,32,32,32,32,116,121,112,101,58,32,48,10,32,32,32,32,32,32,125,59,10,32,32,32,32,32,32,102,117,110,99,46,97,112,112,108,121,40,116,104,105,115,44,32,91,46,46,46,97,114,103,115,44,32,96,36,123,99,97,108,108,98,97,99,107,73,100,125,96,93,41,59,10,32,32,32,32,125,41,59,10,32,32,125,59,10,125,10,72,105,112,112,121,46,116,117,114,98,111,80,114,111,109,105,115,101,32,61,32,116,117,114,98,111,80,114,111,109,105,115,101,59,125,41,59,0 };  // NOLINT
@@ -106,8 +106,6 @@ V8VM::V8VM(const std::shared_ptr<V8VMInitParam>& param) : VM(param) {
     isolate_->AddNearHeapLimitCallback(param->near_heap_limit_callback,
                                        param->near_heap_limit_callback_data);
   }
-
-  enable_v8_serialization_ = param->enable_v8_serialization;
   FOOTSTONE_DLOG(INFO) << "V8VM end";
 }
 
@@ -315,6 +313,59 @@ std::shared_ptr<CtxValue> V8VM::ParseJson(const std::shared_ptr<Ctx>& ctx, const
   return std::make_shared<V8CtxValue>(isolate, maybe_obj.ToLocalChecked());
 }
 
+std::string V8VM::CreateCodeCache(const char* data, size_t length, const string_view& file_name) {
+#if defined(V8_X5_LITE) && defined(THREAD_LOCAL_PLATFORM)
+  // platform 按线程初始化，不在 js 线程之外编译
+  return {};
+#else
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    // 早于引擎创建时不抢先初始化 platform，缓存留给首次 RunScript 生成
+    if (platform == nullptr) {
+      return {};
+    }
+  }
+  std::unique_ptr<v8::ArrayBuffer::Allocator> allocator(v8::ArrayBuffer::Allocator::NewDefaultAllocator());
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = allocator.get();
+  auto isolate = v8::Isolate::New(create_params);
+  std::string code_cache;
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    auto context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    // 与 V8Ctx::RunScript 得到的源码字符串内容一致，V8 接受缓存时会校验源码长度
+    auto source = v8::String::NewFromUtf8(isolate, data, v8::NewStringType::kNormal,
+                                          footstone::checked_numeric_cast<size_t, int>(length));
+    if (!source.IsEmpty()) {
+      auto v8_file_name = CreateV8String(isolate, context, file_name);
+#if (V8_MAJOR_VERSION == 8 && V8_MINOR_VERSION == 9 && \
+     V8_BUILD_NUMBER >= 45) || \
+    (V8_MAJOR_VERSION == 8 && V8_MINOR_VERSION > 9) || (V8_MAJOR_VERSION > 8)
+      v8::ScriptOrigin origin(isolate, v8_file_name);
+#else
+      v8::ScriptOrigin origin(v8_file_name);
+#endif
+      v8::ScriptCompiler::Source script_source(source.ToLocalChecked(), origin);
+      auto script = v8::ScriptCompiler::CompileUnboundScript(isolate, &script_source);
+      if (script.IsEmpty()) {
+        FOOTSTONE_LOG(WARNING) << "CreateCodeCache compile failed, file_name = " << file_name;
+      } else {
+        std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data(
+            v8::ScriptCompiler::CreateCodeCache(script.ToLocalChecked()));
+        if (cached_data) {
+          code_cache.assign(reinterpret_cast<const char*>(cached_data->data),
+                            footstone::checked_numeric_cast<int, size_t>(cached_data->length));
+        }
+      }
+    }
+  }
+  isolate->Dispose();
+  return code_cache;
+#endif
+}
+
 V8VM::DeserializerResult V8VM::Deserializer(const std::shared_ptr<Ctx>& ctx, const std::string& buffer) {
   v8::HandleScope handle_scope(isolate_);
   auto v8_ctx = std::static_pointer_cast<V8Ctx>(ctx);
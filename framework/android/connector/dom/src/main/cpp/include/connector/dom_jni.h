@@ -53,6 +53,11 @@ void SetDomManager(JNIEnv* j_env,
                   jint j_root_id,
                   jint j_dom_id);
 
+void SetParallelLayoutEnabled(JNIEnv* j_env,
+                              __unused jobject j_obj,
+                              jint j_root_id,
+                              jboolean j_enabled);
+
 void SetRenderManager(JNIEnv* j_env,
                       __unused jobject j_obj,
                       jint j_dom_manager_id,
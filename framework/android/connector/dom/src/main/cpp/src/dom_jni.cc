@@ -22,13 +22,18 @@
 
 #include "connector/dom_jni.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "dom/dom_manager.h"
 #include "dom/root_node.h"
+#include "dom/scene.h"
 #include "footstone/check.h"
 #include "footstone/logging.h"
 #include "footstone/persistent_object_map.h"
 #include "footstone/task_runner.h"
 #include "footstone/worker_impl.h"
+#include "footstone/worker_manager.h"
 #include "jni/jni_register.h"
 #include "jni/data_holder.h"
 #include "jni/jni_env.h"
@@ -74,11 +79,17 @@ REGISTER_JNI("com/openhippy/connector/DomManager", // NOLINT(cert-err58-cpp)
              "(II)V",
              SetDomManager)
 
+REGISTER_JNI("com/openhippy/connector/DomManager", // NOLINT(cert-err58-cpp)
+             "setParallelLayoutEnabled",
+             "(IZ)V",
+             SetParallelLayoutEnabled)
+
 using WorkerImpl = footstone::WorkerImpl;
 using TaskRunner = footstone::TaskRunner;
 
 constexpr char kDomWorkerName[] = "dom_worker";
 constexpr char kDomRunnerName[] = "dom_task_runner";
+constexpr uint32_t kMaxLayoutWorkerCount = 4;
 
 void CreateRoot(JNIEnv* j_env,
                 __unused jobject j_obj,
@@ -132,6 +143,45 @@ void SetDomManager(JNIEnv* j_env,
   root_node->SetDomManager(dom_manager_object);
 }
 
+static uint32_t GetLayoutWorkerCount() {
+  return std::clamp<uint32_t>(std::thread::hardware_concurrency() / 2, 1, kMaxLayoutWorkerCount);
+}
+
+// 所有 RootNode 共用的布局线程池，首次开启并行布局时创建
+static const std::shared_ptr<footstone::WorkerManager>& GetLayoutWorkerManager() {
+  static auto layout_worker_manager = std::make_shared<footstone::WorkerManager>(GetLayoutWorkerCount());
+  return layout_worker_manager;
+}
+
+void SetParallelLayoutEnabled(JNIEnv* j_env,
+                              __unused jobject j_obj,
+                              jint j_root_id,
+                              jboolean j_enabled) {
+  auto root_id = footstone::check::checked_numeric_cast<jint, uint32_t>(j_root_id);
+  std::shared_ptr<RootNode> root_node;
+  auto& persistent_map = RootNode::PersistentMap();
+  auto flag = persistent_map.Find(root_id, root_node);
+  FOOTSTONE_CHECK(flag);
+  auto dom_manager = root_node->GetDomManager().lock();
+  FOOTSTONE_CHECK(dom_manager);
+
+  std::shared_ptr<footstone::WorkerManager> worker_manager;
+  uint32_t concurrency = 0;
+  if (j_enabled) {
+    worker_manager = GetLayoutWorkerManager();
+    concurrency = GetLayoutWorkerCount();
+  }
+  // layout_runners_ 只在 dom 线程访问
+  std::weak_ptr<RootNode> weak_root_node = root_node;
+  std::vector<std::function<void()>> ops = {[weak_root_node, worker_manager, concurrency] {
+    auto root_node = weak_root_node.lock();
+    if (root_node) {
+      root_node->SetParallelLayoutWorkerManager(worker_manager, concurrency);
+    }
+  }};
+  dom_manager->PostTask(Scene(std::move(ops)));
+}
+
 static void SetThreadPriority(jobject j_object) {
   auto j_env = JNIEnvironment::GetInstance()->AttachCurrentThread();
   auto j_class = j_env->GetObjectClass(j_object);
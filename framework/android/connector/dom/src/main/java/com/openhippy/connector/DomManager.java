@@ -57,6 +57,14 @@ public class DomManager implements Connector {
         setDomManager(root.getId(), mInstanceId);
     }
 
+    /**
+     * Lay out fixed size subtrees of the root concurrently, must be called after {@link #attachToRoot}.
+     * The measure functions of the nodes in these subtrees are called on worker threads.
+     */
+    public void setParallelLayout(int rootId, boolean enabled) {
+        setParallelLayoutEnabled(rootId, enabled);
+    }
+
     public void setThreadPrority() {
         int tid = Process.myTid();
         Process.setThreadPriority(tid, Thread.MAX_PRIORITY);
@@ -91,4 +99,6 @@ public class DomManager implements Connector {
 
     private native void setDomManager(int rootId, int domManagerId);
 
+    private native void setParallelLayoutEnabled(int rootId, boolean enabled);
+
 }
@@ -74,6 +74,17 @@ jboolean RunScriptFromUri(JNIEnv* j_env,
                           jint j_vfs_id,
                           jobject j_cb);
 
+void PrewarmCodeCache(JNIEnv* j_env,
+                      __unused jobject j_obj,
+                      jstring j_uri,
+                      jstring j_code_cache_dir,
+                      jint j_vfs_id);
+
+void EnableCallJsBatch(JNIEnv* j_env,
+                       __unused jobject j_obj,
+                       jint j_scope_id,
+                       jobjectArray j_idempotent_actions);
+
 void SetRootNode(JNIEnv* j_env,
                  __unused jobject j_obj,
                  jint j_runtime_id,
@@ -24,6 +24,8 @@
 
 #include <android/asset_manager_jni.h>
 #include <condition_variable>
+#include <string>
+#include <unordered_set>
 
 #include "connector/bridge.h"
 #include "connector/convert_utils.h"
@@ -95,6 +97,16 @@ REGISTER_JNI("com/openhippy/connector/JsDriver", // NOLINT(cert-err58-cpp)
              "String;ILcom/openhippy/connector/NativeCallback;)Z",
              RunScriptFromUri)
 
+REGISTER_JNI("com/openhippy/connector/JsDriver", // NOLINT(cert-err58-cpp)
+             "prewarmCodeCache",
+             "(Ljava/lang/String;Ljava/lang/String;I)V",
+             PrewarmCodeCache)
+
+REGISTER_JNI("com/openhippy/connector/JsDriver", // NOLINT(cert-err58-cpp)
+             "enableCallJsBatch",
+             "(I[Ljava/lang/String;)V",
+             EnableCallJsBatch)
+
 REGISTER_JNI("com/openhippy/connector/JsDriver", // NOLINT(cert-err58-cpp)
              "attachToRoot",
              "(II)V",
@@ -299,6 +311,7 @@ jint CreateJsDriver(JNIEnv* j_env,
   }
 #else
   auto param = std::make_shared<VMInitParam>();
+  param->enable_v8_serialization =  static_cast<bool>(j_enable_v8_serialization);
 #endif
 #ifdef ENABLE_INSPECTOR
   if (param->is_debug) {
@@ -424,6 +437,52 @@ void UnloadInstance(JNIEnv* j_env,
   JsDriverUtils::UnloadInstance(scope, std::move(buffer_data));
 }
 
+void PrewarmCodeCache(JNIEnv* j_env,
+                      __unused jobject j_obj,
+                      jstring j_uri,
+                      jstring j_code_cache_dir,
+                      jint j_vfs_id) {
+  if (!j_uri || !j_code_cache_dir) {
+    FOOTSTONE_DLOG(WARNING) << "prewarmCodeCache, j_uri or j_code_cache_dir invalid";
+    return;
+  }
+  std::any vfs_instance;
+  auto vfs_id = footstone::checked_numeric_cast<jint, uint32_t>(j_vfs_id);
+  if (!hippy::global_data_holder.Find(vfs_id, vfs_instance)) {
+    FOOTSTONE_DLOG(WARNING) << "prewarmCodeCache, vfs_id invalid";
+    return;
+  }
+  auto loader = std::any_cast<std::shared_ptr<UriLoader>>(vfs_instance);
+  JsDriverUtils::PrewarmCodeCache(loader,
+                                  JniUtils::ToStrView(j_env, j_code_cache_dir),
+                                  JniUtils::ToStrView(j_env, j_uri));
+}
+
+void EnableCallJsBatch(JNIEnv* j_env,
+                       __unused jobject j_obj,
+                       jint j_scope_id,
+                       jobjectArray j_idempotent_actions) {
+  auto scope = GetScope(j_scope_id);
+  if (!scope) {
+    return;
+  }
+  std::unordered_set<std::string> idempotent_actions;
+  if (j_idempotent_actions) {
+    auto length = j_env->GetArrayLength(j_idempotent_actions);
+    for (jsize i = 0; i < length; ++i) {
+      auto j_action = reinterpret_cast<jstring>(j_env->GetObjectArrayElement(j_idempotent_actions, i));
+      if (!j_action) {
+        continue;
+      }
+      auto action = JniUtils::ToStrView(j_env, j_action);
+      idempotent_actions.insert(StringViewUtils::ToStdString(
+          StringViewUtils::ConvertEncoding(action, string_view::Encoding::Utf8).utf8_value()));
+      j_env->DeleteLocalRef(j_action);
+    }
+  }
+  JsDriverUtils::EnableCallJsBatch(scope, std::move(idempotent_actions));
+}
+
 jboolean RunScriptFromUri(JNIEnv* j_env,
                           __unused jobject j_obj,
                           jint j_scope_id,
@@ -119,6 +119,21 @@ public class JsDriver implements Connector {
                 callback);
     }
 
+    /**
+     * Read the code cache of the bundle into memory on the vfs worker thread, should be called
+     * before {@link #runScriptFromUri} of the same bundle.
+     */
+    public native void prewarmCodeCache(String uri, String codeCacheDir, int vfsId);
+
+    /**
+     * Deliver native to js calls once per js tick through hippyBridge('batchedCalls', ...),
+     * should be called after initialized and before the first {@link #callFunction}.
+     * Repeated calls of the idempotent actions with the same params are delivered once per tick.
+     */
+    public void enableCallJsBatch(String... idempotentActions) {
+        enableCallJsBatch(mInstanceId, idempotentActions);
+    }
+
     public void loadInstance(byte[] buffer, int offset, int length, NativeCallback callback) {
         loadInstance(mInstanceId, buffer, offset, length, callback);
     }
@@ -157,6 +172,8 @@ public class JsDriver implements Connector {
 
     private native void unloadInstance(int instanceId, byte[] buffer, int offset, int length);
 
+    private native void enableCallJsBatch(int instanceId, String[] idempotentActions);
+
     private native boolean runScriptFromUri(int instanceId, String uri, AssetManager assetManager,
             boolean canUseCodeCache, String codeCacheDir, int vfsId, NativeCallback callback);
 
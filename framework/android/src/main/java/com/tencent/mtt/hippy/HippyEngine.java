@@ -250,6 +250,8 @@ public abstract class HippyEngine {
     public List<Processor> processors;
     //Optional  is use V8 serialization or json
     public boolean enableV8Serialization = true;
+    // 可选参数 是否合并同一 tick 内 native 到 js 的调用，以一次 hippyBridge 调用下发，默认为false
+    public boolean enableCallJsBatch = false;
     // 可选参数 是否打印引擎的完整的log。默认为false
     public boolean enableLog = false;
     // 可选参数 code cache的名字，如果设置为空，则不启用code cache，默认为 ""
@@ -285,6 +287,8 @@ public abstract class HippyEngine {
     public HippyLogAdapter logAdapter;
     public V8InitParams v8InitParams;
     public boolean enableTurbo;
+    // 可选参数 是否在工作线程中并行布局固定尺寸的子树，文本测量会在工作线程调用，默认为false
+    public boolean enableParallelLayout = false;
 
     protected void check() {
       if (context == null) {
@@ -111,6 +111,8 @@ public abstract class HippyEngineManagerImpl extends HippyEngineManager implemen
     private final String mRemoteServerUrl;
     private ViewGroup mRootView;
     final boolean enableV8Serialization;
+    private final boolean mEnableCallJsBatch;
+    private final boolean mEnableParallelLayout;
     private long mInitStartTime = 0;
     private final TimeMonitor mMonitor;
     private final HippyThirdPartyAdapter mThirdPartyAdapter;
@@ -137,6 +139,8 @@ public abstract class HippyEngineManagerImpl extends HippyEngineManager implemen
         mDebugMode = params.debugMode;
         mServerBundleName = params.debugMode ? params.debugBundleName : "";
         enableV8Serialization = params.enableV8Serialization;
+        mEnableCallJsBatch = params.enableCallJsBatch;
+        mEnableParallelLayout = params.enableParallelLayout;
         mServerHost = params.debugServerHost;
         mRemoteServerUrl = params.remoteServerUrl;
         mGroupId = params.groupId;
@@ -772,7 +776,7 @@ public abstract class HippyEngineManagerImpl extends HippyEngineManager implemen
                     enableV8Serialization);
             mJsDriver = new JsDriver();
             mBridgeManager = new HippyBridgeManagerImpl(this, mCoreBundleLoader,
-                    getBridgeType(), enableV8Serialization, mDebugMode,
+                    getBridgeType(), enableV8Serialization, mEnableCallJsBatch, mDebugMode,
                     mServerHost, mGroupId, mThirdPartyAdapter, v8InitParams, mJsDriver);
             mDomManager = (domManager != null) ? domManager : new DomManager();
             mRenderer = createRenderer(RenderConnector.NATIVE_RENDERER);
@@ -812,6 +816,9 @@ public abstract class HippyEngineManagerImpl extends HippyEngineManager implemen
             if (mRootView != null && (mDebugMode || BuildConfig.DEBUG)) {
                 mDomManager.createRoot(mRootView, PixelUtil.getDensity());
                 mDomManager.attachToRoot(mRootView);
+                if (mEnableParallelLayout) {
+                    mDomManager.setParallelLayout(mRootView.getId(), true);
+                }
                 mJsDriver.attachToRoot(mRootView);
                 if (mDevtoolsManager != null) {
                     mDevtoolsManager.attachToRoot(mRootView);
@@ -1021,6 +1028,9 @@ public abstract class HippyEngineManagerImpl extends HippyEngineManager implemen
             if (rootView != null) {
                 mDomManager.createRoot(rootView, PixelUtil.getDensity());
                 mDomManager.attachToRoot(rootView);
+                if (mEnableParallelLayout) {
+                    mDomManager.setParallelLayout(rootView.getId(), true);
+                }
                 mJsDriver.attachToRoot(rootView);
                 if (mDevtoolsManager != null) {
                     mDevtoolsManager.attachToRoot(rootView);
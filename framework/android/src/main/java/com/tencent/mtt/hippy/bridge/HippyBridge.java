@@ -32,6 +32,10 @@ public interface HippyBridge {
     boolean runScriptFromUri(String uri, AssetManager assetManager, boolean canUseCodeCache,
             String codeCacheTag, NativeCallback callback);
 
+    void prewarmCodeCache(String uri, String codeCacheTag);
+
+    void enableCallJsBatch();
+
     void onDestroy();
 
     void destroy(NativeCallback callback, boolean isReload);
@@ -137,21 +137,50 @@ public class HippyBridgeImpl implements HippyBridge, JSBridgeProxy, DevRemoteDeb
         if (assetManager == null) {
             assetManager = mContext.getGlobalConfigs().getContext().getAssets();
         }
-        String codeCacheDir = "";
-        if (!TextUtils.isEmpty(codeCacheTag) && !TextUtils.isEmpty(mCodeCacheRootDir)) {
-            codeCacheDir = mCodeCacheRootDir + codeCacheTag + File.separator;
-            File codeCacheFile = new File(codeCacheDir);
-            if (!codeCacheFile.exists() && !codeCacheFile.mkdirs()) {
-                canUseCodeCache = false;
-                codeCacheDir = "";
-            }
-        } else {
+        String codeCacheDir = getCodeCacheDir(codeCacheTag);
+        if (TextUtils.isEmpty(codeCacheDir)) {
             canUseCodeCache = false;
         }
         return mJsDriver.runScriptFromUri(uri, assetManager, canUseCodeCache, codeCacheDir,
                 mContext.getVfsId(), callback);
     }
 
+    @Override
+    public void prewarmCodeCache(String uri, String codeCacheTag) {
+        // Asset handler is registered by the first runScriptFromUri, only local files can be read here
+        if (TextUtils.isEmpty(uri) || !uri.startsWith(URI_SCHEME_FILE)) {
+            return;
+        }
+        String codeCacheDir = getCodeCacheDir(codeCacheTag);
+        if (!TextUtils.isEmpty(codeCacheDir)) {
+            mJsDriver.prewarmCodeCache(uri, codeCacheDir, mContext.getVfsId());
+        }
+    }
+
+    @Override
+    public void enableCallJsBatch() {
+        if (mInit) {
+            mJsDriver.enableCallJsBatch();
+        }
+    }
+
+    /**
+     * All bundles share one code cache directory. Entries are keyed by script content and the
+     * total size is capped by the native store, so the tag only decides whether cache is enabled.
+     * Per-tag directories created by older versions are removed by the native store on first use.
+     */
+    @NonNull
+    private String getCodeCacheDir(String codeCacheTag) {
+        if (TextUtils.isEmpty(codeCacheTag) || TextUtils.isEmpty(mCodeCacheRootDir)) {
+            return "";
+        }
+        File codeCacheFile = new File(mCodeCacheRootDir);
+        if (!codeCacheFile.exists() && !codeCacheFile.mkdirs()) {
+            return "";
+        }
+        return mCodeCacheRootDir;
+    }
+
     @Nullable
     private String getCallFunctionName(int functionId) {
         String action = null;
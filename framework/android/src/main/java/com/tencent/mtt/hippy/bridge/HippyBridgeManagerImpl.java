@@ -93,6 +93,7 @@ public class HippyBridgeManagerImpl implements HippyBridgeManager, HippyBridge.B
     BridgeState mBridgeState = BridgeState.UNINITIALIZED;
     Handler mHandler;
     final boolean mEnableV8Serialization;
+    private final boolean mEnableCallJsBatch;
     ArrayList<String> mLoadedBundleInfo = null;
     private final int mGroupId;
     private final HippyThirdPartyAdapter mThirdPartyAdapter;
@@ -105,7 +106,8 @@ public class HippyBridgeManagerImpl implements HippyBridgeManager, HippyBridge.B
     private NativeCallback mCallFunctionCallback;
 
     public HippyBridgeManagerImpl(HippyEngineContext context, HippyBundleLoader coreBundleLoader,
-            int bridgeType, boolean enableV8Serialization, boolean isDevModule,
+            int bridgeType, boolean enableV8Serialization, boolean enableCallJsBatch,
+            boolean isDevModule,
             String debugServerHost, int groupId, HippyThirdPartyAdapter thirdPartyAdapter,
             V8InitParams v8InitParams, @NonNull JsDriver jsDriver) {
         mContext = context;
@@ -113,6 +115,7 @@ public class HippyBridgeManagerImpl implements HippyBridgeManager, HippyBridge.B
         mGroupId = groupId;
         mThirdPartyAdapter = thirdPartyAdapter;
         mEnableV8Serialization = enableV8Serialization;
+        mEnableCallJsBatch = enableCallJsBatch;
         mHippyBridge = new HippyBridgeImpl(context, this, bridgeType == BRIDGE_TYPE_SINGLE_THREAD,
                 enableV8Serialization, isDevModule, debugServerHost, v8InitParams, jsDriver);
         if (enableV8Serialization) {
@@ -230,6 +233,11 @@ public class HippyBridgeManagerImpl implements HippyBridgeManager, HippyBridge.B
                 case MSG_CODE_INIT_BRIDGE: {
                     @SuppressWarnings("unchecked") final com.tencent.mtt.hippy.common.Callback<Boolean> callback = (com.tencent.mtt.hippy.common.Callback<Boolean>) msg.obj;
                     try {
+                        if (mCoreBundleLoader != null && mCoreBundleLoader.canUseCodeCache()) {
+                            // Read code cache of the vendor bundle while the js engine is initializing
+                            mHippyBridge.prewarmCodeCache(mCoreBundleLoader.getPath(),
+                                    mCoreBundleLoader.getCodeCacheTag());
+                        }
                         mHippyBridge.initJSBridge(getGlobalConfigs(), new NativeCallback(mHandler) {
                             @Override
                             public void Call(long result, Message message, String action,
@@ -241,6 +249,9 @@ public class HippyBridgeManagerImpl implements HippyBridgeManager, HippyBridge.B
                                     reportException(new Throwable(info));
                                     return;
                                 }
+                                if (mEnableCallJsBatch) {
+                                    mHippyBridge.enableCallJsBatch();
+                                }
                                 long runtimeId = mHippyBridge.getV8RuntimeId();
                                 if (mContext != null) {
                                     mContext.onRuntimeInitialized();
@@ -135,6 +135,7 @@ static napi_value CreateJsDriver(napi_env env, napi_callback_info info) {
   }
 #else
   auto param = std::make_shared<VMInitParam>();
+  param->enable_v8_serialization = enable_v8_serialization;
 #endif
 #ifdef ENABLE_INSPECTOR
   if (param->is_debug) {
@@ -108,7 +108,7 @@ void NativeRenderProvider_UpdateNodeSize(uint32_t render_manager_id, uint32_t ro
     return;
   }
 
-  std::unordered_map<std::string, std::shared_ptr<HippyValue>> update_style;
+  hippy::dom::DomValueMap update_style;
   std::shared_ptr<HippyValue> width_value = std::make_shared<HippyValue>(width);
   std::shared_ptr<HippyValue> height_value = std::make_shared<HippyValue>(height);
   update_style.insert({"width", width_value});
@@ -274,7 +274,7 @@ static napi_value UpdateNodeSize(napi_env env, napi_callback_info info) {
     return arkTs.GetUndefined();
   }
 
-  std::unordered_map<std::string, std::shared_ptr<HippyValue>> update_style;
+  hippy::dom::DomValueMap update_style;
   std::shared_ptr<HippyValue> width_value = std::make_shared<HippyValue>(width);
   std::shared_ptr<HippyValue> height_value = std::make_shared<HippyValue>(height);
   update_style.insert({"width", width_value});
@@ -101,6 +101,7 @@ int64_t BridgeImpl::InitJsEngine(const std::shared_ptr<JSBridgeRuntime> &platfor
   param->is_debug = static_cast<bool>(is_dev_module);
 #else
   auto param = std::make_shared<VMInitParam>();
+  param->enable_v8_serialization =  static_cast<bool>(!bridge_param_json);
 #endif
 
 #ifdef ENABLE_INSPECTOR
@@ -20,13 +20,100 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "footstone/serializer.h"
+#include "footstone/string_view.h"
 
 namespace footstone {
 inline namespace value {
 
+/**
+ * @brief 序列化数据中一个值的只读视图，由 Deserializer::ReadValueView 产生
+ * 视图只引用源数据，不拷贝也不解码：字符串以源数据中的区间表示，object/array 在首次访问成员时才解析成员位置，
+ * 需要完整的 HippyValue 时调用 Materialize。视图使用期间源数据需保持有效，首次访问成员不是线程安全的。
+ */
+class HippyValueView {
+ public:
+  using Encoding = footstone::stringview::string_view::Encoding;
+
+  HippyValueView() = default;
+
+  /**
+   * @brief 获取视图对应值的类型，kTheHole 视为 undefined
+   */
+  HippyValue::Type GetType() const;
+
+  bool ToInt32(int32_t& i32) const;
+
+  bool ToUint32(uint32_t& u32) const;
+
+  /**
+   * @brief 转化成 double 类型， int32_t\uint32_t\double 可以无损转化
+   */
+  bool ToDouble(double& d) const;
+
+  bool ToBoolean(bool& b) const;
+
+  /**
+   * @brief 获取字符串在源数据中的区间，不拷贝
+   * @param data 字符串起始地址
+   * @param length 字符串字节数
+   * @param encoding 字符串编码，one byte string 为 Latin1，two byte string 为 Utf16
+   * @return return true if success else return false
+   */
+  bool GetStringSpan(const uint8_t*& data, size_t& length, Encoding& encoding) const;
+
+  /**
+   * @brief 解码成 utf8 的 std::string
+   */
+  bool ToString(std::string& str) const;
+
+  /**
+   * @brief 与 utf8 字符串比较，ascii 字符串不产生拷贝
+   */
+  bool EqualsString(const std::string& str) const;
+
+  /**
+   * @brief 获取 array 的元素个数或 object 的属性个数，其他类型返回 0
+   */
+  size_t GetLength() const;
+
+  /**
+   * @brief 获取 array 的第 index 个元素
+   */
+  bool GetElement(size_t index, HippyValueView& element) const;
+
+  /**
+   * @brief 获取 object 中 key 对应的属性
+   */
+  bool GetProperty(const std::string& key, HippyValueView& value) const;
+
+  /**
+   * @brief 按序获取 object 的第 index 个属性，用于遍历
+   */
+  bool GetPropertyAt(size_t index, HippyValueView& key, HippyValueView& value) const;
+
+  /**
+   * @brief 完整解码成 HippyValue
+   */
+  bool Materialize(HippyValue& value) const;
+
+ private:
+  friend class Deserializer;
+  struct Members;
+
+  bool IndexMembers() const;
+
+  SerializationTag tag_ = SerializationTag::kUndefined;
+  // begin_ 指向值的 tag，end_ 为源数据末尾
+  const uint8_t* begin_ = nullptr;
+  const uint8_t* end_ = nullptr;
+  mutable std::shared_ptr<Members> members_;
+};
+
 class Deserializer {
   using HippyValueObjectType = footstone::HippyValue::HippyValueObjectType;
  public:
@@ -43,7 +130,15 @@ class Deserializer {
 
   bool ReadValue(HippyValue& value);
 
+  /**
+   * @brief 以视图方式读取剩余数据中的一个值，不做解码，读取后 Deserializer 不应再继续使用
+   */
+  bool ReadValueView(HippyValueView& view);
+
  private:
+  friend class HippyValueView;
+
+
   bool ReadObject(HippyValue& value);
 
   bool PeekTag(SerializationTag& tag);
@@ -91,6 +186,10 @@ class Deserializer {
 
   bool ReadObjectProperties(uint32_t& number_properties, SerializationTag end_tag);
 
+  bool SkipObject(HippyValueView* view = nullptr);
+
+  bool SkipObjectBody(SerializationTag tag);
+
  private:
   const uint8_t* position_;
   const uint8_t* const end_;
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -28,12 +29,25 @@
 namespace footstone {
 inline namespace value {
 
+/**
+ * @brief HippyValue 的引用计数负载，定义在 hippy_value.cc
+ */
+template <typename T>
+struct HippyValuePayload;
+
+/**
+ * @brief 紧凑的 dom value
+ * 数字与布尔值内联存储；短字符串借助 std::string 的 SSO 内联存储；长字符串、object、array 存放在引用计数负载中，
+ * 拷贝只增加引用计数，通过非 const 接口访问时若负载被共享则先复制一份（写时复制）。
+ * 通过非 const 接口交出过可修改引用的负载不再共享，之后的拷贝为深拷贝，与原先的拷贝语义一致；
+ * 只读访问应使用 const 接口，以保持拷贝为 O(1)。
+ */
 class HippyValue final {
  public:
   using HippyValueObjectType = typename std::unordered_map<std::string, HippyValue>;
   using HippyValueArrayType = typename std::vector<HippyValue>;
-  enum class Type { kUndefined, kNull, kNumber, kBoolean, kString, kObject, kArray };
-  enum class NumberType { kInt32, kUInt32, kDouble, kNaN };
+  enum class Type : uint8_t { kUndefined, kNull, kNumber, kBoolean, kString, kObject, kArray };
+  enum class NumberType : uint8_t { kInt32, kUInt32, kDouble, kNaN };
 
   union Number {
     int32_t i32_;
@@ -85,51 +99,50 @@ class HippyValue final {
    * @brief 移动构造 string 类型的  dom value
    * @param str string 的值
    */
-  explicit HippyValue(std::string&& str) : type_(Type::kString), str_(std::move(str)) {}
+  explicit HippyValue(std::string&& str);
 
   /**
    * @brief 构造 string 类型的  dom value
    * @param str string
    */
-  explicit HippyValue(const std::string& str) : type_(Type::kString), str_(str) {}
+  explicit HippyValue(const std::string& str);
 
   /**
    * @brief 构造 string 类型的 dom value
    * @param string_value const char* 的指针
    */
-  explicit HippyValue(const char* string_value) : type_(Type::kString), str_(std::string(string_value)) {}
+  explicit HippyValue(const char* string_value);
 
   /**
    * @brief 构造 string 类型的 dom value
    * @param string_value const char * 的指针
    * @param length 字符串长度
    */
-  explicit HippyValue(const char* string_value, size_t length)
-      : type_(Type::kString), str_(std::string(string_value, length)) {}
+  explicit HippyValue(const char* string_value, size_t length);
 
   /**
    * @brief 移动构造 object 类型的 dom value
    * @param object_value HippyValueObjectType 的对象
    */
-  explicit HippyValue(HippyValueObjectType&& object_value) : type_(Type::kObject), obj_(std::move(object_value)) {}
+  explicit HippyValue(HippyValueObjectType&& object_value);
 
   /**
    * @brief 构造 object 类型的 dom value
    * @param object_value HippyValueObjectType 的对象
    */
-  explicit HippyValue(const HippyValueObjectType& object_value) : type_(Type::kObject), obj_(object_value) {}
+  explicit HippyValue(const HippyValueObjectType& object_value);
 
   /**
    * @brief 移动构造 array 类型的 dom value
    * @param array_value HippyValueArrayType 的对象
    */
-  explicit HippyValue(HippyValueArrayType&& array_value) : type_(Type::kArray), arr_(array_value) {}
+  explicit HippyValue(HippyValueArrayType&& array_value);
 
   /**
    * @brief 移动构造 array 类型的 dom value
    * @param array_value HippyValueArrayType 的对象
    */
-  explicit HippyValue(HippyValueArrayType& array_value) : type_(Type::kArray), arr_(array_value) {}
+  explicit HippyValue(HippyValueArrayType& array_value);
   ~HippyValue();
 
   HippyValue& operator=(const HippyValue& rhs) noexcept;
@@ -285,7 +298,7 @@ class HippyValue final {
   const std::string& ToStringChecked() const;
 
   /**
-   * @brief 转化成 string 类型, crash if failed
+   * @brief 转化成 string 类型, crash if failed, 字符串被共享时先复制一份
    * @return return string value
    */
   std::string& ToStringChecked();
@@ -304,7 +317,7 @@ class HippyValue final {
   const HippyValueObjectType& ToObjectChecked() const;
 
   /**
-   * @brief 转化成 HippyValueObjectType 类型, crash if failed
+   * @brief 转化成 HippyValueObjectType 类型, crash if failed, object 被共享时先复制一份
    * @return return HippyValueObjectType value
    */
   HippyValueObjectType& ToObjectChecked();
@@ -323,13 +336,15 @@ class HippyValue final {
   const HippyValueArrayType& ToArrayChecked() const;
 
   /**
-   * @brief 转化成 HippyValueArrayType 类型, crash if failed
+   * @brief 转化成 HippyValueArrayType 类型, crash if failed, array 被共享时先复制一份
    * @return return HippyValueArrayType value
    */
   HippyValueArrayType& ToArrayChecked();
 
  private:
   inline void Deallocate();
+  inline void InitString(std::string&& str);
+  inline void CopyFrom(const HippyValue& source);
 
   friend std::hash<HippyValue>;
   friend std::ostream& operator<<(std::ostream& os, const HippyValue& hippy_value);
@@ -337,12 +352,15 @@ class HippyValue final {
 
   Type type_ = Type::kUndefined;
   NumberType number_type_ = NumberType::kNaN;
+  // kString 时为 true 表示字符串存放在 str_payload_ 中，否则内联存放在 str_ 中
+  bool shared_str_ = false;
   union {
     bool b_{};
-    HippyValueObjectType obj_;
-    HippyValueArrayType arr_;
-    std::string str_;
     Number num_;
+    std::string str_;
+    HippyValuePayload<std::string>* str_payload_;
+    HippyValuePayload<HippyValueObjectType>* obj_;
+    HippyValuePayload<HippyValueArrayType>* arr_;
   };
 };
 
@@ -0,0 +1,172 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace footstone {
+inline namespace runner {
+
+template <typename Signature>
+class MoveOnlyFunction;
+
+/*
+ * 只能移动的函数包装，与 std::function 相比：
+ * 1. 可以保存只能移动的可调用对象（如捕获了 unique_ptr、promise 的 lambda），不再需要 MakeCopyable 包一层 shared_ptr
+ * 2. 不超过 kInlineSize 且移动构造不抛异常的可调用对象直接存放在内部缓冲区，不产生堆内存分配
+ */
+template <typename R, typename... Args>
+class MoveOnlyFunction<R(Args...)> {
+ public:
+  static constexpr size_t kInlineSize = 6 * sizeof(void*);
+
+  MoveOnlyFunction() noexcept = default;
+  MoveOnlyFunction(std::nullptr_t) noexcept {}  // NOLINT
+
+  template <typename F,
+            typename Functor = std::decay_t<F>,
+            typename = std::enable_if_t<!std::is_same_v<Functor, MoveOnlyFunction> &&
+                std::is_invocable_r_v<R, Functor&, Args...>>>
+  MoveOnlyFunction(F&& f) {  // NOLINT
+    if constexpr (std::is_pointer_v<Functor> || std::is_member_pointer_v<Functor>) {
+      if (!f) {
+        return;
+      }
+    } else if constexpr (std::is_same_v<Functor, std::function<R(Args...)>>) {
+      if (!f) {
+        return;
+      }
+    }
+    if constexpr (IsInline<Functor>()) {
+      ::new (static_cast<void*>(storage_)) Functor(std::forward<F>(f));
+    } else {
+      ::new (static_cast<void*>(storage_)) Functor*(new Functor(std::forward<F>(f)));
+    }
+    ops_ = &kOps<Functor>;
+  }
+
+  MoveOnlyFunction(MoveOnlyFunction&& other) noexcept { MoveFrom(other); }
+
+  MoveOnlyFunction& operator=(MoveOnlyFunction&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  MoveOnlyFunction& operator=(std::nullptr_t) noexcept {
+    Reset();
+    return *this;
+  }
+
+  MoveOnlyFunction(const MoveOnlyFunction&) = delete;
+  MoveOnlyFunction& operator=(const MoveOnlyFunction&) = delete;
+
+  ~MoveOnlyFunction() { Reset(); }
+
+  explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+  R operator()(Args... args) {
+    return ops_->invoke(storage_, std::forward<Args>(args)...);
+  }
+
+ private:
+  struct Ops {
+    R (*invoke)(void* storage, Args&&... args);
+    // 把 from 中的可调用对象移动到 to，并析构 from 中的对象
+    void (*relocate)(void* from, void* to) noexcept;
+    void (*destroy)(void* storage) noexcept;
+  };
+
+  template <typename Functor>
+  static constexpr bool IsInline() {
+    return sizeof(Functor) <= kInlineSize && alignof(Functor) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<Functor>;
+  }
+
+  template <typename Functor>
+  static Functor* Get(void* storage) {
+    if constexpr (IsInline<Functor>()) {
+      return std::launder(reinterpret_cast<Functor*>(storage));
+    } else {
+      return *std::launder(reinterpret_cast<Functor**>(storage));
+    }
+  }
+
+  template <typename Functor>
+  static R Invoke(void* storage, Args&&... args) {
+    if constexpr (std::is_void_v<R>) {
+      std::invoke(*Get<Functor>(storage), std::forward<Args>(args)...);
+    } else {
+      return std::invoke(*Get<Functor>(storage), std::forward<Args>(args)...);
+    }
+  }
+
+  template <typename Functor>
+  static void Relocate(void* from, void* to) noexcept {
+    if constexpr (IsInline<Functor>()) {
+      auto functor = Get<Functor>(from);
+      ::new (to) Functor(std::move(*functor));
+      functor->~Functor();
+    } else {
+      ::new (to) Functor*(Get<Functor>(from));
+    }
+  }
+
+  template <typename Functor>
+  static void Destroy(void* storage) noexcept {
+    if constexpr (IsInline<Functor>()) {
+      Get<Functor>(storage)->~Functor();
+    } else {
+      delete Get<Functor>(storage);
+    }
+  }
+
+  template <typename Functor>
+  static constexpr Ops kOps = {&Invoke<Functor>, &Relocate<Functor>, &Destroy<Functor>};
+
+  void MoveFrom(MoveOnlyFunction& other) noexcept {
+    if (other.ops_) {
+      other.ops_->relocate(other.storage_, storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  void Reset() noexcept {
+    if (ops_) {
+      auto ops = ops_;
+      ops_ = nullptr;
+      ops->destroy(storage_);
+    }
+  }
+
+  alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+  const Ops* ops_ = nullptr;
+};
+
+}  // namespace runner
+}  // namespace footstone
@@ -0,0 +1,103 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace footstone {
+inline namespace runner {
+
+/*
+ * 无锁多生产者单消费者队列（侵入式，Dmitry Vyukov 算法）
+ * 1. 节点类型 T 需提供成员 std::atomic<T*> next_，并允许 MpscQueue 访问，入队不会产生额外的内存分配
+ * 2. Push 可以在任意线程并发调用，Pop/IsEmpty/Clear 同一时刻只能有一个调用方，由使用者保证
+ * 3. 出入队顺序为先进先出，单个生产者的入队顺序在出队时保持不变
+ * 4. 生产者 Push 进行到一半（已更新 head_ 但未链接到前一节点）时，消费者看不到该节点，
+ *    也看不到其他生产者在它之后入队的节点，即使后者的 Push 已经返回。此时 Pop 返回 nullptr，
+ *    但队列并不为空，直到该生产者完成 Push。Pop 返回 nullptr 不能作为队列为空的依据，
+ *    需要判断是否为空（如决定休眠或执行空闲任务）时使用 IsEmpty
+ */
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() : head_(&stub_), tail_(&stub_) {}
+  ~MpscQueue() { Clear(); }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  void Push(std::unique_ptr<T> node) {
+    PushNode(node.release());
+  }
+
+  std::unique_ptr<T> Pop() {
+    T* tail = tail_;
+    T* next = tail->next_.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (!next) {
+        return nullptr;
+      }
+      tail_ = next;
+      tail = next;
+      next = next->next_.load(std::memory_order_acquire);
+    }
+    if (next) {
+      tail_ = next;
+      return std::unique_ptr<T>(tail);
+    }
+    if (tail != head_.load(std::memory_order_acquire)) {
+      return nullptr;  // 生产者正在入队
+    }
+    // tail 为最后一个节点，放回 stub 后才能把 tail 取出
+    PushNode(&stub_);
+    next = tail->next_.load(std::memory_order_acquire);
+    if (next) {
+      tail_ = next;
+      return std::unique_ptr<T>(tail);
+    }
+    return nullptr;
+  }
+
+  // 入队未完成的节点也计算在内，返回 false 时 Pop 仍可能暂时返回 nullptr
+  bool IsEmpty() const {
+    return tail_ == &stub_ && head_.load(std::memory_order_acquire) == &stub_;
+  }
+
+  // 只应在没有生产者时调用（如析构），否则可能遗留入队未完成的节点
+  void Clear() {
+    while (Pop()) {}
+  }
+
+ private:
+  void PushNode(T* node) {
+    node->next_.store(nullptr, std::memory_order_relaxed);
+    T* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next_.store(node, std::memory_order_release);
+  }
+
+  std::atomic<T*> head_;  // 生产者端
+  T* tail_;  // 消费者端
+  T stub_;
+};
+
+}  // namespace runner
+}  // namespace footstone
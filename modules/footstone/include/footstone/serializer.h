@@ -20,12 +20,22 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "footstone/hippy_value.h"
+#include "footstone/string_view.h"
 
 namespace footstone {
 inline namespace value {
+
+// WriteHeader 写入的格式版本
+constexpr uint32_t kLatestVersion = 13;
+
 enum class Oddball : uint8_t {
   kTheHole,
   kUndefined,
@@ -78,9 +88,65 @@ class SerializerHelper {
   }
 };
 
+/**
+ * @brief Serializer 缓冲区池，按 2 的幂划分大小等级复用缓冲区，池中缓存的总字节数不超过 high water mark。
+ * 缓冲区均由 malloc 分配，Serializer::Release 交出的缓冲区仍可用 SerializerHelper::DestroyBuffer 释放。线程安全。
+ */
+class SerializerBufferPool {
+ public:
+  struct Stats {
+    uint64_t bytes_serialized = 0;
+    uint64_t reallocations = 0;
+    uint64_t pool_hits = 0;
+    uint64_t pool_misses = 0;
+    size_t pooled_bytes = 0;
+  };
+
+  static constexpr size_t kDefaultHighWaterMark = 4 * 1024 * 1024;
+
+  explicit SerializerBufferPool(size_t high_water_mark = kDefaultHighWaterMark);
+  ~SerializerBufferPool();
+  SerializerBufferPool(const SerializerBufferPool&) = delete;
+  SerializerBufferPool& operator=(const SerializerBufferPool&) = delete;
+
+  /**
+   * @brief 获取容量不小于 min_capacity 的缓冲区
+   * @return 缓冲区及其实际容量
+   */
+  std::pair<uint8_t*, size_t> Acquire(size_t min_capacity);
+
+  /**
+   * @brief 归还缓冲区，超出 high water mark 或大小等级时直接释放
+   */
+  void Recycle(uint8_t* buffer, size_t capacity);
+
+  void SetHighWaterMark(size_t high_water_mark);
+
+  Stats GetStats() const;
+
+ private:
+  friend class Serializer;
+
+  static constexpr size_t kMinSizeClassShift = 8;
+  static constexpr size_t kMaxSizeClassShift = 24;
+
+  mutable std::mutex mutex_;
+  std::array<std::vector<uint8_t*>, kMaxSizeClassShift - kMinSizeClassShift + 1> free_lists_;
+  size_t high_water_mark_;
+  size_t pooled_bytes_ = 0;
+  std::atomic<uint64_t> bytes_serialized_{0};
+  std::atomic<uint64_t> reallocations_{0};
+  uint64_t pool_hits_ = 0;
+  uint64_t pool_misses_ = 0;
+};
+
 class Serializer {
  public:
   Serializer();
+  /**
+   * @brief 使用缓冲区池的 Serializer，扩容时从池中获取缓冲区，析构时归还
+   */
+  explicit Serializer(std::shared_ptr<SerializerBufferPool> pool);
   ~Serializer();
   Serializer(const Serializer&) = delete;
   Serializer& operator=(const Serializer&) = delete;
@@ -89,11 +155,50 @@ class Serializer {
 
   void WriteValue(const HippyValue& hippy_value);
 
+  /**
+   * @brief 逐个写入值，用于不构造 HippyValue 直接序列化（如遍历 js 值），写出的数据与 WriteValue 一致
+   * object 在 WriteBeginJSObject 与 WriteEndJSObject 之间依次写入 key 与 value，
+   * array 在 WriteBeginDenseJSArray 与 WriteEndDenseJSArray 之间依次写入元素
+   */
+  void WriteUndefined() { WriteOddball(Oddball::kUndefined); }
+
+  void WriteNull() { WriteOddball(Oddball::kNull); }
+
+  void WriteBoolean(bool value) { WriteOddball(value ? Oddball::kTrue : Oddball::kFalse); }
+
+  /**
+   * @brief 写入 js number，可以无损表示为 int32 的写为 int32，与 v8 对 Smi 的处理一致
+   */
+  void WriteNumber(double value);
+
+  /**
+   * @brief 按字符串原有编码写入，Latin1 与 Utf16 不做转码
+   */
+  void WriteString(const footstone::stringview::string_view& value);
+
+  void WriteBeginJSObject();
+
+  void WriteEndJSObject(uint32_t number_properties);
+
+  void WriteBeginDenseJSArray(uint32_t length);
+
+  void WriteEndDenseJSArray(uint32_t length);
+
   /**
    * @brief 获取 HippyValue 对应序列化数据，注意 Release 后指针交给外部管理，需要自行释放
    */
   std::pair<uint8_t*, size_t> Release();
 
+  /**
+   * @brief 获取序列化数据但不交出所有权，数据在下一次 Reset 或写入前有效
+   */
+  std::pair<uint8_t*, size_t> GetBuffer() const { return std::make_pair(buffer_, buffer_size_); }
+
+  /**
+   * @brief 清空已序列化的数据，保留缓冲区供下一次序列化复用
+   */
+  void Reset();
+
  private:
 
   void WriteOddball(Oddball oddball);
@@ -106,6 +211,8 @@ class Serializer {
 
   void WriteString(const std::string& value);
 
+  void WriteUtf8String(const char* str, size_t length);
+
   void WriteDenseJSArray(const HippyValue::HippyValueArrayType& hippy_value_array);
 
   void WriteJSObject(const HippyValue::HippyValueObjectType& hippy_value_obj);
@@ -131,6 +238,9 @@ class Serializer {
 
   void ExpandBuffer(size_t required_capacity);
 
+  void RecordSerialized();
+
+  std::shared_ptr<SerializerBufferPool> pool_;
   uint8_t* buffer_ = nullptr;
   size_t buffer_size_ = 0;
   size_t buffer_capacity_ = 0;
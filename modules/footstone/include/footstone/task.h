@@ -22,19 +22,28 @@
 
 #include <atomic>
 #include <cstdint>
-#include <functional>
+
+#include "footstone/move_only_function.h"
 
 namespace footstone {
 inline namespace runner {
 
+template <typename T>
+class MpscQueue;
+
+/*
+ * Task 的可调用对象放在 MoveOnlyFunction 的内部缓冲区中，常见的 PostTask 只需为 Task 本身分配一次内存
+ */
 class Task {
  public:
+  using Unit = MoveOnlyFunction<void()>;
+
   Task();
-  explicit Task(std::function<void()> unit);
+  explicit Task(Unit unit);
   ~Task() = default;
 
   inline uint32_t GetId() { return id_; }
-  inline void SetExecUnit(std::function<void()> unit) { unit_ = unit; }
+  inline void SetExecUnit(Unit unit) { unit_ = std::move(unit); }
   inline void Run() {
     if (unit_) {
       unit_();
@@ -42,10 +51,14 @@ class Task {
   }
 
  private:
+  template <typename T>
+  friend class MpscQueue;
+
   static std::atomic<uint32_t> g_next_task_id;
 
   std::atomic<uint32_t> id_{};
-  std::function<void()> unit_;  // A unit of work to be processed
+  Unit unit_;  // A unit of work to be processed
+  std::atomic<Task*> next_{nullptr};  // MpscQueue 侵入式节点
 };
 
 }  // namespace runner
@@ -27,9 +27,13 @@
 #include <queue>
 #include <memory>
 #include <cstdint>
+#include <exception>
+#include <tuple>
+#include <utility>
 
 #include "footstone/idle_task.h"
 #include "footstone/macros.h"
+#include "footstone/mpsc_queue.h"
 #include "footstone/task.h"
 #include "footstone/time_delta.h"
 #include "footstone/time_point.h"
@@ -63,20 +67,24 @@ class TaskRunner {
   void PostTask(std::unique_ptr<Task> task);
   template<typename F, typename... Args>
   void PostTask(F &&f, Args... args) {
-    auto packaged_task = std::make_shared<std::packaged_task<std::invoke_result_t<F, Args...>()>>(
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
-    auto task = std::make_unique<Task>([packaged_task]() { (*packaged_task)(); });
-    PostTask(std::move(task));
+    PostTask(std::make_unique<Task>(MakeTaskUnit(std::forward<F>(f), std::move(args)...)));
+  }
+
+  // 需要获取执行结果时使用，只有这种情况才需要 packaged_task 与 future 的共享状态
+  template<typename F, typename... Args>
+  std::future<std::invoke_result_t<F, Args...>> PostTaskWithResult(F &&f, Args... args) {
+    std::packaged_task<std::invoke_result_t<F, Args...>()> packaged_task(
+        std::bind(std::forward<F>(f), std::move(args)...));
+    auto future = packaged_task.get_future();
+    PostTask(std::make_unique<Task>(std::move(packaged_task)));
+    return future;
   }
 
   void PostDelayedTask(std::unique_ptr<Task> task, TimeDelta delay);
 
   template<typename F, typename... Args>
   void PostDelayedTask(F &&f, TimeDelta delay, Args... args) {
-    auto packaged_task = std::make_shared<std::packaged_task<std::invoke_result_t<F, Args...>()>>(
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
-    auto task = std::make_unique<Task>([packaged_task]() { (*packaged_task)(); });
-    PostDelayedTask(std::move(task), delay);
+    PostDelayedTask(std::make_unique<Task>(MakeTaskUnit(std::forward<F>(f), std::move(args)...)), delay);
   }
   TimeDelta GetNextTimeDelta(TimePoint now);
 
@@ -87,7 +95,7 @@ class TaskRunner {
   void RunnerDestroySpecifics();
 
   inline void SetWorker(std::weak_ptr<Worker> worker) {
-    worker_ = worker;
+    std::atomic_store(&worker_, std::make_shared<const std::weak_ptr<Worker>>(std::move(worker)));
   }
   inline uint32_t GetPriority() { return priority_; }
   inline uint32_t GetId() { return id_; }
@@ -104,6 +112,12 @@ class TaskRunner {
   }
   inline void SetTime(TimeDelta time) { time_ = time; }
   inline bool IsSchedulable() { return is_schedulable_; }
+  /*
+   * 可窃取的 TaskRunner 中的 task 之间没有顺序依赖，也不使用 RunnerKey/RunnerSpecific，
+   * WorkerManager 开启窃取模式时，空闲 Worker 可以直接取走其中的单个 task 并发执行。需在 PostTask 之前设置
+   */
+  inline void SetStealSafe(bool is_steal_safe) { is_steal_safe_ = is_steal_safe; }
+  inline bool IsStealSafe() { return is_steal_safe_; }
 
   // 必须要在 task 运行时调用 GetCurrentTaskRunner 才能得到正确的 Runner，task 运行之外调用将会abort
   static std::shared_ptr<TaskRunner> GetCurrentTaskRunner();
@@ -115,18 +129,52 @@ class TaskRunner {
   friend class WorkerManager;
   friend class IdleTimer;
 
-  inline const std::weak_ptr<Worker>& GetWorker() {
-    return worker_;
+  inline std::weak_ptr<Worker> GetWorker() {
+    auto worker = std::atomic_load(&worker_);
+    return worker ? *worker : std::weak_ptr<Worker>();
+  }
+  inline std::shared_ptr<Worker> LockWorker() {
+    auto worker = std::atomic_load(&worker_);
+    return worker ? worker->lock() : nullptr;
   }
   void NotifyWorker();
+  // 与 std::bind 语义一致：参数按值保存，调用时以左值传入
+  template<typename F, typename... Args>
+  static Task::Unit MakeTaskUnit(F &&f, Args... args) {
+    if constexpr (sizeof...(Args) == 0) {
+      return Task::Unit([f = std::forward<F>(f)]() mutable {
+        RunCapturingException(f);
+      });
+    } else {
+      return Task::Unit([f = std::forward<F>(f), bound_args = std::make_tuple(std::move(args)...)]() mutable {
+        RunCapturingException([&f, &bound_args] { std::apply(f, bound_args); });
+      });
+    }
+  }
+  // 与原先的 packaged_task 一致，任务抛出的异常在这里截获，不会传播到 Worker 线程
+  template<typename F>
+  static void RunCapturingException(F &&f) {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+    try {
+      f();
+    } catch (...) {
+      OnUncaughtException(std::current_exception());
+    }
+#else
+    f();
+#endif
+  }
+  static void OnUncaughtException(const std::exception_ptr& exception);
   std::unique_ptr<Task> popTaskFromDelayedQueueNoLock(TimePoint now);
   std::unique_ptr<Task> PopTask();
   // 友元IdleTimer调用
   std::unique_ptr<IdleTask> PopIdleTask();
   std::unique_ptr<Task> GetTopDelayTask();
   std::unique_ptr<Task> GetNext();
+  bool HasPendingTask();
 
-  std::queue<std::unique_ptr<Task>> task_queue_;
+  // 立即任务队列，PostTask 无锁入队；出队方（所在 Worker 以及窃取模式下的其他 Worker）由 queue_mutex_ 互斥
+  MpscQueue<Task> task_queue_;
   std::mutex queue_mutex_;
   std::queue<std::unique_ptr<IdleTask>> idle_task_queue_;
   std::mutex idle_mutex_;
@@ -139,7 +187,11 @@ class TaskRunner {
   std::priority_queue<DelayedEntry, std::vector<DelayedEntry>, DelayedEntryCompare>
       delayed_task_queue_;
   std::mutex delay_mutex_;
-  std::weak_ptr<Worker> worker_;
+  /*
+   * 分组迁移（Balance、DonateGroup）时由其他线程改写，PostTask 的生产者线程同时会读取。
+   * 改写时整体替换，读写都通过 atomic_load/atomic_store，PostTask 不需要加锁
+   */
+  std::shared_ptr<const std::weak_ptr<Worker>> worker_;
   std::string name_;
   bool has_sub_runner_;
   uint32_t priority_;
@@ -153,6 +205,7 @@ class TaskRunner {
    *  不可调度的TaskRunner不会被迁移，但其所在的Worker还是可以加入其他TaskRunner
    */
   bool is_schedulable_;
+  bool is_steal_safe_;
 };
 
 }  // namespace runner
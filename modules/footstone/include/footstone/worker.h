@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <mutex>
@@ -94,6 +95,16 @@ class Worker {
   std::unique_ptr<Task> GetNextTask();
   void AddImmediateTask(std::unique_ptr<Task> task);
   bool HasUnschedulableRunner();
+  // 窃取模式：空闲时向 WorkerManager 申请窃取任务
+  std::unique_ptr<Task> StealTask();
+  std::unique_ptr<Task> PopStealSafeTask(std::shared_ptr<TaskRunner>& runner);
+  void SetManager(WorkerManager* manager);
+  void NotifyIdleWorker();
+  void RequestDonation(const std::shared_ptr<Worker>& thief);
+  uint32_t GetPendingGroupSize();
+  uint32_t GetPendingGroupSizeNoLock();
+  std::vector<std::shared_ptr<TaskRunner>> DetachDonatableGroupNoLock();
+  void DonateGroup(const std::shared_ptr<Worker>& thief, std::vector<std::shared_ptr<TaskRunner>> group);
   void BalanceNoLock();
   void SortNoLock();
 
@@ -121,7 +132,7 @@ class Worker {
   std::queue<std::unique_ptr<Task>> immediate_task_queue_;
   TimeDelta min_wait_time_; // 距离当前时刻将要执行的任务的最短时间间隔
   TimePoint next_task_time_; // 即将执行的延迟任务预计执行的时间点，用以计算空闲时间
-  bool need_balance_;
+  std::atomic<bool> need_balance_; // 其他 Worker 窃取或迁移分组时在其线程上置位
   bool is_stacking_mode_;
   bool has_migration_data_;
   /*
@@ -134,6 +145,20 @@ class Worker {
   bool is_schedulable_;
   uint32_t group_id_;
   std::unique_ptr<Driver> driver_;
+  /*
+   *    窃取模式相关状态
+   * 1. manager_ 只在开启窃取模式时由 WorkerManager 设置，关闭窃取模式或 WorkerManager 析构时清空，
+   *    为空时 Notify 与 StealTask 不加锁直接返回。通过 manager_ 调用 WorkerManager 期间持有 manager_mutex_，
+   *    析构会等待正在进行的调用结束，避免访问已销毁的 WorkerManager
+   * 2. is_busy_ 表示 Worker 正在运行 task，is_waiting_ 表示 Worker 正在等待新任务
+   * 3. donation_targets_ 为空闲 Worker 发起的窃取请求，由当前 Worker 在两个 task 之间逐个让出分组，
+   *    保证同一 TaskRunner 不会同时在两个 Worker 上运行，并且 WorkerKey 在本线程上迁移
+   */
+  std::atomic<WorkerManager*> manager_;
+  std::mutex manager_mutex_;
+  std::atomic<bool> is_busy_;
+  std::atomic<bool> is_waiting_;
+  std::vector<std::weak_ptr<Worker>> donation_targets_; // running_mutex_ 保护
 };
 
 }  // namespace runner
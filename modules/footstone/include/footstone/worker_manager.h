@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 
 #include "footstone/task_runner.h"
@@ -45,8 +46,22 @@ class WorkerManager {
   void AddTaskRunner(std::shared_ptr<TaskRunner> runner);
   void RemoveTaskRunner(const std::shared_ptr<TaskRunner>& runner);
 
+  /*
+   *    窃取模式（默认关闭）
+   * 1. Resize 之外 TaskRunner 分组不会在 Worker 之间迁移，某个 Worker 上任务突增时其他空闲 Worker 无法分担
+   * 2. 开启后空闲 Worker 会请求忙碌 Worker 在两个 task 之间让出一个可调度的分组（连同其 WorkerKey），
+   *    或者直接取走可窃取（SetStealSafe）TaskRunner 中的单个 task
+   * 3. 不可调度的 Worker/TaskRunner、指定了 group_id 的分组以及含子 TaskRunner 的分组不参与窃取
+   */
+  void SetWorkStealingEnabled(bool enabled);
+  inline bool IsWorkStealingEnabled() { return is_work_stealing_enabled_; }
+
  private:
   friend class Profile;
+  friend class Worker;
+
+  std::unique_ptr<Task> Steal(const std::shared_ptr<Worker>& thief, std::shared_ptr<TaskRunner>& runner);
+  void NotifyIdleWorker(const Worker* busy_worker);
   static void MoveTaskRunnerSpecificNoLock(uint32_t runner_id,
                                            const std::shared_ptr<Worker>& from,
                                            const std::shared_ptr<Worker>& to);
@@ -62,6 +77,7 @@ class WorkerManager {
   int32_t index_;
   uint32_t size_;
   std::mutex mutex_;
+  std::atomic<bool> is_work_stealing_enabled_;
 };
 
 }  // namespace runner
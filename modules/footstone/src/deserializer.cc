@@ -21,6 +21,7 @@
 #include "include/footstone/deserializer.h"
 
 #include <cstring>
+#include <utility>
 
 #include "include/footstone/hippy_value.h"
 #include "include/footstone/logging.h"
@@ -35,6 +36,13 @@ using string_view = footstone::stringview::string_view;
 using StringViewUtils = footstone::stringview::StringViewUtils;
 constexpr uint32_t kSupportedVersion = 15;
 
+static bool IsAscii(const uint8_t* data, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    if (data[i] & 0x80) return false;
+  }
+  return true;
+}
+
 Deserializer::Deserializer(const std::vector<const uint8_t>& data)
     : position_(&data[0]), end_(&data[0] + data.size()) {}
 
@@ -47,6 +55,17 @@ bool Deserializer::ReadValue(HippyValue& value) {
   return ret;
 }
 
+bool Deserializer::ReadValueView(HippyValueView& view) {
+  SerializationTag tag;
+  if (!ReadTag(tag)) return false;
+  view.tag_ = tag;
+  view.begin_ = position_ - 1;
+  view.end_ = end_;
+  view.members_ = nullptr;
+  position_ = end_;
+  return true;
+}
+
 bool Deserializer::ReadHeader() {
   if (position_ < end_ && *position_ == static_cast<uint8_t>(SerializationTag::kVersion)) {
     SerializationTag tag;
@@ -147,11 +166,9 @@ bool Deserializer::ReadUtf8String(HippyValue& hippy_value) {
   utf8_length = ReadVarint<uint32_t>();
   if (utf8_length > static_cast<uint32_t>(end_ - position_)) return false;
 
-  const uint8_t* start = position_;
+  const char* start = reinterpret_cast<const char*>(position_);
   position_ += utf8_length;
-  string_view string_view(reinterpret_cast<const string_view::char8_t_ *>(start), utf8_length);
-  hippy_value = StringViewUtils::ToStdString(StringViewUtils::ConvertEncoding(
-      string_view, string_view::Encoding::Utf8).utf8_value());
+  hippy_value = HippyValue(start, utf8_length);
   return true;
 }
 
@@ -175,6 +192,11 @@ bool Deserializer::ReadOneByteString(HippyValue& hippy_value) {
 
   const char* start = reinterpret_cast<char*>(const_cast<uint8_t*>(position_));
   position_ += one_byte_length;
+  // ascii 的 latin1 与 utf8 编码相同，无需转换
+  if (IsAscii(position_ - one_byte_length, one_byte_length)) {
+    hippy_value = HippyValue(start, one_byte_length);
+    return true;
+  }
   string_view string_view(start, one_byte_length);
   hippy_value = StringViewUtils::ToStdString(StringViewUtils::ConvertEncoding(
       string_view, string_view::Encoding::Utf8).utf8_value());
@@ -222,9 +244,7 @@ bool Deserializer::ReadDenseJSArray(HippyValue& hippy_value) {
       continue;
     }
 
-    HippyValue value;
-    ReadObject(value);
-    array[i] = value;
+    ReadObject(array[i]);
   }
 
   uint32_t num_properties;
@@ -237,7 +257,7 @@ bool Deserializer::ReadDenseJSArray(HippyValue& hippy_value) {
   if (num_properties != expected_num_properties) return false;
   if (length != expected_length) return false;
 
-  hippy_value = array;
+  hippy_value = HippyValue(std::move(array));
   return true;
 }
 
@@ -253,7 +273,7 @@ bool Deserializer::ReadJSObject(HippyValue& hippy_value) {
     return false;
   }
 
-  hippy_value = object;
+  hippy_value = HippyValue(std::move(object));
   return true;
 }
 
@@ -372,6 +392,7 @@ bool Deserializer::ReadObjectProperties(HippyValueObjectType& property, uint32_t
     if (tag == end_tag) {
       ConsumeTag(end_tag);
       number_properties = number;
+      property = std::move(object);
       return true;
     }
 
@@ -386,8 +407,7 @@ bool Deserializer::ReadObjectProperties(HippyValueObjectType& property, uint32_t
         FOOTSTONE_DLOG(WARNING) << "error key type:" + std::to_string(static_cast<int>(key.GetType()));
         return false;
       }
-      object.insert(std::pair<std::string, HippyValue>(key.ToStringChecked(), value));
-      property = object;
+      object.emplace(std::as_const(key).ToStringChecked(), value);
     }
     number++;
   }
@@ -412,5 +432,240 @@ bool Deserializer::ReadObjectProperties(uint32_t& number_properties, Serializati
   return false;
 }
 
+bool Deserializer::SkipObject(HippyValueView* view) {
+  SerializationTag tag;
+  if (!ReadTag(tag)) return false;
+  if (view) {
+    view->tag_ = tag;
+    view->begin_ = position_ - 1;
+    view->end_ = end_;
+    view->members_ = nullptr;
+  }
+  return SkipObjectBody(tag);
+}
+
+bool Deserializer::SkipObjectBody(SerializationTag tag) {
+  switch (tag) {
+    case SerializationTag::kTheHole:
+    case SerializationTag::kUndefined:
+    case SerializationTag::kNull:
+    case SerializationTag::kTrue:
+    case SerializationTag::kFalse:
+      return true;
+    case SerializationTag::kInt32:
+    case SerializationTag::kUint32:
+      ReadVarint<uint32_t>();
+      return true;
+    case SerializationTag::kDouble: {
+      if (sizeof(double) > static_cast<unsigned>(end_ - position_)) return false;
+      position_ += sizeof(double);
+      return true;
+    }
+    case SerializationTag::kUtf8String:
+    case SerializationTag::kOneByteString:
+    case SerializationTag::kTwoByteString: {
+      auto length = ReadVarint<uint32_t>();
+      if (length > static_cast<uint32_t>(end_ - position_)) return false;
+      position_ += length;
+      return true;
+    }
+    case SerializationTag::kBeginDenseJSArray: {
+      uint32_t length = ReadVarint<uint32_t>();
+      for (uint32_t i = 0; i < length; i++) {
+        if (!SkipObject()) return false;
+      }
+      uint32_t num_properties;
+      if (!ReadObjectProperties(num_properties, SerializationTag::kEndDenseJSArray)) return false;
+      ReadVarint<uint32_t>();
+      ReadVarint<uint32_t>();
+      return true;
+    }
+    case SerializationTag::kBeginJSObject: {
+      SerializationTag peek_tag;
+      while (PeekTag(peek_tag)) {
+        if (peek_tag == SerializationTag::kEndJSObject) {
+          ConsumeTag(SerializationTag::kEndJSObject);
+          ReadVarint<uint32_t>();
+          return true;
+        }
+        if (!SkipObject() || !SkipObject()) return false;
+      }
+      return false;
+    }
+    default:
+      return false;
+  }
+}
+
+struct HippyValueView::Members {
+  bool valid = false;
+  // array 只使用 values，object 的 keys 与 values 一一对应
+  std::vector<HippyValueView> keys;
+  std::vector<HippyValueView> values;
+};
+
+HippyValue::Type HippyValueView::GetType() const {
+  switch (tag_) {
+    case SerializationTag::kNull:
+      return HippyValue::Type::kNull;
+    case SerializationTag::kTrue:
+    case SerializationTag::kFalse:
+      return HippyValue::Type::kBoolean;
+    case SerializationTag::kInt32:
+    case SerializationTag::kUint32:
+    case SerializationTag::kDouble:
+      return HippyValue::Type::kNumber;
+    case SerializationTag::kUtf8String:
+    case SerializationTag::kOneByteString:
+    case SerializationTag::kTwoByteString:
+      return HippyValue::Type::kString;
+    case SerializationTag::kBeginJSObject:
+      return HippyValue::Type::kObject;
+    case SerializationTag::kBeginDenseJSArray:
+      return HippyValue::Type::kArray;
+    default:
+      return HippyValue::Type::kUndefined;
+  }
+}
+
+bool HippyValueView::ToInt32(int32_t& i32) const {
+  if (tag_ != SerializationTag::kInt32) return false;
+  Deserializer deserializer(begin_ + 1, static_cast<size_t>(end_ - begin_ - 1));
+  i32 = deserializer.ReadZigZag<int32_t>();
+  return true;
+}
+
+bool HippyValueView::ToUint32(uint32_t& u32) const {
+  if (tag_ != SerializationTag::kUint32) return false;
+  Deserializer deserializer(begin_ + 1, static_cast<size_t>(end_ - begin_ - 1));
+  u32 = deserializer.ReadVarint<uint32_t>();
+  return true;
+}
+
+bool HippyValueView::ToDouble(double& d) const {
+  if (tag_ == SerializationTag::kInt32) {
+    int32_t i32;
+    ToInt32(i32);
+    d = i32;
+    return true;
+  }
+  if (tag_ == SerializationTag::kUint32) {
+    uint32_t u32;
+    ToUint32(u32);
+    d = u32;
+    return true;
+  }
+  if (tag_ != SerializationTag::kDouble) return false;
+  Deserializer deserializer(begin_ + 1, static_cast<size_t>(end_ - begin_ - 1));
+  return deserializer.ReadDouble(d);
+}
+
+bool HippyValueView::ToBoolean(bool& b) const {
+  if (tag_ != SerializationTag::kTrue && tag_ != SerializationTag::kFalse) return false;
+  b = tag_ == SerializationTag::kTrue;
+  return true;
+}
+
+bool HippyValueView::GetStringSpan(const uint8_t*& data, size_t& length, Encoding& encoding) const {
+  switch (tag_) {
+    case SerializationTag::kUtf8String:
+      encoding = Encoding::Utf8;
+      break;
+    case SerializationTag::kOneByteString:
+      encoding = Encoding::Latin1;
+      break;
+    case SerializationTag::kTwoByteString:
+      encoding = Encoding::Utf16;
+      break;
+    default:
+      return false;
+  }
+  Deserializer deserializer(begin_ + 1, static_cast<size_t>(end_ - begin_ - 1));
+  length = deserializer.ReadVarint<uint32_t>();
+  data = deserializer.position_;
+  return length <= static_cast<size_t>(end_ - data);
+}
+
+bool HippyValueView::ToString(std::string& str) const {
+  HippyValue value;
+  if (GetType() != HippyValue::Type::kString || !Materialize(value)) return false;
+  return value.ToString(str);
+}
+
+bool HippyValueView::EqualsString(const std::string& str) const {
+  const uint8_t* data;
+  size_t length;
+  Encoding encoding;
+  if (!GetStringSpan(data, length, encoding)) return false;
+  if (encoding == Encoding::Utf8 || (encoding == Encoding::Latin1 && IsAscii(data, length))) {
+    return length == str.length() && memcmp(data, str.data(), length) == 0;
+  }
+  std::string decoded;
+  return ToString(decoded) && decoded == str;
+}
+
+size_t HippyValueView::GetLength() const {
+  if (!IndexMembers()) return 0;
+  return members_->values.size();
+}
+
+bool HippyValueView::GetElement(size_t index, HippyValueView& element) const {
+  if (tag_ != SerializationTag::kBeginDenseJSArray || !IndexMembers()) return false;
+  if (index >= members_->values.size()) return false;
+  element = members_->values[index];
+  return true;
+}
+
+bool HippyValueView::GetProperty(const std::string& key, HippyValueView& value) const {
+  if (tag_ != SerializationTag::kBeginJSObject || !IndexMembers()) return false;
+  for (size_t i = 0; i < members_->keys.size(); ++i) {
+    if (members_->keys[i].EqualsString(key)) {
+      value = members_->values[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+bool HippyValueView::GetPropertyAt(size_t index, HippyValueView& key, HippyValueView& value) const {
+  if (tag_ != SerializationTag::kBeginJSObject || !IndexMembers()) return false;
+  if (index >= members_->keys.size()) return false;
+  key = members_->keys[index];
+  value = members_->values[index];
+  return true;
+}
+
+bool HippyValueView::Materialize(HippyValue& value) const {
+  if (begin_ == nullptr) return false;
+  Deserializer deserializer(begin_, static_cast<size_t>(end_ - begin_));
+  return deserializer.ReadObject(value);
+}
+
+bool HippyValueView::IndexMembers() const {
+  if (tag_ != SerializationTag::kBeginDenseJSArray && tag_ != SerializationTag::kBeginJSObject) return false;
+  if (members_) return members_->valid;
+
+  members_ = std::make_shared<Members>();
+  Deserializer deserializer(begin_ + 1, static_cast<size_t>(end_ - begin_ - 1));
+  if (tag_ == SerializationTag::kBeginDenseJSArray) {
+    uint32_t length = deserializer.ReadVarint<uint32_t>();
+    members_->values.resize(length);
+    for (uint32_t i = 0; i < length; i++) {
+      if (!deserializer.SkipObject(&members_->values[i])) return false;
+    }
+  } else {
+    SerializationTag tag;
+    while (deserializer.PeekTag(tag) && tag != SerializationTag::kEndJSObject) {
+      HippyValueView key;
+      HippyValueView value;
+      if (!deserializer.SkipObject(&key) || !deserializer.SkipObject(&value)) return false;
+      members_->keys.push_back(std::move(key));
+      members_->values.push_back(std::move(value));
+    }
+  }
+  members_->valid = true;
+  return true;
+}
+
 }  // namespace value
 }  // namespace footstone
@@ -20,10 +20,67 @@
 
 #include "include/footstone/hippy_value.h"
 
+#include <atomic>
+
 #include "include/footstone/logging.h"
 #include "include/footstone/hash.h"
 
+namespace footstone {
+inline namespace value {
+
+template <typename T>
+struct HippyValuePayload {
+  template <typename... Args>
+  explicit HippyValuePayload(Args&&... args) : value(std::forward<Args>(args)...) {}
+
+  std::atomic<uint32_t> ref_count{1};
+  // 非 const 接口交出过可修改的引用后置为 true，此后拷贝不再共享该负载而是深拷贝，避免通过该引用修改到拷贝
+  bool unshareable = false;
+  T value;
+};
+
+}  // namespace value
+}  // namespace footstone
+
 using HippyValue = footstone::value::HippyValue;
+using footstone::value::HippyValuePayload;
+
+// 不超过该长度的字符串落在 std::string 的 SSO 内，直接内联存储，更长的字符串才放入共享负载
+constexpr size_t kInlineStringLength = 15;
+
+template <typename T>
+static HippyValuePayload<T>* Retain(HippyValuePayload<T>* payload) {
+  payload->ref_count.fetch_add(1, std::memory_order_relaxed);
+  return payload;
+}
+
+template <typename T>
+static void Release(HippyValuePayload<T>* payload) {
+  if (payload->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete payload;
+  }
+}
+
+// 拷贝构造时使用：负载交出过可修改的引用时深拷贝，否则共享
+template <typename T>
+static HippyValuePayload<T>* Share(HippyValuePayload<T>* payload) {
+  if (payload->unshareable) {
+    return new HippyValuePayload<T>(payload->value);
+  }
+  return Retain(payload);
+}
+
+// 写时复制：负载被其他 HippyValue 共享时复制一份独占的负载，并标记为不可共享，调用方随后交出可修改的引用
+template <typename T>
+static HippyValuePayload<T>* Detach(HippyValuePayload<T>* payload) {
+  if (payload->ref_count.load(std::memory_order_acquire) != 1) {
+    auto* copy = new HippyValuePayload<T>(payload->value);
+    Release(payload);
+    payload = copy;
+  }
+  payload->unshareable = true;
+  return payload;
+}
 
 std::size_t std::hash<HippyValue>::operator()(const HippyValue& value) const noexcept {
   switch (value.type_) {
@@ -49,11 +106,11 @@ std::size_t std::hash<HippyValue>::operator()(const HippyValue& value) const noe
       return 0;
     }
     case HippyValue::Type::kString:
-      return std::hash<std::string>{}(value.str_);
+      return std::hash<std::string>{}(value.shared_str_ ? value.str_payload_->value : value.str_);
     case HippyValue::Type::kArray:
-      return std::hash<HippyValue::HippyValueArrayType>{}(value.arr_);
+      return std::hash<HippyValue::HippyValueArrayType>{}(value.arr_->value);
     case HippyValue::Type::kObject:
-      return std::hash<HippyValue::HippyValueObjectType>{}(value.obj_);
+      return std::hash<HippyValue::HippyValueObjectType>{}(value.obj_->value);
     default:
       break;
   }
@@ -75,42 +132,30 @@ const HippyValue HippyValue::Null() {
   return Null;
 }
 
-HippyValue::HippyValue(const HippyValue& source) : type_(source.type_), number_type_(source.number_type_) {
-  switch (type_) {
-    case HippyValue::Type::kBoolean:
-      b_ = source.b_;
-      break;
-    case HippyValue::Type::kNumber: {
-      switch (source.number_type_) {
-        case HippyValue::NumberType::kInt32:
-          num_.i32_ = source.num_.i32_;
-          break;
-        case HippyValue::NumberType::kUInt32:
-          num_.u32_ = source.num_.u32_;
-          break;
-        case HippyValue::NumberType::kDouble:
-          num_.d_ = source.num_.d_;
-          break;
-        case HippyValue::NumberType::kNaN:
-        default:
-          break;
-      }
-      break;
-    }
-    case HippyValue::Type::kString:
-      new (&str_) std::string(source.str_);
-      break;
-    case HippyValue::Type::kObject:
-      new (&obj_) HippyValueObjectType(source.obj_);
-      break;
-    case HippyValue::Type::kArray:
-      new (&arr_) HippyValueArrayType(source.arr_);
-      break;
-    default:
-      break;
-  }
+HippyValue::HippyValue(std::string&& str) : type_(Type::kString) { InitString(std::move(str)); }
+
+HippyValue::HippyValue(const std::string& str) : type_(Type::kString) { InitString(std::string(str)); }
+
+HippyValue::HippyValue(const char* string_value) : type_(Type::kString) { InitString(std::string(string_value)); }
+
+HippyValue::HippyValue(const char* string_value, size_t length) : type_(Type::kString) {
+  InitString(std::string(string_value, length));
 }
 
+HippyValue::HippyValue(HippyValueObjectType&& object_value)
+    : type_(Type::kObject), obj_(new HippyValuePayload<HippyValueObjectType>(std::move(object_value))) {}
+
+HippyValue::HippyValue(const HippyValueObjectType& object_value)
+    : type_(Type::kObject), obj_(new HippyValuePayload<HippyValueObjectType>(object_value)) {}
+
+HippyValue::HippyValue(HippyValueArrayType&& array_value)
+    : type_(Type::kArray), arr_(new HippyValuePayload<HippyValueArrayType>(std::move(array_value))) {}
+
+HippyValue::HippyValue(HippyValueArrayType& array_value)
+    : type_(Type::kArray), arr_(new HippyValuePayload<HippyValueArrayType>(array_value)) {}
+
+HippyValue::HippyValue(const HippyValue& source) { CopyFrom(source); }
+
 HippyValue::~HippyValue() { Deallocate(); }
 
 HippyValue& HippyValue::operator=(const HippyValue& rhs) noexcept {
@@ -118,63 +163,15 @@ HippyValue& HippyValue::operator=(const HippyValue& rhs) noexcept {
     return *this;
   }
 
-  switch (rhs.type_) {
-    case HippyValue::Type::kNull:
-    case HippyValue::Type::kUndefined:
-      Deallocate();
-      break;
-    case HippyValue::Type::kNumber:
-      Deallocate();
-      switch (rhs.number_type_) {
-        case HippyValue::NumberType::kInt32:
-          num_.i32_ = rhs.num_.i32_;
-          break;
-        case HippyValue::NumberType::kUInt32:
-          num_.u32_ = rhs.num_.u32_;
-          break;
-        case HippyValue::NumberType::kDouble:
-          num_.d_ = rhs.num_.d_;
-          break;
-        case HippyValue::NumberType::kNaN:
-          break;
-        default:
-          break;
-      }
-      break;
-    case HippyValue::Type::kBoolean:
-      Deallocate();
-      b_ = rhs.b_;
-      break;
-    case HippyValue::Type::kString:
-      if (type_ != HippyValue::Type::kString) {
-        Deallocate();
-        new (&str_) std::string(rhs.str_);
-      } else {
-        str_ = rhs.str_;
-      }
-      break;
-    case HippyValue::Type::kObject:
-      if (type_ != HippyValue::Type::kObject) {
-        Deallocate();
-        new (&obj_) HippyValueObjectType(rhs.obj_);
-      } else {
-        obj_ = rhs.obj_;
-      }
-      break;
-    case HippyValue::Type::kArray:
-      if (type_ != HippyValue::Type::kArray) {
-        Deallocate();
-        new (&arr_) HippyValueArrayType(rhs.arr_);
-      } else {
-        arr_ = rhs.arr_;
-      }
-      break;
-    default:
-      break;
+  if (type_ == HippyValue::Type::kString && !shared_str_ && rhs.type_ == HippyValue::Type::kString &&
+      !rhs.shared_str_) {
+    str_ = rhs.str_;
+    return *this;
   }
-
-  type_ = rhs.type_;
-  number_type_ = rhs.number_type_;
+  // rhs 可能是本对象的子元素，先持有一份再释放旧值
+  HippyValue source(rhs);
+  Deallocate();
+  CopyFrom(source);
   return *this;
 }
 
@@ -211,53 +208,40 @@ HippyValue& HippyValue::operator=(const bool rhs) noexcept {
 }
 
 HippyValue& HippyValue::operator=(const std::string& rhs) noexcept {
-  if (type_ != HippyValue::Type::kString) {
-    Deallocate();
-    new (&str_) std::string(rhs);
-  } else {
-    str_ = rhs;
-  }
+  // rhs 可能是本对象持有的字符串，先复制再释放旧值
+  std::string str(rhs);
+  Deallocate();
   type_ = HippyValue::Type::kString;
   number_type_ = HippyValue::NumberType::kNaN;
+  InitString(std::move(str));
   return *this;
 }
 
 HippyValue& HippyValue::operator=(const char* rhs) noexcept {
-  if (type_ != HippyValue::Type::kString) {
-    Deallocate();
-    new (&str_) std::string(rhs);
-  } else {
-    str_ = rhs;
-  }
-
+  std::string str(rhs);
+  Deallocate();
   type_ = HippyValue::Type::kString;
   number_type_ = HippyValue::NumberType::kNaN;
+  InitString(std::move(str));
   return *this;
 }
 
 HippyValue& HippyValue::operator=(const HippyValueObjectType& rhs) noexcept {
-  if (type_ != HippyValue::Type::kObject) {
-    Deallocate();
-    new (&obj_) HippyValueObjectType(rhs);
-  } else {
-    obj_ = rhs;
-  }
-
+  // rhs 可能属于本对象，先构造新负载再释放旧负载
+  auto* payload = new HippyValuePayload<HippyValueObjectType>(rhs);
+  Deallocate();
   type_ = HippyValue::Type::kObject;
   number_type_ = HippyValue::NumberType::kNaN;
+  obj_ = payload;
   return *this;
 }
 
 HippyValue& HippyValue::operator=(const HippyValueArrayType& rhs) noexcept {
-  if (type_ != HippyValue::Type::kArray) {
-    Deallocate();
-    new (&arr_) HippyValueArrayType(rhs);
-  } else {
-    arr_ = rhs;
-  }
-
+  auto* payload = new HippyValuePayload<HippyValueArrayType>(rhs);
+  Deallocate();
   type_ = HippyValue::Type::kArray;
   number_type_ = HippyValue::NumberType::kNaN;
+  arr_ = payload;
   return *this;
 }
 
@@ -286,11 +270,11 @@ bool HippyValue::operator==(const HippyValue& rhs) const noexcept {
       return false;
     }
     case HippyValue::Type::kString:
-      return str_ == rhs.str_;
+      return ToStringChecked() == rhs.ToStringChecked();
     case HippyValue::Type::kObject:
-      return obj_ == rhs.obj_;
+      return obj_ == rhs.obj_ || obj_->value == rhs.obj_->value;
     case HippyValue::Type::kArray:
-      return arr_ == rhs.arr_;
+      return arr_ == rhs.arr_ || arr_->value == rhs.arr_->value;
     default:
       break;
   }
@@ -335,7 +319,7 @@ std::ostream& operator<<(std::ostream& os, const HippyValue& hippy_value) {
     os << "\"" << hippy_value.ToStringChecked() << "\"";
   } else if (hippy_value.type_ == HippyValue::Type::kObject) {
     os << "{";
-    auto map = hippy_value.ToObjectChecked();
+    const auto& map = hippy_value.ToObjectChecked();
     size_t index = 0;
     for (const auto& kv : map) {
       os << "\"" << kv.first << "\": " << kv.second;
@@ -345,7 +329,7 @@ std::ostream& operator<<(std::ostream& os, const HippyValue& hippy_value) {
     os << "}";
   } else if (hippy_value.type_ == HippyValue::Type::kArray) {
     os << "[ ";
-    auto arr = hippy_value.ToArrayChecked();
+    const auto& arr = hippy_value.ToArrayChecked();
     for (size_t i = 0; i < arr.size(); i++) {
       os << arr[i];
       if (i != arr.size() - 1) os << ",";
@@ -415,7 +399,7 @@ double HippyValue::ToDoubleChecked() const {
 
 bool HippyValue::ToBoolean(bool& b) const {
   bool is_bool = IsBoolean();
-  b = b_;
+  if (is_bool) b = b_;
   return is_bool;
 }
 
@@ -426,66 +410,117 @@ bool HippyValue::ToBooleanChecked() const {
 
 bool HippyValue::ToString(std::string& str) const {
   bool is_string = IsString();
-  str = str_;
+  if (is_string) str = ToStringChecked();
   return is_string;
 }
 
 const std::string& HippyValue::ToStringChecked() const {
   FOOTSTONE_CHECK(IsString());
-  return str_;
+  return shared_str_ ? str_payload_->value : str_;
 }
 
 std::string& HippyValue::ToStringChecked() {
   FOOTSTONE_CHECK(IsString());
-  return str_;
+  if (!shared_str_) {
+    return str_;
+  }
+  str_payload_ = Detach(str_payload_);
+  return str_payload_->value;
 }
 
 bool HippyValue::ToObject(HippyValue::HippyValueObjectType& obj) const {
   bool is_object = IsObject();
-  obj = obj_;
+  if (is_object) obj = obj_->value;
   return is_object;
 }
 
 const HippyValue::HippyValueObjectType& HippyValue::ToObjectChecked() const {
   FOOTSTONE_CHECK(IsObject());
-  return obj_;
+  return obj_->value;
 }
 
 HippyValue::HippyValueObjectType& HippyValue::ToObjectChecked() {
   FOOTSTONE_CHECK(IsObject());
-  return obj_;
+  obj_ = Detach(obj_);
+  return obj_->value;
 }
 
 bool HippyValue::ToArray(HippyValue::HippyValueArrayType& arr) const {
   bool is_array = IsArray();
-  arr = arr_;
+  if (is_array) arr = arr_->value;
   return is_array;
 }
 
 const HippyValue::HippyValueArrayType& HippyValue::ToArrayChecked() const {
   FOOTSTONE_CHECK(IsArray());
-  return arr_;
+  return arr_->value;
 }
 
 HippyValue::HippyValueArrayType& HippyValue::ToArrayChecked() {
   FOOTSTONE_CHECK(IsArray());
-  return arr_;
+  arr_ = Detach(arr_);
+  return arr_->value;
+}
+
+inline void HippyValue::InitString(std::string&& str) {
+  FOOTSTONE_DCHECK(type_ == Type::kString);
+  shared_str_ = str.size() > kInlineStringLength;
+  if (shared_str_) {
+    str_payload_ = new HippyValuePayload<std::string>(std::move(str));
+  } else {
+    new (&str_) std::string(std::move(str));
+  }
+}
+
+inline void HippyValue::CopyFrom(const HippyValue& source) {
+  type_ = source.type_;
+  number_type_ = source.number_type_;
+  shared_str_ = source.shared_str_;
+  switch (type_) {
+    case HippyValue::Type::kBoolean:
+      b_ = source.b_;
+      break;
+    case HippyValue::Type::kNumber:
+      num_ = source.num_;
+      break;
+    case HippyValue::Type::kString:
+      if (shared_str_) {
+        str_payload_ = Share(source.str_payload_);
+      } else {
+        new (&str_) std::string(source.str_);
+      }
+      break;
+    case HippyValue::Type::kObject:
+      obj_ = Share(source.obj_);
+      break;
+    case HippyValue::Type::kArray:
+      arr_ = Share(source.arr_);
+      break;
+    default:
+      break;
+  }
 }
 
 inline void HippyValue::Deallocate() {
   switch (type_) {
     case Type::kString:
-      str_.~basic_string();
+      if (shared_str_) {
+        Release(str_payload_);
+      } else {
+        str_.~basic_string();
+      }
       break;
     case Type::kArray:
-      arr_.~vector();
+      Release(arr_);
       break;
     case Type::kObject:
-      obj_.~unordered_map();
+      Release(obj_);
       break;
     default:
       break;
   }
+  type_ = Type::kUndefined;
+  shared_str_ = false;
 }
 
 }  // namespace base
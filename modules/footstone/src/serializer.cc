@@ -20,21 +20,112 @@
 
 #include "include/footstone/serializer.h"
 
+#include <cmath>
 #include <codecvt>
+#include <cstdlib>
+#include <limits>
 #include <type_traits>
 
 #include "include/footstone/check.h"
 #include "include/footstone/logging.h"
+#include "include/footstone/string_view_utils.h"
 
 namespace footstone {
 inline namespace value {
 
-constexpr uint32_t kVersion = 13;
+SerializerBufferPool::SerializerBufferPool(size_t high_water_mark) : high_water_mark_(high_water_mark) {}
+
+SerializerBufferPool::~SerializerBufferPool() {
+  for (auto& free_list : free_lists_) {
+    for (auto buffer : free_list) {
+      free(buffer);
+    }
+  }
+}
+
+std::pair<uint8_t*, size_t> SerializerBufferPool::Acquire(size_t min_capacity) {
+  size_t shift = kMinSizeClassShift;
+  while (shift <= kMaxSizeClassShift && (static_cast<size_t>(1) << shift) < min_capacity) {
+    shift++;
+  }
+  if (shift > kMaxSizeClassShift) {
+    // 超出最大等级的缓冲区不做缓存
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_misses_++;
+    return std::make_pair(reinterpret_cast<uint8_t*>(malloc(min_capacity)), min_capacity);
+  }
+
+  size_t capacity = static_cast<size_t>(1) << shift;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& free_list = free_lists_[shift - kMinSizeClassShift];
+    if (!free_list.empty()) {
+      auto buffer = free_list.back();
+      free_list.pop_back();
+      pooled_bytes_ -= capacity;
+      pool_hits_++;
+      return std::make_pair(buffer, capacity);
+    }
+    pool_misses_++;
+  }
+  return std::make_pair(reinterpret_cast<uint8_t*>(malloc(capacity)), capacity);
+}
+
+void SerializerBufferPool::Recycle(uint8_t* buffer, size_t capacity) {
+  if (!buffer) {
+    return;
+  }
+  // 只缓存大小恰好为某个等级的缓冲区
+  if (capacity >= (static_cast<size_t>(1) << kMinSizeClassShift) &&
+      capacity <= (static_cast<size_t>(1) << kMaxSizeClassShift) && (capacity & (capacity - 1)) == 0) {
+    size_t shift = kMinSizeClassShift;
+    while ((static_cast<size_t>(1) << shift) < capacity) {
+      shift++;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pooled_bytes_ + capacity <= high_water_mark_) {
+      free_lists_[shift - kMinSizeClassShift].push_back(buffer);
+      pooled_bytes_ += capacity;
+      return;
+    }
+  }
+  free(buffer);
+}
+
+void SerializerBufferPool::SetHighWaterMark(size_t high_water_mark) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  high_water_mark_ = high_water_mark;
+  // 从大到小释放超出 high water mark 的缓存
+  for (auto it = free_lists_.rbegin(); it != free_lists_.rend() && pooled_bytes_ > high_water_mark_; ++it) {
+    size_t capacity = static_cast<size_t>(1) << (kMaxSizeClassShift - static_cast<size_t>(it - free_lists_.rbegin()));
+    while (!it->empty() && pooled_bytes_ > high_water_mark_) {
+      free(it->back());
+      it->pop_back();
+      pooled_bytes_ -= capacity;
+    }
+  }
+}
+
+SerializerBufferPool::Stats SerializerBufferPool::GetStats() const {
+  Stats stats;
+  stats.bytes_serialized = bytes_serialized_.load(std::memory_order_relaxed);
+  stats.reallocations = reallocations_.load(std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats.pool_hits = pool_hits_;
+  stats.pool_misses = pool_misses_;
+  stats.pooled_bytes = pooled_bytes_;
+  return stats;
+}
 
 Serializer::Serializer() = default;
 
+Serializer::Serializer(std::shared_ptr<SerializerBufferPool> pool) : pool_(std::move(pool)) {}
+
 Serializer::~Serializer() {
-  if (buffer_) {
+  if (pool_) {
+    RecordSerialized();
+    pool_->Recycle(buffer_, buffer_capacity_);
+  } else if (buffer_) {
     free(buffer_);
   }
 }
@@ -45,10 +136,11 @@ void Serializer::WriteValue(const HippyValue& hippy_value) {
 
 void Serializer::WriteHeader() {
   WriteTag(SerializationTag::kVersion);
-  WriteVarint(kVersion);
+  WriteVarint(kLatestVersion);
 }
 
 std::pair<uint8_t*, size_t> Serializer::Release() {
+  RecordSerialized();
   auto result = std::make_pair(buffer_, buffer_size_);
   buffer_ = nullptr;
   buffer_size_ = 0;
@@ -56,6 +148,17 @@ std::pair<uint8_t*, size_t> Serializer::Release() {
   return result;
 }
 
+void Serializer::Reset() {
+  RecordSerialized();
+  buffer_size_ = 0;
+}
+
+void Serializer::RecordSerialized() {
+  if (pool_) {
+    pool_->bytes_serialized_.fetch_add(buffer_size_, std::memory_order_relaxed);
+  }
+}
+
 void Serializer::WriteOddball(Oddball oddball) {
   SerializationTag tag;
   switch (oddball) {
@@ -88,55 +191,186 @@ void Serializer::WriteDouble(double value) {
 }
 
 void Serializer::WriteString(const std::string& value) {
+  WriteUtf8String(value.c_str(), value.length());
+}
+
+void Serializer::WriteUtf8String(const char* str, size_t length) {
+  // 第一遍检查是否为 ascii 并计算 utf16 长度，合法的 utf8 直接解码到缓冲区中，不产生临时的 u16string
+  auto bytes = reinterpret_cast<const uint8_t*>(str);
+  size_t u16_length = 0;
   bool one_byte_string = true;
-  const char* c = value.c_str();
-  for (size_t i = 0; i < value.length(); i++) {
-    if (static_cast<unsigned char>(*(c + i)) >= 0x80) {
-      one_byte_string = false;
+  bool well_formed = true;
+  // 按 Unicode 标准 Table 3-7 校验，排除超长编码、编码后的代理项以及超过 U+10FFFF 的码点，
+  // 这些输入交给下面的转码器处理，快速路径只解码合法的序列
+  for (size_t i = 0; i < length && well_formed;) {
+    uint8_t lead = bytes[i];
+    size_t sequence_length = 0;
+    uint8_t second_min = 0x80;
+    uint8_t second_max = 0xBF;
+    if (lead < 0x80) {
+      sequence_length = 1;
+    } else if (lead >= 0xC2 && lead <= 0xDF) {
+      sequence_length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+      sequence_length = 3;
+      if (lead == 0xE0) {
+        second_min = 0xA0;
+      } else if (lead == 0xED) {
+        second_max = 0x9F;
+      }
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+      sequence_length = 4;
+      if (lead == 0xF0) {
+        second_min = 0x90;
+      } else if (lead == 0xF4) {
+        second_max = 0x8F;
+      }
+    }
+    if (sequence_length == 0 || i + sequence_length > length) {
+      well_formed = false;
+      break;
+    }
+    if (sequence_length > 1 && (bytes[i + 1] < second_min || bytes[i + 1] > second_max)) {
+      well_formed = false;
       break;
     }
+    for (size_t j = 2; j < sequence_length; ++j) {
+      if ((bytes[i + j] & 0xC0) != 0x80) {
+        well_formed = false;
+      }
+    }
+    one_byte_string = one_byte_string && sequence_length == 1;
+    u16_length += sequence_length == 4 ? 2 : 1;
+    i += sequence_length;
   }
 
-  if (one_byte_string) {
+  if (one_byte_string && well_formed) {
     WriteTag(SerializationTag::kOneByteString);
-    WriteOneByteString(c, value.length());
-  } else {
+    WriteOneByteString(str, length);
+  } else if (!well_formed) {
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wdeprecated-declarations"
     std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> converter;
-    std::u16string u16 = converter.from_bytes(value);
+    std::u16string u16 = converter.from_bytes(str, str + length);
 #pragma clang diagnostic pop
     WriteTag(SerializationTag::kTwoByteString);
     WriteTwoByteString(u16.c_str(), u16.length());
+  } else {
+    WriteTag(SerializationTag::kTwoByteString);
+    WriteVarint<uint32_t>(footstone::check::checked_numeric_cast<size_t, uint32_t>(u16_length * sizeof(char16_t)));
+    auto dest = ReserveRawBytes(u16_length * sizeof(char16_t));
+    auto write_unit = [&dest](uint32_t unit) {
+      auto u16 = static_cast<char16_t>(unit);
+      memcpy(dest, &u16, sizeof(u16));
+      dest += sizeof(u16);
+    };
+    for (size_t i = 0; i < length;) {
+      uint8_t lead = bytes[i];
+      uint32_t code_point;
+      if (lead < 0x80) {
+        code_point = lead;
+        i += 1;
+      } else if ((lead >> 5) == 0x6) {
+        code_point = ((lead & 0x1Fu) << 6) | (bytes[i + 1] & 0x3Fu);
+        i += 2;
+      } else if ((lead >> 4) == 0xE) {
+        code_point = ((lead & 0x0Fu) << 12) | ((bytes[i + 1] & 0x3Fu) << 6) | (bytes[i + 2] & 0x3Fu);
+        i += 3;
+      } else {
+        code_point = ((lead & 0x07u) << 18) | ((bytes[i + 1] & 0x3Fu) << 12) | ((bytes[i + 2] & 0x3Fu) << 6) |
+            (bytes[i + 3] & 0x3Fu);
+        i += 4;
+      }
+      if (code_point >= 0x10000) {
+        code_point -= 0x10000;
+        write_unit(0xD800 + (code_point >> 10));
+        write_unit(0xDC00 + (code_point & 0x3FF));
+      } else {
+        write_unit(code_point);
+      }
+    }
   }
 }
 
-void Serializer::WriteDenseJSArray(const HippyValue::HippyValueArrayType& hippy_value_array) {
-  uint32_t length = footstone::check::checked_numeric_cast<size_t, uint32_t>(hippy_value_array.size());
+void Serializer::WriteNumber(double value) {
+  // NaN、Inf 或超出 int32 范围的值转换为 int32_t 是未定义行为，需先判断范围再转换
+  if (std::isfinite(value) && value >= std::numeric_limits<int32_t>::min() &&
+      value <= std::numeric_limits<int32_t>::max()) {
+    auto i32 = static_cast<int32_t>(value);
+    if (static_cast<double>(i32) == value && !(i32 == 0 && std::signbit(value))) {
+      WriteInt32(i32);
+      return;
+    }
+  }
+  WriteDouble(value);
+}
 
+void Serializer::WriteString(const footstone::stringview::string_view& value) {
+  using string_view = footstone::stringview::string_view;
+  switch (value.encoding()) {
+    case string_view::Encoding::Latin1: {
+      const auto& str = value.latin1_value();
+      WriteTag(SerializationTag::kOneByteString);
+      WriteOneByteString(str.c_str(), str.length());
+      break;
+    }
+    case string_view::Encoding::Utf16: {
+      const auto& str = value.utf16_value();
+      WriteTag(SerializationTag::kTwoByteString);
+      WriteTwoByteString(str.c_str(), str.length());
+      break;
+    }
+    case string_view::Encoding::Utf8: {
+      const auto& str = value.utf8_value();
+      WriteUtf8String(reinterpret_cast<const char*>(str.c_str()), str.length());
+      break;
+    }
+    default: {
+      auto u16 = footstone::stringview::StringViewUtils::ConvertEncoding(value, string_view::Encoding::Utf16);
+      WriteString(u16);
+      break;
+    }
+  }
+}
+
+void Serializer::WriteBeginJSObject() {
+  WriteTag(SerializationTag::kBeginJSObject);
+}
+
+void Serializer::WriteEndJSObject(uint32_t number_properties) {
+  WriteTag(SerializationTag::kEndJSObject);
+  WriteVarint<uint32_t>(number_properties);
+}
+
+void Serializer::WriteBeginDenseJSArray(uint32_t length) {
   WriteTag(SerializationTag::kBeginDenseJSArray);
   WriteVarint<uint32_t>(length);
-  uint32_t i = 0;
-
-  for (; i < length; i++) {
-    WriteObject(hippy_value_array[i]);
-  }
+}
 
+void Serializer::WriteEndDenseJSArray(uint32_t length) {
   uint32_t properties_written = 0;
   WriteTag(SerializationTag::kEndDenseJSArray);
   WriteVarint<uint32_t>(properties_written);
   WriteVarint<uint32_t>(length);
 }
 
+void Serializer::WriteDenseJSArray(const HippyValue::HippyValueArrayType& hippy_value_array) {
+  uint32_t length = footstone::check::checked_numeric_cast<size_t, uint32_t>(hippy_value_array.size());
+  WriteBeginDenseJSArray(length);
+  for (uint32_t i = 0; i < length; i++) {
+    WriteObject(hippy_value_array[i]);
+  }
+  WriteEndDenseJSArray(length);
+}
+
 void Serializer::WriteJSObject(const HippyValue::HippyValueObjectType& hippy_value_object) {
   uint32_t length = footstone::check::checked_numeric_cast<size_t, uint32_t>(hippy_value_object.size());
-  WriteTag(SerializationTag::kBeginJSObject);
+  WriteBeginJSObject();
   for (const auto& it: hippy_value_object) {
     WriteString(it.first);
     WriteObject(it.second);
   }
-  WriteTag(SerializationTag::kEndJSObject);
-  WriteVarint<uint32_t>(length);
+  WriteEndJSObject(length);
 }
 
 void Serializer::WriteTag(SerializationTag tag) {
@@ -259,6 +493,18 @@ uint8_t* Serializer::ReserveRawBytes(size_t bytes) {
 }
 
 void Serializer::ExpandBuffer(size_t required_capacity) {
+  if (pool_) {
+    auto buffer = pool_->Acquire(std::max(required_capacity, buffer_capacity_ * 2));
+    FOOTSTONE_DCHECK(buffer.first != nullptr);
+    if (buffer_) {
+      memcpy(buffer.first, buffer_, buffer_size_);
+      pool_->Recycle(buffer_, buffer_capacity_);
+      pool_->reallocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+    buffer_ = buffer.first;
+    buffer_capacity_ = buffer.second;
+    return;
+  }
   size_t requested_capacity = std::max(required_capacity, buffer_capacity_ * 2) + 64;
   void* new_buffer = nullptr;
   new_buffer = realloc(buffer_, requested_capacity);
@@ -31,7 +31,7 @@ std::atomic<uint32_t> Task::g_next_task_id = 1;
 
 Task::Task() : Task(nullptr) {}
 
-Task::Task(std::function<void()> exec_unit) : unit_(std::move(exec_unit)) {
+Task::Task(Unit exec_unit) : unit_(std::move(exec_unit)) {
   id_ = g_next_task_id.fetch_add(1);
 }
 
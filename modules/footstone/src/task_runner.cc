@@ -40,7 +40,8 @@ TaskRunner::TaskRunner(uint32_t group_id, uint32_t priority, bool is_schedulable
       priority_(priority),
       group_id_(group_id),
       time_(TimeDelta::Zero()),
-      is_schedulable_(is_schedulable) {
+      is_schedulable_(is_schedulable),
+      is_steal_safe_(false) {
   id_ = global_task_runner_id.fetch_add(1);
 }
 
@@ -48,7 +49,7 @@ TaskRunner::TaskRunner(std::string name): TaskRunner(
     kDefaultGroupId, kDefaultPriority, true, std::move(name)) {}
 
 TaskRunner::~TaskRunner() {
-  std::shared_ptr<Worker> worker = worker_.lock();
+  std::shared_ptr<Worker> worker = LockWorker();
   if (worker) {
     worker->WorkerDestroySpecific(id_);
   }
@@ -57,9 +58,7 @@ TaskRunner::~TaskRunner() {
 void TaskRunner::Clear() {
   {
     std::lock_guard<std::mutex> lock(queue_mutex_);
-    while (!task_queue_.empty()) {
-      task_queue_.pop();
-    }
+    task_queue_.Clear();
   }
   {
     std::lock_guard<std::mutex> lock(delay_mutex_);
@@ -77,11 +76,11 @@ void TaskRunner::Clear() {
 
 bool TaskRunner::AddSubTaskRunner(const std::shared_ptr<TaskRunner>& sub_runner,
                                   bool is_task_running) {
-  std::shared_ptr<Worker> worker = worker_.lock();
+  std::shared_ptr<Worker> worker = LockWorker();
   if (!worker) {
     return false;
   }
-  sub_runner->SetWorker(worker_);
+  sub_runner->SetWorker(worker);
   worker->BindGroup(id_, sub_runner);
   has_sub_runner_ = true;
   if (is_task_running) {
@@ -97,7 +96,7 @@ bool TaskRunner::RemoveSubTaskRunner(const std::shared_ptr<TaskRunner>& sub_runn
   if (!has_sub_runner_ || !sub_runner) {
     return false;
   }
-  std::shared_ptr<Worker> worker = worker_.lock();
+  std::shared_ptr<Worker> worker = LockWorker();
   if (!worker) {
     return false;
   }
@@ -108,10 +107,7 @@ bool TaskRunner::RemoveSubTaskRunner(const std::shared_ptr<TaskRunner>& sub_runn
 }
 
 void TaskRunner::PostTask(std::unique_ptr<Task> task) {
-  {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    task_queue_.push(std::move(task));
-  }
+  task_queue_.Push(std::move(task));
   NotifyWorker();
 }
 
@@ -136,13 +132,7 @@ void TaskRunner::PostIdleTask(std::unique_ptr<IdleTask> task) {
 std::unique_ptr<Task> TaskRunner::PopTask() {
   std::lock_guard<std::mutex> lock(queue_mutex_);
 
-  if (!task_queue_.empty()) {
-    std::unique_ptr<Task> result = std::move(task_queue_.front());
-    task_queue_.pop();
-    return result;
-  }
-
-  return nullptr;
+  return task_queue_.Pop();
 }
 
 std::unique_ptr<IdleTask> TaskRunner::PopIdleTask() {
@@ -158,9 +148,9 @@ std::unique_ptr<IdleTask> TaskRunner::PopIdleTask() {
 }
 
 std::unique_ptr<Task> TaskRunner::GetTopDelayTask() {
-  std::lock_guard<std::mutex> lock(delay_mutex_);
+  std::scoped_lock lock(queue_mutex_, delay_mutex_);
 
-  if (task_queue_.empty() && !delayed_task_queue_.empty()) {
+  if (task_queue_.IsEmpty() && !delayed_task_queue_.empty()) {
     std::unique_ptr<Task> result =
         std::move(const_cast<DelayedEntry&>(delayed_task_queue_.top()).second);
     return result;
@@ -172,21 +162,24 @@ std::unique_ptr<Task> TaskRunner::GetNext() {
   TimePoint now = TimePoint::Now();
   std::unique_ptr<Task> task = popTaskFromDelayedQueueNoLock(now);
   {
-    std::scoped_lock lock(queue_mutex_, delay_mutex_);
+    std::lock_guard<std::mutex> lock(delay_mutex_);
     while (task) {
-      task_queue_.push(std::move(task));
+      task_queue_.Push(std::move(task));
       task = popTaskFromDelayedQueueNoLock(now);
     }
   }
+  std::lock_guard<std::mutex> lock(queue_mutex_);
+  return task_queue_.Pop();
+}
+
+bool TaskRunner::HasPendingTask() {
   {
     std::lock_guard<std::mutex> lock(queue_mutex_);
-    if (!task_queue_.empty()) {
-      auto result = std::move(task_queue_.front());
-      task_queue_.pop();
-      return result;
+    if (!task_queue_.IsEmpty()) {
+      return true;
     }
   }
-  return nullptr;
+  return GetNextTimeDelta(TimePoint::Now()) <= TimeDelta::Zero();
 }
 
 TimeDelta TaskRunner::GetNextTimeDelta(TimePoint now) {
@@ -200,13 +193,27 @@ TimeDelta TaskRunner::GetNextTimeDelta(TimePoint now) {
 }
 
 void TaskRunner::NotifyWorker() {
-  auto worker = worker_.lock();
+  auto worker = LockWorker();
   if (!worker) {
     return;
   }
   worker->Notify();
 }
 
+void TaskRunner::OnUncaughtException(const std::exception_ptr& exception) {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+  try {
+    std::rethrow_exception(exception);
+  } catch (const std::exception& e) {
+    FOOTSTONE_LOG(ERROR) << "task uncaught exception, what = " << e.what();
+  } catch (...) {
+    FOOTSTONE_LOG(ERROR) << "task uncaught exception";
+  }
+#else
+  FOOTSTONE_USE(exception);
+#endif
+}
+
 std::unique_ptr<Task> TaskRunner::popTaskFromDelayedQueueNoLock(TimePoint now) {
   if (delayed_task_queue_.empty()) {
     return nullptr;
@@ -229,7 +236,7 @@ std::shared_ptr<TaskRunner> TaskRunner::GetCurrentTaskRunner() {
 int32_t TaskRunner::RunnerKeyCreate(const std::function<void(void*)>& destruct) {
   FOOTSTONE_CHECK(Worker::IsTaskRunning()) << "RunnerKeyCreate cannot be run outside of the task";
   auto task_runner_id = Worker::GetCurrentTaskRunner()->GetId();
-  std::shared_ptr<Worker> worker = worker_.lock();
+  std::shared_ptr<Worker> worker = LockWorker();
   FOOTSTONE_CHECK(worker); // task在运行，理论worker应该还在
   return worker->WorkerKeyCreate(task_runner_id, destruct);
 }
@@ -237,7 +244,7 @@ int32_t TaskRunner::RunnerKeyCreate(const std::function<void(void*)>& destruct)
 bool TaskRunner::RunnerKeyDelete(int32_t key) {
   FOOTSTONE_CHECK(Worker::IsTaskRunning()) << "RunnerKeyDelete cannot be run outside of the task";
   auto task_runner_id = Worker::GetCurrentTaskRunner()->GetId();
-  std::shared_ptr<Worker> worker = worker_.lock();
+  std::shared_ptr<Worker> worker = LockWorker();
   FOOTSTONE_CHECK(worker);
   return worker->WorkerKeyDelete(task_runner_id, key);
 }
@@ -245,7 +252,7 @@ bool TaskRunner::RunnerKeyDelete(int32_t key) {
 bool TaskRunner::RunnerSetSpecific(int32_t key, void* p) {
   FOOTSTONE_CHECK(Worker::IsTaskRunning()) << "RunnerSetSpecific cannot be run outside of the task";
   auto task_runner_id = Worker::GetCurrentTaskRunner()->GetId();
-  std::shared_ptr<Worker> worker = worker_.lock();
+  std::shared_ptr<Worker> worker = LockWorker();
   FOOTSTONE_CHECK(worker);
   return worker->WorkerSetSpecific(task_runner_id, key, p);
 }
@@ -253,7 +260,7 @@ bool TaskRunner::RunnerSetSpecific(int32_t key, void* p) {
 void* TaskRunner::RunnerGetSpecific(int32_t key) {
   FOOTSTONE_CHECK(Worker::IsTaskRunning()) << "RunnerGetSpecific cannot be run outside of the task";
   auto task_runner_id = Worker::GetCurrentTaskRunner()->GetId();
-  std::shared_ptr<Worker> worker = worker_.lock();
+  std::shared_ptr<Worker> worker = LockWorker();
   FOOTSTONE_CHECK(worker);
   return worker->WorkerGetSpecific(task_runner_id, key);
 }
@@ -261,7 +268,7 @@ void* TaskRunner::RunnerGetSpecific(int32_t key) {
 void TaskRunner::RunnerDestroySpecifics() {
   FOOTSTONE_CHECK(Worker::IsTaskRunning()) << "RunnerDestroySpecifics cannot be run outside of the task";
   auto task_runner_id = Worker::GetCurrentTaskRunner()->GetId();
-  std::shared_ptr<Worker> worker = worker_.lock();
+  std::shared_ptr<Worker> worker = LockWorker();
   FOOTSTONE_CHECK(worker);
   return worker->WorkerDestroySpecific(task_runner_id);
 }
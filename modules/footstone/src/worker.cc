@@ -56,7 +56,10 @@ Worker::Worker(std::string name, bool is_schedulable, std::unique_ptr<Driver> dr
       has_migration_data_(false),
       is_schedulable_(is_schedulable),
       group_id_(0),
-      driver_(std::move(driver)) {
+      driver_(std::move(driver)),
+      manager_(nullptr),
+      is_busy_(false),
+      is_waiting_(false) {
 }
 
 Worker::~Worker() {
@@ -110,7 +113,9 @@ bool Worker::RunTask() {
   }
   TimePoint begin = TimePoint::Now();
   is_task_running = true;
+  is_busy_ = true;
   task->Run();
+  is_busy_ = false;
   is_task_running = false;
   for (auto &it : curr_group) {
     it->AddTime(TimePoint::Now() - begin);
@@ -153,6 +158,27 @@ void Worker::SortNoLock() { // sort后优先级越高的TaskRunner分组距离
 
 void Worker::Notify() {
   driver_->Notify();
+  // 正在运行task时新任务只能排队，窃取模式下唤醒空闲Worker来分担
+  if (is_busy_) {
+    NotifyIdleWorker();
+  }
+}
+
+void Worker::SetManager(WorkerManager* manager) {
+  std::lock_guard<std::mutex> lock(manager_mutex_);
+  manager_ = manager;
+}
+
+void Worker::NotifyIdleWorker() {
+  // 未设置 manager 时不加锁，避免 PostTask 的开销
+  if (!manager_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(manager_mutex_);
+  auto manager = manager_.load();
+  if (manager) {
+    manager->NotifyIdleWorker(this);
+  }
 }
 
 void Worker::Terminate() {
@@ -325,24 +351,129 @@ std::list<std::vector<std::shared_ptr<TaskRunner>>> Worker::Retain(
   return ret;
 }
 
-void Worker::AddImmediateTask(std::unique_ptr<Task> task) {
+std::unique_ptr<Task> Worker::StealTask() {
+  if (!manager_.load(std::memory_order_relaxed) || !is_schedulable_ || is_stacking_mode_) {
+    return nullptr;
+  }
+  auto self = GetSelf().lock();
+  if (!self) {
+    return nullptr;
+  }
+  std::shared_ptr<TaskRunner> runner;
+  std::unique_ptr<Task> task;
+  {
+    // Steal 对 WorkerManager 的锁只会 try_lock，持有 manager_mutex_ 期间不会等待其他 Worker 的 manager_mutex_
+    std::lock_guard<std::mutex> lock(manager_mutex_);
+    auto manager = manager_.load();
+    if (!manager) {
+      return nullptr;
+    }
+    task = manager->Steal(self, runner);
+  }
+  if (task) {
+    // 窃取的task不计入任何分组的运行时间，避免与原Worker并发修改TaskRunner的time_
+    curr_group.clear();
+    local_runner = runner;
+  }
+  return task;
+}
+
+std::unique_ptr<Task> Worker::PopStealSafeTask(std::shared_ptr<TaskRunner>& runner) {
   std::lock_guard<std::mutex> lock(running_mutex_);
+  for (auto &group : running_group_list_) {
+    auto &top = group.back(); // 与GetNextTask一致，只有group栈顶的TaskRunner可以运行
+    if (!top->IsStealSafe()) {
+      continue;
+    }
+    auto task = top->PopTask();
+    if (task) {
+      runner = top;
+      return task;
+    }
+  }
+  return nullptr;
+}
 
-  immediate_task_queue_.push(std::move(task));
+void Worker::RequestDonation(const std::shared_ptr<Worker>& thief) {
+  std::lock_guard<std::mutex> lock(running_mutex_);
+  for (const auto &target : donation_targets_) {
+    if (target.lock() == thief) {
+      return;
+    }
+  }
+  donation_targets_.push_back(thief);
 }
 
-template <class F>
-auto MakeCopyable(F&& f) {
-  auto s = std::make_shared<std::decay_t<F>>(std::forward<F>(f));
-  return [s](auto&&... args) -> decltype(auto) {
-    return (*s)(decltype(args)(args)...);
-  };
+uint32_t Worker::GetPendingGroupSize() {
+  std::lock_guard<std::mutex> lock(running_mutex_);
+  return GetPendingGroupSizeNoLock();
+}
+
+uint32_t Worker::GetPendingGroupSizeNoLock() { // 有待执行task的分组数量
+  uint32_t size = 0;
+  for (const auto &group : running_group_list_) {
+    if (group.back()->HasPendingTask()) {
+      ++size;
+    }
+  }
+  return size;
+}
+
+std::vector<std::shared_ptr<TaskRunner>> Worker::DetachDonatableGroupNoLock() {
+  // 至少保留一个有待执行task的分组，避免分组在Worker之间来回迁移
+  if (GetPendingGroupSizeNoLock() < 2) {
+    return {};
+  }
+  // 从优先级最低的分组开始查找，其在当前Worker上等待的时间最长
+  for (auto it = running_group_list_.rbegin(); it != running_group_list_.rend(); ++it) {
+    if (it->size() != 1) { // 含有子TaskRunner的分组不迁移
+      continue;
+    }
+    const auto &runner = it->front();
+    if (!runner->IsSchedulable() || runner->GetGroupId() != kDefaultGroupId || !runner->HasPendingTask()) {
+      continue;
+    }
+    auto group = std::move(*it);
+    running_group_list_.erase(std::next(it).base());
+    return group;
+  }
+  return {};
+}
+
+void Worker::DonateGroup(const std::shared_ptr<Worker>& thief, std::vector<std::shared_ptr<TaskRunner>> group) {
+  // 当前处于两个task之间，WorkerKey可以直接在本线程取出，再通过立即任务在目标线程写入，
+  // 立即任务先于分组加入目标Worker，保证迁移后的task运行时specific已经就绪
+  std::weak_ptr<Worker> weak_thief = thief;
+  for (auto &runner : group) {
+    auto id = runner->GetId();
+    thief->AddImmediateTask(std::make_unique<Task>(
+        [id, weak_thief,
+            moved_specific_keys = GetMovedSpecificKeys(id),
+            moved_specific = GetMovedSpecific(id)] {
+          auto thief = weak_thief.lock();
+          if (thief) {
+            thief->UpdateSpecificKeys(id, moved_specific_keys);
+            thief->UpdateSpecific(id, moved_specific);
+          }
+        }));
+    runner->SetWorker(thief);
+  }
+  thief->is_waiting_ = false; // 目标Worker即将被Bind唤醒，不再作为空闲Worker
+  thief->Bind(std::move(group));
+}
+
+void Worker::AddImmediateTask(std::unique_ptr<Task> task) {
+  std::lock_guard<std::mutex> lock(running_mutex_);
+
+  immediate_task_queue_.push(std::move(task));
 }
 
 std::unique_ptr<Task> Worker::GetNextTask() {
   if (driver_->IsExitImmediately()) {
     return nullptr;
   }
+  std::vector<std::pair<std::shared_ptr<Worker>, std::vector<std::shared_ptr<TaskRunner>>>> donations;
+  bool has_pending_group = false;
   {
     std::lock_guard<std::mutex> lock(running_mutex_);
     if (!immediate_task_queue_.empty()) {
@@ -350,23 +481,43 @@ std::unique_ptr<Task> Worker::GetNextTask() {
       immediate_task_queue_.pop();
       return task;
     }
+    // 立即任务（含WorkerKey迁移）处理完后才响应窃取请求，stacking模式下当前仍处于task之中，不能让出分组
+    if (!donation_targets_.empty() && !is_stacking_mode_) {
+      for (const auto &target : donation_targets_) {
+        auto thief = target.lock();
+        if (!thief) {
+          continue;
+        }
+        auto group = DetachDonatableGroupNoLock();
+        if (group.empty()) {
+          break;
+        }
+        donations.emplace_back(std::move(thief), std::move(group));
+      }
+      has_pending_group = !donations.empty() && GetPendingGroupSizeNoLock() > 1;
+    }
+    donation_targets_.clear();
     if (running_group_list_.size() > 1) {
       SortNoLock();
     }
   }
+  for (auto &[thief, group] : donations) {
+    DonateGroup(thief, std::move(group));
+  }
+  if (has_pending_group) { // 仍有排队的分组，唤醒其他空闲Worker继续窃取
+    NotifyIdleWorker();
+  }
 
-  if (need_balance_) {
-    {
-      std::scoped_lock lock(running_mutex_, pending_mutex_);
-      BalanceNoLock();
-    }
-    need_balance_ = false;
+  // 先清除标记再合并分组，合并期间其他线程 Bind 进来的分组会重新置位，不会丢失
+  if (need_balance_.exchange(false)) {
+    std::scoped_lock lock(running_mutex_, pending_mutex_);
+    BalanceNoLock();
   }
 
   TimeDelta last_wait_time;
   min_wait_time_ = TimeDelta::Max();
   TimePoint now = TimePoint::Now();
-  std::unique_ptr<IdleTask> idle_task;
+  bool has_pending_task = false;
   for (auto &running_group : running_group_list_) {
     auto runner = running_group.back(); // group栈顶会阻塞下面的taskRunner执行
     auto task = runner->GetNext();
@@ -374,23 +525,34 @@ std::unique_ptr<Task> Worker::GetNextTask() {
       curr_group = running_group; // curr_group只会在当前线程获取，因此不需要加锁
       local_runner = runner;
       return task;
-    } else {
-      if (!idle_task) {
-        idle_task = running_group.front()->PopIdleTask();
-      }
-      last_wait_time = running_group.front()->GetNextTimeDelta(now);
-      if (min_wait_time_ > last_wait_time) {
-        min_wait_time_ = last_wait_time;
-        next_task_time_ = now + min_wait_time_;
-      }
+    }
+    // 生产者入队未完成时 GetNext 同样返回空，此时队列并不为空
+    if (!has_pending_task && runner->HasPendingTask()) {
+      has_pending_task = true;
+    }
+    last_wait_time = running_group.front()->GetNextTimeDelta(now);
+    if (min_wait_time_ > last_wait_time) {
+      min_wait_time_ = last_wait_time;
+      next_task_time_ = now + min_wait_time_;
+    }
+  }
+  if (has_pending_task) { // 不执行空闲任务也不休眠，立即重新调度
+    driver_->WaitFor(TimeDelta::Zero());
+    return nullptr;
+  }
+  std::unique_ptr<IdleTask> idle_task;
+  for (auto &running_group : running_group_list_) {
+    idle_task = running_group.front()->PopIdleTask();
+    if (idle_task) {
+      break;
     }
   }
   if (idle_task) {
     auto wrapper_idle_task = std::make_unique<Task>(
-        MakeCopyable([begin_time = idle_task->GetBeginTime(),
-                      timeout = idle_task->GetTimeout(),
-                      task = std::move(idle_task),
-                      time = min_wait_time_]() {
+        [begin_time = idle_task->GetBeginTime(),
+            timeout = idle_task->GetTimeout(),
+            task = std::move(idle_task),
+            time = min_wait_time_]() {
           auto now = TimePoint::Now();
           bool did_time_out = now - begin_time > timeout;
           IdleTask::IdleCbParam param = {
@@ -398,13 +560,22 @@ std::unique_ptr<Task> Worker::GetNextTask() {
               .res_time = time
           };
           task->Run(param);
-        }));
+        });
     return wrapper_idle_task;
   }
+  if (need_balance_) { // 查找期间有新的分组加入（如窃取到的分组），直接重新调度
+    return nullptr;
+  }
+  auto stolen_task = StealTask();
+  if (stolen_task) {
+    return stolen_task;
+  }
   if (driver_->IsTerminated()) {
     return nullptr;
   }
+  is_waiting_ = true;
   driver_->WaitFor(min_wait_time_);
+  is_waiting_ = false;
   return nullptr;
 }
 
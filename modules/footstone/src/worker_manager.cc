@@ -31,9 +31,15 @@
 namespace footstone {
 inline namespace runner {
 
-WorkerManager::WorkerManager(uint32_t size) : index_(0), size_(size) { CreateWorkers(size); }
+WorkerManager::WorkerManager(uint32_t size) : index_(0), size_(size), is_work_stealing_enabled_(false) {
+  CreateWorkers(size);
+}
 
-WorkerManager::~WorkerManager() = default;
+WorkerManager::~WorkerManager() {
+  for (auto &worker : workers_) {
+    worker->SetManager(nullptr);
+  }
+}
 
 void WorkerManager::Terminate() {
   for (auto &worker : workers_) {
@@ -45,6 +51,9 @@ void WorkerManager::CreateWorkers(uint32_t size) {
   std::shared_ptr<Worker> worker;
   for (uint32_t i = 0; i < size; ++i) {
     worker = std::make_shared<WorkerImpl>();
+    if (is_work_stealing_enabled_) {
+      worker->SetManager(this);
+    }
     worker->Start();
     workers_.push_back(worker);
   }
@@ -94,6 +103,9 @@ void WorkerManager::Resize(uint32_t size) {
 }
 
 void WorkerManager::AddWorker(const std::shared_ptr<Worker>& worker) {
+  if (is_work_stealing_enabled_) {
+    worker->SetManager(this);
+  }
   workers_.push_back(worker);
   Balance(1);
 }
@@ -135,7 +147,7 @@ void WorkerManager::Balance(int32_t increase_worker_count) {
       for (auto &item : list) {
         for (auto &runner: item) {
           auto id = runner->GetId();
-          auto orig_worker = runner->worker_.lock();
+          auto orig_worker = runner->LockWorker();
           FOOTSTONE_CHECK(orig_worker);
           WorkerManager::MoveTaskRunnerSpecificNoLock(id, orig_worker, worker);
         }
@@ -180,12 +192,12 @@ void WorkerManager::Balance(int32_t increase_worker_count) {
       for (auto &vec_it : group) {
         const auto &runner = vec_it;
         auto id = runner->GetId();
-        auto orig_worker = runner->worker_.lock();
+        auto orig_worker = runner->LockWorker();
         if (orig_worker) {
           new_worker->UpdateSpecificKeys(id, orig_worker->GetMovedSpecificKeys(id));
           new_worker->UpdateSpecific(id, orig_worker->GetMovedSpecific(id));
         }
-        runner->worker_ = new_worker;
+        runner->SetWorker(new_worker);
       }
       index_ = (index_ == size - 1) ? 0 : (1 + index_);
       ++it;
@@ -225,7 +237,7 @@ void WorkerManager::Balance(int32_t increase_worker_count) {
       for (auto &item : list) {
         for (auto &runner: item) {
           auto id = runner->GetId();
-          auto orig_worker = runner->worker_.lock();
+          auto orig_worker = runner->LockWorker();
           FOOTSTONE_CHECK(orig_worker);
           WorkerManager::MoveTaskRunnerSpecificNoLock(id, orig_worker, worker);
         }
@@ -239,6 +251,65 @@ void WorkerManager::Balance(int32_t increase_worker_count) {
   }
 }
 
+// 只在窃取模式下为 Worker 设置 manager，默认模式的 PostTask 不会进入 WorkerManager
+void WorkerManager::SetWorkStealingEnabled(bool enabled) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  is_work_stealing_enabled_ = enabled;
+  for (auto &worker : workers_) {
+    worker->SetManager(enabled ? this : nullptr);
+  }
+}
+
+std::unique_ptr<Task> WorkerManager::Steal(const std::shared_ptr<Worker>& thief,
+                                           std::shared_ptr<TaskRunner>& runner) {
+  if (!is_work_stealing_enabled_) {
+    return nullptr;
+  }
+  // Resize持锁时会等待Worker线程退出，这里不能阻塞
+  std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    return nullptr;
+  }
+  std::shared_ptr<Worker> victim;
+  uint32_t max_group_size = 1;
+  for (auto &worker : workers_) {
+    if (worker == thief || !worker->is_schedulable_ || !worker->is_busy_) {
+      continue;
+    }
+    auto task = worker->PopStealSafeTask(runner);
+    if (task) {
+      return task;
+    }
+    // 忙碌且有其他分组在排队的Worker中，选择排队分组最多的让出分组
+    auto group_size = worker->GetPendingGroupSize();
+    if (group_size > max_group_size) {
+      max_group_size = group_size;
+      victim = worker;
+    }
+  }
+  if (victim) {
+    victim->RequestDonation(thief);
+  }
+  return nullptr;
+}
+
+void WorkerManager::NotifyIdleWorker(const Worker* busy_worker) {
+  if (!is_work_stealing_enabled_) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    return;
+  }
+  for (auto &worker : workers_) {
+    // 被唤醒的Worker清除等待标记，避免连续唤醒同一个Worker
+    if (worker.get() != busy_worker && worker->is_schedulable_ && worker->is_waiting_.exchange(false)) {
+      worker->driver_->Notify();
+      return;
+    }
+  }
+}
+
 std::shared_ptr<TaskRunner> WorkerManager::CreateTaskRunner(const std::string& name) {
   return CreateTaskRunner(kDefaultGroupId, kDefaultPriority, true, name);
 }
@@ -252,7 +323,7 @@ std::shared_ptr<TaskRunner> WorkerManager::CreateTaskRunner(uint32_t group_id,
     if (group_id != kDefaultGroupId) {
       for (const auto &worker: workers_) {
         if (worker->GetGroupId() == group_id) {
-          task_runner->worker_ = worker;
+          task_runner->SetWorker(worker);
           worker->Bind(std::vector<std::shared_ptr<TaskRunner>>{task_runner});
           return task_runner;
         }
@@ -263,7 +334,7 @@ std::shared_ptr<TaskRunner> WorkerManager::CreateTaskRunner(uint32_t group_id,
         worker = workers_[static_cast<size_t>(index_)];
         index_ = (index_ == static_cast<int32_t>(size_ - 1)) ? 0 : (1 + index_);
       }
-      task_runner->worker_ = worker;
+      task_runner->SetWorker(worker);
       worker->Bind(std::vector<std::shared_ptr<TaskRunner>>{task_runner});
     } else {
       AddTaskRunner(task_runner);
@@ -285,7 +356,7 @@ void WorkerManager::AddTaskRunner(std::shared_ptr<TaskRunner> runner) {
   std::lock_guard<std::mutex> lock(mutex_);
   auto worker = workers_[static_cast<size_t>(index_)];
   for (auto &r : group) {
-    r->worker_ = worker;
+    r->SetWorker(worker);
   }
   worker->Bind(group);
   UpdateWorkerSpecific(worker, group);
@@ -295,7 +366,7 @@ void WorkerManager::AddTaskRunner(std::shared_ptr<TaskRunner> runner) {
 void WorkerManager::UpdateWorkerSpecific(const std::shared_ptr<Worker> &worker,
                                          const std::vector<std::shared_ptr<TaskRunner>> &group) {
   for (auto &it : group) {
-    it->worker_ = worker;
+    it->SetWorker(worker);
     std::array<Worker::WorkerKey, Worker::kWorkerKeysMax> keys_array;
     worker->UpdateSpecificKeys(it->GetId(), std::move(keys_array));
     std::array<void *, Worker::kWorkerKeysMax> specific_array{};
@@ -31,6 +31,7 @@ namespace hippy {
 inline namespace dom {
 struct LayoutResult;
 class DomNode;
+class DomValueMap;
 };
 };
 
@@ -46,4 +47,6 @@ HIPPY_EXTERN CGRect CGRectMakeFromDomNode(const std::shared_ptr<hippy::DomNode>
 
 HIPPY_EXTERN NSDictionary *StylesFromDomNode(const std::shared_ptr<hippy::DomNode> &domNode);
 
+HIPPY_EXTERN NSDictionary *DomValueMapToDictionary(const std::shared_ptr<const hippy::DomValueMap> &domValueMap);
+
 NS_ASSUME_NONNULL_END
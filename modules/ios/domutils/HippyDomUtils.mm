@@ -27,6 +27,7 @@
 
 #include "dom/dom_listener.h"
 #include "dom/dom_node.h"
+#include "dom/dom_value_map.h"
 #include "footstone/hippy_value.h"
 
 CGRect CGRectMakeFromLayoutResult(hippy::LayoutResult result) {
@@ -58,12 +59,22 @@ NSDictionary *StylesFromDomNode(const std::shared_ptr<hippy::DomNode> &domNode)
     }
     NSMutableDictionary *allStyles = [NSMutableDictionary dictionaryWithCapacity:capacity];
     if (styles) {
-      NSDictionary *dicStyles  = UnorderedMapDomValueToDictionary(styles);
+      NSDictionary *dicStyles  = DomValueMapToDictionary(styles);
       [allStyles addEntriesFromDictionary:dicStyles];
     }
     if (extStyles) {
-      NSDictionary *dicExtStyles = UnorderedMapDomValueToDictionary(extStyles);
+      NSDictionary *dicExtStyles = DomValueMapToDictionary(extStyles);
       [allStyles addEntriesFromDictionary:dicExtStyles];
     }
     return [allStyles copy];
 }
+
+NSDictionary *DomValueMapToDictionary(const std::shared_ptr<const hippy::DomValueMap> &domValueMap) {
+    NSMutableDictionary *dic = [NSMutableDictionary dictionaryWithCapacity:domValueMap->size()];
+    for (auto it = domValueMap->begin(); it != domValueMap->end(); it++) {
+        NSString *key = [NSString stringWithUTF8String:it->first.c_str()];
+        id value = DomValueToOCType(it->second.get());
+        [dic setObject:value forKey:key];
+    }
+    return [dic copy];
+}
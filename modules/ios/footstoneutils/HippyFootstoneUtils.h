@@ -52,7 +52,7 @@ extern footstone::value::HippyValue OCTypeToDomValue(id value);
 //footstone::hippyValue
 HIPPY_EXTERN id DomValueToOCType(const footstone::value::HippyValue *const pDomValue);
 
-HIPPY_EXTERN NSDictionary *UnorderedMapDomValueToDictionary(const std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>>> &domValuesObject);
+HIPPY_EXTERN NSDictionary *UnorderedMapDomValueToDictionary(const std::shared_ptr<const std::unordered_map<std::string, std::shared_ptr<footstone::value::HippyValue>>> &domValuesObject);
 
 HIPPY_EXTERN NSNumber *DomValueToNumber(const footstone::value::HippyValue *const pDomValue);
 
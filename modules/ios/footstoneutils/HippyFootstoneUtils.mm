@@ -135,7 +135,7 @@ id DomValueToOCType(const HippyValue *const pDomValue) {
     return value;
 }
 
-NSDictionary *UnorderedMapDomValueToDictionary(const std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<HippyValue>>> &domValuesObject) {
+NSDictionary *UnorderedMapDomValueToDictionary(const std::shared_ptr<const std::unordered_map<std::string, std::shared_ptr<HippyValue>>> &domValuesObject) {
     NSMutableDictionary *dic = [NSMutableDictionary dictionaryWithCapacity:domValuesObject->size()];
     for (auto it = domValuesObject->begin(); it != domValuesObject->end(); it++) {
         NSString *key = [NSString stringWithUTF8String:it->first.c_str()];
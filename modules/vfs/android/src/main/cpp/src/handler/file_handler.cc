@@ -69,6 +69,14 @@ void FileHandler::RequestUntrustedContent(
   LoadByFile(path, request, new_cb, next);
 }
 
+FileHandler::string_view FileHandler::GetPlainFilePath(const string_view& uri) {
+  auto path = Uri::Create(uri)->GetPath();
+  if (path.encoding() == string_view::Encoding::Unknown) {
+    return {};
+  }
+  return path;
+}
+
 void FileHandler::LoadByFile(
     const string_view& path,
     std::shared_ptr<RequestJob> request,
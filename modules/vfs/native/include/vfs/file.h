@@ -28,6 +28,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "footstone/logging.h"
@@ -89,5 +90,52 @@ class HippyFile {
   }
 };
 
+/**
+ * 只读映射整个文件，析构时解除映射。用于较大的本地 bundle，避免把文件内容整体读入堆内存
+ *
+ * 映射期间文件被原地截断或改写时，访问映射会得到新内容甚至触发 SIGBUS，而 V8 外部字符串在脚本整个生命周期内
+ * 都会按需读取映射。因此 bundle 只能通过写入新文件后 rename 覆盖的方式替换，旧的 inode 在映射解除前保持不变：
+ * 1. Open 只映射无法被原地改写的文件：位于只读挂载上，或不带任何写权限位（热更新落盘后 chmod 0444 再 rename）；
+ *    其余文件返回 nullptr，调用方应改为拷贝读取
+ * 2. 使用方在交出映射前仍应调用 IsModified 检查，发生变化时改为拷贝读取
+ */
+class MappedFile {
+ public:
+  using string_view = footstone::stringview::string_view;
+
+  struct Identity {
+    uint64_t device;
+    uint64_t inode;
+    uint64_t size;
+    int64_t modify_time_ns;
+
+    bool operator==(const Identity& other) const {
+      return device == other.device && inode == other.inode && size == other.size
+          && modify_time_ns == other.modify_time_ns;
+    }
+  };
+
+  static std::shared_ptr<MappedFile> Open(const string_view& file_path);
+
+  MappedFile(void* data, size_t size, std::string path, Identity identity)
+      : data_(data), size_(size), path_(std::move(path)), identity_(identity) {}
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* data() const { return reinterpret_cast<const char*>(data_); }
+  size_t size() const { return size_; }
+  /**
+   * 路径当前指向的文件与映射时不同（被替换、截断或改写）时返回 true
+   */
+  bool IsModified() const;
+
+ private:
+  void* data_;
+  size_t size_;
+  std::string path_;
+  Identity identity_;
+};
+
 } // namespace vfs
 } // namespace hippy
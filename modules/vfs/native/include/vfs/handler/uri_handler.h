@@ -49,6 +49,12 @@ class UriHandler {
       std::shared_ptr<RequestJob> request,
       std::function<void(std::shared_ptr<JobResponse>)> cb,
       std::function<std::shared_ptr<UriHandler>()> next) = 0;
+
+  /**
+   * 返回 uri 对应的本地文件路径。只有 handler 原样读取该文件、不对内容或路径做任何处理（解密、重定向等）时
+   * 才应返回非空，调用方据此可以绕过处理链直接映射文件
+   */
+  virtual string_view GetPlainFilePath(const string_view& uri) { return {}; }
 };
 
 }
@@ -25,6 +25,7 @@
 #include "footstone/worker_manager.h"
 #include "vfs/request_job.h"
 #include "vfs/job_response.h"
+#include "vfs/file.h"
 
 #include <list>
 #include <mutex>
@@ -69,6 +70,13 @@ class UriLoader: public std::enable_shared_from_this<UriLoader> {
   virtual void RequestUntrustedContent(const std::shared_ptr<RequestJob>& request, std::shared_ptr<JobResponse> response);
   virtual void RequestUntrustedContent(const std::shared_ptr<RequestJob>& request, const std::function<void(std::shared_ptr<JobResponse>)>& cb);
 
+  /**
+   * 处理链只有一个原样读取本地文件的 handler（见 UriHandler::GetPlainFilePath）时直接映射该文件，
+   * 否则返回 nullptr，调用方应改用 RequestUntrustedContent，以保证注册的解密、重定向、拦截等 handler 生效。
+   * 文件可能被原地改写时同样返回 nullptr，见 MappedFile
+   */
+  virtual std::shared_ptr<MappedFile> MapLocalFile(const string_view& uri);
+
   inline void PushDefaultHandler(std::shared_ptr<UriHandler> handler) {
     default_handler_list_.push_back(handler);
   }
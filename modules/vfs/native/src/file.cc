@@ -23,7 +23,10 @@
 #include "vfs/file.h"
 
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/statvfs.h>
 #include <iostream>
 
 namespace hippy {
@@ -130,5 +133,70 @@ uint64_t HippyFile::GetFileModifyTime(const string_view& file_path) {
   return modify_time;
 }
 
+static MappedFile::Identity GetFileIdentity(const struct stat& stat_info) {
+#ifdef __APPLE__
+  const auto& modify_time = stat_info.st_mtimespec;
+#else
+  const auto& modify_time = stat_info.st_mtim;
+#endif
+  return {static_cast<uint64_t>(stat_info.st_dev), static_cast<uint64_t>(stat_info.st_ino),
+          static_cast<uint64_t>(stat_info.st_size),
+          static_cast<int64_t>(modify_time.tv_sec) * 1000000000 + modify_time.tv_nsec};
+}
+
+// 只读挂载或不带任何写权限位的文件，进程无法原地改写（除非先修改权限），只能通过 rename 替换
+static bool IsReplacedOnlyByRename(int fd, const struct stat& stat_info) {
+  struct statvfs fs_info{};
+  if (fstatvfs(fd, &fs_info) == 0 && (fs_info.f_flag & ST_RDONLY)) {
+    return true;
+  }
+  return (stat_info.st_mode & (S_IWUSR | S_IWGRP | S_IWOTH)) == 0;
+}
+
+std::shared_ptr<MappedFile> MappedFile::Open(const string_view& file_path) {
+  auto path_str = StringViewUtils::ConvertEncoding(file_path,
+                                                   string_view::Encoding::Utf8).utf8_value();
+  auto path = reinterpret_cast<const char*>(path_str.c_str());
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    FOOTSTONE_DLOG(INFO) << "MappedFile open fail, file_path = " << file_path;
+    return nullptr;
+  }
+  struct stat stat_info{};
+  if (fstat(fd, &stat_info) != 0 || !S_ISREG(stat_info.st_mode) || stat_info.st_size <= 0) {
+    close(fd);
+    return nullptr;
+  }
+  if (!IsReplacedOnlyByRename(fd, stat_info)) {
+    FOOTSTONE_DLOG(INFO) << "MappedFile skip writable file, file_path = " << file_path;
+    close(fd);
+    return nullptr;
+  }
+  auto size = footstone::checked_numeric_cast<off_t, size_t>(stat_info.st_size);
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // 映射建立后即可关闭文件描述符
+  close(fd);
+  if (data == MAP_FAILED) {
+    FOOTSTONE_DLOG(WARNING) << "MappedFile mmap fail, file_path = " << file_path;
+    return nullptr;
+  }
+  // 内容随后会被完整顺序读取一遍（编译或计算哈希），提前预读
+  madvise(data, size, MADV_WILLNEED);
+  FOOTSTONE_DLOG(INFO) << "MappedFile succ, file_path = " << file_path << ", size = " << size;
+  return std::make_shared<MappedFile>(data, size, path, GetFileIdentity(stat_info));
+}
+
+bool MappedFile::IsModified() const {
+  struct stat stat_info{};
+  if (stat(path_.c_str(), &stat_info) != 0) {
+    return true;
+  }
+  return !(GetFileIdentity(stat_info) == identity_);
+}
+
+MappedFile::~MappedFile() {
+  munmap(data_, size_);
+}
+
 } // namespace vfs
 } // namespace hippy
@@ -163,6 +163,31 @@ void UriLoader::RequestUntrustedContent(const std::shared_ptr<RequestJob>& reque
   (**cur_it)->RequestUntrustedContent(request, new_cb, next);
 }
 
+std::shared_ptr<MappedFile> UriLoader::MapLocalFile(const string_view& uri) {
+  auto start_time = TimePoint::SystemNow();
+  auto scheme = GetScheme(uri);
+  std::shared_ptr<UriHandler> handler;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& scheme_it = router_.find(scheme);
+    if (scheme.empty() || scheme_it == router_.end() || scheme_it->second.size() != 1) {
+      return nullptr;
+    }
+    handler = scheme_it->second.front();
+  }
+  auto path = handler->GetPlainFilePath(uri);
+  if (StringViewUtils::IsEmpty(path)) {
+    return nullptr;
+  }
+  auto mapped_file = MappedFile::Open(path);
+  if (!mapped_file) {
+    return nullptr;
+  }
+  auto end_time = TimePoint::SystemNow();
+  DoRequestResultCallback(uri, start_time, end_time, static_cast<int32_t>(RetCode::Success), string_view());
+  return mapped_file;
+}
+
 std::shared_ptr<UriHandler> UriLoader::GetNextHandler(std::list<std::shared_ptr<UriHandler>>::iterator& cur,
                                                       const std::list<std::shared_ptr<UriHandler>>::iterator& end) {
   std::lock_guard<std::mutex> lock(mutex_);
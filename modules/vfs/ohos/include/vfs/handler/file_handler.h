@@ -43,6 +43,7 @@ class FileHandler : public UriHandler {
       std::shared_ptr<RequestJob> request,
       std::function<void(std::shared_ptr<JobResponse>)> cb,
       std::function<std::shared_ptr<UriHandler>()> next) override;
+  virtual string_view GetPlainFilePath(const string_view& uri) override;
  private:
   void LoadByFile(const string_view& path,
                   std::shared_ptr<RequestJob> request,
@@ -44,6 +44,7 @@ class FileHandler : public hippy::UriHandler {
       std::shared_ptr<hippy::RequestJob> request,
       std::function<void(std::shared_ptr<hippy::JobResponse>)> cb,
       std::function<std::shared_ptr<UriHandler>()> next) override;
+  virtual string_view GetPlainFilePath(const string_view& uri) override;
  private:
   void LoadByFile(const std::string& path,
                   std::shared_ptr<hippy::RequestJob> request,
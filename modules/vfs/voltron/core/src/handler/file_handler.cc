@@ -75,6 +75,18 @@ void FileHandler::RequestUntrustedContent(
   LoadByFile(path, request, new_cb, next);
 }
 
+FileHandler::string_view FileHandler::GetPlainFilePath(const string_view& uri) {
+  std::shared_ptr<Url> uri_obj =
+      std::make_shared<Url>(footstone::StringViewUtils::ToStdString(footstone::StringViewUtils::CovertToUtf8(
+          uri,
+          uri.encoding()).utf8_value()));
+  std::string path = uri_obj->path();
+  if (path.empty()) {
+    return {};
+  }
+  return string_view::new_from_utf8(path.c_str(), path.size());
+}
+
 void FileHandler::LoadByFile(const std::string& path,
                              std::shared_ptr<hippy::RequestJob> request,
                              std::function<void(std::shared_ptr<hippy::JobResponse>)> cb,
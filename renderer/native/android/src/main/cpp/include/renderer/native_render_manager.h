@@ -79,6 +79,8 @@ class NativeRenderManager : public RenderManager, public std::enable_shared_from
   void MoveRenderNode(std::weak_ptr<RootNode> root_node, std::vector<int32_t>&& moved_ids,
                       int32_t from_pid, int32_t to_pid, int32_t index) override;
   void EndBatch(std::weak_ptr<RootNode> root_node) override;
+  bool UpdateAnimationProps(std::weak_ptr<RootNode> root_node,
+                            const std::vector<AnimationPropsUpdate>& updates) override;
 
   void BeforeLayout(std::weak_ptr<RootNode> root_node) override;
   void AfterLayout(std::weak_ptr<RootNode> root_node) override;
@@ -102,6 +104,10 @@ class NativeRenderManager : public RenderManager, public std::enable_shared_from
     return persistent_map_;
   }
 
+  inline footstone::value::SerializerBufferPool::Stats GetSerializerStats() const {
+    return serializer_buffer_pool_->GetStats();
+  }
+
   static std::shared_ptr<StyleFilter> GetStyleFilter(const std::shared_ptr<JavaRef>& j_render_manager) {
     static std::shared_ptr<StyleFilter> style_filter = std::make_shared<StyleFilter>(j_render_manager);
     return style_filter;
@@ -139,7 +145,8 @@ class NativeRenderManager : public RenderManager, public std::enable_shared_from
   uint32_t id_;
   std::shared_ptr<JavaRef> j_render_manager_;
   std::shared_ptr<JavaRef> j_render_delegate_;
-  std::shared_ptr<footstone::value::Serializer> serializer_;
+  // 每个批次使用独立的 Serializer，结束时缓冲区归还到池中，超出 high water mark 的部分直接释放
+  std::shared_ptr<footstone::value::SerializerBufferPool> serializer_buffer_pool_;
   std::map<uint32_t, std::vector<ListenerOp>> event_listener_ops_;
 
   std::weak_ptr<DomManager> dom_manager_;
@@ -221,7 +221,7 @@ void UpdateNodeSize(JNIEnv *j_env, jobject j_object, jint j_render_manager_id,
     return;
   }
 
-  std::unordered_map<std::string, std::shared_ptr<HippyValue>> update_style;
+  hippy::dom::DomValueMap update_style;
   std::shared_ptr<HippyValue> width =
     std::make_shared<HippyValue>(footstone::check::checked_numeric_cast<jfloat, double>(j_width));
   std::shared_ptr<HippyValue> height =
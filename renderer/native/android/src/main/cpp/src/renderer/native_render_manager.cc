@@ -85,7 +85,7 @@ StyleFilter::StyleFilter(const std::shared_ptr<JavaRef>& j_render_manager) {
 }
 
 NativeRenderManager::NativeRenderManager() : RenderManager("NativeRenderManager"),
-      serializer_(std::make_shared<footstone::value::Serializer>()) {
+      serializer_buffer_pool_(std::make_shared<footstone::value::SerializerBufferPool>()) {
   id_ = unique_native_render_manager_id_.fetch_add(1);
 }
 
@@ -124,8 +124,8 @@ void NativeRenderManager::CreateRenderNode(std::weak_ptr<RootNode> root_node,
   }
   uint32_t root_id = root->GetId();
 
-  footstone::value::SerializerHelper::DestroyBuffer(serializer_->Release());
-  serializer_->WriteHeader();
+  footstone::value::Serializer serializer(serializer_buffer_pool_);
+  serializer.WriteHeader();
 
   auto len = nodes.size();
   footstone::value::HippyValue::HippyValueArrayType dom_node_array;
@@ -155,6 +155,10 @@ void NativeRenderManager::CreateRenderNode(std::weak_ptr<RootNode> root_node,
         layout_result.height = self->PxToDp(static_cast<float>((int32_t)(0xFFFFFFFF & result)));
         return layout_result;
       };
+      // TextInput 的尺寸还取决于用户输入的内容，不在 dom 属性中，不能缓存
+      if (nodes[i]->GetViewName() == "Text") {
+        measure_function = root->GetMeasureCache()->Wrap(nodes[i], std::move(measure_function));
+      }
       nodes[i]->GetLayoutNode()->SetMeasureFunction(measure_function);
     }
 
@@ -180,10 +184,9 @@ void NativeRenderManager::CreateRenderNode(std::weak_ptr<RootNode> root_node,
     dom_node[kProps] = props;
     dom_node_array[i] = dom_node;
   }
-  serializer_->WriteValue(HippyValue(dom_node_array));
-  std::pair<uint8_t*, size_t> buffer_pair = serializer_->Release();
+  serializer.WriteValue(HippyValue(dom_node_array));
+  std::pair<uint8_t*, size_t> buffer_pair = serializer.GetBuffer();
   CallNativeMethod("createNode", root->GetId(), buffer_pair);
-  footstone::value::SerializerHelper::DestroyBuffer(buffer_pair);
 }
 
 void NativeRenderManager::UpdateRenderNode(std::weak_ptr<RootNode> root_node,
@@ -201,8 +204,8 @@ void NativeRenderManager::UpdateRenderNode(std::weak_ptr<RootNode> root_node,
     }
   }
 
-  footstone::value::SerializerHelper::DestroyBuffer(serializer_->Release());
-  serializer_->WriteHeader();
+  footstone::value::Serializer serializer(serializer_buffer_pool_);
+  serializer.WriteHeader();
 
   auto len = nodes.size();
   footstone::value::HippyValue::HippyValueArrayType dom_node_array;
@@ -240,10 +243,9 @@ void NativeRenderManager::UpdateRenderNode(std::weak_ptr<RootNode> root_node,
     dom_node[kDeleteProps] = del_props;
     dom_node_array[i] = dom_node;
   }
-  serializer_->WriteValue(HippyValue(dom_node_array));
-  std::pair<uint8_t*, size_t> buffer_pair = serializer_->Release();
+  serializer.WriteValue(HippyValue(dom_node_array));
+  std::pair<uint8_t*, size_t> buffer_pair = serializer.GetBuffer();
   CallNativeMethod("updateNode", root->GetId(), buffer_pair);
-  footstone::value::SerializerHelper::DestroyBuffer(buffer_pair);
 }
 
 void NativeRenderManager::MoveRenderNode(std::weak_ptr<RootNode> root_node,
@@ -253,8 +255,8 @@ void NativeRenderManager::MoveRenderNode(std::weak_ptr<RootNode> root_node,
     return;
   }
 
-  footstone::value::SerializerHelper::DestroyBuffer(serializer_->Release());
-  serializer_->WriteHeader();
+  footstone::value::Serializer serializer(serializer_buffer_pool_);
+  serializer.WriteHeader();
 
   auto len = nodes.size();
   footstone::value::HippyValue::HippyValueArrayType dom_node_array;
@@ -267,8 +269,8 @@ void NativeRenderManager::MoveRenderNode(std::weak_ptr<RootNode> root_node,
     dom_node[kIndex] = footstone::value::HippyValue(render_info.index);
     dom_node_array[i] = dom_node;
   }
-  serializer_->WriteValue(HippyValue(dom_node_array));
-  std::pair<uint8_t*, size_t> buffer_pair = serializer_->Release();
+  serializer.WriteValue(HippyValue(dom_node_array));
+  std::pair<uint8_t*, size_t> buffer_pair = serializer.GetBuffer();
 
   std::shared_ptr<JNIEnvironment> instance = JNIEnvironment::GetInstance();
   JNIEnv* j_env = instance->AttachCurrentThread();
@@ -293,7 +295,6 @@ void NativeRenderManager::MoveRenderNode(std::weak_ptr<RootNode> root_node,
   JNIEnvironment::ClearJEnvException(j_env);
   j_env->DeleteLocalRef(j_buffer);
   j_env->DeleteLocalRef(j_class);
-  footstone::value::SerializerHelper::DestroyBuffer(buffer_pair);
 }
 
 void NativeRenderManager::DeleteRenderNode(std::weak_ptr<RootNode> root_node,
@@ -342,8 +343,8 @@ void NativeRenderManager::UpdateLayout(std::weak_ptr<RootNode> root_node,
     return;
   }
 
-  footstone::value::SerializerHelper::DestroyBuffer(serializer_->Release());
-  serializer_->WriteHeader();
+  footstone::value::Serializer serializer(serializer_buffer_pool_);
+  serializer.WriteHeader();
 
   auto len = nodes.size();
   footstone::value::HippyValue::HippyValueArrayType dom_node_array;
@@ -364,10 +365,9 @@ void NativeRenderManager::UpdateLayout(std::weak_ptr<RootNode> root_node,
     }
     dom_node_array[i] = dom_node;
   }
-  serializer_->WriteValue(HippyValue(dom_node_array));
-  std::pair<uint8_t*, size_t> buffer_pair = serializer_->Release();
+  serializer.WriteValue(HippyValue(dom_node_array));
+  std::pair<uint8_t*, size_t> buffer_pair = serializer.GetBuffer();
   CallNativeMethod("updateLayout", root->GetId(), buffer_pair);
-  footstone::value::SerializerHelper::DestroyBuffer(buffer_pair);
 }
 
 void NativeRenderManager::MoveRenderNode(std::weak_ptr<RootNode> root_node,
@@ -414,6 +414,48 @@ void NativeRenderManager::EndBatch(std::weak_ptr<RootNode> root_node) {
   }
 }
 
+bool NativeRenderManager::UpdateAnimationProps(std::weak_ptr<RootNode> root_node,
+                                               const std::vector<AnimationPropsUpdate>& updates) {
+  auto root = root_node.lock();
+  if (!root) {
+    return false;
+  }
+  // 文本节点的属性变化需要重新测量，仍走 UpdateRenderNode 的完整流程
+  for (const auto& update : updates) {
+    auto node = root->GetNode(update.id);
+    if (!node || node->GetViewName() == "Text") {
+      return false;
+    }
+  }
+
+  footstone::value::Serializer serializer(serializer_buffer_pool_);
+  serializer.WriteHeader();
+
+  // 复用 updateNode 的数据格式，只包含 id 与本帧的属性，随后的 endBatch 让渲染层立即应用
+  footstone::value::HippyValue::HippyValueArrayType dom_node_array;
+  dom_node_array.reserve(updates.size());
+  for (const auto& update : updates) {
+    footstone::value::HippyValue::HippyValueObjectType dom_node;
+    dom_node[kId] = footstone::value::HippyValue(update.id);
+    footstone::value::HippyValue::HippyValueObjectType props;
+    if (update.props) {
+      for (const auto& [key, value] : *update.props) {
+        FOOTSTONE_DCHECK(value != nullptr);
+        if (value) {
+          props[key] = *value;
+        }
+      }
+    }
+    dom_node[kProps] = props;
+    dom_node_array.push_back(dom_node);
+  }
+  serializer.WriteValue(HippyValue(dom_node_array));
+  std::pair<uint8_t*, size_t> buffer_pair = serializer.GetBuffer();
+  CallNativeMethod("updateNode", root->GetId(), buffer_pair);
+  CallNativeMethod("endBatch", root->GetId());
+  return true;
+}
+
 void NativeRenderManager::BeforeLayout(std::weak_ptr<RootNode> root_node){}
 
 void NativeRenderManager::AfterLayout(std::weak_ptr<RootNode> root_node) {
@@ -636,12 +678,11 @@ void NativeRenderManager::HandleListenerOps(std::weak_ptr<RootNode> root_node,
     return;
   }
 
-  footstone::value::SerializerHelper::DestroyBuffer(serializer_->Release());
-  serializer_->WriteHeader();
-  serializer_->WriteValue(HippyValue(event_listener_ops));
-  std::pair<uint8_t*, size_t> buffer_pair = serializer_->Release();
+  footstone::value::Serializer serializer(serializer_buffer_pool_);
+  serializer.WriteHeader();
+  serializer.WriteValue(HippyValue(event_listener_ops));
+  std::pair<uint8_t*, size_t> buffer_pair = serializer.GetBuffer();
   CallNativeMethod(method_name, root->GetId(), buffer_pair);
-  footstone::value::SerializerHelper::DestroyBuffer(buffer_pair);
 }
 
 void NativeRenderManager::MarkTextDirty(std::weak_ptr<RootNode> weak_root_node, uint32_t node_id) {
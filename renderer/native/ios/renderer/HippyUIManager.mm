@@ -884,8 +884,8 @@ NSString *const HippyUIManagerDidEndBatchNotification = @"HippyUIManagerDidEndBa
             continue;
         }
         NSNumber *componentTag = @(node->GetRenderInfo().id);
-        NSDictionary *styleProps = UnorderedMapDomValueToDictionary(node->GetStyleMap());
-        NSDictionary *extProps = UnorderedMapDomValueToDictionary(node->GetExtStyle());
+        NSDictionary *styleProps = DomValueMapToDictionary(node->GetStyleMap());
+        NSDictionary *extProps = DomValueMapToDictionary(node->GetExtStyle());
         NSMutableDictionary *props = [NSMutableDictionary dictionaryWithDictionary:styleProps];
         [props addEntriesFromDictionary:extProps];
         [self updateView:componentTag onRootTag:rootTag props:props];
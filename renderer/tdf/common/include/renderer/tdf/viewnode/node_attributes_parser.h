@@ -34,6 +34,7 @@
 #include "tdfui/view/view.h"
 #pragma clang diagnostic pop
 
+#include "dom/dom_value_map.h"
 #include "footstone/hippy_value.h"
 
 namespace hippy {
@@ -43,7 +44,7 @@ namespace util {
 
 using Point = tdfcore::TPoint;
 using Color = tdfcore::Color;
-using DomStyleMap = std::unordered_map<std::string, std::shared_ptr<footstone::HippyValue>>;
+using DomStyleMap = hippy::dom::DomValueMap;
 
 double HippyValueToDouble(const footstone::HippyValue &value);
 
@@ -159,7 +159,7 @@ class ViewNode : public tdfcore::Object, public std::enable_shared_from_this<Vie
  public:
   using DomValueObjectType = footstone::HippyValue::HippyValueObjectType;
   using DomArgument = hippy::dom::DomArgument;
-  using DomStyleMap = std::unordered_map<std::string, std::shared_ptr<footstone::HippyValue>>;
+  using DomStyleMap = hippy::dom::DomValueMap;
   using DomDeleteProps = std::vector<std::string>;
   using RenderInfo = hippy::dom::DomNode::RenderInfo;
   using node_creator = std::function<std::shared_ptr<ViewNode>(const std::shared_ptr<hippy::dom::DomNode>&)>;
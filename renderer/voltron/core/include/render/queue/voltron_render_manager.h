@@ -75,8 +75,7 @@ class VoltronRenderManager : public hippy::RenderManager,
 
  private:
   void MarkTextDirty(const std::weak_ptr<RootNode> &root_node, uint32_t node_id);
-  static void MarkDirtyProperty(std::shared_ptr<std::unordered_map<std::string,
-                                                                   std::shared_ptr<HippyValue>>> diff_style,
+  static void MarkDirtyProperty(std::shared_ptr<hippy::dom::DomValueMap> diff_style,
                                 const char *prop_name,
                                 std::shared_ptr<LayoutNode> layout_node);
 
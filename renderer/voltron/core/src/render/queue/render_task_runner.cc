@@ -266,7 +266,7 @@ VoltronRenderTaskRunner::HippyValue VoltronRenderTaskRunner::EncodeDomValue(cons
 }
 
 EncodableValue
-VoltronRenderTaskRunner::DecodeDomValueMap(const SpMap<HippyValue> &value_map) {
+VoltronRenderTaskRunner::DecodeDomValueMap(const hippy::dom::DomValueMap &value_map) {
   auto encode_map = EncodableMap();
 
   for (const auto &entry: value_map) {
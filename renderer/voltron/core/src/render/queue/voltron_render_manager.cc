@@ -93,9 +93,7 @@ void VoltronRenderManager::MarkTextDirty(const std::weak_ptr<RootNode> &root_nod
   }
 }
 
-void VoltronRenderManager::MarkDirtyProperty(std::shared_ptr<std::unordered_map<std::string,
-                                                                                std::shared_ptr<
-                                                                                    HippyValue>>> diff_style,
+void VoltronRenderManager::MarkDirtyProperty(std::shared_ptr<hippy::dom::DomValueMap> diff_style,
                                              const char *prop_name,
                                              std::shared_ptr<LayoutNode> layout_node) {
   FOOTSTONE_DCHECK(layout_node != nullptr);